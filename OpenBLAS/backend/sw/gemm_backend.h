@@ -14,6 +14,8 @@
 #include <assert.h>
 #include <getopt.h>
 #include <ctype.h>
+#include <math.h>
+#include <float.h>
 
 
 // #include <osnap_tools.h>
@@ -53,6 +55,23 @@ extern "C" {
 /* This number is unique and is declared in ~snap/ActionTypes.md */
 #define ACTION_TYPE 0x86868604
 
+/* cgemm specific, read only: bit 31 exact outputs, 30:24 nb_bits_ovf,
+   23:12 msb_summand and 11:0 lsb_summand as signed */
+#define ACTION_ACCUM_REG 0x188
+#define GEMM_ACCUM_EXACT 0x80000000
+
+/* cgemm specific, read only: bit 31 weight stationary arrays, 23:0 the
+   k steps of B they hold; 0 for orthogonal arrays */
+#define ACTION_TOPOLOGY_REG 0x18C
+#define GEMM_TOPOLOGY_WS 0x80000000
+
+/* cgemm specific, read only: alternate input format f = 1..3 of the arrays at
+   ACTION_ALT_FORMAT_REG + 4*(f-1), B3 arith type, B2 bitwidth in bits, B1
+   param1, B0 param2; 0 when there is no format f. A job selects its input
+   format in the arith_format field of action_job_t, 0 for ACTION_TYPE_REG's */
+#define ACTION_ALT_FORMAT_REG 0x1C0
+#define GEMM_ALT_FORMATS 3
+
 static uint8_t verbose_level = 0;
 
 #define VERBOSE0(file, fmt, ...) do {       \
@@ -88,6 +107,7 @@ typedef struct action_job {
     uint32_t read_burst_num;
     uint32_t write_burst_num;
     uint32_t transfer_type;
+    uint32_t arith_format;  /* input format of the job */
 } action_job_t;
 
 // static long get_nanos(void) {
@@ -125,7 +145,8 @@ static void snap_prepare_action(struct snap_job *cjob,
                                 uint8_t type_out,
                                 uint32_t read_burst_num,
                                 uint32_t write_burst_num,
-                                uint32_t transfer_type)
+                                uint32_t transfer_type,
+                                uint32_t arith_format)
 {
     assert(sizeof(*mjob) <= SNAP_JOBSIZE);
     memset(mjob, 0, sizeof(*mjob));
@@ -139,6 +160,7 @@ static void snap_prepare_action(struct snap_job *cjob,
     mjob->read_burst_num = read_burst_num;
     mjob->write_burst_num = write_burst_num;
     mjob->transfer_type = transfer_type;
+    mjob->arith_format = arith_format;
 
     snap_job_set(cjob, mjob, sizeof(*mjob), NULL, 0);
 }
@@ -495,6 +517,469 @@ static IFLOAT from_bytes_to_IFLOAT(
 	}
 }
 
+/**
+	@brief decodes reg, the ACTION_ALT_FORMAT_REG entry of an alternate input
+	format, into its type, width in bytes and parameters. False when the arrays
+	have no such format or its elements do not fit the slots of
+	arithmetic_bitwidth bytes of the ACTION_TYPE_REG format
+  */
+static bool gemm_alt_format(uint32_t reg, uint8_t arithmetic_bitwidth,
+		uint8_t *type, uint8_t *bitwidth, uint8_t *param1, uint8_t *param2) {
+	if ((reg & 0x00FF0000) == 0 || ((reg & 0x00FF0000) >> 19) > arithmetic_bitwidth) {
+		return false;
+	}
+	*type     = (reg & 0xFF000000) >> 24;
+	*bitwidth = (reg & 0x00FF0000) >> 19;  // in bytes
+	*param1   = (reg & 0x0000FF00) >>  8;
+	*param2   = (reg & 0x000000FF) >>  0;
+	return true;
+}
+
+/* bus words of the input stream sent per job, override with GEMM_CHUNK_WORDS */
+#define GEMM_CHUNK_WORDS 8192
+#define GEMM_SOB 0x40  // flags in the last byte of a bus word
+#define GEMM_EOB 0x80
+#define GEMM_LDB 0x20  // weight stationary: the word loads one step of B
+/* sparse streams are used when they leave out at least this fraction of the
+   words, override with GEMM_SPARSE_SKIP, 1 keeps every stream dense */
+#define GEMM_SPARSE_SKIP 0.125
+
+/**
+	@brief layout of the SOB/EOB framed input stream: block b multiplies row band
+	(b/groups)/vertical_bands of op(A) by column band (b/groups)%vertical_bands
+	of op(B), one bus word per step of a k_segment long slice of k, so any range
+	of words can be packed on its own. Lane e of block b takes the slice
+	(b%groups)*lanes+e. Rounded outputs cannot be summed on the host, so their
+	stream is tiled instead: k is a single slice and lane e of block b takes
+	the pair of bands p = b*lanes+e, row band p/vertical_bands by column band
+	p%vertical_bands, the lanes past the last pair staying zero.
+
+	With weight stationary arrays, k is cut in segments of k_segment steps the
+	B buffer holds, and each column band is loaded once per segment with LDB
+	words, the B band at bit 0. The following words carry A only, lane e the
+	row band wave*lanes+e, so a loaded segment serves every wave of row bands,
+	each wave ending its own block. Rounded outputs cannot be summed on the
+	host: when k needs several segments they are chained, each wave loading
+	them again in turn and only the last one ending the block.
+
+	A sparse orthogonal stream leaves out the steps that only multiply zeros:
+	block b then takes words [block_words[b], block_words[b+1]) and word w
+	carries step steps[w] of the slices, k_segment for a padding word of zeros.
+  */
+typedef struct gemm_stream {
+	IFLOAT *A;
+	IFLOAT *B;
+	uint64_t m, n, k;
+	uint64_t lda, ldb;
+	int transA, transB;
+	uint8_t rows, columns;
+	uint64_t vertical_bands;
+	uint64_t k_segment, groups;
+	uint8_t lanes;
+	int tiled, stationary, chained;
+	uint64_t blocks;
+	uint64_t segments, waves;
+	uint64_t *block_words, *steps;  // NULL for a dense stream
+	uint16_t bus_size;
+	uint8_t arithmetic_slot;  // bytes between elements, the input format fills the low ones
+	uint8_t arithmetic_type, arithmetic_bitwidth, arithmetic_param1, arithmetic_param2;
+} gemm_stream_t;
+
+/**
+	@brief the pair of bands, row band * vertical_bands + column band, and the
+	step kk of k that lane `lane` of an orthogonal block multiplies at `step`
+  */
+static uint64_t gemm_stream_pair(const gemm_stream_t *s, uint64_t block, uint8_t lane, uint64_t step, uint64_t *kk) {
+	if (s->tiled) {
+		*kk = step;
+		return block*s->lanes + lane;
+	}
+	*kk = ((block % s->groups)*s->lanes + lane)*s->k_segment + step;
+	return block / s->groups;
+}
+
+/**
+	@brief where word w of a weight stationary stream falls: the column band,
+	the wave and segment it serves, its step in the segment and whether it
+	loads B
+  */
+static void gemm_stream_locate(const gemm_stream_t *s, uint64_t w,
+		uint64_t *band, uint64_t *wave, uint64_t *segment, uint64_t *step, bool *load) {
+	uint64_t L = s->k_segment;
+	if (s->chained) {
+		uint64_t per_wave = 2*L*s->segments;
+		*band    = w / (per_wave*s->waves);
+		*wave    = (w / per_wave) % s->waves;
+		*segment = (w % per_wave) / (2*L);
+		*load    = (w % (2*L)) < L;
+		*step    = w % L;
+		return;
+	}
+	uint64_t per_segment = L*(1+s->waves);
+	uint64_t r = w % per_segment;
+	*band    = w / (per_segment*s->segments);
+	*segment = (w / per_segment) % s->segments;
+	*load    = r < L;
+	*wave    = *load ? 0 : (r - L) / L;
+	*step    = r % L;
+}
+
+/**
+	@brief the last block of a sparse stream starting at or before word w, so
+	also the number of blocks words [0, w) end
+  */
+static uint64_t gemm_stream_block_of(const gemm_stream_t *s, uint64_t w) {
+	uint64_t lo = 0, hi = s->blocks;
+	while (lo < hi) {
+		uint64_t mid = (lo + hi + 1) / 2;
+		if (s->block_words[mid] <= w)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+	return lo;
+}
+
+/**
+	@brief the number of blocks that words [0, end) of the stream end, each
+	one writes systolic array rows words of output
+  */
+static uint64_t gemm_stream_blocks(const gemm_stream_t *s, uint64_t end) {
+	if (s->steps) {
+		return gemm_stream_block_of(s, end);
+	}
+	if (!s->stationary) {
+		return end / s->k_segment;
+	}
+	if (s->chained) {
+		return end / (2*s->k_segment*s->segments);
+	}
+	uint64_t per_segment = s->k_segment*(1+s->waves);
+	uint64_t r = end % per_segment;
+	return (end / per_segment)*s->waves + (r >= s->k_segment ? r / s->k_segment - 1 : 0);
+}
+
+static void gemm_stream_pack_stationary(const gemm_stream_t *s, uint64_t first_word, uint64_t words, char *dst, char *bytes_scratchpad) {
+	IFLOAT arith_scratchpad;
+	memset(dst, 0, words*s->bus_size);
+	for (uint64_t w=0 ; w < words ; ++w) {
+		uint64_t band, wave, segment, step;
+		bool load;
+		gemm_stream_locate(s, first_word+w, &band, &wave, &segment, &step, &load);
+		uint64_t kk = segment*s->k_segment + step;
+		char *word = dst + w*s->bus_size;
+		bool first = step==0 && (load || !s->chained || segment==0);
+		bool last  = !load && step==s->k_segment-1 && (!s->chained || segment==s->segments-1);
+		word[s->bus_size-1] = (load ? GEMM_LDB : 0) | (first ? GEMM_SOB : 0) | (last ? GEMM_EOB : 0);
+		if (kk >= s->k) {
+			continue;
+		}
+		if (load) {
+			uint64_t col0 = band * s->columns;
+			for (uint64_t col_i=0 ; col_i < s->columns && col0+col_i < s->n ; ++col_i) {
+				if (s->transB==0) {
+					arith_scratchpad = s->B[(col0+col_i)*s->ldb + kk];
+				} else {
+					arith_scratchpad = s->B[(kk*s->ldb) + (col0+col_i)];
+				}
+				from_IFLOAT_to_bytes(&arith_scratchpad, s->arithmetic_type, s->arithmetic_bitwidth, s->arithmetic_param1, s->arithmetic_param2, bytes_scratchpad);
+				memcpy(word + col_i*s->arithmetic_slot, bytes_scratchpad, s->arithmetic_bitwidth);
+			}
+			continue;
+		}
+		for (uint8_t lane=0 ; lane < s->lanes ; ++lane) {
+			uint64_t row0 = (wave*s->lanes + lane) * s->rows;
+			for (uint64_t row_i=0 ; row_i < s->rows && row0+row_i < s->m ; ++row_i) {
+				if (s->transA==0) {
+					arith_scratchpad = s->A[(row0+row_i) + (kk*s->lda)];
+				} else {
+					arith_scratchpad = s->A[(row0+row_i)*s->lda + kk];
+				}
+				from_IFLOAT_to_bytes(&arith_scratchpad, s->arithmetic_type, s->arithmetic_bitwidth, s->arithmetic_param1, s->arithmetic_param2, bytes_scratchpad);
+				memcpy(word + (lane*s->rows + row_i)*s->arithmetic_slot, bytes_scratchpad, s->arithmetic_bitwidth);
+			}
+		}
+	}
+}
+
+/**
+	@brief casts and places the elements of words [first_word, first_word+words)
+	of the stream into dst, padding rows and columns past m and n and steps past
+	k are zero
+  */
+static void gemm_stream_pack(const gemm_stream_t *s, uint64_t first_word, uint64_t words, char *dst, char *bytes_scratchpad) {
+	IFLOAT arith_scratchpad;
+	size_t lane_size = (s->rows+s->columns)*s->arithmetic_slot;
+	if (s->stationary) {
+		gemm_stream_pack_stationary(s, first_word, words, dst, bytes_scratchpad);
+		return;
+	}
+	memset(dst, 0, words*s->bus_size);
+	for (uint64_t w=0 ; w < words ; ++w) {
+		uint64_t block = (first_word+w) / s->k_segment;
+		uint64_t step  = (first_word+w) % s->k_segment;
+		bool first = step==0;
+		bool last  = step==s->k_segment-1;
+		if (s->steps) {
+			block = gemm_stream_block_of(s, first_word+w);
+			step  = s->steps[first_word+w];
+			first = first_word+w == s->block_words[block];
+			last  = first_word+w+1 == s->block_words[block+1];
+		}
+		char *word = dst + w*s->bus_size;
+		for (uint8_t lane=0 ; lane < s->lanes ; ++lane) {
+			uint64_t kk;
+			uint64_t pair = gemm_stream_pair(s, block, lane, step, &kk);
+			uint64_t row0 = (pair / s->vertical_bands) * s->rows;
+			uint64_t col0 = (pair % s->vertical_bands) * s->columns;
+			char *lane_word = word + lane*lane_size;
+			if (kk >= s->k || step >= s->k_segment || row0 >= s->m) {
+				break;  // past k, a padding word or past the last pair
+			}
+			for (uint64_t row_i=0 ; row_i < s->rows && row0+row_i < s->m ; ++row_i) {
+				if (s->transA==0) {
+					arith_scratchpad = s->A[(row0+row_i) + (kk*s->lda)];
+				} else {
+					arith_scratchpad = s->A[(row0+row_i)*s->lda + kk];
+				}
+				from_IFLOAT_to_bytes(&arith_scratchpad, s->arithmetic_type, s->arithmetic_bitwidth, s->arithmetic_param1, s->arithmetic_param2, bytes_scratchpad);
+				memcpy(lane_word + row_i*s->arithmetic_slot, bytes_scratchpad, s->arithmetic_bitwidth);
+			}
+			for (uint64_t col_i=0 ; col_i < s->columns && col0+col_i < s->n ; ++col_i) {
+				if (s->transB==0) {
+					arith_scratchpad = s->B[(col0+col_i)*s->ldb + kk];
+				} else {
+					arith_scratchpad = s->B[(kk*s->ldb) + (col0+col_i)];
+				}
+				from_IFLOAT_to_bytes(&arith_scratchpad, s->arithmetic_type, s->arithmetic_bitwidth, s->arithmetic_param1, s->arithmetic_param2, bytes_scratchpad);
+				memcpy(lane_word + (s->rows+col_i)*s->arithmetic_slot, bytes_scratchpad, s->arithmetic_bitwidth);
+			}
+		}
+		word[s->bus_size-1] = (first ? GEMM_SOB : 0) | (last ? GEMM_EOB : 0);
+	}
+}
+
+/**
+	@brief finds the words of an orthogonal stream that only multiply zeros:
+	those whose lanes all take an all zero column of the A band against a
+	finite row of the B band, or an all zero row of the B band against a finite
+	column of the A band. 0*Inf and 0*NaN are NaN, so these words are kept as
+	in the dense stream. They are left out when that saves at least min_skip of
+	the words. A block keeps its other words in order, padded with zero words
+	to the array rows so that the drains of two blocks never overlap, and its
+	first and last word take SOB and EOB as usual.
+	@return the number of words of the stream, the dense one's otherwise
+  */
+static uint64_t gemm_stream_sparsify(gemm_stream_t *s, double min_skip) {
+	uint64_t blocks = s->blocks;
+	uint64_t dense_words = s->k_segment*blocks;
+	uint64_t horizontal_bands = (s->m + s->rows - 1) / s->rows;
+	s->block_words = NULL;
+	s->steps = NULL;
+	if (min_skip >= 1.0) {
+		return dense_words;
+	}
+	// per band and step of k: are its values all zero, are they all finite
+	bool *zero_A = (bool*)malloc(horizontal_bands*s->k*sizeof(bool));
+	bool *finite_A = (bool*)malloc(horizontal_bands*s->k*sizeof(bool));
+	bool *zero_B = (bool*)malloc(s->vertical_bands*s->k*sizeof(bool));
+	bool *finite_B = (bool*)malloc(s->vertical_bands*s->k*sizeof(bool));
+	for (uint64_t kk=0 ; kk < s->k ; ++kk) {
+		for (uint64_t band=0 ; band < horizontal_bands ; ++band) {
+			bool zero = true, finite = true;
+			for (uint64_t row=band*s->rows ; row < (band+1)*s->rows && row < s->m ; ++row) {
+				IFLOAT a = s->transA==0 ? s->A[row + kk*s->lda] : s->A[row*s->lda + kk];
+				zero = zero && a == 0;
+				finite = finite && isfinite(a);
+			}
+			zero_A[band*s->k + kk] = zero;
+			finite_A[band*s->k + kk] = finite;
+		}
+		for (uint64_t band=0 ; band < s->vertical_bands ; ++band) {
+			bool zero = true, finite = true;
+			for (uint64_t col=band*s->columns ; col < (band+1)*s->columns && col < s->n ; ++col) {
+				IFLOAT b = s->transB==0 ? s->B[col*s->ldb + kk] : s->B[kk*s->ldb + col];
+				zero = zero && b == 0;
+				finite = finite && isfinite(b);
+			}
+			zero_B[band*s->k + kk] = zero;
+			finite_B[band*s->k + kk] = finite;
+		}
+	}
+
+	// a block never takes more than k_segment words, which is at least rows
+	uint64_t *block_words = (uint64_t*)malloc((blocks+1)*sizeof(uint64_t));
+	uint64_t *steps = (uint64_t*)malloc(dense_words*sizeof(uint64_t));
+	uint64_t words = 0;
+	for (uint64_t block=0 ; block < blocks ; ++block) {
+		block_words[block] = words;
+		for (uint64_t step=0 ; step < s->k_segment ; ++step) {
+			for (uint8_t lane=0 ; lane < s->lanes ; ++lane) {
+				uint64_t kk;
+				uint64_t pair = gemm_stream_pair(s, block, lane, step, &kk);
+				uint64_t row_band = pair / s->vertical_bands;
+				uint64_t col_band = pair % s->vertical_bands;
+				if (kk >= s->k || row_band >= horizontal_bands) {
+					break;
+				}
+				uint64_t a = row_band*s->k + kk, b = col_band*s->k + kk;
+				if (!(zero_A[a] && finite_B[b]) && !(zero_B[b] && finite_A[a])) {
+					steps[words++] = step;
+					break;
+				}
+			}
+		}
+		while (words - block_words[block] < s->rows) {
+			steps[words++] = s->k_segment;
+		}
+	}
+	block_words[blocks] = words;
+	free(zero_A);
+	free(finite_A);
+	free(zero_B);
+	free(finite_B);
+
+	if (words > dense_words*(1.0 - min_skip)) {
+		free(block_words);
+		free(steps);
+		return dense_words;
+	}
+	s->block_words = block_words;
+	s->steps = steps;
+	return words;
+}
+
+/**
+	@brief loads the exact output of `bits` bits at bit pos of src: an
+	accumulator in two's complement under a NaN flag. It is sign extended over
+	the limbs of term, the NaN flag is returned
+  */
+static bool gemm_exact_load(uint64_t *term, size_t limbs, const char *src, uint64_t pos, uint16_t bits) {
+	const uint8_t *p = (const uint8_t *)src + (pos >> 3);
+	int shift = pos & 7;
+	int acc_bits = bits - 1;
+	memset(term, 0, limbs*sizeof(uint64_t));
+	for (int i=0 ; 8*i < shift+bits ; ++i) {
+		int at = 8*i - shift;  // where byte i lands in the field
+		uint64_t v = p[i];
+		if (at < 0) {
+			v >>= -at;
+			at = 0;
+		}
+		term[at >> 6] |= v << (at & 63);
+		if ((at & 63) > 56) {
+			term[(at >> 6) + 1] |= v >> (64 - (at & 63));
+		}
+	}
+	bool nan  = (term[acc_bits >> 6] >> (acc_bits & 63)) & 1;
+	bool sign = (term[(acc_bits-1) >> 6] >> ((acc_bits-1) & 63)) & 1;
+	uint64_t fill = sign ? ~0ULL : 0;
+	size_t l = acc_bits >> 6;
+	int b = acc_bits & 63;
+	term[l] = (b ? term[l] & ((1ULL << b) - 1) : 0) | (fill << b);
+	for (size_t i=l+1 ; i < limbs ; ++i) {
+		term[i] = fill;
+	}
+	return nan;
+}
+
+/**
+	@brief sum += term over limbs 64 bit limbs, two's complement
+  */
+static void gemm_exact_add(uint64_t *sum, const uint64_t *term, size_t limbs) {
+	uint64_t carry = 0;
+	for (size_t i=0 ; i < limbs ; ++i) {
+		uint64_t s = sum[i] + carry;
+		carry = s < carry;
+		sum[i] = s + term[i];
+		carry |= sum[i] < s;
+	}
+}
+
+/**
+	@brief rounds sum * 2^lsb to the nearest even IFLOAT, sum is two's
+	complement over limbs 64 bit limbs and is consumed
+  */
+static IFLOAT gemm_exact_round(uint64_t *sum, size_t limbs, int lsb) {
+	int precision = (sizeof(IFLOAT)==4) ? FLT_MANT_DIG : DBL_MANT_DIG;
+	int min_ulp   = (sizeof(IFLOAT)==4) ? FLT_MIN_EXP-FLT_MANT_DIG : DBL_MIN_EXP-DBL_MANT_DIG;
+	bool sign = sum[limbs-1] >> 63;
+	if (sign) {
+		uint64_t carry = 1;
+		for (size_t i=0 ; i < limbs ; ++i) {
+			sum[i] = ~sum[i] + carry;
+			carry = carry && sum[i] == 0;
+		}
+	}
+	int64_t top = -1;
+	for (size_t i=limbs ; i-- > 0 ; ) {
+		if (sum[i]) {
+			top = 64*i + 63 - __builtin_clzll(sum[i]);
+			break;
+		}
+	}
+	if (top < 0) {
+		return 0.0f;
+	}
+
+	// keep precision bits from the top, fewer where the result is subnormal
+	int64_t cut = top - precision + 1;
+	if (cut + lsb < min_ulp) {
+		cut = min_ulp - lsb;
+	}
+	if (cut < 0) {
+		cut = 0;
+	}
+	if (cut > top+1) {
+		return sign ? -0.0f : 0.0f;  // below half the smallest subnormal
+	}
+	uint64_t mantissa = 0;
+	if (cut <= top) {
+		uint64_t l = cut >> 6, b = cut & 63;
+		mantissa = sum[l] >> b;
+		if (b && l+1 < limbs) {
+			mantissa |= sum[l+1] << (64 - b);
+		}
+		mantissa &= (1ULL << (top - cut + 1)) - 1;
+	}
+	bool guard = cut > 0 && ((sum[(cut-1) >> 6] >> ((cut-1) & 63)) & 1);
+	bool sticky = false;
+	for (int64_t i=0 ; i < (cut-1) >> 6 && !sticky ; ++i) {
+		sticky = sum[i] != 0;
+	}
+	if (cut > 1 && ((cut-1) & 63)) {
+		sticky = sticky || (sum[(cut-1) >> 6] & ((1ULL << ((cut-1) & 63)) - 1));
+	}
+	if (guard && (sticky || (mantissa & 1))) {
+		++mantissa;  // at most 2^precision, ldexp carries it into the exponent
+	}
+	double magnitude = ldexp((double)mantissa, (int)(cut + lsb));
+	return (IFLOAT)(sign ? -magnitude : magnitude);
+}
+
+/**
+	@brief adds up the exact outputs that lanes of groups consecutive blocks
+	hold for one element of C and rounds the sum once, so the result does not
+	depend on how k was cut. first_row is the element's row word in the first
+	block, first_bit its place in lane 0
+  */
+static IFLOAT gemm_exact_reduce(const char *first_row, size_t block_size, uint64_t groups, uint8_t lanes,
+		uint64_t first_bit, uint64_t lane_bits, uint16_t bits, int lsb,
+		uint64_t *sum, uint64_t *term, size_t limbs) {
+	bool nan = false;
+	memset(sum, 0, limbs*sizeof(uint64_t));
+	for (uint64_t group=0 ; group < groups ; ++group) {
+		for (uint8_t lane=0 ; lane < lanes ; ++lane) {
+			nan |= gemm_exact_load(term, limbs, first_row + group*block_size, first_bit + lane*lane_bits, bits);
+			gemm_exact_add(sum, term, limbs);
+		}
+	}
+	if (nan) {
+		return NAN;
+	}
+	return gemm_exact_round(sum, limbs, lsb);
+}
+
 /**
   @param void *a: pointer to input matrix A(where op( A ) is m*k)
   @param void *b: pointer to input matrix B(where op( B ) is k*n)
@@ -579,7 +1064,12 @@ static int gemm_backend_test (
 		   etime_action_execution, stime_action_execution;
 
 
-    snap_action_flag_t action_irq = 0; //(SNAP_ACTION_DONE_IRQ | SNAP_ATTACH_IRQ); //no irq for now; snap_action_flag_t is an enum defined in snaplib
+    // GEMM_IRQ=1 waits for the action done interrupt of each job instead of
+    // polling; GEMM_POLL_SPIN_US, GEMM_POLL_SLEEP_MIN_US and
+    // GEMM_POLL_SLEEP_MAX_US tune the poller (see snap_action_set_poll)
+    snap_action_flag_t action_irq = 0; //snap_action_flag_t is an enum defined in snaplib
+    if (( pTmp = getenv( "GEMM_IRQ" )) != NULL && atoi(pTmp) > 0)
+        action_irq = SNAP_ACTION_DONE_IRQ;
 
 
     // Allocate Card
@@ -605,8 +1095,20 @@ static int gemm_backend_test (
         VERBOSE0(stderr, "err: failed to attach action %u: %s\n", card_no, strerror(errno));
         goto out_error1;
     }
+    if (action_irq)
+        snap_action_assign_irq(action, ACTION_IRQ_SRC_LO);
+    struct snap_poll_cfg poll_cfg;
+    snap_action_get_poll(action, &poll_cfg);
+    if (( pTmp = getenv( "GEMM_POLL_SPIN_US" )) != NULL)
+        poll_cfg.spin_us = strtoul(pTmp, NULL, 0);
+    if (( pTmp = getenv( "GEMM_POLL_SLEEP_MIN_US" )) != NULL)
+        poll_cfg.sleep_min_us = strtoul(pTmp, NULL, 0);
+    if (( pTmp = getenv( "GEMM_POLL_SLEEP_MAX_US" )) != NULL)
+        poll_cfg.sleep_max_us = strtoul(pTmp, NULL, 0);
+    if (snap_action_set_poll(action, &poll_cfg) != 0)
+        VERBOSE0(stderr, "err: GEMM_POLL_SLEEP_MIN_US above GEMM_POLL_SLEEP_MAX_US, poller left as it was\n");
     gettimeofday(&etime_attach_action, NULL);
-    VERBOSE3(stdout, "Action Attached Successfully\n");
+    VERBOSE3(stdout, "Action Attached Successfully, %s\n", action_irq? "done irq" : "polling");
 
 
     // Retrieve HW-accelerated kernel informations
@@ -618,8 +1120,11 @@ static int gemm_backend_test (
     uint8_t arithmetic_bitwidth_bits = (reg & 0x00FF0000) >> 16; // in bits
     uint8_t arithmetic_bitwidth      = arithmetic_bitwidth_bits >> 3;
     uint8_t arithmetic_type          = (reg & 0x0000FF00) >> 8;  // ieee=0;tfp=1;bf16=2;posit=3
+    uint8_t engines                  = (reg & 0x000000F0) >> 4;  // 0 reads as 1
+    engines += (engines == 0)? 1 : 0;
     VERBOSE3(stdout, "Arith bitwidth in bytes is: %u\n", arithmetic_bitwidth);
     VERBOSE3(stdout, "Arith type is: %u\n", arithmetic_type);
+    VERBOSE3(stdout, "Engines: %u\n", engines);
 
     // fetch fromm HW registers the dimensions of the systolic kernel
     snap_action_read32 (card, ACTION_RELEASE_REG, &reg);
@@ -632,6 +1137,45 @@ static int gemm_backend_test (
     VERBOSE3(stdout, "SA cols: %u\n", systolic_array_columns);
     VERBOSE3(stdout, "arithmetic param1: %u\n", arithmetic_param1);
     VERBOSE3(stdout, "arithmetic param2: %u\n", arithmetic_param2);
+
+    // fetch from HW registers the accumulator window, outputs are the
+    // accumulators themselves when the array was built with arithmetic_out=exact
+    snap_action_read32 (card, ACTION_ACCUM_REG, &reg);
+    VERBOSE3(stdout, "test ACCUM SA from register polling %u\n", reg);
+    bool exact_output = (reg & GEMM_ACCUM_EXACT) != 0;
+    int accum_ovf     = (reg & 0x7F000000) >> 24;
+    int accum_msb     = ((int32_t)(reg << 8)) >> 20;
+    int accum_lsb     = ((int32_t)(reg << 20)) >> 20;
+    uint16_t exact_bitwidth_bits = accum_msb - accum_lsb + accum_ovf + 2;  // and the NaN flag
+    VERBOSE3(stdout, "exact output: %d, msb %d lsb %d ovf %d\n", exact_output, accum_msb, accum_lsb, accum_ovf);
+
+    // fetch from HW registers the topology, weight stationary arrays keep a
+    // column band of B for b_depth steps of k and take A only
+    snap_action_read32 (card, ACTION_TOPOLOGY_REG, &reg);
+    VERBOSE3(stdout, "test TOPOLOGY SA from register polling %u\n", reg);
+    bool stationary   = (reg & GEMM_TOPOLOGY_WS) != 0;
+    uint64_t b_depth  = reg & 0x00FFFFFF;
+    VERBOSE3(stdout, "weight stationary: %d, b_depth %llu\n", stationary, (unsigned long long)b_depth);
+
+    // the input format of this GEMM: GEMM_FORMAT=f packs A and B in the
+    // alternate format f of the arrays, in the low bytes of the element slots,
+    // outputs stay in the ACTION_TYPE_REG format
+    uint32_t arith_format = 0;
+    uint8_t in_type = arithmetic_type, in_bitwidth = arithmetic_bitwidth;
+    uint8_t in_param1 = arithmetic_param1, in_param2 = arithmetic_param2;
+    if (( pTmp = getenv( "GEMM_FORMAT" )) != NULL && atoi(pTmp) > 0) {
+        arith_format = atoi(pTmp);
+        reg = 0;
+        if (arith_format <= GEMM_ALT_FORMATS)
+            snap_action_read32 (card, ACTION_ALT_FORMAT_REG + 4*(arith_format-1), &reg);
+        VERBOSE3(stdout, "test FORMAT %u SA from register polling %u\n", arith_format, reg);
+        if (!gemm_alt_format(reg, arithmetic_bitwidth, &in_type, &in_bitwidth, &in_param1, &in_param2)) {
+            VERBOSE0(stderr, "err: the arrays have no input format %u\n", arith_format);
+            rc = 0x86;
+            goto out_error2;
+        }
+    }
+    VERBOSE3(stdout, "input format %u: type %u, %u bytes\n", arith_format, in_type, in_bitwidth);
     if (systolic_array_rows == 0) {
 	    rc = 0x86;
 	    goto out_error2;  // certainly a bad bistream
@@ -661,15 +1205,113 @@ static int gemm_backend_test (
     VERBOSE3(stdout, "case vertical padding: %d\n", vertical_padding_case);
     VERBOSE3(stdout, "case horizontal padding: %d\n", horizontal_padding_case);
 
-    size_t aggregate_dma_memory_size = (fpga_bus_size*k*entire_horizontal_bands_matrix_op_A*entire_vertical_bands_matrix_op_B);
-    size_t mem_out_size = systolic_array_rows*fpga_bus_size*entire_horizontal_bands_matrix_op_A*entire_vertical_bands_matrix_op_B;
-    VERBOSE3(stdout,"size in: %zu\n", aggregate_dma_memory_size);
+    // Exact outputs are added up here, so k can be cut into segments, one per
+    // engine lane, each short enough (2^(ovf-1) products) that the carry bits
+    // of the array never wrap, but not shorter than the array is high.
+    uint64_t k_segment = k;
+    uint64_t k_groups = 1;
+    uint8_t k_lanes = 1;
+    uint64_t waves = 1;
+    bool tiled = false;
+    bool chained = false;
+    if (stationary) {
+        // the engines take row bands sharing B, k is cut where the B buffer
+        // ends, exact outputs of a segment are summed here as above
+        uint64_t max_segment = b_depth;
+        if (exact_output && accum_ovf <= 40)
+            max_segment = (accum_ovf <= 0)? 1 : (max_segment < (1ULL << (accum_ovf-1)))? max_segment : (1ULL << (accum_ovf-1));
+        k_groups = (k + max_segment - 1) / max_segment;
+        k_segment = (k + k_groups - 1) / k_groups;
+        k_lanes = engines;
+        waves = (entire_horizontal_bands_matrix_op_A + engines - 1) / engines;
+        chained = !exact_output && k_groups > 1;
+        if (exact_output && k_segment < systolic_array_rows) {
+            rc = 0x86;
+            goto out_error2;  // blocks shorter than the array drains
+        }
+        VERBOSE3(stdout, "k cut in %llu segments of %llu, %llu waves of row bands\n", (unsigned long long)k_groups, (unsigned long long)k_segment, (unsigned long long)waves);
+    } else if (exact_output) {
+        uint64_t max_segment = (accum_ovf > 40)? (1ULL << 39) : (accum_ovf > 0)? (1ULL << (accum_ovf-1)) : 1;
+        uint64_t segments = (k + max_segment - 1) / max_segment;
+        if (segments < engines)
+            segments = engines;
+        if (segments > k / systolic_array_rows)
+            segments = k / systolic_array_rows;
+        k_segment = (k + segments - 1) / segments;
+        segments = (k + k_segment - 1) / k_segment;
+        k_lanes = (segments < engines)? segments : engines;
+        k_groups = (segments + k_lanes - 1) / k_lanes;
+        VERBOSE3(stdout, "k cut in %llu segments of %llu over %u lanes\n", (unsigned long long)segments, (unsigned long long)k_segment, k_lanes);
+    } else {
+        // rounded outputs: k stays whole and the engines take pairs of bands
+        // side by side, each block runs engines tiles of C
+        uint64_t pairs = entire_horizontal_bands_matrix_op_A*entire_vertical_bands_matrix_op_B;
+        k_lanes = (pairs < engines)? pairs : engines;
+        tiled = true;
+        VERBOSE3(stdout, "%llu tiles over %u lanes\n", (unsigned long long)pairs, k_lanes);
+    }
+    uint64_t blocks = k_groups*entire_horizontal_bands_matrix_op_A*entire_vertical_bands_matrix_op_B;
+    if (stationary)
+        blocks = (chained? 1 : k_groups)*waves*entire_vertical_bands_matrix_op_B;
+    if (tiled)
+        blocks = (blocks + k_lanes - 1) / k_lanes;
+
+    // The stream is cut into jobs of chunk_words bus words wherever they fall:
+    // the array only clears its exact accumulators on SOB and only drains them
+    // on EOB, so a block split across jobs is still rounded once, and staging
+    // stays bounded whatever k is. Each job writes the blocks it ends.
+    uint64_t total_words = k_segment*blocks;
+    if (stationary)  // B loads, then A for every wave
+        total_words = entire_vertical_bands_matrix_op_B*k_groups*k_segment*(chained? 2*waves : 1+waves);
+
+    gemm_stream_t stream = {
+        .A = A, .B = B,
+        .m = m, .n = n, .k = k,
+        .lda = lda, .ldb = ldb,
+        .transA = transA, .transB = transB,
+        .rows = systolic_array_rows, .columns = systolic_array_columns,
+        .vertical_bands = entire_vertical_bands_matrix_op_B,
+        .k_segment = k_segment, .groups = k_groups,
+        .lanes = k_lanes,
+        .tiled = tiled, .stationary = stationary, .chained = chained,
+        .blocks = blocks,
+        .segments = k_groups, .waves = waves,
+        .bus_size = fpga_bus_size,
+        .arithmetic_slot = arithmetic_bitwidth,
+        .arithmetic_type = in_type,
+        .arithmetic_bitwidth = in_bitwidth,
+        .arithmetic_param1 = in_param1,
+        .arithmetic_param2 = in_param2
+    };
+
+    // Sparse operands: the steps that only multiply zeros are left out of
+    // orthogonal streams, unless that saves less than GEMM_SPARSE_SKIP of the
+    // words, SOB and EOB move to the first and last step a block keeps
+    double sparse_skip = GEMM_SPARSE_SKIP;
+    if (( pTmp = getenv( "GEMM_SPARSE_SKIP" )) != NULL)
+        sparse_skip = strtod(pTmp, NULL);
+    if (!stationary)
+        total_words = gemm_stream_sparsify(&stream, sparse_skip);
+    VERBOSE3(stdout, "%s stream of %llu words\n", stream.steps? "sparse" : "dense", (unsigned long long)total_words);
+    uint64_t chunk_words = GEMM_CHUNK_WORDS;
+    if (( pTmp = getenv( "GEMM_CHUNK_WORDS" )) != NULL && strtoull(pTmp, NULL, 0) > 0)
+        chunk_words = strtoull(pTmp, NULL, 0);
+    if (chunk_words > total_words)
+        chunk_words = total_words;
+    uint64_t chunks = (total_words + chunk_words - 1) / chunk_words;
+    size_t chunk_memory_size = fpga_bus_size*chunk_words;
+    size_t block_out_size = systolic_array_rows*fpga_bus_size;
+    size_t mem_out_size = block_out_size*blocks;
+    VERBOSE3(stdout,"size in: %zu in %llu chunks of %zu\n", (size_t)(fpga_bus_size*total_words), (unsigned long long)chunks, chunk_memory_size);
     VERBOSE3(stdout,"size out: %zu\n", mem_out_size);
 
 
     gettimeofday(&stime_memory_allocation, NULL);
     // we perform 8192 bytes alignment to match arsize / arlen of fpga logic. bursts of 64 transfers of 128B
-    char *aggregate_dma_memory = (char *)(alloc_mem(8192, sizeof(char)*aggregate_dma_memory_size));
+    // two chunks: the next one is packed while the card streams the current one
+    char *chunk_memory[2];
+    chunk_memory[0] = (char *)(alloc_mem(8192, sizeof(char)*chunk_memory_size));
+    chunk_memory[1] = (char *)(alloc_mem(8192, sizeof(char)*chunk_memory_size));
     char *mem_out = (char*)(alloc_mem(8192, sizeof(char)*mem_out_size));
     gettimeofday(&etime_memory_allocation, NULL);
 
@@ -683,80 +1325,10 @@ static int gemm_backend_test (
     char* arithmetic_bytes_scratchpad = (char*)malloc(arithmetic_bitwidth*sizeof(char));
 
 
-    // take, cast and place elements of A
+    // take, cast and place elements of A and B for the first chunk
     gettimeofday(&stime_memory_prepare, NULL);
-    for (uint64_t row_band_i=0 ; row_band_i < entire_horizontal_bands_matrix_op_A ; ++row_band_i) {
-        for (uint64_t row_i=0 ; row_i < systolic_array_rows ; ++row_i) {
-            for (uint64_t col_j=0 ; col_j < k ; ++col_j) {
-                if (horizontal_padding_case && row_band_i==(entire_horizontal_bands_matrix_op_A-1) && (row_i>=rows_last_partial_band_matrix_op_A)) {
-                    arith_scratchpad = 0.0f;
-                } else {
-                    if (transA==0) {
-                                arith_scratchpad = A[(row_band_i*systolic_array_rows) + (col_j*lda) + (row_i)];
-                    } else {
-                                arith_scratchpad = A[(row_band_i*lda*systolic_array_rows) + (lda*row_i) + (col_j)];
-                    }
-                }
-                from_IFLOAT_to_bytes(&arith_scratchpad, arithmetic_type, arithmetic_bitwidth, arithmetic_param1, arithmetic_param2, arithmetic_bytes_scratchpad);
-                for (uint64_t rewrite_i=0 ; rewrite_i < entire_vertical_bands_matrix_op_B ; ++rewrite_i) {
-                    memcpy( aggregate_dma_memory +
-                        (row_band_i*entire_vertical_bands_matrix_op_B*fpga_bus_size*k) +
-                        (rewrite_i*k*fpga_bus_size) +
-                        (fpga_bus_size*col_j) +
-                        (row_i*arithmetic_bitwidth), // end address calculation
-                        arithmetic_bytes_scratchpad,
-                        arithmetic_bitwidth);
-                }
-            }
-        }
-    }
-    // take, cast and place elements of B
-    for (uint64_t col_band_i=0 ; col_band_i < entire_vertical_bands_matrix_op_B ; ++col_band_i) {
-        for (uint64_t col_i=0 ; col_i < systolic_array_columns ; ++col_i) {
-            for (uint64_t row_j=0 ; row_j < k ; ++row_j) {
-                if (vertical_padding_case && col_band_i==(entire_vertical_bands_matrix_op_B-1) && (col_i>=cols_last_partial_band_matrix_op_B)) {
-                    arith_scratchpad = 0.0f;
-                } else {
-                    if(transB==0) {
-                        arith_scratchpad = B[(col_band_i*ldb*systolic_array_columns) + (ldb*col_i) + (row_j)];
-                    } else {
-                        arith_scratchpad = B[(col_band_i*systolic_array_columns) + (ldb*row_j) + (col_i)];
-                    }
-                }
-                from_IFLOAT_to_bytes(&arith_scratchpad, arithmetic_type, arithmetic_bitwidth, arithmetic_param1, arithmetic_param2, arithmetic_bytes_scratchpad);
-                for (uint64_t rewrite_i=0 ; rewrite_i < entire_horizontal_bands_matrix_op_A ; ++rewrite_i) {
-                    memcpy( aggregate_dma_memory +
-                        (col_band_i*fpga_bus_size*k) +
-                        (rewrite_i*entire_vertical_bands_matrix_op_B*k*fpga_bus_size) +
-                        (fpga_bus_size*row_j) +
-                        (systolic_array_rows*arithmetic_bitwidth) + // offset
-                        //(fpga_bus_size >> 1) + // offset
-                        (col_i*arithmetic_bitwidth), // end address calculation
-                        arithmetic_bytes_scratchpad,
-                        arithmetic_bitwidth);
-                }
-            }
-        }
-    }
-
-    // place Start Of Block (SOB) and End Of Block (EOB) bits
-    for (uint64_t i=0 ; i < aggregate_dma_memory_size ; ++i) {
-	uint64_t bus_index = i % fpga_bus_size;
-	uint64_t col_index = (i/fpga_bus_size) % k;
-	if (bus_index == 127) {
-	    if (col_index == 0) {
-                aggregate_dma_memory[i] = 0x40;  // SOB
-	    } else if (col_index==k-1) {
-                aggregate_dma_memory[i] = 0x80;  // EOB
-	    } else {
-                aggregate_dma_memory[i] = 0x00;
-	    }
-	}
-    }
+    gemm_stream_pack(&stream, 0, chunk_words, chunk_memory[0], arithmetic_bytes_scratchpad);
     gettimeofday(&etime_memory_prepare, NULL);
-    if (verbose_level > 3 ) {
-        __hexdump(stdout, aggregate_dma_memory, aggregate_dma_memory_size);
-    }
 
 
     // Prepare action for DMA
@@ -765,45 +1337,67 @@ static int gemm_backend_test (
     uint32_t read_burst_num  = 64; // fpga has logic only for 7 arlen
     uint32_t write_burst_num = 64; // fpga has logic only for 7 awlen
     uint32_t transfer_type = 4; // host to host
-    gettimeofday(&stime_action_prepare, NULL);
-    uint64_t addr_in = 0x0ull;
-    uint64_t addr_out = 0x0ull;
-    addr_in  = (unsigned long)aggregate_dma_memory;
-    addr_out = (unsigned long)mem_out;
-    snap_prepare_action(&cjob,
-                        &mjob,
-                        (void *)addr_in,
-                        aggregate_dma_memory_size,
-                        type_in,
-                        (void *)addr_out,
-                        mem_out_size,
-                        type_out,
-                        read_burst_num,
-                        write_burst_num,
-                        transfer_type
-    );
-    gettimeofday(&etime_action_prepare, NULL);
-
-
-    // Execute Action
-    if (verbose_level > 3 ) {
-        __hexdump(stdout, aggregate_dma_memory, aggregate_dma_memory_size);
-    }
+    uint64_t blocks_written = 0;
+    uint64_t time_prepare_action = 0;
+
+
+    // Execute Action, one job per chunk
     gettimeofday(&stime_action_execution, NULL);
-    rc = snap_action_sync_execute_job(action, &cjob, timeout);
-    gettimeofday(&etime_action_execution, NULL);
-    if (rc != 0) {
-        VERBOSE0(stdout, "err: job execution %d: %s!\n", rc, strerror(errno));
-        goto out_error3;
-    }
-    if (cjob.retc == SNAP_RETC_SUCCESS) {
-        VERBOSE3(stdout, "SUCCESS\n");
-    }
-    else {
-        VERBOSE0(stdout, "FAILED\n");
-        VERBOSE0(stdout, "err: Unexpected RETC=%x!\n", cjob.retc);
-        goto out_error3;
+    for (uint64_t chunk=0 ; chunk < chunks ; ++chunk) {
+        uint64_t first_word = chunk*chunk_words;
+        uint64_t words = (total_words-first_word < chunk_words) ? total_words-first_word : chunk_words;
+        uint64_t blocks_ended = gemm_stream_blocks(&stream, first_word+words);
+        char *chunk_in = chunk_memory[chunk & 1];
+
+        if (verbose_level > 3 ) {
+            __hexdump(stdout, chunk_in, fpga_bus_size*words);
+        }
+        gettimeofday(&stime_action_prepare, NULL);
+        snap_prepare_action(&cjob,
+                            &mjob,
+                            (void *)chunk_in,
+                            fpga_bus_size*words,
+                            type_in,
+                            (void *)(mem_out + blocks_written*block_out_size),
+                            (blocks_ended-blocks_written)*block_out_size,
+                            type_out,
+                            read_burst_num,
+                            write_burst_num,
+                            transfer_type,
+                            arith_format
+        );
+        rc = snap_action_sync_execute_job_set_regs(action, &cjob);
+        gettimeofday(&etime_action_prepare, NULL);
+        time_prepare_action += timediff_usec(&etime_action_prepare, &stime_action_prepare);
+        if (rc != 0) {
+            VERBOSE0(stdout, "err: job registers %d: %s!\n", rc, strerror(errno));
+            goto out_error3;
+        }
+        snap_action_start(action);
+
+        if (chunk+1 < chunks) {
+            uint64_t next_first_word = first_word + chunk_words;
+            uint64_t next_words = (total_words-next_first_word < chunk_words) ? total_words-next_first_word : chunk_words;
+            gemm_stream_pack(&stream, next_first_word, next_words, chunk_memory[(chunk+1) & 1], arithmetic_bytes_scratchpad);
+        }
+
+        rc = snap_action_sync_execute_job_check_completion(action, &cjob, timeout);
+        if (rc != 0) {
+            VERBOSE0(stdout, "err: job execution %d: %s!\n", rc, strerror(errno));
+            goto out_error3;
+        }
+        if (cjob.retc == SNAP_RETC_SUCCESS) {
+            VERBOSE3(stdout, "SUCCESS chunk %llu\n", (unsigned long long)chunk);
+        }
+        else {
+            VERBOSE0(stdout, "FAILED\n");
+            VERBOSE0(stdout, "err: Unexpected RETC=%x!\n", cjob.retc);
+            rc = -1;
+            goto out_error3;
+        }
+        blocks_written = blocks_ended;
     }
+    gettimeofday(&etime_action_execution, NULL);
 
 
     // Printing Results if enough verbosity
@@ -838,16 +1432,54 @@ static int gemm_backend_test (
     }
 
 
-    // Write Matrix C to out
-    for (uint32_t vertical_band_j=0 ; vertical_band_j < entire_horizontal_bands_matrix_op_A ; ++vertical_band_j) {
+    // exact outputs of the segments of an element are summed over these limbs
+    size_t exact_limbs = (exact_bitwidth_bits + 63) / 64 + 1;
+    uint64_t *exact_sum  = (uint64_t*)malloc(exact_limbs*sizeof(uint64_t));
+    uint64_t *exact_term = (uint64_t*)malloc(exact_limbs*sizeof(uint64_t));
+
+    // Write Matrix C to out, weight stationary: lane e of the blocks of a
+    // wave holds row band wave*engines+e, segments are waves blocks apart
+    for (uint64_t band=0 ; stationary && band < entire_vertical_bands_matrix_op_B ; ++band) {
+        for (uint64_t wave=0 ; wave < waves ; ++wave) {
+            uint64_t first_block = (chained? band : band*k_groups)*waves + wave;
+            for (uint8_t lane=0 ; lane < k_lanes ; ++lane) {
+                uint64_t row0 = (wave*k_lanes + lane)*systolic_array_rows;
+                for (uint32_t row_i=0 ; row_i < systolic_array_rows ; ++row_i) {  // row_i is reversed as the array exits from the bottom
+                    uint64_t row = row0 + systolic_array_rows-1-row_i;
+                    char * row_tmp = mem_out + first_block*block_out_size + fpga_bus_size*row_i;
+                    for (uint32_t col_j=0 ; col_j < systolic_array_columns ; ++col_j) {
+                        uint64_t col = band*systolic_array_columns + col_j;
+                        if (row >= m || col >= n)
+                            continue;
+                        if (exact_output) {
+                            arith_scratchpad = gemm_exact_reduce(row_tmp, waves*block_out_size, k_groups, 1,
+                                                                 (lane*systolic_array_columns + col_j)*exact_bitwidth_bits, 0,
+                                                                 exact_bitwidth_bits, accum_lsb, exact_sum, exact_term, exact_limbs);
+                        } else {
+                            arith_scratchpad = from_bytes_to_IFLOAT(row_tmp + arithmetic_bitwidth*(lane*systolic_array_columns + col_j), arithmetic_type, arithmetic_bitwidth, arithmetic_param1, arithmetic_param2);
+                        }
+                        if (*BETA == 0.0f) {  // we consider beta is 0 or 1 to avoid a multiplication
+                            C[row + col*ldc] = arith_scratchpad;
+                        } else if (*BETA == 1.0f) {
+                            C[row + col*ldc] += arith_scratchpad;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    // orthogonal: tiled blocks hold pair p of bands in lane p%engines of
+    // block p/engines, exact ones the k_groups segments of pair p from block
+    // p*k_groups on
+    for (uint32_t vertical_band_j=0 ; !stationary && vertical_band_j < entire_horizontal_bands_matrix_op_A ; ++vertical_band_j) {
         for (uint32_t horizontal_block_i=0 ; horizontal_block_i < entire_vertical_bands_matrix_op_B ; ++horizontal_block_i) {
+            uint64_t pair = vertical_band_j * entire_vertical_bands_matrix_op_B + horizontal_block_i;
+            uint8_t tile_lane = tiled? pair % k_lanes : 0;
             for (uint32_t row_i=0 ; row_i < systolic_array_rows ; ++row_i) {  // row_i is reversed as the array exits from the bottom
                 for (uint32_t col_j=0 ; col_j < systolic_array_columns ; ++col_j) {
-    		    char * c_tmp = mem_out +
-                                (vertical_band_j * entire_vertical_bands_matrix_op_B * fpga_bus_size * systolic_array_rows) +
-                                (horizontal_block_i * fpga_bus_size * systolic_array_rows) +
-                                (fpga_bus_size * row_i) +
-                                (arithmetic_bitwidth*col_j);
+    		    char * row_tmp = mem_out +
+                                (tiled? pair / k_lanes : pair * k_groups) * block_out_size +
+                                (fpga_bus_size * row_i);
     		    if ( !(horizontal_padding_case &&
     		           vertical_band_j==entire_horizontal_bands_matrix_op_A-1 &&
     		           row_i <= systolic_array_rows-1-rows_last_partial_band_matrix_op_A) &&
@@ -855,7 +1487,13 @@ static int gemm_backend_test (
     		           horizontal_block_i==entire_vertical_bands_matrix_op_B-1 &&
     		           col_j >= cols_last_partial_band_matrix_op_B)
     		       ) {
-    		            arith_scratchpad = from_bytes_to_IFLOAT(c_tmp, arithmetic_type, arithmetic_bitwidth, arithmetic_param1, arithmetic_param2);
+    		            if (exact_output) {
+    		                arith_scratchpad = gemm_exact_reduce(row_tmp, block_out_size, k_groups, k_lanes,
+    		                                                     col_j*exact_bitwidth_bits, systolic_array_columns*exact_bitwidth_bits,
+    		                                                     exact_bitwidth_bits, accum_lsb, exact_sum, exact_term, exact_limbs);
+    		            } else {
+    		                arith_scratchpad = from_bytes_to_IFLOAT(row_tmp + arithmetic_bitwidth*(tile_lane*systolic_array_columns + col_j), arithmetic_type, arithmetic_bitwidth, arithmetic_param1, arithmetic_param2);
+    		            }
 		            if (*BETA == 0.0f) {  // we consider beta is 0 or 1 to avoid a multiplication
     		            	C[(horizontal_block_i*ldc*systolic_array_columns)+
     		            	  (vertical_band_j*systolic_array_rows)+
@@ -884,7 +1522,6 @@ static int gemm_backend_test (
         uint64_t time_attach_action = timediff_usec(&etime_attach_action,  &stime_attach_action);
         uint64_t time_memory_allocation = timediff_usec(&etime_memory_allocation,  &stime_memory_allocation);
         uint64_t time_memory_preparation = timediff_usec(&etime_memory_prepare,  &stime_memory_prepare);
-        uint64_t time_prepare_action = timediff_usec(&etime_action_prepare,  &stime_action_prepare);
         uint64_t time_action_execute = timediff_usec(&etime_action_execution,  &stime_action_execution);
 	uint64_t time_total = time_card_allocation + time_attach_action + time_memory_allocation + time_memory_preparation + time_prepare_action + time_action_execute;
 	VERBOSE3(stdout, "time card allocation (us): %lld, %lld\%\n",time_card_allocation, (100*time_card_allocation/time_total));
@@ -894,6 +1531,16 @@ static int gemm_backend_test (
 	VERBOSE3(stdout, "time action prepare(us): %lld, %lld\%\n",time_prepare_action, (100*time_prepare_action/time_total));
 	VERBOSE3(stdout, "time action execute(us): %lld, %lld\%\n",time_action_execute, (100*time_action_execute/time_total));
 
+        // completion latency of the jobs, to compare polling and IRQ
+        uint64_t lat_hist[SNAP_LAT_BUCKETS];
+        snap_wait_mode_t wait_mode = action_irq? SNAP_WAIT_IRQ : SNAP_WAIT_POLL;
+        if (snap_action_get_latency(action, wait_mode, lat_hist)) {
+            for (int b = 0; b < SNAP_LAT_BUCKETS; b++) {
+                if (lat_hist[b])
+                    VERBOSE3(stdout, "%llu %s completions in %llu..%llu usec\n", (unsigned long long)lat_hist[b],
+                             action_irq? "irq" : "poll", b? 1ull << b : 0ull, (1ull << (b + 1)) - 1);
+            }
+        }
     }
 
 
@@ -913,14 +1560,22 @@ static int gemm_backend_test (
     //    free(A);
     //}
     free(arithmetic_bytes_scratchpad);
+    free(stream.block_words);
+    free(stream.steps);
+    free(exact_sum);
+    free(exact_term);
     free(mem_out);
-    free(aggregate_dma_memory);
+    free(chunk_memory[0]);
+    free(chunk_memory[1]);
     //exit(EXIT_SUCCESS);
     return 0;
 
     out_error3:
     	free(arithmetic_bytes_scratchpad);
-	free(aggregate_dma_memory);
+	free(stream.block_words);
+	free(stream.steps);
+	free(chunk_memory[0]);
+	free(chunk_memory[1]);
         free(mem_out);
     out_error2:
         snap_detach_action(action);
@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../sw/gemm_backend.h"
+
+// Host side of the backend, no card needed: the rounding of exact outputs
+// from known accumulator bit patterns, the weight stationary stream run
+// through a model of the array, and the decoding of alternate input formats.
+//
+// usage: gemm_host
+
+static int errors = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+      printf("%s:%d: ", __FILE__, __LINE__); \
+      printf(__VA_ARGS__); \
+      printf("\n"); \
+      errors++; \
+    } \
+  } while (0)
+
+#define LIMBS 3
+
+// v = sign * 2^e over LIMBS limbs, two's complement
+static void power(uint64_t *v, int sign, int e) {
+  uint64_t carry = 1;
+  memset(v, 0, LIMBS*sizeof(uint64_t));
+  v[e >> 6] = 1ULL << (e & 63);
+  if (sign < 0) {
+    for (int i = 0; i < LIMBS; i++) {
+      v[i] = ~v[i] + carry;
+      carry = carry && v[i] == 0;
+    }
+  }
+}
+
+// v += sign * 2^e
+static void add_power(uint64_t *v, int sign, int e) {
+  uint64_t w[LIMBS], carry = 0;
+  power(w, sign, e);
+  for (int i = 0; i < LIMBS; i++) {
+    uint64_t s = v[i] + carry;
+    carry = s < carry;
+    v[i] = s + w[i];
+    carry |= v[i] < s;
+  }
+}
+
+// writes the low bits-1 bits of v and the NaN flag above them at bit pos
+static void put_exact(char *dst, uint64_t pos, int bits, const uint64_t *v, int nan) {
+  for (int i = 0; i < bits; i++) {
+    int bit = (i == bits-1) ? nan : (v[i >> 6] >> (i & 63)) & 1;
+    uint8_t *p = (uint8_t *)dst + ((pos+i) >> 3);
+    if (bit)
+      *p |= 1 << ((pos+i) & 7);
+    else
+      *p &= ~(1 << ((pos+i) & 7));
+  }
+}
+
+// the sum of the accumulators of lanes lanes in groups blocks, as the
+// unpacker reduces one element of C
+static float reduce(const uint64_t (*v)[LIMBS], const int *nan, uint64_t groups, uint8_t lanes, int bits, int lsb) {
+  char rows[2][64];
+  uint64_t sum[LIMBS], term[LIMBS];
+  uint64_t first_bit = 3, lane_bits = bits + 5;  // off the byte boundaries
+  memset(rows, 0, sizeof(rows));
+  for (uint64_t g = 0; g < groups; g++)
+    for (uint8_t l = 0; l < lanes; l++)
+      put_exact(rows[g], first_bit + l*lane_bits, bits, v[g*lanes + l], nan[g*lanes + l]);
+  return gemm_exact_reduce(rows[0], sizeof(rows[0]), groups, lanes, first_bit, lane_bits, bits, lsb, sum, term, LIMBS);
+}
+
+static float round_one(const uint64_t *v, int bits, int lsb) {
+  int nan = 0;
+  return reduce((const uint64_t (*)[LIMBS])v, &nan, 1, 1, bits, lsb);
+}
+
+static void test_exact(void) {
+  uint64_t v[4][LIMBS];
+  int nan[4] = {0, 0, 0, 0};
+  float r;
+
+  // -2^64 + 2^40 in group 0, 2^41 - 2^41 in group 1: borrows across the limbs
+  power(v[0], -1, 64);
+  power(v[1], 1, 40);
+  power(v[2], 1, 41);
+  power(v[3], -1, 41);
+  r = reduce((const uint64_t (*)[LIMBS])v, nan, 2, 2, 100, -40);
+  CHECK(r == -16777215.0f, "negative carry: %.9g", r);
+
+  // a sign extended 99 bit accumulator of -1 next to +1
+  power(v[0], -1, 0);
+  power(v[1], 1, 0);
+  r = reduce((const uint64_t (*)[LIMBS])v, nan, 1, 2, 100, 0);
+  CHECK(r == 0.0f, "-1 + 1: %.9g", r);
+
+  // ties to even, either way, and a remainder past the tie
+  power(v[0], 1, 24);
+  add_power(v[0], 1, 0);
+  r = round_one(v[0], 40, 0);
+  CHECK(r == 16777216.0f, "2^24+1: %.9g", r);
+  add_power(v[0], 1, 1);
+  r = round_one(v[0], 40, 0);
+  CHECK(r == 16777220.0f, "2^24+3: %.9g", r);
+  power(v[0], -1, 24);
+  add_power(v[0], -1, 0);
+  r = round_one(v[0], 40, 0);
+  CHECK(r == -16777216.0f, "-(2^24+1): %.9g", r);
+  power(v[0], 1, 26);
+  add_power(v[0], 1, 2);
+  add_power(v[0], 1, 0);
+  r = round_one(v[0], 40, 0);
+  CHECK(r == 67108872.0f, "2^26+5: %.9g", r);
+
+  // subnormal outputs, counted in ulps of 2^-149 with lsb -150
+  power(v[0], 1, 0);
+  add_power(v[0], 1, 1);
+  r = round_one(v[0], 40, -150);
+  CHECK(r == ldexpf(2.0f, -149), "1.5 ulp: %.9g", r);
+  power(v[0], 1, 2);
+  add_power(v[0], 1, 0);
+  r = round_one(v[0], 40, -150);
+  CHECK(r == ldexpf(2.0f, -149), "2.5 ulp: %.9g", r);
+  power(v[0], 1, 0);
+  r = round_one(v[0], 40, -150);
+  CHECK(r == 0.0f && !signbit(r), "0.5 ulp: %.9g", r);
+  // 2.5 ulp and 2^-31 ulp: rounded once, not to 24 bits then to the ulp
+  power(v[0], 1, 32);
+  add_power(v[0], 1, 30);
+  add_power(v[0], 1, 0);
+  r = round_one(v[0], 40, -180);
+  CHECK(r == ldexpf(3.0f, -149), "2.5+2^-31 ulp: %.9g", r);
+  power(v[0], 1, 24);
+  add_power(v[0], -1, 0);
+  r = round_one(v[0], 40, -150);
+  CHECK(r == FLT_MIN, "2^23-0.5 ulp: %.9g", r);
+
+  // overflow to Inf, also when rounding carries into 2^128
+  power(v[0], 1, 130);
+  r = round_one(v[0], 140, 0);
+  CHECK(isinf(r) && r > 0, "2^130: %.9g", r);
+  power(v[0], -1, 128);
+  add_power(v[0], 1, 103);
+  r = round_one(v[0], 140, 0);
+  CHECK(isinf(r) && r < 0, "-(2^128-2^103): %.9g", r);
+  power(v[0], 1, 128);
+  add_power(v[0], -1, 103);
+  add_power(v[0], -1, 0);
+  r = round_one(v[0], 140, 0);
+  CHECK(r == FLT_MAX, "2^128-2^103-1: %.9g", r);
+
+  // the NaN flag of any lane of any block makes the element NaN
+  power(v[0], 1, 0);
+  power(v[1], 1, 0);
+  power(v[2], 1, 0);
+  power(v[3], 1, 0);
+  nan[3] = 1;
+  r = reduce((const uint64_t (*)[LIMBS])v, nan, 2, 2, 100, 0);
+  CHECK(isnan(r), "NaN flag: %.9g", r);
+}
+
+// A is m x k and B k x n, both column major, with small integers the array
+// and the host add up exactly
+static float element(int i, int j, int seed) {
+  return (float)((i*7 + j*3 + seed) % 9 - 4);
+}
+
+// Runs a weight stationary stream through a model of the arrays: LDB words
+// write the B buffer, SOB rewinds it and clears the accumulators on A words,
+// each A word reads the next step of B and EOB drains the accumulators to the
+// tile gemm_stream_locate() gives, where the blocks of the k segments add up.
+static void test_stationary(int chained, int transA, int transB, uint32_t format_reg) {
+  const uint8_t rows = 2, columns = 2, lanes = 2;
+  const uint64_t m = 7, n = 5, k = 7, b_depth = 3;
+  const uint16_t bus_size = 128;
+  uint8_t slot = 4, type = 0, bitwidth = 4, param1 = 0, param2 = 0;
+  if (format_reg)
+    CHECK(gemm_alt_format(format_reg, slot, &type, &bitwidth, &param1, &param2), "format %08x", format_reg);
+
+  uint64_t segments = (k + b_depth - 1) / b_depth;
+  uint64_t k_segment = (k + segments - 1) / segments;
+  uint64_t bands = (m + rows - 1) / rows, vertical_bands = (n + columns - 1) / columns;
+  uint64_t waves = (bands + lanes - 1) / lanes;
+  uint64_t words = vertical_bands*segments*k_segment*(chained ? 2*waves : 1+waves);
+  uint64_t lda = transA ? k : m, ldb = transB ? n : k;
+
+  float *A = malloc(m*k*sizeof(float)), *B = malloc(k*n*sizeof(float));
+  double *C = calloc(m*n, sizeof(double));
+  for (uint64_t i = 0; i < m; i++)
+    for (uint64_t l = 0; l < k; l++)
+      A[transA ? i*lda + l : i + l*lda] = element(i, l, 1);
+  for (uint64_t l = 0; l < k; l++)
+    for (uint64_t j = 0; j < n; j++)
+      B[transB ? l*ldb + j : j*ldb + l] = element(l, j, 5);
+
+  gemm_stream_t s = {
+    .A = A, .B = B,
+    .m = m, .n = n, .k = k,
+    .lda = lda, .ldb = ldb,
+    .transA = transA, .transB = transB,
+    .rows = rows, .columns = columns,
+    .vertical_bands = vertical_bands,
+    .k_segment = k_segment, .groups = segments,
+    .lanes = lanes,
+    .stationary = 1, .chained = chained,
+    .blocks = (chained ? 1 : segments)*waves*vertical_bands,
+    .segments = segments, .waves = waves,
+    .bus_size = bus_size,
+    .arithmetic_slot = slot,
+    .arithmetic_type = type, .arithmetic_bitwidth = bitwidth,
+    .arithmetic_param1 = param1, .arithmetic_param2 = param2
+  };
+
+  // any range of words packs on its own
+  char *stream = malloc(words*bus_size), *chunk = malloc(5*bus_size), bytes[8];
+  gemm_stream_pack(&s, 0, words, stream, bytes);
+  for (uint64_t w = 0; w < words; w += 5) {
+    uint64_t len = (words - w < 5) ? words - w : 5;
+    gemm_stream_pack(&s, w, len, chunk, bytes);
+    CHECK(memcmp(chunk, stream + w*bus_size, len*bus_size) == 0, "chunk at word %llu differs", (unsigned long long)w);
+  }
+
+  double buffer[8][2], acc[2][2][2];
+  uint64_t wptr = 0, rptr = 0, ends = 0;
+  for (uint64_t w = 0; w < words; w++) {
+    char *word = stream + w*bus_size;
+    uint8_t flags = word[bus_size-1];
+    CHECK(gemm_stream_blocks(&s, w) == ends, "%llu blocks end before word %llu, %llu counted",
+          (unsigned long long)ends, (unsigned long long)w, (unsigned long long)gemm_stream_blocks(&s, w));
+    for (int e = 0; e < rows*lanes; e++)
+      for (int b = bitwidth; b < slot; b++)
+        CHECK(word[e*slot + b] == 0, "word %llu: slot %d not zero past the element", (unsigned long long)w, e);
+    if (flags & GEMM_LDB) {
+      CHECK(!(flags & GEMM_EOB), "word %llu: EOB on a load", (unsigned long long)w);
+      if (flags & GEMM_SOB)
+        wptr = rptr = 0;
+      CHECK(wptr < k_segment, "word %llu: load past the buffer", (unsigned long long)w);
+      for (int c = 0; c < columns; c++)
+        buffer[wptr][c] = from_bytes_to_IFLOAT(word + c*slot, type, bitwidth, param1, param2);
+      wptr++;
+      continue;
+    }
+    if (flags & GEMM_SOB) {
+      rptr = 0;
+      memset(acc, 0, sizeof(acc));
+    }
+    CHECK(rptr < wptr, "word %llu: reads step %llu of B, %llu loaded", (unsigned long long)w,
+          (unsigned long long)rptr, (unsigned long long)wptr);
+    for (int l = 0; l < lanes; l++)
+      for (int r = 0; r < rows; r++) {
+        double a = from_bytes_to_IFLOAT(word + (l*rows + r)*slot, type, bitwidth, param1, param2);
+        for (int c = 0; c < columns; c++)
+          acc[l][r][c] += a*buffer[rptr][c];
+      }
+    rptr++;
+    if (flags & GEMM_EOB) {
+      uint64_t band, wave, segment, step;
+      bool load;
+      gemm_stream_locate(&s, w, &band, &wave, &segment, &step, &load);
+      for (int l = 0; l < lanes; l++)
+        for (int r = 0; r < rows; r++)
+          for (int c = 0; c < columns; c++) {
+            uint64_t i = (wave*lanes + l)*rows + r, j = band*columns + c;
+            if (i < m && j < n)
+              C[i + j*m] += acc[l][r][c];
+          }
+      ends++;
+    }
+  }
+  CHECK(ends == s.blocks && gemm_stream_blocks(&s, words) == ends, "%llu blocks, %llu expected",
+        (unsigned long long)ends, (unsigned long long)s.blocks);
+
+  for (uint64_t i = 0; i < m; i++)
+    for (uint64_t j = 0; j < n; j++) {
+      double sum = 0.0;
+      for (uint64_t l = 0; l < k; l++)
+        sum += element(i, l, 1)*element(l, j, 5);
+      CHECK(C[i + j*m] == sum, "chained %d trans %d%d format %08x: C[%llu,%llu]=%g want %g", chained, transA, transB,
+            format_reg, (unsigned long long)i, (unsigned long long)j, C[i + j*m], sum);
+    }
+
+  free(A);
+  free(B);
+  free(C);
+  free(stream);
+  free(chunk);
+}
+
+static void test_formats(void) {
+  uint8_t type = 9, bitwidth = 9, param1 = 9, param2 = 9;
+  // posit<16,1> in the 4 byte slots of a fp32 array
+  CHECK(gemm_alt_format(0x03100102, 4, &type, &bitwidth, &param1, &param2), "posit16");
+  CHECK(type == 3 && bitwidth == 2 && param1 == 1 && param2 == 2, "posit16: type %u, %u bytes, %u %u",
+        type, bitwidth, param1, param2);
+  // no format, and a format wider than the slots
+  CHECK(!gemm_alt_format(0, 4, &type, &bitwidth, &param1, &param2), "format 0 accepted");
+  CHECK(!gemm_alt_format(0x00400000, 4, &type, &bitwidth, &param1, &param2), "fp64 in 4 byte slots accepted");
+  CHECK(gemm_alt_format(0x00200000, 4, &type, &bitwidth, &param1, &param2) && bitwidth == 4, "fp32 in 4 byte slots");
+}
+
+int main(int argc, char **argv)
+{
+  test_exact();
+  for (int chained = 0; chained < 2; chained++) {
+    test_stationary(chained, 0, 0, 0);
+    test_stationary(chained, 1, 1, 0);
+    test_stationary(chained, 0, 1, 0x00100000);  // fp16 in the low bytes of the slots
+  }
+  test_formats();
+
+  printf("%d errors\n", errors);
+  return errors != 0;
+}
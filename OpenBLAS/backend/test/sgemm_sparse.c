@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "cblas.h"
+#include "f77blas.h"
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+// Random element sparsity: every element of A and B is zero with the given
+// probability on its own, as after pruning, not whole columns or rows. The
+// backend only leaves out the k steps where a whole column of an A band or
+// row of a B band is zero, run with VERBOSITY=3 to see how many words that
+// still saves. C is checked against a plain triple loop.
+//
+// Step 0 of k multiplies an Inf and step 1 a NaN of A by an all zero row of
+// B, step 2 an all zero column of A by an Inf of B: these steps are zero in
+// one operand but must not be skipped, the products are NaN.
+//
+// usage: sgemm_sparse [zero percent] [m n k]
+
+double get_time() {
+  struct timeval t;
+  struct timezone tzp;
+  gettimeofday(&t, &tzp);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+int main(int argc, char **argv)
+{
+  float *A, *B, *C;
+  int m, n, k, i, j, l, zero_percent, errors;
+  float alpha, beta;
+  double start, end;
+
+  zero_percent = 80;
+  m = 100, n = 60, k = 300;
+  if (argc > 1) zero_percent = atoi(argv[1]);
+  if (argc > 4) m = atoi(argv[2]), n = atoi(argv[3]), k = atoi(argv[4]);
+
+  alpha = 1.0f; beta = 0.0f;
+
+  printf("m, n, k: %d, %d, %d, %d%% zeros\n", m, n, k, zero_percent);
+  posix_memalign((void**) &A, 64, m*k*sizeof( float ));
+  posix_memalign((void**) &B, 64, k*n*sizeof( float ));
+  posix_memalign((void**) &C, 64, m*n*sizeof( float ));
+
+  if (A == NULL || B == NULL || C == NULL) {
+    printf( "\n ERROR: Can't allocate memory for matrices. Aborting... \n\n");
+    free(A);
+    free(B);
+    free(C);
+    return 1;
+  }
+
+  srand(1);
+  for (i = 0; i < (m*k); i++) {
+    A[i] = (rand() % 100 < zero_percent) ? 0.0f : (float)(rand() % 255 - 127) / 16.0f;
+  }
+
+  for (i = 0; i < (k*n); i++) {
+    B[i] = (rand() % 100 < zero_percent) ? 0.0f : (float)(rand() % 255 - 127) / 16.0f;
+  }
+
+  for (i = 0; i < (m*n); i++) {
+    C[i] = 0.0f;
+  }
+
+  if (k > 2) {
+    for (j = 0; j < n; j++) {
+      B[0 + j*k] = 0.0f;
+      B[1 + j*k] = 0.0f;
+    }
+    for (i = 0; i < m; i++) {
+      A[i + 2*m] = 0.0f;
+    }
+    A[0 + 0*m] = INFINITY;
+    A[(m-1) + 1*m] = NAN;
+    B[2 + (n-1)*k] = INFINITY;
+  }
+
+  start = get_time();
+  cblas_sgemm(CblasColMajor, CblasNoTrans, CblasNoTrans,
+        m, n, k, alpha, A, m, B, k, beta, C, m);
+  end = get_time();
+
+  printf("%f s\n",  (end - start));
+
+  // the array rounds like the CPU does not, allow for the accumulation order
+  errors = 0;
+  for (j = 0; j < n; j++) {
+    for (i = 0; i < m; i++) {
+      double sum = 0.0, magnitude = 0.0;
+      for (l = 0; l < k; l++) {
+        sum += (double)A[i + l*m] * (double)B[l + j*k];
+        magnitude += fabs((double)A[i + l*m] * (double)B[l + j*k]);
+      }
+      if (isfinite(sum) ? fabs(C[i + j*m] - sum) > 1e-5*magnitude
+                        : !(isnan(sum) ? isnan(C[i + j*m]) : C[i + j*m] == sum)) {
+        if (errors < 5)
+          printf("C[%d,%d]=%f want %f\n", i, j, C[i + j*m], sum);
+        errors++;
+      }
+    }
+  }
+  printf("%d errors\n", errors);
+
+  free(A);
+  free(B);
+  free(C);
+
+return errors != 0;
+}
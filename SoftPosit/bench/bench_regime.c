@@ -0,0 +1,228 @@
+
+/*============================================================================
+
+This C source file is part of the SoftPosit Posit Arithmetic Package
+by S. H. Leong (Cerlane).
+
+Copyright 2017 2018 A*STAR.  All rights reserved.
+
+This C source file was based on SoftFloat IEEE Floating-Point Arithmetic
+Package, Release 3d, by John R. Hauser.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions, and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions, and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+ 3. Neither the name of the University nor the names of its contributors may
+    be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS "AS IS", AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE, ARE
+DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+=============================================================================*/
+
+/*----------------------------------------------------------------------------
+| Microbenchmark for the count-leading-zeros regime decoder.
+|
+| For every width the decoder in internals.h is checked against the original
+| shift-loop decoder (exhaustively for posit8 and posit16, on random bit
+| patterns for posit32) and both are timed over the same inputs.  The common
+| operations are then timed so that builds of the library before and after a
+| change can be compared op by op.
+*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "platform.h"
+#include "internals.h"
+
+#define N32 (1u<<24)
+
+static uint32_t rngState = 0x2545F491;
+
+static uint32_t nextRandom( void ) {
+	rngState ^= rngState << 13;
+	rngState ^= rngState >> 17;
+	rngState ^= rngState << 5;
+	return rngState;
+}
+
+static double nowSeconds( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//Reference decoders: the shift loops the library used before.
+static int_fast8_t loopRegime8( bool regS, uint_fast8_t *tmp ) {
+	int_fast8_t k = 0;
+	if (regS){
+		while (*tmp>>7){
+			k++;
+			*tmp= (*tmp<<1) & 0xFF;
+		}
+	}
+	else{
+		k=-1;
+		while (!(*tmp>>7)){
+			k--;
+			*tmp= (*tmp<<1) & 0xFF;
+		}
+	}
+	*tmp&=0x7F;
+	return k;
+}
+
+static int_fast8_t loopRegime16( bool regS, uint_fast16_t *tmp ) {
+	int_fast8_t k = 0;
+	if (regS){
+		while (*tmp>>15){
+			k++;
+			*tmp= (*tmp<<1) & 0xFFFF;
+		}
+	}
+	else{
+		k=-1;
+		while (!(*tmp>>15)){
+			k--;
+			*tmp= (*tmp<<1) & 0xFFFF;
+		}
+	}
+	*tmp&=0x7FFF;
+	return k;
+}
+
+static int_fast8_t loopRegime32( bool regS, uint_fast32_t *tmp ) {
+	int_fast8_t k = 0;
+	if (regS){
+		while (*tmp>>31){
+			k++;
+			*tmp= (*tmp<<1) & 0xFFFFFFFF;
+		}
+	}
+	else{
+		k=-1;
+		while (!(*tmp>>31)){
+			k--;
+			*tmp= (*tmp<<1) & 0xFFFFFFFF;
+		}
+	}
+	*tmp&=0x7FFFFFFF;
+	return k;
+}
+
+static int_fast8_t clzRegime8( bool regS, uint_fast8_t *tmp ) {
+	return softposit_decodeRegimeP8UI( regS, *tmp );
+}
+
+static int_fast8_t clzRegime16( bool regS, uint_fast16_t *tmp ) {
+	return softposit_decodeRegimeP16UI( regS, *tmp );
+}
+
+static int_fast8_t clzRegime32( bool regS, uint_fast32_t *tmp ) {
+	return softposit_decodeRegimeP32UI( regS, *tmp );
+}
+
+static void report( const char *name, size_t n, double tLoop, double tClz ) {
+	printf( "%-10s %12.3f %12.3f %8.2fx\n", name,
+			tLoop * 1e9 / n, tClz * 1e9 / n, tLoop / tClz );
+}
+
+//Zero and NaR have no regime to decode and are skipped, as in the library.
+#define CHECK_AND_TIME( name, n, width, mask, uintType, nextInput, loopFn, clzFn ) {\
+	size_t i;\
+	long sumLoop = 0, sumClz = 0;\
+	double t0, tLoop, tClz;\
+	for (i=0; i<(n); i++){\
+		uint_fast32_t uiA = (nextInput) & (mask);\
+		if (uiA==0 || uiA==((uint_fast32_t)1<<((width)-1))) continue;\
+		bool regS = (uiA>>((width)-2)) & 0x1;\
+		uintType tmpLoop = (uiA<<2) & (mask);\
+		uintType tmpClz = tmpLoop;\
+		int_fast8_t kLoop = loopFn( regS, &tmpLoop );\
+		int_fast8_t kClz = clzFn( regS, &tmpClz );\
+		if (kLoop!=kClz || tmpLoop!=tmpClz){\
+			printf( "%s: mismatch for 0x%lx: k %d/%d tmp 0x%lx/0x%lx\n", name,\
+					(unsigned long) uiA, (int) kLoop, (int) kClz,\
+					(unsigned long) tmpLoop, (unsigned long) tmpClz );\
+			exit( EXIT_FAILURE );\
+		}\
+	}\
+	t0 = nowSeconds();\
+	for (i=0; i<(n); i++){\
+		uint_fast32_t uiA = ((nextInput) & (mask)) | 0x1;\
+		uintType tmp = (uiA<<2) & (mask);\
+		sumLoop += loopFn( (uiA>>((width)-2)) & 0x1, &tmp ) + tmp;\
+	}\
+	tLoop = nowSeconds() - t0;\
+	t0 = nowSeconds();\
+	for (i=0; i<(n); i++){\
+		uint_fast32_t uiA = ((nextInput) & (mask)) | 0x1;\
+		uintType tmp = (uiA<<2) & (mask);\
+		sumClz += clzFn( (uiA>>((width)-2)) & 0x1, &tmp ) + tmp;\
+	}\
+	tClz = nowSeconds() - t0;\
+	if (sumLoop!=sumClz){\
+		printf( "%s: checksum mismatch\n", name );\
+		exit( EXIT_FAILURE );\
+	}\
+	report( name, (n), tLoop, tClz );\
+}
+
+#define TIME_OP( name, n, expr ) {\
+	size_t i;\
+	uint_fast32_t sum = 0;\
+	double t0 = nowSeconds();\
+	for (i=0; i<(n); i++) sum += (expr);\
+	printf( "%-10s %12.3f   (checksum %08lx)\n", name,\
+			(nowSeconds() - t0) * 1e9 / (n), (unsigned long) (sum & 0xFFFFFFFF) );\
+}
+
+int main( void ) {
+	uint32_t *rnd = malloc( N32 * sizeof(uint32_t) );
+	size_t i;
+
+	if (!rnd) return EXIT_FAILURE;
+	for (i=0; i<N32; i++) rnd[i] = nextRandom();
+
+	printf( "%-10s %12s %12s %9s\n", "decode", "loop ns", "clz ns", "speedup" );
+	//Every pattern is visited 256 (posit8) and 16 (posit16) times for timing.
+	CHECK_AND_TIME( "posit8", 1u<<16, 8, 0xFF, uint_fast8_t, i, loopRegime8, clzRegime8 );
+	CHECK_AND_TIME( "posit16", 1u<<20, 16, 0xFFFF, uint_fast16_t, i, loopRegime16, clzRegime16 );
+	CHECK_AND_TIME( "posit32", N32, 32, 0xFFFFFFFF, uint_fast32_t, rnd[i], loopRegime32, clzRegime32 );
+
+	printf( "\n%-10s %12s\n", "op", "ns/op" );
+	TIME_OP( "p8_add", N32, castUI( p8_add( castP8( rnd[i]&0xFF ), castP8( rnd[i]>>24 ) ) ) );
+	TIME_OP( "p8_mul", N32, castUI( p8_mul( castP8( rnd[i]&0xFF ), castP8( rnd[i]>>24 ) ) ) );
+	TIME_OP( "p8_div", N32, castUI( p8_div( castP8( rnd[i]&0xFF ), castP8( rnd[i]>>24 ) ) ) );
+	TIME_OP( "p16_add", N32, castUI( p16_add( castP16( rnd[i]&0xFFFF ), castP16( rnd[i]>>16 ) ) ) );
+	TIME_OP( "p16_mul", N32, castUI( p16_mul( castP16( rnd[i]&0xFFFF ), castP16( rnd[i]>>16 ) ) ) );
+	TIME_OP( "p16_div", N32, castUI( p16_div( castP16( rnd[i]&0xFFFF ), castP16( rnd[i]>>16 ) ) ) );
+	TIME_OP( "p16_sqrt", N32, castUI( p16_sqrt( castP16( rnd[i]&0xFFFF ) ) ) );
+	TIME_OP( "p32_add", N32-1, castUI( p32_add( castP32( rnd[i] ), castP32( rnd[i+1] ) ) ) );
+	TIME_OP( "p32_sub", N32-1, castUI( p32_sub( castP32( rnd[i] ), castP32( rnd[i+1] ) ) ) );
+	TIME_OP( "p32_mul", N32-1, castUI( p32_mul( castP32( rnd[i] ), castP32( rnd[i+1] ) ) ) );
+	TIME_OP( "p32_div", N32-1, castUI( p32_div( castP32( rnd[i] ), castP32( rnd[i+1] ) ) ) );
+	TIME_OP( "p32_sqrt", N32, castUI( p32_sqrt( castP32( rnd[i] ) ) ) );
+	TIME_OP( "p32_mulAdd", N32-2, castUI( p32_mulAdd( castP32( rnd[i] ), castP32( rnd[i+1] ), castP32( rnd[i+2] ) ) ) );
+
+	free( rnd );
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+# Compare two softposit_bench JSON files: prints the ns/op of each operation
+# in both runs and the speedup, and flags results whose checksums differ.
+import json
+import sys
+
+def load(name):
+   with open(name) as f:
+      data = json.load(f)
+   return data, {(r["op"], r["mode"]): r for r in data["results"]}
+
+if len(sys.argv) != 3:
+   sys.exit("usage: compare_bench.py before.json after.json")
+
+before, old = load(sys.argv[1])
+after, new = load(sys.argv[2])
+print("before: %s (%s)" % (before["label"] or sys.argv[1], before["cpu"]))
+print("after:  %s (%s)" % (after["label"] or sys.argv[2], after["cpu"]))
+print("%-20s %-10s %10s %10s %8s" % ("op", "mode", "before", "after", "speedup"))
+for key in sorted(set(old) & set(new)):
+   a, b = old[key], new[key]
+   note = "" if a["checksum"] == b["checksum"] else "  CHECKSUM DIFFERS"
+   print("%-20s %-10s %10.3f %10.3f %7.2fx%s" % (key[0], key[1], a["ns_per_op"],
+         b["ns_per_op"], a["ns_per_op"] / b["ns_per_op"], note))
@@ -0,0 +1,455 @@
+
+/*============================================================================
+
+This C source file is part of the SoftPosit Posit Arithmetic Package
+by S. H. Leong (Cerlane).
+
+Copyright 2017 2018 A*STAR.  All rights reserved.
+
+This C source file was based on SoftFloat IEEE Floating-Point Arithmetic
+Package, Release 3d, by John R. Hauser.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions, and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions, and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+ 3. Neither the name of the University nor the names of its contributors may
+    be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS "AS IS", AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE, ARE
+DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+=============================================================================*/
+
+/*----------------------------------------------------------------------------
+| Throughput and latency benchmark for the SoftPosit operations.
+|
+| Every operation is timed over a fixed input set per width:
+|   posit8   all 65536 operand pairs (exhaustive);
+|   posit16  every posit16 pattern as first operand, each against 16 random
+|            second operands (the unary operations see every pattern 16x);
+|   posit32  and posit_2_t (x bits, es=2): a large random set.
+| Each operation runs in two variants.  "throughput" evaluates independent
+| operations and stores every result; "latency" feeds the low bit of each
+| result into the next first operand so the calls form a dependency chain.
+| Quire fused dot products are timed as an accumulation (a chain by nature),
+| with the quire rounded and cleared every QUIRE_BLOCK products.
+|
+| Results are written as JSON (one record per operation and variant) so that
+| runs can be compared across commits and machines; a checksum of the results
+| is included, which must match between builds of the same inputs.
+*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "softposit.h"
+
+#define BENCH_VERSION 1
+#define QUIRE_BLOCK 1024
+
+typedef struct {
+	const char *name;		//"posit8", ...
+	const char *inputs;		//"exhaustive", "exhaustive-first", "random"
+	size_t n;
+	uint32_t *a, *b, *c, *out;
+	double *d;
+} benchSet_t;
+
+typedef uint32_t (*benchKernel_t)( const benchSet_t * );
+
+typedef struct {
+	const char *op;
+	benchSet_t *set;
+	benchKernel_t throughput;
+	benchKernel_t latency;		//NULL for quire accumulation
+} benchCase_t;
+
+static int benchX = 24;
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t nextRandom( void ) {
+	rngState ^= rngState << 13;
+	rngState ^= rngState >> 7;
+	rngState ^= rngState << 17;
+	return (uint32_t) (rngState >> 16);
+}
+
+static double nowSeconds( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t benchChecksum( const uint32_t *out, size_t n ) {
+	uint32_t h = 2166136261u;
+	size_t i;
+	for (i=0; i<n; i++) h = (h ^ out[i]) * 16777619u;
+	return h;
+}
+
+static inline uint32_t doubleBits( double d ) {
+	uint64_t u;
+	memcpy( &u, &d, sizeof(u) );
+	return (uint32_t) (u ^ (u>>32));
+}
+
+//Fixed-x wrappers so that posit_2_t fits the same kernels as the others.
+static inline posit_2_t pX2_addB( posit_2_t a, posit_2_t b ) { return pX2_add( a, b, benchX ); }
+static inline posit_2_t pX2_subB( posit_2_t a, posit_2_t b ) { return pX2_sub( a, b, benchX ); }
+static inline posit_2_t pX2_mulB( posit_2_t a, posit_2_t b ) { return pX2_mul( a, b, benchX ); }
+static inline posit_2_t pX2_divB( posit_2_t a, posit_2_t b ) { return pX2_div( a, b, benchX ); }
+static inline posit_2_t pX2_sqrtB( posit_2_t a ) { return pX2_sqrt( a, benchX ); }
+static inline posit_2_t pX2_mulAddB( posit_2_t a, posit_2_t b, posit_2_t c ) { return pX2_mulAdd( a, b, c, benchX ); }
+static inline posit_2_t castPX2B( uint32_t a ) { posit_2_t p; p.v = a; return p; }
+
+/*----------------------------------------------------------------------------
+| Kernel generators.  `expr' is evaluated with A, B, C (raw operand bits) and
+| D (a double) in scope and must yield the uint32_t result bits.
+*----------------------------------------------------------------------------*/
+#define BENCH_KERNEL( name, expr ) \
+static uint32_t name##_throughput( const benchSet_t *s ) {\
+	size_t i;\
+	for (i=0; i<s->n; i++){\
+		uint32_t A = s->a[i], B = s->b[i], C = s->c[i];\
+		double D = s->d[i];\
+		(void) A; (void) B; (void) C; (void) D;\
+		s->out[i] = (expr);\
+	}\
+	return benchChecksum( s->out, s->n );\
+}\
+static uint32_t name##_latency( const benchSet_t *s ) {\
+	size_t i;\
+	uint32_t r = 0;\
+	for (i=0; i<s->n; i++){\
+		uint32_t A = s->a[i] ^ (r & 0x1), B = s->b[i], C = s->c[i];\
+		double D = s->d[i] + (double) (r & 0x1);\
+		(void) A; (void) B; (void) C; (void) D;\
+		r = (expr);\
+	}\
+	return r;\
+}
+
+//NaR operands would turn the quire into NaR and short-cut every later call.
+#define BENCH_QUIRE( name, quireType, clr, fdp, toPosit, cast, nar ) \
+static uint32_t name##_accumulate( const benchSet_t *s ) {\
+	size_t i;\
+	uint32_t sum = 0;\
+	quireType q = clr();\
+	for (i=0; i<s->n; i++){\
+		uint32_t A = s->a[i], B = s->b[i];\
+		if (A==(nar)) A = 0;\
+		if (B==(nar)) B = 0;\
+		q = fdp( q, cast( A ), cast( B ) );\
+		if ((i & (QUIRE_BLOCK-1))==QUIRE_BLOCK-1){\
+			sum = sum * 31 + castUI( toPosit );\
+			q = clr();\
+		}\
+	}\
+	return sum * 31 + castUI( toPosit );\
+}
+
+BENCH_KERNEL( p8_add, castUI( p8_add( castP8( A ), castP8( B ) ) ) )
+BENCH_KERNEL( p8_sub, castUI( p8_sub( castP8( A ), castP8( B ) ) ) )
+BENCH_KERNEL( p8_mul, castUI( p8_mul( castP8( A ), castP8( B ) ) ) )
+BENCH_KERNEL( p8_div, castUI( p8_div( castP8( A ), castP8( B ) ) ) )
+BENCH_KERNEL( p8_sqrt, castUI( p8_sqrt( castP8( A ) ) ) )
+BENCH_KERNEL( p8_mulAdd, castUI( p8_mulAdd( castP8( A ), castP8( B ), castP8( C ) ) ) )
+BENCH_KERNEL( p8_to_p16, castUI( p8_to_p16( castP8( A ) ) ) )
+BENCH_KERNEL( p8_to_p32, castUI( p8_to_p32( castP8( A ) ) ) )
+BENCH_KERNEL( p8_to_i32, (uint32_t) p8_to_i32( castP8( A ) ) )
+BENCH_KERNEL( i32_to_p8, castUI( i32_to_p8( (int32_t) (A<<24) >> 24 ) ) )
+BENCH_KERNEL( convertP8ToDouble, doubleBits( convertP8ToDouble( castP8( A ) ) ) )
+BENCH_KERNEL( convertDoubleToP8, castUI( convertDoubleToP8( D ) ) )
+BENCH_QUIRE( q8_fdp_add, quire8_t, q8Clr, q8_fdp_add, q8_to_p8( q ), castP8, 0x80 )
+
+BENCH_KERNEL( p16_add, castUI( p16_add( castP16( A ), castP16( B ) ) ) )
+BENCH_KERNEL( p16_sub, castUI( p16_sub( castP16( A ), castP16( B ) ) ) )
+BENCH_KERNEL( p16_mul, castUI( p16_mul( castP16( A ), castP16( B ) ) ) )
+BENCH_KERNEL( p16_div, castUI( p16_div( castP16( A ), castP16( B ) ) ) )
+BENCH_KERNEL( p16_sqrt, castUI( p16_sqrt( castP16( A ) ) ) )
+BENCH_KERNEL( p16_mulAdd, castUI( p16_mulAdd( castP16( A ), castP16( B ), castP16( C ) ) ) )
+BENCH_KERNEL( p16_to_p8, castUI( p16_to_p8( castP16( A ) ) ) )
+BENCH_KERNEL( p16_to_p32, castUI( p16_to_p32( castP16( A ) ) ) )
+BENCH_KERNEL( p16_to_i32, (uint32_t) p16_to_i32( castP16( A ) ) )
+BENCH_KERNEL( i32_to_p16, castUI( i32_to_p16( (int32_t) (A<<16) >> 16 ) ) )
+BENCH_KERNEL( convertP16ToDouble, doubleBits( convertP16ToDouble( castP16( A ) ) ) )
+BENCH_KERNEL( convertDoubleToP16, castUI( convertDoubleToP16( D ) ) )
+BENCH_QUIRE( q16_fdp_add, quire16_t, q16Clr, q16_fdp_add, q16_to_p16( q ), castP16, 0x8000 )
+
+BENCH_KERNEL( p32_add, castUI( p32_add( castP32( A ), castP32( B ) ) ) )
+BENCH_KERNEL( p32_sub, castUI( p32_sub( castP32( A ), castP32( B ) ) ) )
+BENCH_KERNEL( p32_mul, castUI( p32_mul( castP32( A ), castP32( B ) ) ) )
+BENCH_KERNEL( p32_div, castUI( p32_div( castP32( A ), castP32( B ) ) ) )
+BENCH_KERNEL( p32_sqrt, castUI( p32_sqrt( castP32( A ) ) ) )
+BENCH_KERNEL( p32_mulAdd, castUI( p32_mulAdd( castP32( A ), castP32( B ), castP32( C ) ) ) )
+BENCH_KERNEL( p32_to_p8, castUI( p32_to_p8( castP32( A ) ) ) )
+BENCH_KERNEL( p32_to_p16, castUI( p32_to_p16( castP32( A ) ) ) )
+BENCH_KERNEL( p32_to_i32, (uint32_t) p32_to_i32( castP32( A ) ) )
+BENCH_KERNEL( i32_to_p32, castUI( i32_to_p32( (int32_t) A ) ) )
+BENCH_KERNEL( convertP32ToDouble, doubleBits( convertP32ToDouble( castP32( A ) ) ) )
+BENCH_KERNEL( convertDoubleToP32, castUI( convertDoubleToP32( D ) ) )
+BENCH_QUIRE( q32_fdp_add, quire32_t, q32Clr, q32_fdp_add, q32_to_p32( q ), castP32, 0x80000000 )
+
+BENCH_KERNEL( pX2_add, castUI( pX2_addB( castPX2B( A ), castPX2B( B ) ) ) )
+BENCH_KERNEL( pX2_sub, castUI( pX2_subB( castPX2B( A ), castPX2B( B ) ) ) )
+BENCH_KERNEL( pX2_mul, castUI( pX2_mulB( castPX2B( A ), castPX2B( B ) ) ) )
+BENCH_KERNEL( pX2_div, castUI( pX2_divB( castPX2B( A ), castPX2B( B ) ) ) )
+BENCH_KERNEL( pX2_sqrt, castUI( pX2_sqrtB( castPX2B( A ) ) ) )
+BENCH_KERNEL( pX2_mulAdd, castUI( pX2_mulAddB( castPX2B( A ), castPX2B( B ), castPX2B( C ) ) ) )
+BENCH_KERNEL( pX2_to_i32, (uint32_t) pX2_to_i32( castPX2B( A ) ) )
+BENCH_KERNEL( i32_to_pX2, castUI( i32_to_pX2( (int32_t) A, benchX ) ) )
+BENCH_KERNEL( convertPX2ToDouble, doubleBits( convertPX2ToDouble( castPX2B( A ) ) ) )
+BENCH_KERNEL( convertDoubleToPX2, castUI( convertDoubleToPX2( D, benchX ) ) )
+BENCH_QUIRE( qX2_fdp_add, quire_2_t, qX2Clr, qX2_fdp_add, qX2_to_pX2( q, benchX ), castPX2B, 0x80000000 )
+
+static benchSet_t setP8 = { "posit8", "exhaustive" };
+static benchSet_t setP16 = { "posit16", "exhaustive-first" };
+static benchSet_t setP32 = { "posit32", "random" };
+static benchSet_t setPX2 = { "posit_2", "random" };
+
+#define CASE( name, set ) { #name, &set, name##_throughput, name##_latency }
+#define QUIRE_CASE( name, set ) { #name, &set, name##_accumulate, NULL }
+
+static const benchCase_t benchCases[] = {
+	CASE( p8_add, setP8 ), CASE( p8_sub, setP8 ), CASE( p8_mul, setP8 ),
+	CASE( p8_div, setP8 ), CASE( p8_sqrt, setP8 ), CASE( p8_mulAdd, setP8 ),
+	CASE( p8_to_p16, setP8 ), CASE( p8_to_p32, setP8 ), CASE( p8_to_i32, setP8 ),
+	CASE( i32_to_p8, setP8 ), CASE( convertP8ToDouble, setP8 ),
+	CASE( convertDoubleToP8, setP8 ), QUIRE_CASE( q8_fdp_add, setP8 ),
+
+	CASE( p16_add, setP16 ), CASE( p16_sub, setP16 ), CASE( p16_mul, setP16 ),
+	CASE( p16_div, setP16 ), CASE( p16_sqrt, setP16 ), CASE( p16_mulAdd, setP16 ),
+	CASE( p16_to_p8, setP16 ), CASE( p16_to_p32, setP16 ), CASE( p16_to_i32, setP16 ),
+	CASE( i32_to_p16, setP16 ), CASE( convertP16ToDouble, setP16 ),
+	CASE( convertDoubleToP16, setP16 ), QUIRE_CASE( q16_fdp_add, setP16 ),
+
+	CASE( p32_add, setP32 ), CASE( p32_sub, setP32 ), CASE( p32_mul, setP32 ),
+	CASE( p32_div, setP32 ), CASE( p32_sqrt, setP32 ), CASE( p32_mulAdd, setP32 ),
+	CASE( p32_to_p8, setP32 ), CASE( p32_to_p16, setP32 ), CASE( p32_to_i32, setP32 ),
+	CASE( i32_to_p32, setP32 ), CASE( convertP32ToDouble, setP32 ),
+	CASE( convertDoubleToP32, setP32 ), QUIRE_CASE( q32_fdp_add, setP32 ),
+
+	CASE( pX2_add, setPX2 ), CASE( pX2_sub, setPX2 ), CASE( pX2_mul, setPX2 ),
+	CASE( pX2_div, setPX2 ), CASE( pX2_sqrt, setPX2 ), CASE( pX2_mulAdd, setPX2 ),
+	CASE( pX2_to_i32, setPX2 ), CASE( i32_to_pX2, setPX2 ),
+	CASE( convertPX2ToDouble, setPX2 ), CASE( convertDoubleToPX2, setPX2 ),
+	QUIRE_CASE( qX2_fdp_add, setPX2 ),
+};
+
+static int allocSet( benchSet_t *s, size_t n ) {
+	s->n = n;
+	s->a = malloc( n * sizeof(uint32_t) );
+	s->b = malloc( n * sizeof(uint32_t) );
+	s->c = malloc( n * sizeof(uint32_t) );
+	s->out = malloc( n * sizeof(uint32_t) );
+	s->d = malloc( n * sizeof(double) );
+	return s->a && s->b && s->c && s->out && s->d;
+}
+
+static void freeSet( benchSet_t *s ) {
+	free( s->a ); free( s->b ); free( s->c ); free( s->out ); free( s->d );
+}
+
+//Doubles are posit values nudged off the posit grid so that rounding is
+//exercised; NaR maps to zero.
+static double nudge( double v ) {
+	return v * (1.0 + (double) (nextRandom() & 0xFFFF) / 1048576.0);
+}
+
+static int initSets( size_t n32 ) {
+	size_t i;
+	uint32_t xMask = (uint32_t) ((int32_t) 0x80000000 >> (benchX-1));
+
+	if (!allocSet( &setP8, 1u<<16 ) || !allocSet( &setP16, 1u<<20 )
+			|| !allocSet( &setP32, n32 ) || !allocSet( &setPX2, n32 ))
+		return 0;
+	for (i=0; i<setP8.n; i++){
+		setP8.a[i] = i & 0xFF;
+		setP8.b[i] = i >> 8;
+		setP8.c[i] = nextRandom() & 0xFF;
+		setP8.d[i] = isNaRP8UI( setP8.a[i] ) ? 0 : nudge( convertP8ToDouble( castP8( setP8.a[i] ) ) );
+	}
+	for (i=0; i<setP16.n; i++){
+		setP16.a[i] = i & 0xFFFF;
+		setP16.b[i] = nextRandom() & 0xFFFF;
+		setP16.c[i] = nextRandom() & 0xFFFF;
+		setP16.d[i] = isNaRP16UI( setP16.a[i] ) ? 0 : nudge( convertP16ToDouble( castP16( setP16.a[i] ) ) );
+	}
+	for (i=0; i<n32; i++){
+		setP32.a[i] = nextRandom();
+		setP32.b[i] = nextRandom();
+		setP32.c[i] = nextRandom();
+		setP32.d[i] = isNaRP32UI( setP32.a[i] ) ? 0 : nudge( convertP32ToDouble( castP32( setP32.a[i] ) ) );
+		setPX2.a[i] = nextRandom() & xMask;
+		setPX2.b[i] = nextRandom() & xMask;
+		setPX2.c[i] = nextRandom() & xMask;
+		setPX2.d[i] = isNaRPX2UI( setPX2.a[i] ) ? 0 : nudge( convertPX2ToDouble( castPX2B( setPX2.a[i] ) ) );
+	}
+	return 1;
+}
+
+static int compareDouble( const void *a, const void *b ) {
+	double x = *(const double *) a, y = *(const double *) b;
+	return (x > y) - (x < y);
+}
+
+//Runs one warm-up and `repeats' timed passes; returns best and median ns/op.
+static uint32_t timeKernel( benchKernel_t kernel, const benchSet_t *s, int repeats,
+		double *bestNs, double *medianNs ) {
+	double *t = malloc( repeats * sizeof(double) );
+	uint32_t check = kernel( s );
+	int r;
+
+	for (r=0; r<repeats; r++){
+		double t0 = nowSeconds();
+		if (kernel( s ) != check){
+			fprintf( stderr, "softposit_bench: non-deterministic result\n" );
+			exit( EXIT_FAILURE );
+		}
+		t[r] = (nowSeconds() - t0) * 1e9 / s->n;
+	}
+	qsort( t, repeats, sizeof(double), compareDouble );
+	*bestNs = t[0];
+	*medianNs = t[repeats/2];
+	free( t );
+	return check;
+}
+
+static void cpuModel( char *buf, size_t len ) {
+	FILE *f = fopen( "/proc/cpuinfo", "r" );
+	char line[256];
+
+	snprintf( buf, len, "unknown" );
+	if (!f) return;
+	while (fgets( line, sizeof(line), f )){
+		if (strncmp( line, "model name", 10 )==0){
+			char *p = strchr( line, ':' );
+			if (p){
+				p += 2;
+				p[strcspn( p, "\n" )] = 0;
+				snprintf( buf, len, "%s", p );
+			}
+			break;
+		}
+	}
+	fclose( f );
+}
+
+static void jsonString( FILE *f, const char *s ) {
+	fputc( '"', f );
+	for (; *s; s++){
+		if (*s=='"' || *s=='\\') fputc( '\\', f );
+		if ((unsigned char) *s >= 0x20) fputc( *s, f );
+	}
+	fputc( '"', f );
+}
+
+static void writeRecord( FILE *f, int *first, const benchCase_t *c, const char *mode,
+		double bestNs, double medianNs, uint32_t check ) {
+	fprintf( f, "%s\n    {\"op\": ", *first ? "" : "," );
+	jsonString( f, c->op );
+	fprintf( f, ", \"type\": \"%s\", \"inputs\": \"%s\", \"mode\": \"%s\", \"n\": %lu, "
+			"\"ns_per_op\": %.4f, \"ns_per_op_median\": %.4f, \"ops_per_s\": %.6g, "
+			"\"checksum\": \"%08lx\"}",
+			c->set->name, c->set->inputs, mode, (unsigned long) c->set->n,
+			bestNs, medianNs, 1e9 / bestNs, (unsigned long) check );
+	fprintf( stderr, "%-20s %-10s %-10s %10.3f ns/op %12.4g ops/s\n",
+			c->op, c->set->name, mode, bestNs, 1e9 / bestNs );
+	*first = 0;
+}
+
+static void usage( const char *prog ) {
+	fprintf( stderr,
+		"usage: %s [-o file.json] [-n count] [-r repeats] [-x bits] [-f filter] [-l label]\n"
+		"  -o  write JSON to file (default: stdout)\n"
+		"  -n  size of the random posit32/posit_2 input sets (default 4194304)\n"
+		"  -r  timed repetitions per kernel, best and median reported (default 5)\n"
+		"  -x  width of the posit_2 cases, 2..32 (default 24)\n"
+		"  -f  only run operations whose name contains this string\n"
+		"  -l  free-form label stored in the JSON, e.g. a commit id\n", prog );
+}
+
+int main( int argc, char *argv[] ) {
+	const char *outName = NULL, *filter = NULL, *label = "";
+	size_t n32 = 1u<<22;
+	int repeats = 5, first = 1, i;
+	size_t k;
+	char cpu[128];
+	FILE *f = stdout;
+
+	for (i=1; i<argc; i++){
+		if (i+1<argc && strcmp( argv[i], "-o" )==0) outName = argv[++i];
+		else if (i+1<argc && strcmp( argv[i], "-n" )==0) n32 = strtoul( argv[++i], NULL, 0 );
+		else if (i+1<argc && strcmp( argv[i], "-r" )==0) repeats = atoi( argv[++i] );
+		else if (i+1<argc && strcmp( argv[i], "-x" )==0) benchX = atoi( argv[++i] );
+		else if (i+1<argc && strcmp( argv[i], "-f" )==0) filter = argv[++i];
+		else if (i+1<argc && strcmp( argv[i], "-l" )==0) label = argv[++i];
+		else {
+			usage( argv[0] );
+			return EXIT_FAILURE;
+		}
+	}
+	if (n32<QUIRE_BLOCK || repeats<1 || benchX<2 || benchX>32){
+		usage( argv[0] );
+		return EXIT_FAILURE;
+	}
+	if (!initSets( n32 )){
+		fprintf( stderr, "softposit_bench: out of memory\n" );
+		return EXIT_FAILURE;
+	}
+	if (outName && !(f = fopen( outName, "w" ))){
+		perror( outName );
+		return EXIT_FAILURE;
+	}
+
+	cpuModel( cpu, sizeof(cpu) );
+	fprintf( f, "{\n  \"benchmark\": \"softposit_bench\",\n  \"version\": %d,\n  \"label\": ", BENCH_VERSION );
+	jsonString( f, label );
+	fprintf( f, ",\n  \"cpu\": " );
+	jsonString( f, cpu );
+	fprintf( f, ",\n  \"compiler\": " );
+#ifdef __VERSION__
+	jsonString( f, __VERSION__ );
+#else
+	jsonString( f, "unknown" );
+#endif
+	fprintf( f, ",\n  \"timestamp\": %ld,\n  \"repeats\": %d,\n  \"posit_2_bits\": %d,\n"
+			"  \"quire_block\": %d,\n  \"results\": [", (long) time( NULL ), repeats, benchX, QUIRE_BLOCK );
+
+	for (k=0; k<sizeof(benchCases)/sizeof(benchCases[0]); k++){
+		const benchCase_t *c = &benchCases[k];
+		double bestNs, medianNs;
+		uint32_t check;
+
+		if (filter && !strstr( c->op, filter )) continue;
+		check = timeKernel( c->throughput, c->set, repeats, &bestNs, &medianNs );
+		writeRecord( f, &first, c, c->latency ? "throughput" : "accumulate", bestNs, medianNs, check );
+		if (c->latency){
+			check = timeKernel( c->latency, c->set, repeats, &bestNs, &medianNs );
+			writeRecord( f, &first, c, "latency", bestNs, medianNs, check );
+		}
+	}
+	fprintf( f, "\n  ]\n}\n" );
+
+	if (f!=stdout) fclose( f );
+	freeSet( &setP8 ); freeSet( &setP16 ); freeSet( &setP32 ); freeSet( &setPX2 );
+	return EXIT_SUCCESS;
+}
@@ -2954,6 +2954,97 @@ class quire_2:
        self.v.toHex()
 
 
+p8_add_batch = _softposit.p8_add_batch
+p8_sub_batch = _softposit.p8_sub_batch
+p8_mul_batch = _softposit.p8_mul_batch
+p8_div_batch = _softposit.p8_div_batch
+p8_sqrt_batch = _softposit.p8_sqrt_batch
+p8_from_float_batch = _softposit.p8_from_float_batch
+p8_to_double_batch = _softposit.p8_to_double_batch
+p8_fdp_batch = _softposit.p8_fdp_batch
+p16_add_batch = _softposit.p16_add_batch
+p16_sub_batch = _softposit.p16_sub_batch
+p16_mul_batch = _softposit.p16_mul_batch
+p16_div_batch = _softposit.p16_div_batch
+p16_sqrt_batch = _softposit.p16_sqrt_batch
+p16_from_float_batch = _softposit.p16_from_float_batch
+p16_to_double_batch = _softposit.p16_to_double_batch
+p16_fdp_batch = _softposit.p16_fdp_batch
+p32_add_batch = _softposit.p32_add_batch
+p32_sub_batch = _softposit.p32_sub_batch
+p32_mul_batch = _softposit.p32_mul_batch
+p32_div_batch = _softposit.p32_div_batch
+p32_sqrt_batch = _softposit.p32_sqrt_batch
+p32_from_float_batch = _softposit.p32_from_float_batch
+p32_to_double_batch = _softposit.p32_to_double_batch
+p32_fdp_batch = _softposit.p32_fdp_batch
+
+def _posit_batch(nbits, op):
+   if nbits not in (8, 16, 32):
+       raise ValueError("nbits must be 8, 16 or 32")
+   return getattr(_softposit, "p%d_%s_batch" % (nbits, op))
+
+def _posit_bits_dtype(nbits):
+   import numpy
+   return {8: numpy.uint8, 16: numpy.uint16, 32: numpy.uint32}[nbits]
+
+def _posit_bits_array(a, nbits):
+   import numpy
+   a = numpy.asarray(a)
+   # a cast would convert floats by value, not take them as posit bits
+   if a.dtype.kind == 'f':
+       raise TypeError("expected posit bits, got a %s array; use posit_array() to convert floats" % a.dtype)
+   return numpy.ascontiguousarray(a, dtype=_posit_bits_dtype(nbits))
+
+def posit_array(x, nbits=32):
+   import numpy
+   x = numpy.ascontiguousarray(x)
+   if x.dtype not in (numpy.float32, numpy.float64):
+       x = x.astype(numpy.float64)
+   out = numpy.empty(x.shape, dtype=_posit_bits_dtype(nbits))
+   _posit_batch(nbits, "from_float")(x, out)
+   return out
+
+def posit_array_to_double(a, nbits=32):
+   import numpy
+   a = _posit_bits_array(a, nbits)
+   out = numpy.empty(a.shape, dtype=numpy.float64)
+   _posit_batch(nbits, "to_double")(a, out)
+   return out
+
+def _posit_array_binary(op, a, b, nbits, out):
+   import numpy
+   a = _posit_bits_array(a, nbits)
+   b = _posit_bits_array(b, nbits)
+   if out is None:
+       out = numpy.empty(a.shape, dtype=a.dtype)
+   _posit_batch(nbits, op)(a, b, out)
+   return out
+
+def posit_array_add(a, b, nbits=32, out=None):
+   return _posit_array_binary("add", a, b, nbits, out)
+
+def posit_array_sub(a, b, nbits=32, out=None):
+   return _posit_array_binary("sub", a, b, nbits, out)
+
+def posit_array_mul(a, b, nbits=32, out=None):
+   return _posit_array_binary("mul", a, b, nbits, out)
+
+def posit_array_div(a, b, nbits=32, out=None):
+   return _posit_array_binary("div", a, b, nbits, out)
+
+def posit_array_sqrt(a, nbits=32, out=None):
+   import numpy
+   a = _posit_bits_array(a, nbits)
+   if out is None:
+       out = numpy.empty(a.shape, dtype=a.dtype)
+   _posit_batch(nbits, "sqrt")(a, out)
+   return out
+
+def posit_array_dot(a, b, nbits=32):
+   return _posit_batch(nbits, "fdp")(_posit_bits_array(a, nbits), _posit_bits_array(b, nbits))
+
+
 # This file is compatible with both classic and new-style classes.
 
 
@@ -29,6 +29,35 @@ SOFTWARE.
 %}
 
 
+// batch entry points are exposed on buffers below
+%ignore p8_add_batch;
+%ignore p8_sub_batch;
+%ignore p8_mul_batch;
+%ignore p8_div_batch;
+%ignore p8_sqrt_batch;
+%ignore convertDoubleToP8_batch;
+%ignore convertFloatToP8_batch;
+%ignore convertP8ToDouble_batch;
+%ignore p8_fdp_batch;
+%ignore p16_add_batch;
+%ignore p16_sub_batch;
+%ignore p16_mul_batch;
+%ignore p16_div_batch;
+%ignore p16_sqrt_batch;
+%ignore convertDoubleToP16_batch;
+%ignore convertFloatToP16_batch;
+%ignore convertP16ToDouble_batch;
+%ignore p16_fdp_batch;
+%ignore p32_add_batch;
+%ignore p32_sub_batch;
+%ignore p32_mul_batch;
+%ignore p32_div_batch;
+%ignore p32_sqrt_batch;
+%ignore convertDoubleToP32_batch;
+%ignore convertFloatToP32_batch;
+%ignore convertP32ToDouble_batch;
+%ignore p32_fdp_batch;
+
 %include "softposit_types.h"
 %include "softposit.h"
 %include <stdint.i>
@@ -2088,4 +2117,270 @@ class quire_2:
     %}
 };
 
+%{
+/*----------------------------------------------------------------------------
+| Batch entry points over buffer-protocol objects (numpy arrays, bytearray,
+| array.array).  Posit operands are raw bits; the GIL is released while the
+| C loop runs so several Python threads can work in parallel.
+*----------------------------------------------------------------------------*/
+
+static int softposit_isFloatBuffer(Py_buffer *view) {
+  const char *format = view->format ? view->format : "B";
+  if (*format == '@' || *format == '=' || *format == '<' || *format == '>' || *format == '!') format++;
+  return (*format == 'f' || *format == 'd' || *format == 'e');
+}
+
+/* isFloat: 1 for a buffer of doubles, 0 for raw posit bits, which a float
+   buffer of the same item size would otherwise pass as */
+static int softposit_getBuffer(PyObject *obj, Py_buffer *view, Py_ssize_t itemsize, int writable, int isFloat, const char *name) {
+  int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT;
+  if (writable) flags |= PyBUF_WRITABLE;
+  if (PyObject_GetBuffer(obj, view, flags) < 0) return -1;
+  if (view->itemsize != itemsize) {
+    PyErr_Format(PyExc_TypeError, "%s: expected a buffer of %d-byte items, got %d-byte items",
+                 name, (int)itemsize, (int)view->itemsize);
+    PyBuffer_Release(view);
+    return -1;
+  }
+  if (softposit_isFloatBuffer(view) != isFloat) {
+    PyErr_Format(PyExc_TypeError, isFloat ? "%s: expected a float64 buffer"
+                                          : "%s: expected a buffer of raw posit bits, got a float buffer",
+                 name);
+    PyBuffer_Release(view);
+    return -1;
+  }
+  return 0;
+}
+
+static int softposit_checkLength(Py_buffer *a, Py_buffer *b, const char *name) {
+  if (a->len / a->itemsize != b->len / b->itemsize) {
+    PyErr_Format(PyExc_ValueError, "%s: buffers have different lengths", name);
+    return -1;
+  }
+  return 0;
+}
+
+#define SOFTPOSIT_BATCH_BINARY(name, uintN_t)\
+static PyObject *softposit_wrap_##name(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {\
+  PyObject *obj0 = 0, *obj1 = 0, *obj2 = 0;\
+  Py_buffer bufA, bufB, bufZ;\
+  size_t n;\
+  if (!PyArg_ParseTuple(args, (char *)"OOO:" #name, &obj0, &obj1, &obj2)) return NULL;\
+  if (softposit_getBuffer(obj0, &bufA, sizeof(uintN_t), 0, 0, #name) < 0) return NULL;\
+  if (softposit_getBuffer(obj1, &bufB, sizeof(uintN_t), 0, 0, #name) < 0) {\
+    PyBuffer_Release(&bufA);\
+    return NULL;\
+  }\
+  if (softposit_getBuffer(obj2, &bufZ, sizeof(uintN_t), 1, 0, #name) < 0) {\
+    PyBuffer_Release(&bufA);\
+    PyBuffer_Release(&bufB);\
+    return NULL;\
+  }\
+  if (softposit_checkLength(&bufA, &bufB, #name) < 0 || softposit_checkLength(&bufA, &bufZ, #name) < 0) {\
+    PyBuffer_Release(&bufA);\
+    PyBuffer_Release(&bufB);\
+    PyBuffer_Release(&bufZ);\
+    return NULL;\
+  }\
+  n = bufA.len / sizeof(uintN_t);\
+  Py_BEGIN_ALLOW_THREADS\
+  name((const uintN_t *)bufA.buf, (const uintN_t *)bufB.buf, (uintN_t *)bufZ.buf, n);\
+  Py_END_ALLOW_THREADS\
+  PyBuffer_Release(&bufA);\
+  PyBuffer_Release(&bufB);\
+  PyBuffer_Release(&bufZ);\
+  Py_RETURN_NONE;\
+}
+
+#define SOFTPOSIT_BATCH_UNARY(name, inT, outT, outIsFloat)\
+static PyObject *softposit_wrap_##name(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {\
+  PyObject *obj0 = 0, *obj1 = 0;\
+  Py_buffer bufA, bufZ;\
+  size_t n;\
+  if (!PyArg_ParseTuple(args, (char *)"OO:" #name, &obj0, &obj1)) return NULL;\
+  if (softposit_getBuffer(obj0, &bufA, sizeof(inT), 0, 0, #name) < 0) return NULL;\
+  if (softposit_getBuffer(obj1, &bufZ, sizeof(outT), 1, outIsFloat, #name) < 0) {\
+    PyBuffer_Release(&bufA);\
+    return NULL;\
+  }\
+  if (softposit_checkLength(&bufA, &bufZ, #name) < 0) {\
+    PyBuffer_Release(&bufA);\
+    PyBuffer_Release(&bufZ);\
+    return NULL;\
+  }\
+  n = bufA.len / sizeof(inT);\
+  Py_BEGIN_ALLOW_THREADS\
+  name((const inT *)bufA.buf, (outT *)bufZ.buf, n);\
+  Py_END_ALLOW_THREADS\
+  PyBuffer_Release(&bufA);\
+  PyBuffer_Release(&bufZ);\
+  Py_RETURN_NONE;\
+}
+
+/* float32 or float64 input, picked from the buffer format */
+#define SOFTPOSIT_BATCH_FROM_FLOAT(N)\
+static PyObject *softposit_wrap_p##N##_from_float_batch(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {\
+  PyObject *obj0 = 0, *obj1 = 0;\
+  Py_buffer bufA, bufZ;\
+  size_t n;\
+  if (!PyArg_ParseTuple(args, (char *)"OO:p" #N "_from_float_batch", &obj0, &obj1)) return NULL;\
+  if (PyObject_GetBuffer(obj0, &bufA, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) return NULL;\
+  if (!softposit_isFloatBuffer(&bufA) || (bufA.itemsize != sizeof(float) && bufA.itemsize != sizeof(double))) {\
+    PyErr_SetString(PyExc_TypeError, "p" #N "_from_float_batch: expected a float32 or float64 buffer");\
+    PyBuffer_Release(&bufA);\
+    return NULL;\
+  }\
+  if (softposit_getBuffer(obj1, &bufZ, sizeof(uint##N##_t), 1, 0, "p" #N "_from_float_batch") < 0) {\
+    PyBuffer_Release(&bufA);\
+    return NULL;\
+  }\
+  if (softposit_checkLength(&bufA, &bufZ, "p" #N "_from_float_batch") < 0) {\
+    PyBuffer_Release(&bufA);\
+    PyBuffer_Release(&bufZ);\
+    return NULL;\
+  }\
+  n = bufA.len / bufA.itemsize;\
+  Py_BEGIN_ALLOW_THREADS\
+  if (bufA.itemsize == sizeof(double))\
+    convertDoubleToP##N##_batch((const double *)bufA.buf, (uint##N##_t *)bufZ.buf, n);\
+  else\
+    convertFloatToP##N##_batch((const float *)bufA.buf, (uint##N##_t *)bufZ.buf, n);\
+  Py_END_ALLOW_THREADS\
+  PyBuffer_Release(&bufA);\
+  PyBuffer_Release(&bufZ);\
+  Py_RETURN_NONE;\
+}
+
+/* quire dot product, returns the raw bits of the rounded result */
+#define SOFTPOSIT_BATCH_FDP(N)\
+static PyObject *softposit_wrap_p##N##_fdp_batch(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {\
+  PyObject *obj0 = 0, *obj1 = 0;\
+  Py_buffer bufA, bufB;\
+  posit##N##_t result;\
+  size_t n;\
+  if (!PyArg_ParseTuple(args, (char *)"OO:p" #N "_fdp_batch", &obj0, &obj1)) return NULL;\
+  if (softposit_getBuffer(obj0, &bufA, sizeof(uint##N##_t), 0, 0, "p" #N "_fdp_batch") < 0) return NULL;\
+  if (softposit_getBuffer(obj1, &bufB, sizeof(uint##N##_t), 0, 0, "p" #N "_fdp_batch") < 0) {\
+    PyBuffer_Release(&bufA);\
+    return NULL;\
+  }\
+  if (softposit_checkLength(&bufA, &bufB, "p" #N "_fdp_batch") < 0) {\
+    PyBuffer_Release(&bufA);\
+    PyBuffer_Release(&bufB);\
+    return NULL;\
+  }\
+  n = bufA.len / sizeof(uint##N##_t);\
+  Py_BEGIN_ALLOW_THREADS\
+  result = p##N##_fdp_batch((const uint##N##_t *)bufA.buf, (const uint##N##_t *)bufB.buf, n);\
+  Py_END_ALLOW_THREADS\
+  PyBuffer_Release(&bufA);\
+  PyBuffer_Release(&bufB);\
+  return PyLong_FromUnsignedLong((unsigned long)castUI(result));\
+}
+
+#define SOFTPOSIT_BATCH_ALL(N)\
+SOFTPOSIT_BATCH_BINARY(p##N##_add_batch, uint##N##_t)\
+SOFTPOSIT_BATCH_BINARY(p##N##_sub_batch, uint##N##_t)\
+SOFTPOSIT_BATCH_BINARY(p##N##_mul_batch, uint##N##_t)\
+SOFTPOSIT_BATCH_BINARY(p##N##_div_batch, uint##N##_t)\
+SOFTPOSIT_BATCH_UNARY(p##N##_sqrt_batch, uint##N##_t, uint##N##_t, 0)\
+SOFTPOSIT_BATCH_UNARY(convertP##N##ToDouble_batch, uint##N##_t, double, 1)\
+SOFTPOSIT_BATCH_FROM_FLOAT(N)\
+SOFTPOSIT_BATCH_FDP(N)
+
+SOFTPOSIT_BATCH_ALL(8)
+SOFTPOSIT_BATCH_ALL(16)
+SOFTPOSIT_BATCH_ALL(32)
+%}
+
+%native(p8_add_batch) PyObject *softposit_wrap_p8_add_batch(PyObject *self, PyObject *args);
+%native(p8_sub_batch) PyObject *softposit_wrap_p8_sub_batch(PyObject *self, PyObject *args);
+%native(p8_mul_batch) PyObject *softposit_wrap_p8_mul_batch(PyObject *self, PyObject *args);
+%native(p8_div_batch) PyObject *softposit_wrap_p8_div_batch(PyObject *self, PyObject *args);
+%native(p8_sqrt_batch) PyObject *softposit_wrap_p8_sqrt_batch(PyObject *self, PyObject *args);
+%native(p8_from_float_batch) PyObject *softposit_wrap_p8_from_float_batch(PyObject *self, PyObject *args);
+%native(p8_to_double_batch) PyObject *softposit_wrap_convertP8ToDouble_batch(PyObject *self, PyObject *args);
+%native(p8_fdp_batch) PyObject *softposit_wrap_p8_fdp_batch(PyObject *self, PyObject *args);
+%native(p16_add_batch) PyObject *softposit_wrap_p16_add_batch(PyObject *self, PyObject *args);
+%native(p16_sub_batch) PyObject *softposit_wrap_p16_sub_batch(PyObject *self, PyObject *args);
+%native(p16_mul_batch) PyObject *softposit_wrap_p16_mul_batch(PyObject *self, PyObject *args);
+%native(p16_div_batch) PyObject *softposit_wrap_p16_div_batch(PyObject *self, PyObject *args);
+%native(p16_sqrt_batch) PyObject *softposit_wrap_p16_sqrt_batch(PyObject *self, PyObject *args);
+%native(p16_from_float_batch) PyObject *softposit_wrap_p16_from_float_batch(PyObject *self, PyObject *args);
+%native(p16_to_double_batch) PyObject *softposit_wrap_convertP16ToDouble_batch(PyObject *self, PyObject *args);
+%native(p16_fdp_batch) PyObject *softposit_wrap_p16_fdp_batch(PyObject *self, PyObject *args);
+%native(p32_add_batch) PyObject *softposit_wrap_p32_add_batch(PyObject *self, PyObject *args);
+%native(p32_sub_batch) PyObject *softposit_wrap_p32_sub_batch(PyObject *self, PyObject *args);
+%native(p32_mul_batch) PyObject *softposit_wrap_p32_mul_batch(PyObject *self, PyObject *args);
+%native(p32_div_batch) PyObject *softposit_wrap_p32_div_batch(PyObject *self, PyObject *args);
+%native(p32_sqrt_batch) PyObject *softposit_wrap_p32_sqrt_batch(PyObject *self, PyObject *args);
+%native(p32_from_float_batch) PyObject *softposit_wrap_p32_from_float_batch(PyObject *self, PyObject *args);
+%native(p32_to_double_batch) PyObject *softposit_wrap_convertP32ToDouble_batch(PyObject *self, PyObject *args);
+%native(p32_fdp_batch) PyObject *softposit_wrap_p32_fdp_batch(PyObject *self, PyObject *args);
 
+%pythoncode %{
+def _posit_batch(nbits, op):
+   if nbits not in (8, 16, 32):
+       raise ValueError("nbits must be 8, 16 or 32")
+   return getattr(_softposit, "p%d_%s_batch" % (nbits, op))
+
+def _posit_bits_dtype(nbits):
+   import numpy
+   return {8: numpy.uint8, 16: numpy.uint16, 32: numpy.uint32}[nbits]
+
+def _posit_bits_array(a, nbits):
+   import numpy
+   a = numpy.asarray(a)
+   # a cast would convert floats by value, not take them as posit bits
+   if a.dtype.kind == 'f':
+       raise TypeError("expected posit bits, got a %s array; use posit_array() to convert floats" % a.dtype)
+   return numpy.ascontiguousarray(a, dtype=_posit_bits_dtype(nbits))
+
+def posit_array(x, nbits=32):
+   import numpy
+   x = numpy.ascontiguousarray(x)
+   if x.dtype not in (numpy.float32, numpy.float64):
+       x = x.astype(numpy.float64)
+   out = numpy.empty(x.shape, dtype=_posit_bits_dtype(nbits))
+   _posit_batch(nbits, "from_float")(x, out)
+   return out
+
+def posit_array_to_double(a, nbits=32):
+   import numpy
+   a = _posit_bits_array(a, nbits)
+   out = numpy.empty(a.shape, dtype=numpy.float64)
+   _posit_batch(nbits, "to_double")(a, out)
+   return out
+
+def _posit_array_binary(op, a, b, nbits, out):
+   import numpy
+   a = _posit_bits_array(a, nbits)
+   b = _posit_bits_array(b, nbits)
+   if out is None:
+       out = numpy.empty(a.shape, dtype=a.dtype)
+   _posit_batch(nbits, op)(a, b, out)
+   return out
+
+def posit_array_add(a, b, nbits=32, out=None):
+   return _posit_array_binary("add", a, b, nbits, out)
+
+def posit_array_sub(a, b, nbits=32, out=None):
+   return _posit_array_binary("sub", a, b, nbits, out)
+
+def posit_array_mul(a, b, nbits=32, out=None):
+   return _posit_array_binary("mul", a, b, nbits, out)
+
+def posit_array_div(a, b, nbits=32, out=None):
+   return _posit_array_binary("div", a, b, nbits, out)
+
+def posit_array_sqrt(a, nbits=32, out=None):
+   import numpy
+   a = _posit_bits_array(a, nbits)
+   if out is None:
+       out = numpy.empty(a.shape, dtype=a.dtype)
+   _posit_batch(nbits, "sqrt")(a, out)
+   return out
+
+def posit_array_dot(a, b, nbits=32):
+   return _posit_batch(nbits, "fdp")(_posit_bits_array(a, nbits), _posit_bits_array(b, nbits))
+%}
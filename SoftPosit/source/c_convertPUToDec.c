@@ -0,0 +1,85 @@
+
+/*============================================================================
+
+This C source file is part of the SoftPosit Posit Arithmetic Package
+by S. H. Leong (Cerlane).
+
+Copyright 2017 2018 A*STAR.  All rights reserved.
+
+This C source file was based on SoftFloat IEEE Floating-Point Arithmetic
+Package, Release 3d, by John R. Hauser.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions, and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions, and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+ 3. Neither the name of the University nor the names of its contributors may
+    be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS "AS IS", AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE, ARE
+DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+=============================================================================*/
+
+#include <math.h>
+
+#include "platform.h"
+#include "internals.h"
+
+double convertPUToDouble( posit_unpacked_t uA ){
+
+	double d;
+
+	if (uA.isNaR) return NAN;
+	if (uA.isZero) return 0;
+
+	d = ldexp( (double) uA.sig, uA.scale-63 );
+	return (uA.sign) ? -d : d;
+}
+
+posit_unpacked_t convertDoubleToPU( double f ){
+
+	union ui64_double uA;
+	posit_unpacked_t uZ;
+	uint_fast64_t fracA;
+	int_fast16_t expA;
+	int_fast8_t shiftLeft;
+
+	uA.d = f;
+	expA = (uA.ui>>52) & 0x7FF;
+	fracA = uA.ui & 0xFFFFFFFFFFFFFULL;
+
+	//NaN and infinities have no posit counterpart
+	if (expA==0x7FF) return pUNaR();
+	if (expA==0 && fracA==0) return pUZero();
+
+	uZ.sign = uA.ui>>63;
+	uZ.isNaR = 0;
+	uZ.isZero = 0;
+	if (expA==0){
+		//subnormal
+		shiftLeft = softposit_countLeadingZeros64( fracA );
+		uZ.sig = fracA << shiftLeft;
+		uZ.scale = -1011 - shiftLeft;
+	}
+	else{
+		uZ.sig = (fracA<<11) | 0x8000000000000000ULL;
+		uZ.scale = expA - 1023;
+	}
+	return uZ;
+}
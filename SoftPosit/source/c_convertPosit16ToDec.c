@@ -70,24 +70,9 @@ double convertP16ToDouble(posit16_t a){
 	regS = signregP16UI( uZ.ui );
 
 	uint_fast16_t tmp = (uZ.ui<<2) & 0xFFFF;
-	if (regS){
-		while (tmp>>15){
-			k++;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		reg = k+1;
-	}
-	else{
-		k=-1;
-		while (!(tmp>>15)){
-			k--;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-		reg =-k;
-	}
+	k += softposit_decodeRegimeP16UI( regS, tmp );
+	reg = (regS) ? k+1 : -k;
+	shift += reg-1;
 	exp = tmp>>14;
 	frac = (tmp & 0x3FFF) >> shift;
 
@@ -137,24 +122,9 @@ double convertP16ToDouble(posit16_t a){
 		regS = signregP16UI( uZ.ui );
 
 		uint_fast16_t tmp = (uZ.ui<<2) & 0xFFFF;
-		if (regS){
-			while (tmp>>15){
-				k++;
-				shift++;
-				tmp= (tmp<<1) & 0xFFFF;
-			}
-			reg = k+1;
-		}
-		else{
-			k=-1;
-			while (!(tmp>>15)){
-				k--;
-				shift++;
-				tmp= (tmp<<1) & 0xFFFF;
-			}
-			tmp&=0x7FFF;
-			reg =-k;
-		}
+		k += softposit_decodeRegimeP16UI( regS, tmp );
+		reg = (regS) ? k+1 : -k;
+		shift += reg-1;
 		exp = tmp>>14;
 		frac = (tmp & 0x3FFF) >> shift;
 
@@ -80,24 +80,9 @@ __float128 convertP32ToQuad(posit32_t a){
 	regS = signregP32UI( uZ.ui );
 
 	tmp = tmp = (uZ.ui<<2)&0xFFFFFFFF;
-	if (regS){
-		while (tmp>>31){
-			k++;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		reg = k+1;
-	}
-	else{
-		k=-1;
-		while (!(tmp>>31)){
-			k--;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-		reg =-k;
-	}
+	k += softposit_decodeRegimeP32UI( regS, tmp );
+	reg = (regS) ? k+1 : -k;
+	shift += reg-1;
 	exp = tmp>>29;
 	frac = (tmp & 0x1FFFFFFF) >> shift;
 
@@ -147,24 +132,9 @@ __float128 convertPX2ToQuad(posit_2_t a){
 	regS = signregP32UI( uZ.ui );
 
 	tmp = tmp = (uZ.ui<<2)&0xFFFFFFFF;
-	if (regS){
-		while (tmp>>31){
-			k++;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		reg = k+1;
-	}
-	else{
-		k=-1;
-		while (!(tmp>>31)){
-			k--;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-		reg =-k;
-	}
+	k += softposit_decodeRegimeP32UI( regS, tmp );
+	reg = (regS) ? k+1 : -k;
+	shift += reg-1;
 	exp = tmp>>29;
 	frac = (tmp & 0x1FFFFFFF) >> shift;
 
@@ -204,21 +174,7 @@ double convertP32ToDouble(posit32_t pA){
 		if(signA) uiA = (-uiA & 0xFFFFFFFF);
 		regSA = signregP32UI(uiA);
 		tmp = (uiA<<2)&0xFFFFFFFF;
-		if (regSA){
-
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 		expA = tmp>>29; //to get 2 bits
 
 		fracA = (((uint64_t)tmp<<3)  & 0xFFFFFFFF)<<20;
@@ -260,24 +216,9 @@ double convertP32ToDouble(posit32_t pA){
 	regS = signregP32UI( uZ.ui );
 
 	tmp = (uZ.ui<<2)&0xFFFFFFFF;
-	if (regS){
-		while (tmp>>31){
-			k++;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		reg = k+1;
-	}
-	else{
-		k=-1;
-		while (!(tmp>>31)){
-			k--;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-		reg =-k;
-	}
+	k += softposit_decodeRegimeP32UI( regS, tmp );
+	reg = (regS) ? k+1 : -k;
+	shift += reg-1;
 	exp = tmp>>29;
 
 	frac = (tmp & 0x1FFFFFFF) >> shift;
@@ -324,24 +265,9 @@ double convertPX2ToDouble(posit_2_t a){
 	regS = signregP32UI( uZ.ui );
 
 	tmp = (uZ.ui<<2)&0xFFFFFFFF;
-	if (regS){
-		while (tmp>>31){
-			k++;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		reg = k+1;
-	}
-	else{
-		k=-1;
-		while (!(tmp>>31)){
-			k--;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-		reg =-k;
-	}
+	k += softposit_decodeRegimeP32UI( regS, tmp );
+	reg = (regS) ? k+1 : -k;
+	shift += reg-1;
 	exp = tmp>>29;
 
 	frac = (tmp & 0x1FFFFFFF) >> shift;
@@ -67,24 +67,9 @@ double convertP8ToDouble(posit8_t a){
 	regS = signregP8UI( uZ.ui );
 
 	uint_fast8_t tmp = (uZ.ui<<2) & 0xFF;
-	if (regS){
-		while (tmp>>7){
-			k++;
-			shift++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		reg = k+1;
-	}
-	else{
-		k=-1;
-		while (!(tmp>>7)){
-			k--;
-			shift++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-		reg =-k;
-	}
+	k += softposit_decodeRegimeP8UI( regS, tmp );
+	reg = (regS) ? k+1 : -k;
+	shift += reg-1;
 	frac = (tmp & 0x7F) >> shift;
 
 
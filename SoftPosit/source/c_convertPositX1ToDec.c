@@ -81,24 +81,9 @@ __float128 convertPX1ToQuad(posit_1_t a){
 	regS = signregP32UI( uZ.ui );
 
 	tmp = tmp = (uZ.ui<<2)&0xFFFFFFFF;
-	if (regS){
-		while (tmp>>31){
-			k++;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		reg = k+1;
-	}
-	else{
-		k=-1;
-		while (!(tmp>>31)){
-			k--;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-		reg =-k;
-	}
+	k += softposit_decodeRegimeP32UI( regS, tmp );
+	reg = (regS) ? k+1 : -k;
+	shift += reg-1;
 	exp = tmp>>30;
 	frac = (tmp & 0x1FFFFFFF) >> shift;
 
@@ -149,24 +134,9 @@ double convertPX1ToDouble(posit_1_t a){
 	regS = signregP32UI( uZ.ui );
 
 	tmp = (uZ.ui<<2)&0xFFFFFFFF;
-	if (regS){
-		while (tmp>>31){
-			k++;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		reg = k+1;
-	}
-	else{
-		k=-1;
-		while (!(tmp>>31)){
-			k--;
-			shift++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-		reg =-k;
-	}
+	k += softposit_decodeRegimeP32UI( regS, tmp );
+	reg = (regS) ? k+1 : -k;
+	shift += reg-1;
 	exp = tmp>>30;
 
 	frac = (tmp & 0x3FFFFFFF) >> shift;
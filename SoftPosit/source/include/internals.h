@@ -64,6 +64,33 @@ enum {
 };
 
 
+/*----------------------------------------------------------------------------
+| Regime decoding.  `tmp' holds the bits that follow the first regime bit,
+| left-aligned in the posit width (i.e. (uiA<<2) masked).  The regime run is
+| measured with a count-leading-zeros instead of a shift loop: `tmp' is
+| shifted past the run and its terminating bit (the MSB is left cleared, so
+| exponent and fraction start just below it), and the value is k for the run
+| (run length for a positive regime, -1-run for a negative one).
+*----------------------------------------------------------------------------*/
+#define softposit_decodeRegimeP8UI( regS, tmp ) ({\
+		uint_fast8_t regRun = softposit_countLeadingZeros32( ((uint32_t) (tmp)<<24) ^ -(uint32_t) (regS) );\
+		(tmp) = ((tmp)<<regRun) & 0x7F;\
+		(int_fast8_t) regRun ^ -(int_fast8_t) !(regS);\
+})
+
+#define softposit_decodeRegimeP16UI( regS, tmp ) ({\
+		uint_fast8_t regRun = softposit_countLeadingZeros32( ((uint32_t) (tmp)<<16) ^ -(uint32_t) (regS) );\
+		(tmp) = ((tmp)<<regRun) & 0x7FFF;\
+		(int_fast8_t) regRun ^ -(int_fast8_t) !(regS);\
+})
+
+#define softposit_decodeRegimeP32UI( regS, tmp ) ({\
+		uint_fast8_t regRun = softposit_countLeadingZeros32( (uint32_t) (tmp) ^ -(uint32_t) (regS) );\
+		(tmp) = ((tmp)<<regRun) & 0x7FFFFFFF;\
+		(int_fast8_t) regRun ^ -(int_fast8_t) !(regS);\
+})
+
+
 /*----------------------------------------------------------------------------
 *----------------------------------------------------------------------------*/
 #define signP8UI( a ) ((bool) ((uint8_t) (a)>>7))
@@ -113,6 +140,14 @@ posit_1_t softposit_addMagsPX1( uint_fast32_t, uint_fast32_t, int);
 posit_1_t softposit_subMagsPX1( uint_fast32_t, uint_fast32_t, int);
 posit_1_t softposit_mulAddPX1( uint_fast32_t, uint_fast32_t, uint_fast32_t, uint_fast32_t, int );
 
+/*----------------------------------------------------------------------------
+| Decode/encode of an x-bit posit with es exponent bits, left-aligned in 32
+| bits (the pX2 layout), to/from the unpacked form.
+*----------------------------------------------------------------------------*/
+
+posit_unpacked_t softposit_unpackPUI( uint_fast32_t, int, int );
+uint_fast32_t softposit_roundPackPU( posit_unpacked_t, int, int );
+
 /*uint_fast16_t reglengthP32UI (uint32_t);
 int_fast16_t regkP32UI(bool, uint_fast32_t);
 #define expP32UI( a, regA ) ((int_fast16_t) ((a>>(28-regA)) & 0x2))
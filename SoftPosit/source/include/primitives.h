@@ -49,4 +49,71 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern const uint_fast16_t softposit_approxRecipSqrt0[16];
 extern const uint_fast16_t softposit_approxRecipSqrt1[16];
 
+struct uint128 { uint64_t v64, v0; };
+
+/*----------------------------------------------------------------------------
+| Returns the number of leading 0 bits before the most-significant 1 bit of
+| `a'.  If `a' is zero, 32 is returned.
+*----------------------------------------------------------------------------*/
+static inline uint_fast8_t softposit_countLeadingZeros32( uint32_t a )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return a ? (uint_fast8_t) __builtin_clz( a ) : 32;
+#else
+    uint_fast8_t count = 0;
+    if ( ! a ) return 32;
+    if ( ! (a & 0xFFFF0000) ) { count += 16; a <<= 16; }
+    if ( ! (a & 0xFF000000) ) { count += 8; a <<= 8; }
+    if ( ! (a & 0xF0000000) ) { count += 4; a <<= 4; }
+    if ( ! (a & 0xC0000000) ) { count += 2; a <<= 2; }
+    if ( ! (a & 0x80000000) ) ++count;
+    return count;
+#endif
+}
+
+/*----------------------------------------------------------------------------
+| Returns the number of leading 0 bits before the most-significant 1 bit of
+| `a'.  If `a' is zero, 64 is returned.
+*----------------------------------------------------------------------------*/
+static inline uint_fast8_t softposit_countLeadingZeros64( uint64_t a )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return a ? (uint_fast8_t) __builtin_clzll( a ) : 64;
+#else
+    uint_fast8_t count = 0;
+    if ( ! a ) return 64;
+    if ( ! (a & 0xFFFFFFFF00000000ULL) ) { count += 32; a <<= 32; }
+    if ( ! (a & 0xFFFF000000000000ULL) ) { count += 16; a <<= 16; }
+    if ( ! (a & 0xFF00000000000000ULL) ) { count += 8; a <<= 8; }
+    if ( ! (a & 0xF000000000000000ULL) ) { count += 4; a <<= 4; }
+    if ( ! (a & 0xC000000000000000ULL) ) { count += 2; a <<= 2; }
+    if ( ! (a & 0x8000000000000000ULL) ) ++count;
+    return count;
+#endif
+}
+
+/*----------------------------------------------------------------------------
+| Returns the 128-bit product of `a' and `b'.
+*----------------------------------------------------------------------------*/
+static inline struct uint128 softposit_mul64To128( uint64_t a, uint64_t b )
+{
+    uint32_t a32, a0, b32, b0;
+    struct uint128 z;
+    uint64_t mid1, mid;
+
+    a32 = a>>32;
+    a0 = a;
+    b32 = b>>32;
+    b0 = b;
+    z.v0 = (uint_fast64_t) a0 * b0;
+    mid1 = (uint_fast64_t) a32 * b0;
+    mid = mid1 + (uint_fast64_t) a0 * b32;
+    z.v64 = (uint_fast64_t) a32 * b32;
+    z.v64 += (uint_fast64_t) (mid < mid1)<<32 | mid>>32;
+    mid <<= 32;
+    z.v0 += mid;
+    z.v64 += (z.v0 < mid);
+    return z;
+}
+
 #endif
@@ -622,6 +622,82 @@ static inline quire_1_t qX1Clr(){
 		uA.ui = ((uA.ui + mask) ^ mask)&0xFFFFFFFF;\
 		uA.p; \
 })
+/*----------------------------------------------------------------------------
+| Batch operations on arrays of raw posit bits (elementwise, n elements).
+*----------------------------------------------------------------------------*/
+void p8_add_batch( const uint8_t *, const uint8_t *, uint8_t *, size_t );
+void p8_sub_batch( const uint8_t *, const uint8_t *, uint8_t *, size_t );
+void p8_mul_batch( const uint8_t *, const uint8_t *, uint8_t *, size_t );
+void p8_div_batch( const uint8_t *, const uint8_t *, uint8_t *, size_t );
+void p8_sqrt_batch( const uint8_t *, uint8_t *, size_t );
+void convertDoubleToP8_batch( const double *, uint8_t *, size_t );
+void convertFloatToP8_batch( const float *, uint8_t *, size_t );
+void convertP8ToDouble_batch( const uint8_t *, double *, size_t );
+posit8_t p8_fdp_batch( const uint8_t *, const uint8_t *, size_t );
+
+void p16_add_batch( const uint16_t *, const uint16_t *, uint16_t *, size_t );
+void p16_sub_batch( const uint16_t *, const uint16_t *, uint16_t *, size_t );
+void p16_mul_batch( const uint16_t *, const uint16_t *, uint16_t *, size_t );
+void p16_div_batch( const uint16_t *, const uint16_t *, uint16_t *, size_t );
+void p16_sqrt_batch( const uint16_t *, uint16_t *, size_t );
+void convertDoubleToP16_batch( const double *, uint16_t *, size_t );
+void convertFloatToP16_batch( const float *, uint16_t *, size_t );
+void convertP16ToDouble_batch( const uint16_t *, double *, size_t );
+posit16_t p16_fdp_batch( const uint16_t *, const uint16_t *, size_t );
+
+void p32_add_batch( const uint32_t *, const uint32_t *, uint32_t *, size_t );
+void p32_sub_batch( const uint32_t *, const uint32_t *, uint32_t *, size_t );
+void p32_mul_batch( const uint32_t *, const uint32_t *, uint32_t *, size_t );
+void p32_div_batch( const uint32_t *, const uint32_t *, uint32_t *, size_t );
+void p32_sqrt_batch( const uint32_t *, uint32_t *, size_t );
+void convertDoubleToP32_batch( const double *, uint32_t *, size_t );
+void convertFloatToP32_batch( const float *, uint32_t *, size_t );
+void convertP32ToDouble_batch( const uint32_t *, double *, size_t );
+posit32_t p32_fdp_batch( const uint32_t *, const uint32_t *, size_t );
+
+/*----------------------------------------------------------------------------
+| Unpacked (decoded) posits.  Operations keep sign, scale and a 64-bit
+| significand so that chained expressions only round once, when packed back.
+*----------------------------------------------------------------------------*/
+
+posit_unpacked_t p8_to_pU( posit8_t );
+posit_unpacked_t p16_to_pU( posit16_t );
+posit_unpacked_t p32_to_pU( posit32_t );
+posit_unpacked_t pX2_to_pU( posit_2_t, int );
+
+posit8_t pU_to_p8( posit_unpacked_t );
+posit16_t pU_to_p16( posit_unpacked_t );
+posit32_t pU_to_p32( posit_unpacked_t );
+posit_2_t pU_to_pX2( posit_unpacked_t, int );
+
+posit_unpacked_t pU_add( posit_unpacked_t, posit_unpacked_t );
+posit_unpacked_t pU_sub( posit_unpacked_t, posit_unpacked_t );
+posit_unpacked_t pU_mul( posit_unpacked_t, posit_unpacked_t );
+posit_unpacked_t pU_mulAdd( posit_unpacked_t, posit_unpacked_t, posit_unpacked_t );
+
+#define isNaRPU( a ) ( (a).isNaR )
+#define isPUZero( a ) ( (a).isZero )
+
+#define negPU(a)({\
+		posit_unpacked_t uA = (a);\
+		if (!uA.isNaR && !uA.isZero) uA.sign = !uA.sign;\
+		uA; \
+})
+
+static inline posit_unpacked_t pUNaR(){
+	posit_unpacked_t uZ = { .sig = 0, .scale = 0, .sign = 0, .isNaR = 1, .isZero = 0 };
+	return uZ;
+}
+
+static inline posit_unpacked_t pUZero(){
+	posit_unpacked_t uZ = { .sig = 0, .scale = 0, .sign = 0, .isNaR = 0, .isZero = 1 };
+	return uZ;
+}
+
+//Helper
+double convertPUToDouble( posit_unpacked_t );
+posit_unpacked_t convertDoubleToPU( double );
+
 /*----------------------------------------------------------------------------
 | 64-bit (double-precision) floating-point operations.
 *----------------------------------------------------------------------------*/
@@ -1214,6 +1214,118 @@ struct quire_2{
 
 };
 
+// Decoded posit for hot loops: arithmetic stays unpacked and only rounds
+// when converted back with toPosit8/16/32 or toPositX2.
+struct posit_unpacked{
+	posit_unpacked_t value;
+
+	posit_unpacked(double x=0) : value(convertDoubleToPU(x)) {
+	}
+	posit_unpacked(const posit8 &a) : value(p8_to_pU(castP8(a.value))) {
+	}
+	posit_unpacked(const posit16 &a) : value(p16_to_pU(castP16(a.value))) {
+	}
+	posit_unpacked(const posit32 &a) : value(p32_to_pU(castP32(a.value))) {
+	}
+	posit_unpacked(const posit_2 &a) : value(pX2_to_pU(castPX2(a.value), a.x)) {
+	}
+
+	//Add
+	posit_unpacked operator+(const posit_unpacked &a) const{
+		posit_unpacked ans;
+		ans.value = pU_add(value, a.value);
+		return ans;
+	}
+
+	//Add equal
+	posit_unpacked& operator+=(const posit_unpacked &a) {
+		value = pU_add(value, a.value);
+		return *this;
+	}
+
+	//Subtract
+	posit_unpacked operator-(const posit_unpacked &a) const{
+		posit_unpacked ans;
+		ans.value = pU_sub(value, a.value);
+		return ans;
+	}
+
+	//Subtract equal
+	posit_unpacked& operator-=(const posit_unpacked &a) {
+		value = pU_sub(value, a.value);
+		return *this;
+	}
+
+	//Multiply
+	posit_unpacked operator*(const posit_unpacked &a) const{
+		posit_unpacked ans;
+		ans.value = pU_mul(value, a.value);
+		return ans;
+	}
+
+	//Multiply equal
+	posit_unpacked& operator*=(const posit_unpacked &a) {
+		value = pU_mul(value, a.value);
+		return *this;
+	}
+
+	//Negate
+	posit_unpacked operator-() const{
+		posit_unpacked ans;
+		ans.value = negPU(value);
+		return ans;
+	}
+
+	bool isNaR() const{
+		return isNaRPU(value);
+	}
+
+	bool isZero() const{
+		return isPUZero(value);
+	}
+
+	double toDouble()const{
+		return convertPUToDouble(value);
+	}
+
+	posit_unpacked fma(posit_unpacked a, posit_unpacked b){ // + (a*b)
+		posit_unpacked ans;
+		ans.value = pU_mulAdd(a.value, b.value, value);
+		return ans;
+	}
+
+	posit8 toPosit8() const{
+		posit8 ans;
+		ans.value = castUI(pU_to_p8(value));
+		return ans;
+	}
+
+	posit16 toPosit16() const{
+		posit16 ans;
+		ans.value = castUI(pU_to_p16(value));
+		return ans;
+	}
+
+	posit32 toPosit32() const{
+		posit32 ans;
+		ans.value = castUI(pU_to_p32(value));
+		return ans;
+	}
+
+	posit_2 toPositX2(int x) const{
+		posit_2 ans;
+		ans.value = castUI(pU_to_pX2(value, x));
+		ans.x = x;
+		return ans;
+	}
+
+	posit_unpacked& toNaR(){
+		value = pUNaR();
+		return *this;
+	}
+
+};
+
 inline posit8 operator+(int a, posit8 b){
 	b.value = castUI(p8_add(i32_to_p8(a), castP8(b.value)));
 	return b;
@@ -1417,6 +1529,11 @@ inline posit_2 fma(posit_2 a, posit_2 b, posit_2 c){ // (a*b) + c
 	ans.x = c.x;
 	return ans;
 }
+inline posit_unpacked fma(posit_unpacked a, posit_unpacked b, posit_unpacked c){ // (a*b) + c
+	posit_unpacked ans;
+	ans.value = pU_mulAdd(a.value, b.value, c.value);
+	return ans;
+}
 
 
 //Round to nearest integer
@@ -1751,6 +1868,18 @@ inline posit_2 pX2(quire_2 a, int x){
 	b.x = x;
 	return b;
 }
+inline posit8 p8(posit_unpacked a){
+	return a.toPosit8();
+}
+inline posit16 p16(posit_unpacked a){
+	return a.toPosit16();
+}
+inline posit32 p32(posit_unpacked a){
+	return a.toPosit32();
+}
+inline posit_2 pX2(posit_unpacked a, int x){
+	return a.toPositX2(x);
+}
 
 
 //cout helper functions
@@ -1775,6 +1904,11 @@ inline std::ostream& operator<<(std::ostream& os, const posit_2& p) {
     return os;
 }
 
+inline std::ostream& operator<<(std::ostream& os, const posit_unpacked& p) {
+    os << p.toDouble();
+    return os;
+}
+
 //Math lib
 
 /*inline posit8 abs(posit8 a){
@@ -1923,6 +2057,563 @@ inline posit32 acos(posit32 a){
 }*/
 
 
+#if __cplusplus >= 201103L
+
+#include <string.h>
+#include <type_traits>
+
+/*
+ * posit<N,ES>: posits of any width 2..32 and exponent size, with masks,
+ * shifts, regime limits and the quire size fixed at compile time.  Rounding
+ * follows the posit standard (round to nearest even on the bit string, no
+ * underflow to zero or overflow to NaR), so posit<x,2> gives the same bits as
+ * pX2_* for every x, and posit<8,0>, posit<16,1>, posit<32,2> the same bits
+ * as the p8_*, p16_*, p32_* routines.  The bits are kept right-aligned in
+ * `value' (pX2 left-aligns them in 32 bits).
+ */
+template <int N, int ES> struct posit;
+template <int N, int ES> struct quire;
+
+namespace softposit_detail {
+
+inline int clz32(uint32_t a){
+#if defined(__GNUC__) || defined(__clang__)
+	return a ? __builtin_clz(a) : 32;
+#else
+	int n = 0;
+	if (!a) return 32;
+	while (!(a & 0x80000000)) { a <<= 1; ++n; }
+	return n;
+#endif
+}
+
+inline int clz64(uint64_t a){
+	return (a >> 32) ? clz32((uint32_t) (a >> 32)) : 32 + clz32((uint32_t) a);
+}
+
+// (-1)^sign * sig * 2^(scale-63) with bit 63 of sig set; bit 0 is sticky.
+struct posit_fields{
+	uint64_t sig;
+	int scale;
+	bool sign;
+};
+
+template <int N, int ES> struct posit_traits{
+	static_assert(N >= 2 && N <= 32, "posit<N,ES> supports 2 <= N <= 32");
+	static_assert(ES >= 0 && ES <= 5, "posit<N,ES> supports 0 <= ES <= 5");
+
+	typedef typename std::conditional<(N <= 8), uint8_t,
+			typename std::conditional<(N <= 16), uint16_t, uint32_t>::type>::type storage;
+
+	static constexpr uint32_t mask = (N == 32) ? 0xFFFFFFFFu : ((1u << (N & 31)) - 1);
+	static constexpr uint32_t nar = 1u << (N - 1);
+	static constexpr uint32_t maxpos = nar - 1;
+	static constexpr uint32_t minpos = 1;
+	static constexpr int maxScale = (N - 2) << ES;	// log2(maxpos)
+
+	// Quire: 2*maxScale fraction bits, 2*maxScale+1 integer bits, sign and
+	// 31 carry-guard bits, rounded up to whole 64-bit words.
+	static constexpr int quireFracBits = 2 * maxScale;
+	static constexpr int quireWords = (4 * maxScale + 33 + 63) / 64;
+
+	static bool isNaR(uint32_t ui){ return ui == nar; }
+
+	// Two's complement magnitude of a nonzero, non-NaR posit.
+	static uint32_t magnitude(uint32_t ui){
+		return (ui & nar) ? ((0u - ui) & mask) : ui;
+	}
+
+	static posit_fields decode(uint32_t ui){
+		posit_fields f;
+		f.sign = (ui & nar) != 0;
+		uint32_t t = magnitude(ui) << (33 - N);	// regime starts at bit 31
+		bool regS = (t >> 31) != 0;
+		int run = clz32(regS ? ~t : t);
+		int k = regS ? run - 1 : -run;
+		uint64_t rest = ((uint64_t) t << 32) << (run + 1);
+		int exp = ES ? (int) (rest >> ((64 - ES) & 63)) : 0;
+		f.scale = k * (1 << ES) + exp;
+		f.sig = 0x8000000000000000ULL | ((rest << ES) >> 1);
+		return f;
+	}
+
+	static uint32_t encode(const posit_fields &f){
+		int k = (f.scale >= 0) ? (f.scale >> ES) : -((-f.scale - 1) >> ES) - 1;
+		uint32_t ui;
+		if (k >= N - 2){
+			ui = maxpos;
+		}
+		else if (k < -(N - 2)){
+			ui = minpos;
+		}
+		else{
+			int e = f.scale - k * (1 << ES);
+			int len = (k >= 0) ? k + 2 : 1 - k;
+			int avail = N - 1 - len;
+			uint32_t regime = (k >= 0) ? (((1u << (k + 1)) - 1) << 1) : 1u;
+			uint64_t frac = f.sig << 1;
+			uint64_t body = (ES ? ((uint64_t) e << ((64 - ES) & 63)) : 0) | (frac >> ES);
+			bool sticky = (frac & ((1ULL << ES) - 1)) != 0 || (body << avail << 1) != 0;
+			bool guard = ((body >> (63 - avail)) & 1) != 0;
+			ui = (regime << avail) | (avail ? (uint32_t) (body >> (64 - avail)) : 0);
+			if (guard && (sticky || (ui & 1))) ui++;
+		}
+		return f.sign ? ((0u - ui) & mask) : ui;
+	}
+
+	// x+y (both nonzero) in a 128-bit window, rounded only by a sticky bit;
+	// returns false if the sum is exactly zero.
+	static bool addFields(posit_fields x, posit_fields y, posit_fields &z){
+		if (y.scale > x.scale || (y.scale == x.scale && y.sig > x.sig)){
+			posit_fields t = x; x = y; y = t;
+		}
+		int d = x.scale - y.scale;
+		uint64_t xh = x.sig >> 1, xl = x.sig << 63;
+		uint64_t yh = y.sig >> 1, yl = y.sig << 63;
+		bool sticky = false;
+		if (d >= 128){
+			sticky = true;
+			yh = yl = 0;
+		}
+		else if (d >= 64){
+			sticky = yl != 0 || (d > 64 && (yh << (128 - d)) != 0);
+			yl = (d == 64) ? yh : (yh >> (d - 64));
+			yh = 0;
+		}
+		else if (d > 0){
+			sticky = (yl << (64 - d)) != 0;
+			yl = (yl >> d) | (yh << (64 - d));
+			yh >>= d;
+		}
+		yl |= sticky;
+		uint64_t zh, zl;
+		if (x.sign == y.sign){
+			zl = xl + yl;
+			zh = xh + yh + (zl < xl);
+		}
+		else{
+			zl = xl - yl;
+			zh = xh - yh - (xl < yl);
+		}
+		if (!zh && !zl) return false;
+		int lz = zh ? clz64(zh) : 64 + clz64(zl);
+		if (lz >= 64){
+			zh = zl << (lz - 64);
+			zl = 0;
+		}
+		else if (lz > 0){
+			zh = (zh << lz) | (zl >> (64 - lz));
+			zl <<= lz;
+		}
+		z.sig = zh | (zl != 0);
+		z.scale = x.scale + 1 - lz;
+		z.sign = x.sign;
+		return true;
+	}
+
+	static posit_fields mulFields(const posit_fields &a, const posit_fields &b){
+		posit_fields z;
+		uint64_t p = (a.sig >> 32) * (b.sig >> 32);
+		int lz = (int) (p >> 63) ^ 1;
+		z.sig = p << lz;
+		z.scale = a.scale + b.scale + 1 - lz;
+		z.sign = a.sign != b.sign;
+		return z;
+	}
+
+	static uint32_t fromUInt64(uint64_t u, bool sign){
+		if (!u) return 0;
+		posit_fields f;
+		int lz = clz64(u);
+		f.sig = u << lz;
+		f.scale = 63 - lz;
+		f.sign = sign;
+		return encode(f);
+	}
+
+	static uint32_t fromDouble(double d){
+		uint64_t u;
+		memcpy(&u, &d, sizeof(u));
+		int exp = (int) ((u >> 52) & 0x7FF);
+		uint64_t frac = u & 0x000FFFFFFFFFFFFFULL;
+		if (exp == 0x7FF) return nar;
+		if (!exp && !frac) return 0;
+		posit_fields f;
+		f.sign = (u >> 63) != 0;
+		if (exp){
+			f.sig = 0x8000000000000000ULL | (frac << 11);
+			f.scale = exp - 1023;
+		}
+		else{
+			int lz = clz64(frac);
+			f.sig = frac << lz;
+			f.scale = -1011 - lz;
+		}
+		return encode(f);
+	}
+
+	static double toDouble(uint32_t ui){
+		if (!ui) return 0;
+		if (isNaR(ui)) return NAN;
+		posit_fields f = decode(ui);
+		double d = ldexp((double) (f.sig >> 32), f.scale - 31);
+		return f.sign ? -d : d;
+	}
+
+	// Integer part of |value|, rounded to nearest even when `round' is set;
+	// saturates at 2^63.
+	static uint64_t toUInt64(const posit_fields &f, bool round){
+		if (f.scale >= 63) return 0x8000000000000000ULL;
+		if (f.scale < -1) return 0;
+		int shift = 63 - f.scale;
+		uint64_t i = (shift >= 64) ? 0 : (f.sig >> shift);
+		if (round){
+			uint64_t rem = (shift >= 64) ? f.sig : (f.sig << (64 - shift));
+			if ((rem >> 63) && ((rem << 1) || (i & 1))) i++;
+		}
+		return i;
+	}
+};
+
+} // namespace softposit_detail
+
+template <int N, int ES> struct posit{
+	typedef softposit_detail::posit_traits<N, ES> traits;
+	typedef typename traits::storage storage;
+
+	storage value;
+
+	posit(double x=0) : value((storage) traits::fromDouble(x)) {
+	}
+
+	static posit fromBits(uint32_t bits){
+		posit ans;
+		ans.value = (storage) (bits & traits::mask);
+		return ans;
+	}
+
+	// Correctly rounded conversion between posit formats.
+	template <int M, int EM> explicit posit(const posit<M, EM> &a){
+		typedef softposit_detail::posit_traits<M, EM> from;
+		if (!a.value) value = 0;
+		else if (from::isNaR(a.value)) value = (storage) traits::nar;
+		else value = (storage) traits::encode(from::decode(a.value));
+	}
+
+	//Equal
+	posit& operator=(const double a) {
+		value = (storage) traits::fromDouble(a);
+		return *this;
+	}
+	posit& operator=(const int a) {
+		value = (storage) traits::fromUInt64(a < 0 ? 0 - (uint64_t) a : (uint64_t) a, a < 0);
+		return *this;
+	}
+
+	//Add
+	posit operator+(const posit &a) const{
+		return fromBits(add(value, a.value));
+	}
+
+	//Add equal
+	posit& operator+=(const posit &a) {
+		value = (storage) add(value, a.value);
+		return *this;
+	}
+
+	//Subtract
+	posit operator-(const posit &a) const{
+		return fromBits(add(value, (0u - a.value) & traits::mask));
+	}
+
+	//Subtract equal
+	posit& operator-=(const posit &a) {
+		value = (storage) add(value, (0u - a.value) & traits::mask);
+		return *this;
+	}
+
+	//Multiply
+	posit operator*(const posit &a) const{
+		return fromBits(mul(value, a.value));
+	}
+
+	//Multiply equal
+	posit& operator*=(const posit &a) {
+		value = (storage) mul(value, a.value);
+		return *this;
+	}
+
+	//Divide
+	posit operator/(const posit &a) const{
+		return fromBits(div(value, a.value));
+	}
+
+	//Divide equal
+	posit& operator/=(const posit &a) {
+		value = (storage) div(value, a.value);
+		return *this;
+	}
+
+	//Comparisons: posits order as two's complement integers, NaR lowest.
+	bool operator<(const posit &a) const{
+		return toSigned(value) < toSigned(a.value);
+	}
+
+	bool operator<=(const posit &a) const{
+		return toSigned(value) <= toSigned(a.value);
+	}
+
+	bool operator==(const posit &a) const{
+		return value == a.value;
+	}
+
+	bool operator!=(const posit &a) const{
+		return value != a.value;
+	}
+
+	bool operator>(const posit &a) const{
+		return toSigned(value) > toSigned(a.value);
+	}
+
+	bool operator>=(const posit &a) const{
+		return toSigned(value) >= toSigned(a.value);
+	}
+
+	//Negate
+	posit operator-() const{
+		return fromBits((0u - value) & traits::mask);
+	}
+
+	bool isNaR() const{
+		return traits::isNaR(value);
+	}
+
+	bool isZero() const{
+		return value == 0;
+	}
+
+	double toDouble()const{
+		return traits::toDouble(value);
+	}
+
+	long long int toInt()const{
+		return toInt64(false);
+	}
+
+	long long int toRInt()const{
+		return toInt64(true);
+	}
+
+	posit& sqrt(){
+		value = (storage) sqrtBits(value);
+		return *this;
+	}
+
+	posit& rint(){
+		if (value && !traits::isNaR(value)){
+			softposit_detail::posit_fields f = traits::decode(value);
+			value = (storage) traits::fromUInt64(traits::toUInt64(f, true), f.sign);
+		}
+		return *this;
+	}
+
+	posit fma(posit a, posit b) const{ // + (a*b)
+		return fromBits(mulAdd(a.value, b.value, value));
+	}
+
+	posit& toNaR(){
+		value = (storage) traits::nar;
+		return *this;
+	}
+
+	static uint32_t add(uint32_t a, uint32_t b){
+		if (traits::isNaR(a) || traits::isNaR(b)) return traits::nar;
+		if (!a) return b;
+		if (!b) return a;
+		softposit_detail::posit_fields z;
+		if (!traits::addFields(traits::decode(a), traits::decode(b), z)) return 0;
+		return traits::encode(z);
+	}
+
+	static uint32_t mul(uint32_t a, uint32_t b){
+		if (traits::isNaR(a) || traits::isNaR(b)) return traits::nar;
+		if (!a || !b) return 0;
+		return traits::encode(traits::mulFields(traits::decode(a), traits::decode(b)));
+	}
+
+	static uint32_t div(uint32_t a, uint32_t b){
+		if (traits::isNaR(a) || traits::isNaR(b) || !b) return traits::nar;
+		if (!a) return 0;
+		softposit_detail::posit_fields x = traits::decode(a), y = traits::decode(b), z;
+		uint64_t num = x.sig & 0xFFFFFFFF00000000ULL, den = y.sig >> 32;
+		uint64_t q = num / den;
+		int lz = softposit_detail::clz64(q);
+		z.sig = (q << lz) | (num % den != 0);
+		z.scale = x.scale - y.scale + 31 - lz;
+		z.sign = x.sign != y.sign;
+		return traits::encode(z);
+	}
+
+	static uint32_t sqrtBits(uint32_t a){
+		if (a & traits::nar) return traits::nar;
+		if (!a) return 0;
+		softposit_detail::posit_fields x = traits::decode(a), z;
+		// Radicand x.sig>>32 << (31 or 32) so that the remaining exponent is even.
+		int shift = ((x.scale - 31) & 1) ? 31 : 32;
+		uint64_t rad = (x.sig >> 32) << shift;
+		uint64_t r = (uint64_t) ::sqrt((double) rad);
+		if (r > 0xFFFFFFFFULL) r = 0xFFFFFFFFULL;
+		while (r * r > rad) r--;
+		while (r < 0xFFFFFFFFULL && (r + 1) * (r + 1) <= rad) r++;
+		z.sig = (r << 32) | (r * r != rad);
+		z.scale = (x.scale - 31 - shift) / 2 + 31;
+		z.sign = false;
+		return traits::encode(z);
+	}
+
+	// a*b + c with a single rounding.
+	static uint32_t mulAdd(uint32_t a, uint32_t b, uint32_t c){
+		if (traits::isNaR(a) || traits::isNaR(b) || traits::isNaR(c)) return traits::nar;
+		if (!a || !b) return c;
+		softposit_detail::posit_fields p = traits::mulFields(traits::decode(a), traits::decode(b)), z;
+		if (!c) return traits::encode(p);
+		if (!traits::addFields(p, traits::decode(c), z)) return 0;
+		return traits::encode(z);
+	}
+
+private:
+	static int32_t toSigned(uint32_t ui){
+		return (int32_t) (ui << (32 - N));
+	}
+
+	long long int toInt64(bool round) const{
+		if (!value) return 0;
+		if (traits::isNaR(value)) return (long long int) 0x8000000000000000ULL;
+		softposit_detail::posit_fields f = traits::decode(value);
+		uint64_t i = traits::toUInt64(f, round);
+		if (i > 0x7FFFFFFFFFFFFFFFULL) i = 0x7FFFFFFFFFFFFFFFULL;
+		return f.sign ? -(long long int) i : (long long int) i;
+	}
+};
+
+template <int N, int ES> struct quire{
+	typedef softposit_detail::posit_traits<N, ES> traits;
+	static constexpr int words = traits::quireWords;
+
+	uint64_t v[words];	// v[0] is the most significant word
+
+	quire(){
+		clr();
+	}
+
+	quire& clr(){
+		for (int i = 0; i < words; i++) v[i] = 0;
+		return *this;
+	}
+
+	bool isNaR() const{
+		if (v[0] != 0x8000000000000000ULL) return false;
+		for (int i = 1; i < words; i++) if (v[i]) return false;
+		return true;
+	}
+
+	quire& toNaR(){
+		clr();
+		v[0] = 0x8000000000000000ULL;
+		return *this;
+	}
+
+	quire& qma(posit<N, ES> a, posit<N, ES> b){ // q += a*b
+		return accumulate(a.value, b.value, false);
+	}
+
+	quire& qms(posit<N, ES> a, posit<N, ES> b){ // q -= a*b
+		return accumulate(a.value, b.value, true);
+	}
+
+	posit<N, ES> toPosit() const{
+		if (isNaR()) return posit<N, ES>::fromBits(traits::nar);
+		uint64_t m[words];
+		bool sign = (v[0] >> 63) != 0;
+		uint64_t borrow = 1;
+		for (int i = words - 1; i >= 0; i--){
+			m[i] = sign ? ~v[i] + borrow : v[i];
+			if (sign) borrow = borrow && !m[i];
+		}
+		int top = 0;
+		while (top < words && !m[top]) top++;
+		if (top == words) return posit<N, ES>::fromBits(0);
+		int lz = softposit_detail::clz64(m[top]);
+		softposit_detail::posit_fields f;
+		f.sig = m[top] << lz;
+		if (top + 1 < words && lz) f.sig |= m[top + 1] >> (64 - lz);
+		bool sticky = top + 1 < words && (m[top + 1] << lz) != 0;
+		for (int i = top + 2; i < words && !sticky; i++) sticky = m[i] != 0;
+		f.sig |= sticky;
+		f.scale = (words - 1 - top) * 64 + 63 - lz - traits::quireFracBits;
+		f.sign = sign;
+		return posit<N, ES>::fromBits(traits::encode(f));
+	}
+
+private:
+	quire& accumulate(uint32_t a, uint32_t b, bool subtract){
+		if (isNaR()) return *this;
+		if (traits::isNaR(a) || traits::isNaR(b)) return toNaR();
+		if (!a || !b) return *this;
+		softposit_detail::posit_fields p = traits::mulFields(traits::decode(a), traits::decode(b));
+		// p.sig has at most 62 significant bits and none below minpos^2.
+		int pos = p.scale - 63 + traits::quireFracBits;
+		uint64_t sig = p.sig;
+		if (pos < 0){
+			sig >>= -pos;
+			pos = 0;
+		}
+		int word = words - 1 - pos / 64, bit = pos % 64;
+		uint64_t lo = sig << bit, hi = bit ? sig >> (64 - bit) : 0;
+		if (subtract != p.sign){
+			uint64_t borrow = 0;
+			for (int i = word; i >= 0; i--){
+				uint64_t s = (i == word) ? lo : (i == word - 1) ? hi : 0;
+				uint64_t d = v[i] - s - borrow;
+				borrow = (v[i] < s) || (v[i] - s < borrow);
+				v[i] = d;
+				if (i < word - 1 && !borrow) break;
+			}
+		}
+		else{
+			uint64_t carry = 0;
+			for (int i = word; i >= 0; i--){
+				uint64_t s = (i == word) ? lo : (i == word - 1) ? hi : 0;
+				uint64_t t = v[i] + s;
+				uint64_t c = t < s;
+				v[i] = t + carry;
+				carry = c || (v[i] < carry);
+				if (i < word - 1 && !carry) break;
+			}
+		}
+		return *this;
+	}
+};
+
+template <int N, int ES> inline posit<N, ES> fma(posit<N, ES> a, posit<N, ES> b, posit<N, ES> c){ // (a*b) + c
+	return posit<N, ES>::fromBits(posit<N, ES>::mulAdd(a.value, b.value, c.value));
+}
+
+template <int N, int ES> inline posit<N, ES> sqrt(posit<N, ES> a){
+	return posit<N, ES>::fromBits(posit<N, ES>::sqrtBits(a.value));
+}
+
+template <int N, int ES> inline posit<N, ES> abs(posit<N, ES> a){
+	return (a.value & posit<N, ES>::traits::nar) ? -a : a;
+}
+
+template <int N, int ES> inline std::ostream& operator<<(std::ostream& os, const posit<N, ES>& p) {
+    os << p.toDouble();
+    return os;
+}
+
+#endif //C++11
+
 #endif //CPLUSPLUS
 
 #endif /* INCLUDE_SOFTPOSIT_CPP_H_ */
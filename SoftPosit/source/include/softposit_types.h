@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef softposit_types_h
 #define softposit_types_h 1
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /*----------------------------------------------------------------------------
@@ -80,6 +81,19 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 	typedef struct { uint64_t v[8]; } quire_1_t;
 	typedef struct { uint64_t v[8]; } quire_0_t;
 
+	/*------------------------------------------------------------------------
+	| Decoded posit: (-1)^sign * sig * 2^(scale-63), sig normalised so that
+	| bit 63 is set.  Bit 0 of sig is sticky (jammed) so that rounding back to
+	| a packed posit is correct.
+	*------------------------------------------------------------------------*/
+	typedef struct {
+		uint64_t sig;
+		int32_t scale;
+		bool sign;
+		bool isNaR;
+		bool isZero;
+	} posit_unpacked_t;
+
 #endif
 
 
@@ -89,41 +89,14 @@ posit16_t p16_div( posit16_t pA, posit16_t pB ) {
 	regSB = signregP16UI(uiB);
 
 	tmp = (uiA<<2) & 0xFFFF;
-	if (regSA){
-		while (tmp>>15){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>15)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	kA += softposit_decodeRegimeP16UI( regSA, tmp );
 	expA = tmp>>14;
 	fracA = (0x4000 | tmp);
 	frac32A = fracA<<14;
 
 	tmp = (uiB<<2) & 0xFFFF;
-	if (regSB){
-		while (tmp>>15){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		fracB = (0x4000 | tmp);
-	}
-	else{
-		kA++;
-		while (!(tmp>>15)){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-		fracB = (0x4000 | (0x7FFF & tmp));
-	}
+	kA -= softposit_decodeRegimeP16UI( regSB, tmp );
+	fracB = (0x4000 | tmp);
 	expA -= tmp>>14;
 
 	divresult = div (frac32A,fracB);
@@ -80,38 +80,12 @@ posit16_t p16_mul( posit16_t pA, posit16_t pB ){
 	regSB = signregP16UI(uiB);
 
 	tmp = (uiA<<2) & 0xFFFF;
-	if (regSA){
-		while (tmp>>15){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>15)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	kA += softposit_decodeRegimeP16UI( regSA, tmp );
 	expA = tmp>>14;
 	fracA = (0x4000 | tmp);
 
 	tmp = (uiB<<2) & 0xFFFF;
-	if (regSB){
-		while (tmp>>15){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		kA--;
-		while (!(tmp>>15)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	kA += softposit_decodeRegimeP16UI( regSB, tmp );
 	expA += tmp>>14;
 	frac32Z = (uint_fast32_t) fracA * (0x4000 | tmp);
 
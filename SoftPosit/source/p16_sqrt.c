@@ -51,7 +51,7 @@ posit16_t p16_sqrt( posit16_t pA ) {
     uint_fast16_t expA, fracA, index, r0, shift, sigma0, uiA, uiZ;
     uint_fast32_t eSqrR0, fracZ, negRem, recipSqrt, shiftedFracZ;
     int_fast16_t kZ;
-    bool bitNPlusOne;
+    bool bitNPlusOne, regS;
 
     uA.p = pA;
     uiA = uA.ui;
@@ -68,21 +68,10 @@ posit16_t p16_sqrt( posit16_t pA ) {
     }
     // Compute the square root. Here, kZ is the net power-of-2 scaling of the result.
     // Decode the regime and exponent bit; scale the input to be in the range 1 to 4:
-	if (uiA >> 14) {
-		kZ = -1;
-		while (uiA & 0x4000) {
-			kZ++;
-			uiA= (uiA<<1) & 0xFFFF;
-		}
-	}
-	else {
-		kZ = 0;
-		while (!(uiA & 0x4000)) {
-			kZ--;
-			uiA= (uiA<<1) & 0xFFFF;
-		}
-
-	}
+	regS = uiA >> 14;
+	uiA = (uiA<<2) & 0xFFFF;
+	kZ = softposit_decodeRegimeP16UI( regS, uiA );
+	uiA >>= 1;
 	uiA &= 0x3fff;
 	expA = 1 - (uiA >> 13);
 	fracA = (uiA | 0x2000) >> 1;
@@ -63,20 +63,7 @@ posit32_t p16_to_p32( posit16_t pA ) {
 	regSA = signregP16UI(uiA);
 
 	tmp = (uiA<<2) & 0xFFFF;
-	if (regSA){
-		while (tmp>>15){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>15)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	kA += softposit_decodeRegimeP16UI( regSA, tmp );
 	exp_frac32A = (uint32_t) tmp<<16;
 
 
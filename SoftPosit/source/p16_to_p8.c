@@ -63,20 +63,7 @@ posit8_t p16_to_p8( posit16_t pA ) {
 	regSA = signregP16UI(uiA);
 
 	tmp = (uiA<<2) & 0xFFFF;
-	if (regSA){
-		while (tmp>>15){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>15)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	kA += softposit_decodeRegimeP16UI( regSA, tmp );
 
 	if (kA<-3 || kA>=3){
 		(kA<0) ? (uZ.ui=0x1):(uZ.ui= 0x7F);
@@ -73,20 +73,7 @@ posit_2_t p16_to_pX2( posit16_t pA, int x ) {
 		regSA = signregP16UI(uiA);
 
 		tmp = (uiA<<2) & 0xFFFF;
-		if (regSA){
-			while (tmp>>15){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>15)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFF;
-			}
-			tmp&=0x7FFF;
-		}
+		kA += softposit_decodeRegimeP16UI( regSA, tmp );
 		exp_frac32A = (uint32_t) tmp<<16;
 
 		if(kA<0){
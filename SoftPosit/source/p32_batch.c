@@ -0,0 +1,122 @@
+
+/*============================================================================
+
+This C source file is part of the SoftPosit Posit Arithmetic Package
+by S. H. Leong (Cerlane).
+
+Copyright 2017 2018 A*STAR.  All rights reserved.
+
+This C source file was based on SoftFloat IEEE Floating-Point Arithmetic
+Package, Release 3d, by John R. Hauser.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions, and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions, and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+ 3. Neither the name of the University nor the names of its contributors may
+    be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS "AS IS", AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE, ARE
+DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+=============================================================================*/
+
+#include "platform.h"
+#include "internals.h"
+
+/*----------------------------------------------------------------------------
+| Elementwise operations on arrays of raw posit32 bits.  Input and output
+| arrays may alias.
+*----------------------------------------------------------------------------*/
+
+void p32_add_batch( const uint32_t *uiA, const uint32_t *uiB, uint32_t *uiZ, size_t n ){
+
+	size_t i;
+
+	for (i=0; i<n; i++)
+		uiZ[i] = castUI( p32_add( castP32(uiA[i]), castP32(uiB[i]) ) );
+}
+
+void p32_sub_batch( const uint32_t *uiA, const uint32_t *uiB, uint32_t *uiZ, size_t n ){
+
+	size_t i;
+
+	for (i=0; i<n; i++)
+		uiZ[i] = castUI( p32_sub( castP32(uiA[i]), castP32(uiB[i]) ) );
+}
+
+void p32_mul_batch( const uint32_t *uiA, const uint32_t *uiB, uint32_t *uiZ, size_t n ){
+
+	size_t i;
+
+	for (i=0; i<n; i++)
+		uiZ[i] = castUI( p32_mul( castP32(uiA[i]), castP32(uiB[i]) ) );
+}
+
+void p32_div_batch( const uint32_t *uiA, const uint32_t *uiB, uint32_t *uiZ, size_t n ){
+
+	size_t i;
+
+	for (i=0; i<n; i++)
+		uiZ[i] = castUI( p32_div( castP32(uiA[i]), castP32(uiB[i]) ) );
+}
+
+void p32_sqrt_batch( const uint32_t *uiA, uint32_t *uiZ, size_t n ){
+
+	size_t i;
+
+	for (i=0; i<n; i++)
+		uiZ[i] = castUI( p32_sqrt( castP32(uiA[i]) ) );
+}
+
+void convertDoubleToP32_batch( const double *a, uint32_t *uiZ, size_t n ){
+
+	size_t i;
+
+	for (i=0; i<n; i++)
+		uiZ[i] = castUI( convertDoubleToP32( a[i] ) );
+}
+
+void convertFloatToP32_batch( const float *a, uint32_t *uiZ, size_t n ){
+
+	size_t i;
+
+	for (i=0; i<n; i++)
+		uiZ[i] = castUI( convertFloatToP32( a[i] ) );
+}
+
+void convertP32ToDouble_batch( const uint32_t *uiA, double *z, size_t n ){
+
+	size_t i;
+
+	for (i=0; i<n; i++)
+		z[i] = convertP32ToDouble( castP32(uiA[i]) );
+}
+
+/*----------------------------------------------------------------------------
+| Dot product of two arrays accumulated exactly in a quire32, rounded once.
+*----------------------------------------------------------------------------*/
+posit32_t p32_fdp_batch( const uint32_t *uiA, const uint32_t *uiB, size_t n ){
+
+	quire32_t qZ = q32Clr();
+	size_t i;
+
+	for (i=0; i<n; i++)
+		qZ = q32_fdp_add( qZ, castP32(uiA[i]), castP32(uiB[i]) );
+	return q32_to_p32( qZ );
+}
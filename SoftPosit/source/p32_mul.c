@@ -98,40 +98,12 @@ posit32_t p32_mul( posit32_t pA, posit32_t pB ){
 	regSB = signregP32UI(uiB);
 
 	tmp = (uiA<<2)&0xFFFFFFFF;
-	if (regSA){
-
-		while (tmp>>31){
-
-			kA++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>31)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-	}
+	kA += softposit_decodeRegimeP32UI( regSA, tmp );
 	expA = tmp>>29; //to get 2 bits
 	fracA = ((tmp<<1) | 0x40000000) & 0x7FFFFFFF;
 
 	tmp = (uiB<<2)&0xFFFFFFFF;
-	if (regSB){
-		while (tmp>>31){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-	}
-	else{
-		kA--;
-		while (!(tmp>>31)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-	}
+	kA += softposit_decodeRegimeP32UI( regSB, tmp );
 	expA += tmp>>29;
 	frac64Z = (uint_fast64_t) fracA * (((tmp<<1) | 0x40000000) & 0x7FFFFFFF);
 
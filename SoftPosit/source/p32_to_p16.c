@@ -71,24 +71,9 @@ posit16_t p32_to_p16( posit32_t pA ){
 
 		//regime
 		tmp = (uiA<<2)&0xFFFFFFFF;
-		if (regSA){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 		//exp and frac
 		exp_frac32A = tmp<<1;
-printBinary(&exp_frac32A, 32);
-printf("kA: %d\n", kA);
 		if(kA<0){
 			regA = (-kA)<<1;
 			if (exp_frac32A&0x80000000) regA--;
@@ -71,20 +71,7 @@ posit8_t p32_to_p8( posit32_t pA ){
 		regSA = signregP32UI(uiA);
 		//regime
 		tmp = (uiA<<2)&0xFFFFFFFF;
-		if (regSA){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 
 		//2nd and 3rd bit exp
 		exp_frac32A = tmp;
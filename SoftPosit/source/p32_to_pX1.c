@@ -72,20 +72,7 @@ posit_1_t p32_to_pX1( posit32_t pA, int x ){
     	regSA = signregP32UI(uiA);
 
     	tmp = (uiA<<2)&0xFFFFFFFF;
-		if (regSA){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 		//exp and frac
 		exp_frac32A = tmp<<1;
 //printf("kA: %d\n", kA);
@@ -83,40 +83,13 @@ posit8_t p8_div( posit8_t pA, posit8_t pB ) {
 	regSB = signregP8UI(uiB);
 
 	tmp = (uiA<<2) & 0xFF;
-	if (regSA){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSA, tmp );
 	fracA = (0x80 | tmp);
 	frac16A = fracA<<7; //hidden bit 2nd bit
 
 	tmp = (uiB<<2) & 0xFF;
-	if (regSB){
-		while (tmp>>7){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		fracB = (0x80 | tmp);
-	}
-	else{
-		kA++;
-		while (!(tmp>>7)){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-		fracB = (0x80 | (0x7F & tmp));
-	}
+	kA -= softposit_decodeRegimeP8UI( regSB, tmp );
+	fracB = (0x80 | tmp);
 
 	divresult = div (frac16A,fracB);
 	frac16Z = divresult.quot;
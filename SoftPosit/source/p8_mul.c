@@ -89,37 +89,11 @@ posit8_t p8_mul( posit8_t pA, posit8_t pB ){
 	regSB = signregP8UI(uiB);
 
 	tmp = (uiA<<2) & 0xFF;
-	if (regSA){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSA, tmp );
 	fracA = (0x80 | tmp);
 
 	tmp = (uiB<<2) & 0xFF;
-	if (regSB){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA--;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSB, tmp );
 	frac16Z = (uint_fast16_t) fracA * (0x80 | tmp);
 
 	rcarry = frac16Z>>15;//1st bit of frac32Z
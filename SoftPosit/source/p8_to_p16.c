@@ -64,20 +64,7 @@ posit16_t p8_to_p16( posit8_t pA ) {
 	regSA = signregP8UI(uiA);
 
 	tmp = (uiA<<2) & 0xFF;
-	if (regSA){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSA, tmp );
 	exp_frac16A = tmp<<8;
 
 	if(kA<0){
@@ -72,20 +72,7 @@ posit_1_t p8_to_pX1( posit8_t pA, int x ) {
 		regSA = signregP8UI(uiA);
 
 		tmp = (uiA<<2) & 0xFF;
-		if (regSA){
-			while (tmp>>7){
-				kA++;
-				tmp= (tmp<<1) & 0xFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>7)){
-				kA--;
-				tmp= (tmp<<1) & 0xFF;
-			}
-			tmp&=0x7F;
-		}
+		kA += softposit_decodeRegimeP8UI( regSA, tmp );
 		exp_frac32A = tmp<<24;
 
 		if(kA<0){
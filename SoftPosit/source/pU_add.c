@@ -0,0 +1,114 @@
+
+/*============================================================================
+
+This C source file is part of the SoftPosit Posit Arithmetic Package
+by S. H. Leong (Cerlane).
+
+Copyright 2017 2018 A*STAR.  All rights reserved.
+
+This C source file was based on SoftFloat IEEE Floating-Point Arithmetic
+Package, Release 3d, by John R. Hauser.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions, and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions, and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+ 3. Neither the name of the University nor the names of its contributors may
+    be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS "AS IS", AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE, ARE
+DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+=============================================================================*/
+
+#include "platform.h"
+#include "internals.h"
+
+posit_unpacked_t pU_add( posit_unpacked_t uA, posit_unpacked_t uB ){
+
+	posit_unpacked_t uZ, uTmp;
+	uint_fast64_t sigZ, sigZLo, sigBHi, sigBLo;
+	int_fast32_t shiftRight;
+	int_fast8_t shiftLeft;
+
+	if (uA.isNaR || uB.isNaR) return pUNaR();
+	if (uA.isZero) return uB;
+	if (uB.isZero) return uA;
+
+	//|uA| >= |uB|
+	if (uA.scale<uB.scale || (uA.scale==uB.scale && uA.sig<uB.sig)){
+		uTmp = uA;
+		uA = uB;
+		uB = uTmp;
+	}
+
+	//align uB on a 128-bit window below uA, nothing is lost before 128 bits
+	shiftRight = uA.scale - uB.scale;
+	if (shiftRight==0){
+		sigBHi = uB.sig;
+		sigBLo = 0;
+	}
+	else if (shiftRight<64){
+		sigBHi = uB.sig >> shiftRight;
+		sigBLo = uB.sig << (64-shiftRight);
+	}
+	else if (shiftRight<128){
+		sigBHi = 0;
+		sigBLo = uB.sig >> (shiftRight-64);
+		if (uB.sig << (128-shiftRight)) sigBLo |= 1;
+	}
+	else{
+		sigBHi = 0;
+		sigBLo = 1;
+	}
+
+	uZ.sign = uA.sign;
+	uZ.scale = uA.scale;
+	uZ.isNaR = 0;
+	uZ.isZero = 0;
+
+	if (uA.sign==uB.sign){
+		sigZLo = sigBLo;
+		sigZ = uA.sig + sigBHi;
+		if (sigZ<uA.sig){
+			//carry out
+			sigZLo = (sigZLo>>1) | (sigZLo&1) | (sigZ<<63);
+			sigZ = (sigZ>>1) | 0x8000000000000000ULL;
+			uZ.scale++;
+		}
+	}
+	else{
+		sigZLo = -sigBLo;
+		sigZ = uA.sig - sigBHi - (sigBLo!=0);
+		if (sigZ==0 && sigZLo==0) return pUZero();
+		if (sigZ==0){
+			sigZ = sigZLo;
+			sigZLo = 0;
+			uZ.scale -= 64;
+		}
+		shiftLeft = softposit_countLeadingZeros64( sigZ );
+		if (shiftLeft){
+			sigZ = (sigZ<<shiftLeft) | (sigZLo>>(64-shiftLeft));
+			sigZLo <<= shiftLeft;
+			uZ.scale -= shiftLeft;
+		}
+	}
+	uZ.sig = sigZ | (sigZLo!=0);
+
+	return uZ;
+}
@@ -0,0 +1,67 @@
+
+/*============================================================================
+
+This C source file is part of the SoftPosit Posit Arithmetic Package
+by S. H. Leong (Cerlane).
+
+Copyright 2017 2018 A*STAR.  All rights reserved.
+
+This C source file was based on SoftFloat IEEE Floating-Point Arithmetic
+Package, Release 3d, by John R. Hauser.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions, and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions, and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+ 3. Neither the name of the University nor the names of its contributors may
+    be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS "AS IS", AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE, ARE
+DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+=============================================================================*/
+
+#include "platform.h"
+#include "internals.h"
+
+posit_unpacked_t pU_mul( posit_unpacked_t uA, posit_unpacked_t uB ){
+
+	posit_unpacked_t uZ;
+	struct uint128 sig128Z;
+
+	if (uA.isNaR || uB.isNaR) return pUNaR();
+	if (uA.isZero || uB.isZero) return pUZero();
+
+	uZ.sign = uA.sign ^ uB.sign;
+	uZ.scale = uA.scale + uB.scale;
+	uZ.isNaR = 0;
+	uZ.isZero = 0;
+
+	//product is in [2^126, 2^128)
+	sig128Z = softposit_mul64To128( uA.sig, uB.sig );
+	if (sig128Z.v64>>63){
+		uZ.scale++;
+	}
+	else{
+		sig128Z.v64 = (sig128Z.v64<<1) | (sig128Z.v0>>63);
+		sig128Z.v0 <<= 1;
+	}
+	uZ.sig = sig128Z.v64 | (sig128Z.v0!=0);
+
+	return uZ;
+}
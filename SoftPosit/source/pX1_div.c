@@ -101,39 +101,13 @@ posit_1_t pX1_div( posit_1_t pA, posit_1_t pB, int x ) {
 	}
 	else{
 		tmp = (uiA<<2)&0xFFFFFFFF;
-		if (regSA){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 		expA = tmp>>30; //to get 1 bits
 		fracA = (tmp | 0x40000000) & 0x7FFFFFFF;
 		frac64A = (uint64_t) fracA << 30;
 
 		tmp = (uiB<<2)&0xFFFFFFFF;
-		if (regSB){
-			while (tmp>>31){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA++;
-			while (!(tmp>>31)){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA -= softposit_decodeRegimeP32UI( regSB, tmp );
 		expA -= tmp>>30;
 		fracB = (tmp | 0x40000000) & 0x7FFFFFFF;
 
@@ -107,40 +107,12 @@ posit_1_t pX1_mul( posit_1_t pA, posit_1_t pB, int x ){
     }
     else{
     	tmp = (uiA<<2)&0xFFFFFFFF;
-		if (regSA){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-
-    	}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 		expA = tmp>>30; //to get 1 bits
 		fracA = (tmp | 0x40000000) & 0x7FFFFFFF;
 
 		tmp = (uiB<<2)&0xFFFFFFFF;
-		if (regSB){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA--;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-
-		}
+		kA += softposit_decodeRegimeP32UI( regSB, tmp );
 		expA += tmp>>30;
 		frac64Z = (uint_fast64_t) fracA * ((tmp | 0x40000000) & 0x7FFFFFFF);
 		if (expA>1){
@@ -63,20 +63,7 @@ posit32_t pX1_to_p32( posit_1_t pA ){
 	regSA = signregP32UI(uiA);
 
 	tmp = (uiA<<2)&0xFFFFFFFF;
-	if (regSA){
-		while (tmp>>31){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>31)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-	}
+	kA += softposit_decodeRegimeP32UI( regSA, tmp );
 
 
 	//2nd bit exp
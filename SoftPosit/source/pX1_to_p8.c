@@ -62,21 +62,7 @@ posit8_t pX1_to_p8( posit_1_t pA ){
 	regSA = signregP32UI(uiA);
 
 	tmp = (uiA<<2)&0xFFFFFFFF;
-	if (regSA){
-		while (tmp>>31){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>31)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-
-	}
+	kA += softposit_decodeRegimeP32UI( regSA, tmp );
 
 	if (kA<-3 || kA>=3){
 		(kA<0) ? (uZ.ui=0x1):(uZ.ui= 0x7F);
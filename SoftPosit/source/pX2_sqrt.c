@@ -48,6 +48,7 @@ posit_2_t pX2_sqrt( posit_2_t pA, int x ) {
     uint_fast32_t mask, uiA, uiZ;
     uint_fast64_t eSqrR0, frac64Z, negRem, recipSqrt, shiftedFracZ, sigma0, sqrSigma0;
     int_fast32_t eps, shiftZ;
+    bool regS;
 
     if (x<2 || x>32){
    		uA.ui = 0x80000000;
@@ -68,19 +69,10 @@ posit_2_t pX2_sqrt( posit_2_t pA, int x ) {
     }
     // Compute the square root; shiftZ is the power-of-2 scaling of the result.
     // Decode regime and exponent; scale the input to be in the range 1 to 4:
-    if (uiA & 0x40000000) {
-        shiftZ = -2;
-        while (uiA & 0x40000000) {
-            shiftZ += 2;
-            uiA = (uiA << 1) & 0xFFFFFFFF;
-        }
-    } else {
-        shiftZ = 0;
-        while (!(uiA & 0x40000000)) {
-            shiftZ -= 2;
-            uiA = (uiA << 1) & 0xFFFFFFFF;
-        }
-    }
+    regS = (uiA >> 30) & 0x1;
+    uiA = (uiA << 2) & 0xFFFFFFFF;
+    shiftZ = softposit_decodeRegimeP32UI( regS, uiA ) << 1;
+    uiA >>= 1;
 
     uiA &= 0x3FFFFFFF;
     expA = (uiA >> 28);
@@ -73,20 +73,7 @@ posit_1_t pX2_to_pX1( posit_2_t pA, int x ){
 	else {
 		//regime
 		tmp = (uiA<<2)&0xFFFFFFFF;
-		if (regSA){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 		//exp and frac
 		exp_frac32A = tmp<<1;
 		if(kA<0){
@@ -76,37 +76,11 @@ quire8_t q8_fdp_add( quire8_t q, posit8_t pA, posit8_t pB ){
 	regSB = signregP8UI(uiB);
 
 	tmp = (uiA<<2) & 0xFF;
-	if (regSA){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSA, tmp );
 	fracA = (0x80 | tmp);
 
 	tmp = (uiB<<2) & 0xFF;
-	if (regSB){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA--;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSB, tmp );
 	frac32Z = (uint_fast32_t)( fracA * (0x80 | tmp) ) <<16;
 
 	rcarry = frac32Z>>31;//1st bit (position 2) of frac32Z, hidden bit is 4th bit (position 3)
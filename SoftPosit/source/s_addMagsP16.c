@@ -76,41 +76,14 @@ posit16_t softposit_addMagsP16( uint_fast16_t uiA, uint_fast16_t uiB ){
 	regSB = signregP16UI( uiB );
 
 	tmp = (uiA<<2) & 0xFFFF;
-	if (regSA){
-		while (tmp>>15){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>15)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	kA += softposit_decodeRegimeP16UI( regSA, tmp );
 	expA = tmp>>14;
 	frac32A = (0x4000 | tmp) << 16;
 	shiftRight = kA;
 
 	tmp = (uiB<<2) & 0xFFFF;
-	if (regSB){
-		while (tmp>>15){
-			shiftRight--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		frac32B = (0x4000 | tmp) <<16;
-	}
-	else{
-		shiftRight++;
-		while (!(tmp>>15)){
-			shiftRight++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-		frac32B = ( (0x4000 | tmp) <<16 ) & 0x7FFFFFFF;
-	}
+	shiftRight -= softposit_decodeRegimeP16UI( regSB, tmp );
+	frac32B = (0x4000 | tmp) <<16;
 
 	//This is 2kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
 	shiftRight = (shiftRight<<1) + expA - (tmp>>14);
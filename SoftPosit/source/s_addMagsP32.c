@@ -67,40 +67,14 @@ posit32_t softposit_addMagsP32( uint_fast32_t uiA, uint_fast32_t uiB ) {
     regSB = signregP32UI( uiB );
 
     tmp = (uiA<<2)&0xFFFFFFFF;
-	if (regSA){
-		while (tmp>>31){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>31)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-	}
+	kA += softposit_decodeRegimeP32UI( regSA, tmp );
 
 	expA = tmp>>29; //to get 2 bits
 	frac64A = ((0x40000000ULL | tmp<<1) & 0x7FFFFFFFULL) <<32;
 	shiftRight = kA;
 
 	tmp = (uiB<<2) & 0xFFFFFFFF;
-	if (regSB){
-		while (tmp>>31){
-			shiftRight--;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-	}
-	else{
-		shiftRight++;
-		while (!(tmp>>31)){
-			shiftRight++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-	}
+	shiftRight -= softposit_decodeRegimeP32UI( regSB, tmp );
 	frac64B = ((0x40000000ULL | tmp<<1) & 0x7FFFFFFFULL) <<32;
 	//This is 4kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
 	shiftRight = (shiftRight<<2) + expA - (tmp>>29);
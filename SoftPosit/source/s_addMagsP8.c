@@ -66,38 +66,12 @@ posit8_t softposit_addMagsP8( uint_fast8_t uiA, uint_fast8_t uiB ){
 	regSB = signregP8UI( uiB );
 
 	tmp = (uiA<<2) & 0xFF;
-	if (regSA){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSA, tmp );
 	frac16A = (0x80 | tmp) << 7;
 	shiftRight = kA;
 
 	tmp = (uiB<<2) & 0xFF;
-	if (regSB){
-		while (tmp>>7){
-			shiftRight--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		shiftRight++;
-		while (!(tmp>>7)){
-			shiftRight++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	shiftRight -= softposit_decodeRegimeP8UI( regSB, tmp );
 	frac16B = (0x80 | tmp) <<7 ;
 
 	//Manage CLANG (LLVM) compiler when shifting right more than number of bits
@@ -73,40 +73,14 @@ posit_1_t softposit_addMagsPX1( uint_fast32_t uiA, uint_fast32_t uiB, int x ) {
     else{
 		tmp = (uiA<<2)&0xFFFFFFFF;
 
-		if (regSA){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 
 		expA = tmp>>30; //to get 1 bits
 		frac64A = ((0x40000000ULL | tmp) & 0x7FFFFFFFULL) <<32;
 		shiftRight = kA;
 
 		tmp = (uiB<<2) & 0xFFFFFFFF;
-		if (regSB){
-			while (tmp>>31){
-				shiftRight--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			shiftRight++;
-			while (!(tmp>>31)){
-				shiftRight++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		shiftRight -= softposit_decodeRegimeP32UI( regSB, tmp );
 
 		frac64B = ((0x40000000ULL | tmp) & 0x7FFFFFFFULL) <<32;
 		//This is 2kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
@@ -82,38 +82,12 @@ posit16_t softposit_mulAddP16( uint_fast16_t uiA, uint_fast16_t uiB, uint_fast16
 	regSC = signregP16UI(uiC);
 
 	tmp = (uiA<<2) & 0xFFFF;
-	if (regSA){
-		while (tmp>>15){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>15)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	kA += softposit_decodeRegimeP16UI( regSA, tmp );
 	expA = tmp>>14;
 	fracA = (0x8000 | (tmp<<1)); //use first bit here for hidden bit to get more bits
 
 	tmp = (uiB<<2) & 0xFFFF;
-	if (regSB){
-		while (tmp>>15){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		kA--;
-		while (!(tmp>>15)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	kA += softposit_decodeRegimeP16UI( regSB, tmp );
 	expA += tmp>>14;
 	frac32Z = (uint_fast32_t) fracA * (0x8000 | (tmp <<1)); // first bit hidden bit
 
@@ -132,20 +106,7 @@ posit16_t softposit_mulAddP16( uint_fast16_t uiA, uint_fast16_t uiB, uint_fast16
 	//Add
 	if (uiC!=0){
 		tmp = (uiC<<2) & 0xFFFF;
-		if (regSC){
-			while (tmp>>15){
-				kC++;
-				tmp= (tmp<<1) & 0xFFFF;
-			}
-		}
-		else{
-			kC=-1;
-			while (!(tmp>>15)){
-				kC--;
-				tmp= (tmp<<1) & 0xFFFF;
-			}
-			tmp&=0x7FFF;
-		}
+		kC += softposit_decodeRegimeP16UI( regSC, tmp );
 		expC = tmp>>14;
 		frac32C = (0x4000 | tmp) << 16;
 		shiftRight = ((kA-kC)<<1) + (expA-expC); //actually this is the scale
@@ -216,10 +177,9 @@ posit16_t softposit_mulAddP16( uint_fast16_t uiA, uint_fast16_t uiB, uint_fast16
 		else {
 			//for subtract cases
 			if (frac32Z!=0){
-				while((frac32Z>>29)==0){
-					kZ--;
-					frac32Z<<=2;
-				}
+				uint_fast8_t normShift = (softposit_countLeadingZeros32( (uint32_t) frac32Z ) - 1) >> 1;
+				kZ -= normShift;
+				frac32Z <<= normShift<<1;
 			}
 			bool ecarry = (0x40000000 & frac32Z)>>30;
 
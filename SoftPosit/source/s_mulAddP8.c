@@ -75,37 +75,11 @@ posit8_t softposit_mulAddP8( uint_fast8_t uiA, uint_fast8_t uiB, uint_fast8_t ui
 	regSC = signregP8UI(uiC);
 
 	tmp = (uiA<<2) & 0xFF;
-	if (regSA){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSA, tmp );
 	fracA = (0x80 | tmp); //use first bit here for hidden bit to get more bits
 
 	tmp = (uiB<<2) & 0xFF;
-	if (regSB){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA--;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSB, tmp );
 	frac16Z = (uint_fast16_t) fracA * (0x80 | tmp);
 
 	rcarry = frac16Z>>15;//1st bit of frac16Z
@@ -116,20 +90,7 @@ posit8_t softposit_mulAddP8( uint_fast8_t uiA, uint_fast8_t uiB, uint_fast8_t ui
 
 	if (uiC!=0){
 		tmp = (uiC<<2) & 0xFF;
-		if (regSC){
-			while (tmp>>7){
-				kC++;
-				tmp= (tmp<<1) & 0xFF;
-			}
-		}
-		else{
-			kC=-1;
-			while (!(tmp>>7)){
-				kC--;
-				tmp= (tmp<<1) & 0xFF;
-			}
-			tmp&=0x7F;
-		}
+		kC += softposit_decodeRegimeP8UI( regSC, tmp );
 		frac16C = (0x80 | tmp) <<7 ;
 		shiftRight = (kA-kC);
 
@@ -194,10 +155,9 @@ posit8_t softposit_mulAddP8( uint_fast8_t uiA, uint_fast8_t uiB, uint_fast8_t ui
 
 			//for subtract cases
 			if (frac16Z!=0){
-				while((frac16Z>>14)==0){
-					kZ--;
-					frac16Z<<=1;
-				}
+				uint_fast8_t normShift = softposit_countLeadingZeros32( (uint32_t) frac16Z ) - 17;
+				kZ -= normShift;
+				frac16Z <<= normShift;
 			}
 		}
 
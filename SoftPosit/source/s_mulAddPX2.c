@@ -111,38 +111,12 @@ posit_2_t
     }
     else{
     	tmp = (uiA<<2)&0xFFFFFFFF;
-		if (regSA){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 		expA = tmp>>29; //to get 2 bits
 		fracA = ((tmp<<2) | 0x80000000) & 0xFFFFFFFF;
 
 		tmp = (uiB<<2)&0xFFFFFFFF;
-		if (regSB){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA--;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSB, tmp );
 		expA += tmp>>29;
 		frac64Z = (uint_fast64_t) fracA * (((tmp<<2) | 0x80000000) & 0xFFFFFFFF);
 
@@ -163,20 +137,7 @@ posit_2_t
 
 		if (uiC!=0){
 			tmp = (uiC<<2)&0xFFFFFFFF;
-			if (regSC){
-				while (tmp>>31){
-					kC++;
-					tmp= (tmp<<1) & 0xFFFFFFFF;
-				}
-			}
-			else{
-				kC=-1;
-				while (!(tmp>>31)){
-					kC--;
-					tmp= (tmp<<1) & 0xFFFFFFFF;
-				}
-				tmp&=0x7FFFFFFF;
-			}
+			kC += softposit_decodeRegimeP32UI( regSC, tmp );
 
 			expC = tmp>>29; //to get 2 bits
 			frac64C = (((tmp<<1) | 0x40000000ULL) & 0x7FFFFFFFULL)<<32;
@@ -251,10 +212,9 @@ posit_2_t
 			else {
 				//for subtract cases
 				if (frac64Z!=0){
-					while((frac64Z>>59)==0){
-						kZ--;
-						frac64Z<<=4;
-					}
+					uint_fast8_t normShift = (softposit_countLeadingZeros64( frac64Z ) - 1) >> 2;
+					kZ -= normShift;
+					frac64Z <<= normShift<<2;
 					while((frac64Z>>62)==0){
 						expZ--;
 						frac64Z<<=1;
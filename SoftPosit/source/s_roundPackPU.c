@@ -0,0 +1,95 @@
+
+/*============================================================================
+
+This C source file is part of the SoftPosit Posit Arithmetic Package
+by S. H. Leong (Cerlane).
+
+Copyright 2017 2018 A*STAR.  All rights reserved.
+
+This C source file was based on SoftFloat IEEE Floating-Point Arithmetic
+Package, Release 3d, by John R. Hauser.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions, and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions, and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+ 3. Neither the name of the University nor the names of its contributors may
+    be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS "AS IS", AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE, ARE
+DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+=============================================================================*/
+
+#include "platform.h"
+#include "internals.h"
+
+uint_fast32_t softposit_roundPackPU( posit_unpacked_t uA, int x, int es ){
+
+	uint_fast32_t uiZ;
+	uint_fast64_t str, frac;
+	int_fast32_t kA, expA;
+	int_fast8_t regLen, pos;
+	bool bitNPlusOne, bitsMore;
+
+	if (uA.isNaR) return 0x80000000;
+	if (uA.isZero) return 0;
+
+	//floor(scale/2^es) without relying on signed shifts
+	if (uA.scale<0)
+		kA = -((-uA.scale-1)>>es) - 1;
+	else
+		kA = uA.scale>>es;
+	expA = uA.scale - kA * (1<<es);
+
+	if (kA>(x-3)){
+		//max or min pos. exp and frac does not matter.
+		uiZ = 0x7FFFFFFF & ((int32_t)0x80000000>>(x-1));
+	}
+	else if (kA<-(x-2)){
+		uiZ = 0x1 << (32-x);
+	}
+	else{
+		//bit string after the sign: regime, exponent then fraction
+		if (kA>=0){
+			regLen = kA + 2;
+			str = ~(0xFFFFFFFFFFFFFFFFULL >> (kA+1));
+		}
+		else{
+			regLen = -kA + 1;
+			str = 0x1ULL << (64-regLen);
+		}
+		pos = regLen + es;
+		if (es>0) str |= (uint_fast64_t) expA << (64-pos);
+
+		//remove hidden bit
+		frac = uA.sig << 1;
+		str |= frac >> pos;
+		bitsMore = (frac << (64-pos)) != 0;
+
+		uiZ = str >> (65-x);
+		bitNPlusOne = (str >> (64-x)) & 0x1;
+		if ((str << x) != 0) bitsMore = 1;
+
+		if (bitNPlusOne) uiZ += (uiZ&1) | bitsMore;
+		uiZ <<= (32-x);
+	}
+
+	if (uA.sign) uiZ = -uiZ & 0xFFFFFFFF;
+	return uiZ;
+}
@@ -75,39 +75,13 @@ posit16_t softposit_subMagsP16( uint_fast16_t uiA, uint_fast16_t uiB ){
     regSB = signregP16UI( uiB );
 
     tmp = (uiA<<2) & 0xFFFF;
-	if (regSA){
-		while (tmp>>15){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>15)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	kA += softposit_decodeRegimeP16UI( regSA, tmp );
 	expA = tmp>>14;
 	frac32A = (0x4000 | tmp) << 16;
 	shiftRight = kA;
 
 	tmp = (uiB<<2) & 0xFFFF;
-	if (regSB){
-		while (tmp>>15){
-			shiftRight--;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-	}
-	else{
-		shiftRight++;
-		while (!(tmp>>15)){
-			shiftRight++;
-			tmp= (tmp<<1) & 0xFFFF;
-		}
-		tmp&=0x7FFF;
-	}
+	shiftRight -= softposit_decodeRegimeP16UI( regSB, tmp );
 	frac32B = (0x4000 | tmp) <<16;
 	//This is 2kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
 
@@ -125,10 +99,9 @@ posit16_t softposit_subMagsP16( uint_fast16_t uiA, uint_fast16_t uiB ){
 
 	frac32A -= frac32B;
 
-	while((frac32A>>29)==0){
-		kA--;
-		frac32A<<=2;
-	}
+	uint_fast8_t normShift = (softposit_countLeadingZeros32( (uint32_t) frac32A ) - 1) >> 1;
+	kA -= normShift;
+	frac32A <<= normShift<<1;
 	ecarry = (0x40000000 & frac32A)>>30;
 	if(!ecarry){
 		if (expA==0) kA--;
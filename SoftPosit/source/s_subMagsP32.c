@@ -73,20 +73,7 @@ posit32_t softposit_subMagsP32( uint_fast32_t uiA, uint_fast32_t uiB ) {
 	regSB = signregP32UI( uiB );
 
 	tmp = (uiA<<2)&0xFFFFFFFF;
-	if (regSA){
-		while (tmp>>31){
-			kA++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>31)){
-			kA--;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-	}
+	kA += softposit_decodeRegimeP32UI( regSA, tmp );
 
 	expA = tmp>>29; //to get 2 bits
 	frac64A = ((0x40000000ULL | tmp<<1) & 0x7FFFFFFFULL) <<32;
@@ -94,22 +81,7 @@ posit32_t softposit_subMagsP32( uint_fast32_t uiA, uint_fast32_t uiB ) {
 
 
 	tmp = (uiB<<2) & 0xFFFFFFFF;
-	if (regSB){
-		while (tmp>>31){
-			shiftRight--;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-
-	}
-	else{
-		shiftRight++;
-		while (!(tmp>>31)){
-			shiftRight++;
-			tmp= (tmp<<1) & 0xFFFFFFFF;
-		}
-		tmp&=0x7FFFFFFF;
-
-	}
+	shiftRight -= softposit_decodeRegimeP32UI( regSB, tmp );
 	frac64B = ((0x40000000ULL | tmp<<1) & 0x7FFFFFFFULL) <<32;
 
 	//This is 4kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
@@ -124,10 +96,9 @@ posit32_t softposit_subMagsP32( uint_fast32_t uiA, uint_fast32_t uiB ) {
 
 	frac64A -= frac64B;
 
-	while((frac64A>>59)==0){
-		kA--;
-		frac64A<<=4;
-	}
+	uint_fast8_t normShift = (softposit_countLeadingZeros64( frac64A ) - 1) >> 2;
+	kA -= normShift;
+	frac64A <<= normShift<<2;
 	ecarry = (0x4000000000000000 & frac64A);//(0x4000000000000000 & frac64A)>>62;
 	while (!ecarry){
 		if (expA==0){
@@ -72,38 +72,12 @@ posit8_t softposit_subMagsP8( uint_fast8_t uiA, uint_fast8_t uiB ){
     regSB = signregP8UI( uiB );
 
     tmp = (uiA<<2) & 0xFF;
-	if (regSA){
-		while (tmp>>7){
-			kA++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		kA=-1;
-		while (!(tmp>>7)){
-			kA--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	kA += softposit_decodeRegimeP8UI( regSA, tmp );
 	frac16A = (0x80 | tmp) << 7;
 	shiftRight = kA;
 
 	tmp = (uiB<<2) & 0xFF;
-	if (regSB){
-		while (tmp>>7){
-			shiftRight--;
-			tmp= (tmp<<1) & 0xFF;
-		}
-	}
-	else{
-		shiftRight++;
-		while (!(tmp>>7)){
-			shiftRight++;
-			tmp= (tmp<<1) & 0xFF;
-		}
-		tmp&=0x7F;
-	}
+	shiftRight -= softposit_decodeRegimeP8UI( regSB, tmp );
 	frac16B = (0x80 | tmp) <<7;
 
 
@@ -117,10 +91,9 @@ posit8_t softposit_subMagsP8( uint_fast8_t uiA, uint_fast8_t uiB ){
 
 	frac16A -= frac16B;
 
-	while((frac16A>>14)==0){
-		kA--;
-		frac16A<<=1;
-	}
+	uint_fast8_t normShift = softposit_countLeadingZeros32( (uint32_t) frac16A ) - 17;
+	kA -= normShift;
+	frac16A <<= normShift;
 	ecarry = (0x4000 & frac16A)>>14;
 	if(!ecarry){
 		kA--;
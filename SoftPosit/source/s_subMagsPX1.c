@@ -78,20 +78,7 @@ posit_1_t softposit_subMagsPX1( uint_fast32_t uiA, uint_fast32_t uiB, int x ) {
 	else{
 
 		tmp = (uiA<<2)&0xFFFFFFFF;
-		if (regSA){
-			while (tmp>>31){
-				kA++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-		}
-		else{
-			kA=-1;
-			while (!(tmp>>31)){
-				kA--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-		}
+		kA += softposit_decodeRegimeP32UI( regSA, tmp );
 
 
 		expA = tmp>>30; //to get 1 bits
@@ -99,22 +86,7 @@ posit_1_t softposit_subMagsPX1( uint_fast32_t uiA, uint_fast32_t uiB, int x ) {
 		shiftRight = kA;
 
 		tmp = (uiB<<2) & 0xFFFFFFFF;
-		if (regSB){
-			while (tmp>>31){
-				shiftRight--;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-
-		}
-		else{
-			shiftRight++;
-			while (!(tmp>>31)){
-				shiftRight++;
-				tmp= (tmp<<1) & 0xFFFFFFFF;
-			}
-			tmp&=0x7FFFFFFF;
-
-		}
+		shiftRight -= softposit_decodeRegimeP32UI( regSB, tmp );
 		frac64B = ((0x40000000ULL | tmp) & 0x7FFFFFFFULL) <<32;
 		//This is 4kZ + expZ; (where kZ=kA-kB and expZ=expA-expB)
 		shiftRight = (shiftRight<<1) + expA - (tmp>>30);
@@ -128,10 +100,9 @@ posit_1_t softposit_subMagsPX1( uint_fast32_t uiA, uint_fast32_t uiB, int x ) {
 
 		frac64A -= frac64B;
 
-		while((frac64A>>61)==0){
-			kA--;
-			frac64A<<=2;
-		}
+		uint_fast8_t normShift = (softposit_countLeadingZeros64( frac64A ) - 1) >> 1;
+		kA -= normShift;
+		frac64A <<= normShift<<1;
 		ecarry = (0x4000000000000000 & frac64A);//(0x4000000000000000 & frac64A)>>62;
 		if (!ecarry){
 			if (expA==0) kA--;
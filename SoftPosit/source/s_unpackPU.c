@@ -0,0 +1,82 @@
+
+/*============================================================================
+
+This C source file is part of the SoftPosit Posit Arithmetic Package
+by S. H. Leong (Cerlane).
+
+Copyright 2017 2018 A*STAR.  All rights reserved.
+
+This C source file was based on SoftFloat IEEE Floating-Point Arithmetic
+Package, Release 3d, by John R. Hauser.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions, and the following disclaimer.
+
+ 2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions, and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+ 3. Neither the name of the University nor the names of its contributors may
+    be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS "AS IS", AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE, ARE
+DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+=============================================================================*/
+
+#include "platform.h"
+#include "internals.h"
+
+posit_unpacked_t softposit_unpackPUI( uint_fast32_t uiA, int x, int es ){
+
+	posit_unpacked_t uZ;
+	uint_fast64_t tmp;
+	int_fast32_t kA, expA=0;
+	int_fast8_t regLen;
+
+	uiA &= 0xFFFFFFFF & ((int32_t)0x80000000>>(x-1));
+
+	uZ.sig = 0;
+	uZ.scale = 0;
+	uZ.sign = 0;
+	uZ.isNaR = (uiA==0x80000000);
+	uZ.isZero = (uiA==0);
+	if (uZ.isNaR || uZ.isZero) return uZ;
+
+	uZ.sign = signP32UI( uiA );
+	if (uZ.sign) uiA = -uiA & 0xFFFFFFFF;
+
+	//drop the sign bit and left-align in 64 bits, trailing bits are zero
+	tmp = (uint_fast64_t) uiA << 33;
+	if (tmp>>63){
+		regLen = softposit_countLeadingZeros64( ~tmp );
+		kA = regLen - 1;
+	}
+	else{
+		regLen = softposit_countLeadingZeros64( tmp );
+		kA = -regLen;
+	}
+	//regime and its terminating bit
+	tmp <<= regLen + 1;
+
+	if (es>0){
+		expA = tmp >> (64-es);
+		tmp <<= es;
+	}
+	uZ.scale = kA * (1<<es) + expA;
+	uZ.sig = (tmp>>1) | 0x8000000000000000ULL;
+
+	return uZ;
+}
@@ -1,3 +1,4 @@
+import json
 import os
 
 frequencies = [200,300,400,500,600]
@@ -90,10 +91,18 @@ configs = [
 	(10, 58, 496,  40,   -50,   9)
 ]
 
-cmd = "/home/binaryman/Documents/PhD/flopoco/build/flopoco S3FDP scale_width={} fraction_width={} bias={} nb_bits_ovf={} msb_summand={} lsb_summand={} has_HSSD=true frequency={} target=VirtexUltrascalePlus outputFile=/tmp/s3fdp_{}_{}_{}_{}_m{}.vhdl name=S3FDP_{}_{}_{}_{}_m{}_HSSD"
+cmd = "/home/binaryman/Documents/PhD/flopoco/build/flopoco S3FDP scale_width={} fraction_width={} bias={} nb_bits_ovf={} msb_summand={} lsb_summand={} has_HSSD=true frequency={} target=VirtexUltrascalePlus outputFile=/tmp/s3fdp_{}.vhdl report=/tmp/s3fdp_{}.json name=S3FDP_{}_HSSD"
 
+# one line per generated operator, read from the flopoco report instead of its stdout
+print("frequency,ws,wf,msb,lsb,ovf,pipeline_depth,critical_path_ns,generation_time_s")
 for f in frequencies:
 	for c in configs:
-		exec_cmd = cmd.format(c[0],c[1],c[2],c[5],c[3],c[4],f,f,c[0],c[1],c[3],-c[4],f,c[0],c[1],c[3],-c[4])
+		tag = "{}_{}_{}_{}_m{}".format(f,c[0],c[1],c[3],-c[4])
+		exec_cmd = cmd.format(c[0],c[1],c[2],c[5],c[3],c[4],f,tag,tag,tag)
 		#print(exec_cmd)
-		os.system(exec_cmd)
+		if os.system(exec_cmd) != 0:
+			continue
+		with open("/tmp/s3fdp_{}.json".format(tag)) as report_file:
+			report = json.load(report_file)
+		top = next(e for e in report["entities"] if e["name"] == report["top"][-1])
+		print("{},{},{},{},{},{},{},{},{}".format(f,c[0],c[1],c[3],c[4],c[5],top["pipelineDepth"],top["criticalPathNs"],top["generationTime"]))
@@ -149,9 +149,9 @@ configs = [
 
 #cmd = "/home/binaryman/Documents/PhD/flopoco/build/flopoco S3FDP scale_width={} fraction_width={} bias={} nb_bits_ovf={} msb_summand={} lsb_summand={} has_HSSD=true frequency={} target=VirtexUltrascalePlus outputFile=/tmp/s3fdp_{}_{}_{}_{}_m{}.vhdl name=S3FDP_{}_{}_{}_{}_m{}_HSSD"
 
-cmd = '/home/binaryman/Documents/PhD/flopoco/build/flopoco SystolicArray N=1 M=1 arithmetic_in="{}" arithmetic_out="same" nb_bits_ovf={} msb_summand={} lsb_summand={} has_HSSD=true frequency={} target=VirtexUltrascalePlus outputFile=/tmp/s3fdp_{}_{}_{}_{}_m{}.vhdl name=S3FDP_{}_{}_{}_{}_m{}_HSSD'
+cmd = '/home/binaryman/Documents/PhD/flopoco/build/flopoco SystolicArray N=1 M=1 arithmetic_in="{}" arithmetic_out="same" nb_bits_ovf={} msb_summand={} lsb_summand={} has_HSSD=true frequency={} target=VirtexUltrascalePlus outputFile=/tmp/s3fdp_{}_{}_{}_{}_m{}.vhdl report=/tmp/s3fdp_{}_{}_{}_{}_m{}.json name=S3FDP_{}_{}_{}_{}_m{}_HSSD'
 
 for c in configs:
-	exec_cmd = cmd.format(c[1],c[7],c[5],c[6],c[0],c[0],c[3],c[4],c[5],-c[6],c[0],c[3],c[4],c[5],-c[6])
+	exec_cmd = cmd.format(c[1],c[7],c[5],c[6],c[0],c[0],c[3],c[4],c[5],-c[6],c[0],c[3],c[4],c[5],-c[6],c[0],c[3],c[4],c[5],-c[6])
 	#print(exec_cmd)
 	os.system(exec_cmd)
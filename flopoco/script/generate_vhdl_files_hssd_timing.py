@@ -90,11 +90,11 @@ frequencies = [100,200,250,300,400,500,600]
 # 	(10, 58, 496,  40,   -50,   9)
 # ]
 
-cmd = '/home/binaryman/Documents/PhD/flopoco/build/flopoco SystolicArray M=32 N=32 arithmetic_in="posit:8:0" arithmetic_out="same" nb_bits_ovf=7 msb_summand=12 lsb_summand=-12 has_HSSD=false frequency={} target=VirtexUltrascalePlus outputFile=/tmp/SA_32_32_f{}.vhdl name=SA_32_32_f{}'
+cmd = '/home/binaryman/Documents/PhD/flopoco/build/flopoco SystolicArray M=32 N=32 arithmetic_in="posit:8:0" arithmetic_out="same" nb_bits_ovf=7 msb_summand=12 lsb_summand=-12 has_HSSD=false frequency={} target=VirtexUltrascalePlus outputFile=/tmp/SA_32_32_f{}.vhdl report=/tmp/SA_32_32_f{}.json name=SA_32_32_f{}'
 
 #cmd = "/home/binaryman/Documents/PhD/flopoco/build/flopoco S3FDP scale_width={} fraction_width={} bias={} nb_bits_ovf={} msb_summand={} lsb_summand={} has_HSSD=true frequency={} target=VirtexUltrascalePlus outputFile=/tmp/s3fdp_{}_{}_{}_{}_m{}.vhdl name=S3FDP_{}_{}_{}_{}_m{}_HSSD"
 
 for f in frequencies:
-	exec_cmd = cmd.format(f,f,f)
+	exec_cmd = cmd.format(f,f,f,f)
 	#print(exec_cmd)
 	os.system(exec_cmd)
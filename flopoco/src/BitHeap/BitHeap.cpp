@@ -4,6 +4,7 @@
 #include "BitHeap/ParandehAfsharCompressionStrategy.hpp"
 #include "BitHeap/MaxEfficiencyCompressionStrategy.hpp"
 #include "BitHeap/OptimalCompressionStrategy.hpp"
+#include "BitHeap/PortfolioCompressionStrategy.hpp"
 #include <algorithm>
 namespace flopoco {
 
@@ -39,11 +40,15 @@ namespace flopoco {
 		}
 		bits.clear();
 
-		for(unsigned i=0; i<bits.size(); i++)
+		for(unsigned i=0; i<history.size(); i++)
 		{
 			history[i].clear();
 		}
 		history.clear();
+
+		bitsBySignal.clear();
+		//the bits themselves are freed with the pool
+		delete bitPool;
 	}
 
 
@@ -68,6 +73,9 @@ namespace flopoco {
 			history.push_back(t2);
 		}
 
+		//the storage of the bits
+		bitPool = new deque<Bit>();
+
 		//initialize the constant bits
 		constantBits = mpz_class(0);
 
@@ -96,12 +104,14 @@ namespace flopoco {
 			return nullptr;
 		}
 
-		//create a new bit
+		//create a new bit in the pool
 		//	the bit's constructor also declares the signal
-		Bit* bit = new Bit(this, name, weight, BitType::free);
+		bitPool->emplace_back(this, name, weight, BitType::free);
+		Bit* bit = &bitPool->back();
 
 		//insert the new bit so that the vector is sorted by bit (cycle, delay)
 		insertBitInColumn(bit, weight-lsb);
+		indexBitBySignals(bit);
 
 		REPORT(DEBUG, "added bit named "  << bit->getName() << " on column " << weight
 				<< " at cycle=" << bit->signal->getCycle() << " cp=" << bit->signal->getCriticalPath());
@@ -135,7 +145,9 @@ namespace flopoco {
 
 	void BitHeap::sortBitsInColumns(){
 		for(unsigned int c = 0; c < bits.size(); c++){
-			std::sort(bits[c].begin(), bits[c].end(), lexicographicOrdering);
+			//the columns are kept sorted on insertion, so most of them need no sorting
+			if(!std::is_sorted(bits[c].begin(), bits[c].end(), lexicographicOrdering))
+				std::sort(bits[c].begin(), bits[c].end(), lexicographicOrdering);
 		}
 	}
 
@@ -152,38 +164,77 @@ namespace flopoco {
 
 	void BitHeap::insertBitInColumn(Bit* bit, unsigned columnNumber)
 	{
-		vector<Bit*>::iterator it = bits[columnNumber].begin();
-		bool inserted = false;
-
-		//if the column is empty, then just insert the bit
-		if(bits[columnNumber].size() == 0)
-		{
-			bits[columnNumber].push_back(bit);
-			return;
-		}
+		vector<Bit*>& column = bits[columnNumber];
 
 		//insert the bit in the column
-		//	in the lexicographic order of the timing
-		while(it != bits[columnNumber].end())
+		//	in the lexicographic order of the timing, after the bits arriving at the same time
+		vector<Bit*>::iterator it = std::upper_bound(column.begin(), column.end(), bit,
+				[](const Bit* bit1, const Bit* bit2){
+					return (bit1->signal->getCycle() < bit2->signal->getCycle())
+							|| ((bit1->signal->getCycle() == bit2->signal->getCycle())
+									&& (bit1->signal->getCriticalPath() < bit2->signal->getCriticalPath()));
+				});
+		column.insert(it, bit);
+
+		isCompressed = false;
+	}
+
+
+	/**
+	 * the identifiers of a right-hand side, in order, possibly repeated
+	 */
+	static vector<string> rhsIdentifiers(const string& rhs)
+	{
+		vector<string> identifiers;
+		size_t i = 0;
+
+		while(i < rhs.size())
 		{
-			if((bit->signal->getCycle() < (*it)->signal->getCycle())
-					|| ((bit->signal->getCycle() == (*it)->signal->getCycle())
-							&& (bit->signal->getCriticalPath() < (*it)->signal->getCriticalPath())))
+			if(isalpha(rhs[i]) || (rhs[i] == '_'))
 			{
-				bits[columnNumber].insert(it, bit);
-				inserted = true;
-				break;
+				size_t start = i;
+				while((i < rhs.size()) && (isalnum(rhs[i]) || (rhs[i] == '_')))
+					i++;
+				identifiers.push_back(rhs.substr(start, i-start));
+			}else if(isdigit(rhs[i])){
+				//skip numbers, so that the digits are not taken for identifiers
+				while((i < rhs.size()) && (isalnum(rhs[i]) || (rhs[i] == '_')))
+					i++;
 			}else{
-				it++;
+				i++;
 			}
 		}
+		return identifiers;
+	}
 
-		if(inserted == false)
+
+	void BitHeap::indexBitBySignals(Bit* bit)
+	{
+		vector<string> identifiers = rhsIdentifiers(bit->getRhsAssignment());
+
+		//index the bit under each identifier of its right-hand side
+		for(unsigned i=0; i<identifiers.size(); i++)
 		{
-			bits[columnNumber].insert(bits[columnNumber].end(), bit);
+			vector<Bit*>& signalBits = bitsBySignal[identifiers[i]];
+			if(signalBits.empty() || (signalBits.back() != bit))
+				signalBits.push_back(bit);
 		}
+	}
 
-		isCompressed = false;
+
+	void BitHeap::unindexBitBySignals(Bit* bit)
+	{
+		vector<string> identifiers = rhsIdentifiers(bit->getRhsAssignment());
+
+		for(unsigned i=0; i<identifiers.size(); i++)
+		{
+			map<string, vector<Bit*> >::iterator it = bitsBySignal.find(identifiers[i]);
+			if(it == bitsBySignal.end())
+				continue;
+			it->second.erase(std::remove(it->second.begin(), it->second.end(), bit), it->second.end());
+			if(it->second.empty())
+				bitsBySignal.erase(it);
+		}
 	}
 
 
@@ -192,16 +243,23 @@ namespace flopoco {
 		if((weight < lsb) || (weight > msb))
 			THROWERROR("Weight " << weight << " out of the bit heap range ("<< msb << ", " << lsb << ") in removeBit");
 
-		vector<Bit*> bitsColumn = bits[weight-lsb];
+		vector<Bit*>& bitsColumn = bits[weight-lsb];
+
+		if(bitsColumn.empty())
+			THROWERROR("Column with weight=" << weight << " is empty in removeBit");
 
 		//if dir=0 the bit will be removed from the beginning of the list,
 		//	else from the end of the list of weighted bits
 		if(direction == 0)
+		{
+			unindexBitBySignals(bitsColumn.front());
 			bitsColumn.erase(bitsColumn.begin());
-		else if(direction == 1)
+		}else if(direction == 1){
+			unindexBitBySignals(bitsColumn.back());
 			bitsColumn.pop_back();
-		else
+		}else{
 			THROWERROR("Invalid direction for removeBit: direction=" << direction);
+		}
 
 		REPORT(DEBUG,"removed a bit from column " << weight);
 
@@ -214,25 +272,17 @@ namespace flopoco {
 		if((weight < lsb) || (weight > msb))
 			THROWERROR("Weight " << weight << " out of the bit heap range ("<< msb << ", " << lsb << ") in removeBit");
 
-		bool bitFound = false;
-		vector<Bit*> bitsColumn = bits[weight-lsb];
-		vector<Bit*>::iterator it = bitsColumn.begin();
+		vector<Bit*>& bitsColumn = bits[weight-lsb];
 
 		//search for the bit and erase it,
 		//	if it is present in the column
-		while(it != bitsColumn.end())
-		{
-			if((*it)->getUid() == bit->getUid())
-			{
-				bitsColumn.erase(it);
-				bitFound = true;
-			}else{
-				it++;
-			}
-		}
-		if(bitFound == false)
+		vector<Bit*>::iterator it = std::find_if(bitsColumn.begin(), bitsColumn.end(),
+				[bit](Bit* b){ return (b == bit) || ((b->getUid() == bit->getUid()) && (b->getName() == bit->getName())); });
+		if(it == bitsColumn.end())
 			THROWERROR("Bit " << bit->getName() << " with uid=" << bit->getUid()
 					<< " not found in column with weight=" << weight);
+		unindexBitBySignals(*it);
+		bitsColumn.erase(it);
 
 		REPORT(DEBUG,"removed bit " << bit->getName() << " from column " << weight);
 
@@ -245,8 +295,7 @@ namespace flopoco {
 		if((weight < lsb) || (weight > msb))
 			THROWERROR("Weight " << weight << " out of the bit heap range ("<< msb << ", " << lsb << ") in removeBit");
 
-		vector<Bit*> bitsColumn = bits[weight-lsb];
-		unsigned currentCount = 0;
+		vector<Bit*>& bitsColumn = bits[weight-lsb];
 
 		if(count > bitsColumn.size())
 		{
@@ -255,10 +304,19 @@ namespace flopoco {
 			count = bitsColumn.size();
 		}
 
-		while(currentCount < count)
-		{
-			removeBit(weight, direction);
-		}
+		//remove the bits at once, from the beginning or from the end of the column
+		vector<Bit*>::iterator first, last;
+		if(direction == 0)
+			first = bitsColumn.begin(), last = bitsColumn.begin() + count;
+		else if(direction == 1)
+			first = bitsColumn.end() - count, last = bitsColumn.end();
+		else
+			THROWERROR("Invalid direction for removeBits: direction=" << direction);
+		for(vector<Bit*>::iterator it = first; it != last; it++)
+			unindexBitBySignals(*it);
+		bitsColumn.erase(first, last);
+
+		REPORT(DEBUG,"removed " << count << " bits from column " << weight);
 
 		isCompressed = false;
 	}
@@ -268,14 +326,12 @@ namespace flopoco {
 	{
 		if(lsb < this->lsb)
 			THROWERROR("LSB (=" << lsb << ") out of bitheap bit range  ("<< this->msb << ", " << this->lsb << ") in removeBit");
-		if(msb > this->lsb)
+		if(msb > this->msb)
 			THROWERROR("MSB (=" << msb << ") out of bitheap bit range  ("<< this->msb << ", " << this->lsb << ") in removeBit");
 
 		for(int i=lsb; i<=msb; i++)
 		{
-			unsigned currentWeight = lsb - this->lsb;
-
-			removeBits(currentWeight, count, direction);
+			removeBits(i, count, direction);
 		}
 
 		isCompressed = false;
@@ -286,20 +342,14 @@ namespace flopoco {
 	{
 		for(unsigned i=0; i<width; i++)
 		{
-			vector<Bit*>::iterator it = bits[i].begin(), lastIt = it;
-
-			//search for the bits marked as compressed and erase them
-			while(it != bits[i].end())
-			{
-				if((*it)->type == BitType::compressed)
-				{
-					bits[i].erase(it);
-					it = lastIt;
-				}else{
-					lastIt = it;
-					it++;
-				}
-			}
+			for(unsigned j=0; j<bits[i].size(); j++)
+				if(bits[i][j]->type == BitType::compressed)
+					unindexBitBySignals(bits[i][j]);
+			//compact the bits not marked as compressed to the front of the column,
+			//	keeping their order, then erase the rest at once
+			bits[i].erase(std::remove_if(bits[i].begin(), bits[i].end(),
+						[](const Bit* bit){ return bit->type == BitType::compressed; }),
+					bits[i].end());
 		}
 	}
 
@@ -311,7 +361,7 @@ namespace flopoco {
 
 		if(number >= bits[weight-lsb].size())
 			THROWERROR("Column with weight=" << weight << " only contains "
-					<< bits[weight].size() << " bits, but bit number=" << number << " is to be marked");
+					<< bits[weight-lsb].size() << " bits, but bit number=" << number << " is to be marked");
 
 		bits[weight-lsb][number]->type = type;
 	}
@@ -319,27 +369,21 @@ namespace flopoco {
 
 	void BitHeap::markBit(Bit* bit, BitType type)
 	{
-		bool bitFound = false;
-
-		for(unsigned i=0; i<=width; i++)
+		//the bit can only be in the column of its weight
+		if((bit->weight >= lsb) && (bit->weight <= msb))
 		{
-			vector<Bit*>::iterator it = bits[i].begin();
+			vector<Bit*>& bitsColumn = bits[bit->weight-lsb];
 
-			//search for the bit
-			while(it != bits[i].end())
+			for(vector<Bit*>::iterator it = bitsColumn.begin(); it != bitsColumn.end(); it++)
 			{
-				if(((*it)->getName() == bit->getName()) && ((*it)->getUid() == bit->getUid()))
+				if(((*it)->getUid() == bit->getUid()) && ((*it)->getName() == bit->getName()))
 				{
 					(*it)->type = type;
-					bitFound = true;
 					return;
-				}else{
-					it++;
 				}
 			}
 		}
-		if(bitFound == false)
-			THROWERROR("Bit=" << bit->getName() << " with uid="
+		THROWERROR("Bit=" << bit->getName() << " with uid="
 					<< bit->getUid() << " not found in bitheap");
 	}
 
@@ -378,27 +422,19 @@ namespace flopoco {
 
 	void BitHeap::markBits(Signal *signal, BitType type, int weight)
 	{
-		int startIndex;
-
 		if(weight > msb)
 		{
 			THROWERROR("Error in markBits: weight cannot be more than the msb: weight=" << weight);
 		}
 
-		if(weight < lsb)
-			startIndex = 0;
-		else
-			startIndex = weight - lsb;
+		map<string, vector<Bit*> >::iterator it = bitsBySignal.find(signal->getName());
+		if(it == bitsBySignal.end())
+			return;
 
-		for(int i=startIndex; (unsigned)i<bits.size(); i++)
+		for(unsigned i=0; i<it->second.size(); i++)
 		{
-			for(unsigned int j=0; j<bits[i].size(); j++)
-			{
-				if(bits[i][j]->getRhsAssignment().find(signal->getName()) != string::npos)
-				{
-					bits[i][j]->type = type;
-				}
-			}
+			if(it->second[i]->weight >= weight)
+				it->second[i]->type = type;
 		}
 	}
 
@@ -612,7 +648,12 @@ namespace flopoco {
 		//add/remove the columns
 		if(newWidth < width)
 		{
-			//remove columns
+			//remove columns, their bits no longer stand for any signal
+			unsigned first = (direction == 0) ? 0 : newWidth;
+			unsigned last = (direction == 0) ? width-newWidth : width;
+			for(unsigned i=first; i<last; i++)
+				for(unsigned j=0; j<bits[i].size(); j++)
+					unindexBitBySignals(bits[i][j]);
 			if(direction == 0)
 			{
 				//remove lsb columns
@@ -697,15 +738,23 @@ namespace flopoco {
 			if(msb < bitheap->msb)
 				resizeBitheap(bitheap->msb, lsb);
 		}
-		//add the bits
-		for(int i=bitheap->lsb; i<bitheap->msb; i++) {
-			for(unsigned j=0; j<bitheap->bits[i-bitheap->lsb].size(); j++)
-				insertBitInColumn(bitheap->bits[i-bitheap->lsb][j], i-bitheap->lsb + (lsb-bitheap->lsb));
+		//add copies of the bits, from the pool of this bitheap,
+		//	so that they do not depend on the lifetime of the other bitheap
+		for(int i=bitheap->lsb; i<=bitheap->msb; i++) {
+			if((i < lsb) || (i > msb))
+			{
+				REPORT(INFO, "WARNING: in mergeBitheap, weight=" << i
+						<< " out of the bit heap range ("<< msb << ", " << lsb << ")... ignoring it");
+				continue;
+			}
+			for(unsigned j=0; j<bitheap->bits[i-bitheap->lsb].size(); j++) {
+				bitPool->push_back(*bitheap->bits[i-bitheap->lsb][j]);
+				Bit* bit = &bitPool->back();
+				bit->bitheap = this;
+				insertBitInColumn(bit, i-lsb);
+				indexBitBySignals(bit);
+			}
 		}
-		//make the bit all point to this bitheap
-		for(unsigned i=0; i<width; i++)
-			for(unsigned j=0; j<bits[i].size(); j++)
-				bits[i][j]->bitheap = this;
 
 		isCompressed = false;
 	}
@@ -771,6 +820,10 @@ namespace flopoco {
 		{
 			compressionStrategy = new OptimalCompressionStrategy(this,true);
 		}
+		else if(op->getTarget()->getCompressionMethod().compare("heuristicPortfolio") == 0)
+		{
+			compressionStrategy = new PortfolioCompressionStrategy(this);
+		}
 		else
 		{
 			THROWERROR("compression " << op->getTarget()->getCompressionMethod() << " unknown!");
@@ -875,6 +928,9 @@ namespace flopoco {
 	{
 		if((weight < lsb) || (weight > msb))
 			THROWERROR("Invalid argument for printColumnInfo: weight=" << weight);
+		//don't walk the column for nothing, as this is called on each added bit
+		if(UserInterface::verbose < FULL)
+			return;
 
 		for(unsigned i=0; i<bits[weight-lsb].size(); i++)
 		{
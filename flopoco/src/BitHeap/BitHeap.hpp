@@ -16,6 +16,8 @@
 
 
 #include <vector>
+#include <deque>
+#include <map>
 #include <sstream>
 
 #include "Operator.hpp"
@@ -241,9 +243,11 @@ enum BitType : unsigned;
 
 		/**
 		 * @brief mark the bits of a signal added to the bitheap.
+		 * The bits are found through the index of the signals on their right-hand side,
+		 * so this does not depend on the number of bits in the bitheap.
 		 * @param signalName the signal who's bits to mark
 		 * @param type how the bits should be marked
-		 * @param weight the weight of the signal, so as to speed-up the search
+		 * @param weight the weight of the signal, bits of lower weight are left as they are
 		 */
 		void markBits(Signal *signal, BitType type, int weight);
 
@@ -370,12 +374,26 @@ enum BitType : unsigned;
 
 		/**
 		 * @brief insert a bit into a column of bits, so that the column is ordered
-		 * in increasing lexicographical order on (cycle, critical path)
+		 * in increasing lexicographical order on (cycle, critical path).
+		 * The position is found by binary search, after the bits arriving at the same time.
 		 * @param bit the bit to insert
 		 * @param columnNumber the index of the column of bits into which to insert the bit
 		 */
 		void insertBitInColumn(Bit* bit, unsigned columnNumber);
 
+		/**
+		 * @brief add a bit to the index of the signals read by its right-hand side
+		 * @param bit the bit to index
+		 */
+		void indexBitBySignals(Bit* bit);
+
+		/**
+		 * @brief remove a bit from the index of the signals read by its right-hand side,
+		 * once it leaves the bitheap
+		 * @param bit the bit to remove from the index
+		 */
+		void unindexBitBySignals(Bit* bit);
+
 		// Quick hack for The Book
 		void latexPlot();
 
@@ -409,6 +427,9 @@ enum BitType : unsigned;
 		vector<vector<Bit*> > bits;                 /**< The bits currently contained in the bitheap, ordered into columns by weight in the bitheap,
 		                                                 and by arrival time of the bits, i.e. lexicographic order on (cycle, cp), inside each column. */
 		vector<vector<Bit*> > history;              /**< All the bits that have been added (and possibly removed at some point) to the bitheap. */
+		deque<Bit>* bitPool;                        /**< The storage of the bits of the bitheap, allocated in chunks and freed with it.
+		                                                 A deque does not move its elements when growing, so the Bit* stay valid. */
+		map<string, vector<Bit*> > bitsBySignal;    /**< The bits added to the bitheap, indexed by the names of the signals on their right-hand side */
 		mpz_class constantBits;						/**< The sum of all the constant bits that need to be added to the bit heap
 				                                                 (constants added to the bitheap, for rounding, two's complement etc) */
 
@@ -280,6 +280,23 @@ namespace flopoco{
 
 
 
+    float CompressionStrategy::getSolutionArea(){
+        float totalArea = 0.0;
+        for(unsigned int s = 0; s + 1 < bitAmount.size(); s++){
+            for(unsigned int c = 0; c < bitAmount[s].size(); c++){
+                vector<pair<BasicCompressor *, unsigned int> > compressors = solution.getCompressorsAtPosition(s, c);
+                for(unsigned int j = 0; j < compressors.size(); j++){
+                    totalArea += compressors[j].first->getArea(compressors[j].second);
+                }
+            }
+        }
+        return totalArea;
+    }
+
+    void CompressionStrategy::bitAmountAlgorithm(){
+        THROWERROR("this compression strategy does not work on bitAmount only");
+    }
+
     void CompressionStrategy::applyAllCompressorsFromSolution(){
 		REPORT(DEBUG, "applying all compressors");
 
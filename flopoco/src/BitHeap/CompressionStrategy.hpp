@@ -25,6 +25,8 @@ class BitheapPlotter;
 
 	class CompressionStrategy
 	{
+		friend class PortfolioCompressionStrategy;
+
 	public:
 
 		/**
@@ -35,7 +37,7 @@ class BitheapPlotter;
 		/**
 		 * Destructor
 		 */
-		~CompressionStrategy();
+		virtual ~CompressionStrategy();
 
 
 		/**
@@ -51,6 +53,14 @@ class BitheapPlotter;
 		 */
 		virtual void compressionAlgorithm() = 0;
 
+		/**
+		 * @brief generates the compressor tree on bitAmount only, putting the compressors into solution.
+		 *        No VHDL is written and the bitheap is not touched, so several strategies of the same
+		 *        bitheap can run it side by side (see PortfolioCompressionStrategy).
+		 *        Throws for the strategies that do not work on bitAmount.
+		 */
+		virtual void bitAmountAlgorithm();
+
 		/**
 		 * @brief start a new round of compression of the bitheap using compressors
 		 *        only bits that are within at most a given delay from the soonest
@@ -227,6 +237,11 @@ class BitheapPlotter;
           */
         void printSolutionStatistics();
 
+        /**
+          * @brief returns the area of the compressors of the solution, in LUT-equivalents
+          */
+        float getSolutionArea();
+
 
 
         /**
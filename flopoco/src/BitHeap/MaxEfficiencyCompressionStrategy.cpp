@@ -49,6 +49,11 @@ namespace flopoco{
 
 	}
 
+	void MaxEfficiencyCompressionStrategy::bitAmountAlgorithm()
+	{
+		maxEfficiencyAlgorithm();
+	}
+
 	void MaxEfficiencyCompressionStrategy::maxEfficiencyAlgorithm(){
 
 
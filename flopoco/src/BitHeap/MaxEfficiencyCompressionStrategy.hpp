@@ -25,6 +25,11 @@ class BitHeap;
 		 */
 		void compressionAlgorithm();
 
+		/**
+		 *	@brief runs maxEfficiencyAlgorithm() alone, for the portfolio
+		 */
+		void bitAmountAlgorithm();
+
 		/**
 		 * generates the compressor tree
 		 */
@@ -48,6 +48,11 @@ namespace flopoco{
 	}
 
 
+	void ParandehAfsharCompressionStrategy::bitAmountAlgorithm()
+	{
+		parandehAfshar();
+	}
+
 	void ParandehAfsharCompressionStrategy::parandehAfshar(){
 		REPORT(DEBUG, " in parandehAfsahr algorithm");
 
@@ -0,0 +1,100 @@
+
+#include "PortfolioCompressionStrategy.hpp"
+#include "MaxEfficiencyCompressionStrategy.hpp"
+#include "ParandehAfsharCompressionStrategy.hpp"
+
+#include <thread>
+
+
+using namespace std;
+
+namespace flopoco{
+
+
+	PortfolioCompressionStrategy::PortfolioCompressionStrategy(BitHeap* bitheap) : CompressionStrategy(bitheap)
+	{
+
+	}
+
+	PortfolioCompressionStrategy::~PortfolioCompressionStrategy()
+	{
+		for(unsigned int i = 0; i < heuristics.size(); i++){
+			delete heuristics[i].second;
+		}
+	}
+
+
+	void PortfolioCompressionStrategy::compressionAlgorithm()
+	{
+		REPORT(DEBUG, "compressionAlgorithm is portfolio");
+
+		//adds the Bits to stages and columns, this schedules the operator so it is done once, here
+		orderBitsByColumnAndStage();
+
+		//populates bitAmount, which every heuristic gets a copy of
+		fillBitAmounts();
+
+		//prints out how the inputbits of the bitheap looks like
+		printBitAmounts();
+
+		//the constructors generate the compressors and use the operator, so they are not run in parallel
+		heuristics.push_back(make_pair(string("heuristicMaxEff"), (CompressionStrategy*) new MaxEfficiencyCompressionStrategy(bitheap)));
+		heuristics.push_back(make_pair(string("heuristicPA"), (CompressionStrategy*) new ParandehAfsharCompressionStrategy(bitheap)));
+		for(unsigned int i = 0; i < heuristics.size(); i++){
+			CompressionStrategy* heuristic = heuristics[i].second;
+			heuristic->orderCompressorsByCompressionEfficiency();
+			heuristic->bitAmount = bitAmount;
+			heuristic->solution = BitHeapSolution();
+			heuristic->solution.setSolutionStatus(BitheapSolutionStatus::HEURISTIC_PARTIAL);
+		}
+
+		//each heuristic only works on its own bitAmount, compressors and solution
+		vector<thread> threads;
+		vector<string> errors(heuristics.size());
+		for(unsigned int i = 0; i < heuristics.size(); i++){
+			threads.push_back(thread([this, i, &errors](){
+				try{
+					heuristics[i].second->bitAmountAlgorithm();
+				}
+				catch(const string& e){
+					errors[i] = e;
+				}
+			}));
+		}
+		for(unsigned int i = 0; i < threads.size(); i++){
+			threads[i].join();
+		}
+
+		int best = -1;
+		float bestArea = 0.0;
+		for(unsigned int i = 0; i < heuristics.size(); i++){
+			CompressionStrategy* heuristic = heuristics[i].second;
+			if(!errors[i].empty()){
+				REPORT(INFO, heuristics[i].first << " failed: " << errors[i]);
+				continue;
+			}
+			float area = heuristic->getSolutionArea();
+			REPORT(DETAILED, heuristics[i].first << " needs an area of " << area << " LUTs in " << heuristic->bitAmount.size() - 1 << " stages");
+			if(best < 0 || area < bestArea || (area == bestArea && heuristic->bitAmount.size() < heuristics[best].second->bitAmount.size())){
+				best = i;
+				bestArea = area;
+			}
+		}
+		if(best < 0){
+			THROWERROR("no heuristic of the portfolio found a compressor tree");
+		}
+		REPORT(DETAILED, "applying the compressor tree of " << heuristics[best].first);
+
+		//the solution refers to the compressors of the heuristic, which stays alive until this strategy is deleted
+		solution = heuristics[best].second->solution;
+		bitAmount = heuristics[best].second->bitAmount;
+
+		//reports the area in LUT-equivalents
+		printSolutionStatistics();
+
+		//here the VHDL-Code for the compressors as well as the bits->compressors->bits are being written.
+		applyAllCompressorsFromSolution();
+
+	}
+
+}
@@ -0,0 +1,38 @@
+#ifndef PORTFOLIOCOMPRESSIONSTRATEGY_HPP
+#define PORTFOLIOCOMPRESSIONSTRATEGY_HPP
+
+#include "BitHeap/CompressionStrategy.hpp"
+#include "BitHeap/BitHeap.hpp"
+
+namespace flopoco
+{
+
+class BitHeap;
+
+	/**
+	 * Runs the heuristics working on bitAmount (maxEfficiency and parandehAfshar) in parallel threads,
+	 * each on its own copy of the bit amounts, and applies the compressor tree of least area,
+	 * or of fewest stages among the ones of equal area.
+	 */
+	class PortfolioCompressionStrategy : public CompressionStrategy
+	{
+	public:
+
+		/**
+		 * A basic constructor for a compression strategy
+		 */
+		PortfolioCompressionStrategy(BitHeap *bitheap);
+
+		~PortfolioCompressionStrategy();
+
+	private:
+		/**
+		 *	@brief starts the compression algorithm. It will call bitAmountAlgorithm() of each heuristic
+		 */
+		void compressionAlgorithm();
+
+		vector<pair<string, CompressionStrategy*> > heuristics; /**< The heuristics, which own the compressors of their solution */
+	};
+
+}
+#endif
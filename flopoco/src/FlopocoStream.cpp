@@ -42,6 +42,9 @@ namespace flopoco{
 		vhdlCode.str("");
 		vhdlCodeBuffer.str("");
 		dependenceTable.clear();
+		statements.clear();
+		statementBuffer = "";
+		lastCleanedDependence = 0;
 		codeParsed = false;
 
 		//initialize the lexing context
@@ -67,6 +70,9 @@ namespace flopoco{
 		vhdlCode.str("");
 		vhdlCodeBuffer.str("");
 		dependenceTable.clear();
+		statements.clear();
+		statementBuffer = "";
+		lastCleanedDependence = 0;
 		codeParsed = false;
 		return vhdlCode.str();
 	}
@@ -79,6 +85,8 @@ namespace flopoco{
 
 		if(op->noParseNoSchedule()) {
 			vhdlCode << vhdlCodeBuffer.str();			
+			statementBuffer += vhdlCodeBuffer.str();
+			buildStatements();
 			codeParsed = true;
 			vhdlCodeBuffer.str("");
 		}
@@ -108,6 +116,12 @@ namespace flopoco{
 							exit(1);
 						}
 
+					//the entries of the previous flush are cleaned up a second time, as they were
+					//	when the whole table was cleaned up at each flush; after that they no longer change
+					lastCleanedDependence = std::min(lastCleanedDependence, dependenceTable.size());
+					cleanupDependenceTable(lastCleanedDependence);
+					lastCleanedDependence = dependenceTable.size();
+
 					//the temporary table is used to update the dependence table  member of FlopocoStream
 					//	this also empties the lexer's dependence table
 					vector<triplet<string, string, int>>::iterator iter;
@@ -115,16 +129,19 @@ namespace flopoco{
 						dependenceTable.push_back(make_triplet(iter->first, iter->second, iter->third));
 					}
 					lexer->dependenceTable -> clear();
+					delete lexer;
 					// updateDependenceTable();
 					
 					//set the flag for code parsing and reset the vhdl code buffer
 					codeParsed = true;
 					vhdlCodeBuffer.str("");
-					//fix the dependence table in case of (rhs1, rhs2) <= ... 
-					cleanupDependenceTable();
+					//fix the new entries of the dependence table in case of (rhs1, rhs2) <= ... 
+					cleanupDependenceTable(lastCleanedDependence);
 
 					//the newly processed code is appended to the existing one
 					vhdlCode << bufferCode.str();
+					statementBuffer += bufferCode.str();
+					buildStatements();
 				}
 		}
 	}
@@ -135,6 +152,7 @@ namespace flopoco{
 		vhdlCodeBuffer.str("");
 		vhdlCode.str("");
 		vhdlCode << code;
+		statementBuffer = "";
 		codeParsed = true;
 	}
 
@@ -161,11 +179,11 @@ namespace flopoco{
 	}
 
 
-	void FlopocoStream::cleanupDependenceTable()
+	void FlopocoStream::cleanupDependenceTable(size_t from)
 	{
 		vector<triplet<string, string, int>> newDependenceTable;
 
-		for(int i=0; (unsigned)i<dependenceTable.size(); i++)
+		for(size_t i=from; i<dependenceTable.size(); i++)
 		{
 			string lhsName = dependenceTable[i].first;
 			string rhsName = dependenceTable[i].second;
@@ -236,14 +254,275 @@ namespace flopoco{
 			}
 		}
 
-		//clear the old values in the dependence table
-		dependenceTable.clear();
+		//replace the processed values in the dependence table
+		dependenceTable.erase(dependenceTable.begin()+from, dependenceTable.end());
+		dependenceTable.insert(dependenceTable.end(), newDependenceTable.begin(), newDependenceTable.end());
+	}
 
-		//add the new values to the dependence table
-		for(unsigned int i=0; i<newDependenceTable.size(); i++)
-		{
-			dependenceTable.push_back(newDependenceTable[i]);
+
+	void FlopocoStream::buildStatements(bool final)
+	{
+		size_t currentPos = 0;
+		size_t nextLhsMark = statementBuffer.find('?');
+		size_t nextRhsMark = statementBuffer.find('$');
+		bool waitingForSemicolon = false;
+
+		//a statement starts at its first mark: ??lhsName for most of them,
+		//	$$selectName for the selected signal assignments
+		while(true)
+			{
+				if(nextLhsMark < currentPos)
+					nextLhsMark = statementBuffer.find('?', currentPos);
+				if(nextRhsMark < currentPos)
+					nextRhsMark = statementBuffer.find('$', currentPos);
+				size_t markPos = std::min(nextLhsMark, nextRhsMark);
+				if(markPos == string::npos)
+					break;
+
+				size_t endPos = statementBuffer.find(';', markPos);
+				if(endPos == string::npos) {
+					if(!final) {
+						waitingForSemicolon = true;
+						break;
+					}
+					endPos = statementBuffer.size()-1;
+				}
+
+				statements.push_back(parseStatement(statementBuffer.substr(currentPos, markPos-currentPos),
+				                                    statementBuffer.substr(markPos+2, endPos+1-markPos-2),
+				                                    nextRhsMark < nextLhsMark));
+				currentPos = endPos+1;
+			}
+
+		//code without marks up to the last semicolon cannot be part of a later statement
+		//	(the label of an instance is kept with it, the instance name is read from there)
+		size_t textEnd = currentPos;
+		if(final)
+			textEnd = statementBuffer.size();
+		else if(!waitingForSemicolon) {
+			size_t lastSemicolon = statementBuffer.rfind(';');
+			if((lastSemicolon != string::npos) && (lastSemicolon >= currentPos))
+				textEnd = lastSemicolon+1;
 		}
+		if(textEnd > currentPos)
+			statements.push_back(textStatement(statementBuffer.substr(currentPos, textEnd-currentPos)));
+		statementBuffer.erase(0, textEnd);
+	}
+
+
+	vector<VHDLStatement>& FlopocoStream::getStatements(){
+		if(!codeParsed)
+			flushAndParseAndBuildDependencyTable();
+		buildStatements(true);
+		return statements;
+	}
+
+
+	VHDLStatement FlopocoStream::textStatement(string code)
+	{
+		VHDLStatement st;
+		st.type = VHDLStatement::text;
+		addText(st, code);
+		return st;
+	}
+
+
+	void FlopocoStream::addText(VHDLStatement &st, string code)
+	{
+		if(code.empty())
+			return;
+		VHDLToken t;
+		t.type = VHDLToken::text;
+		t.code = code;
+		t.functionalDelay = 0;
+		st.tokens.push_back(t);
+	}
+
+
+	void FlopocoStream::addSignal(VHDLStatement &st, VHDLToken::TokenType type, string code, string signalName, int functionalDelay, string formalName)
+	{
+		VHDLToken t;
+		t.type = type;
+		t.code = code;
+		t.signalName = signalName;
+		t.formalName = formalName;
+		t.functionalDelay = functionalDelay;
+		st.tokens.push_back(t);
+	}
+
+
+	//remove the possible parentheses around a rhsName
+	static string stripParentheses(string rhsName)
+	{
+		if(rhsName.find("(") != string::npos)
+			return rhsName.substr(rhsName.find("(")+1, rhsName.find(")")-rhsName.find("(")-1);
+		return rhsName;
+	}
+
+
+	VHDLStatement FlopocoStream::parseStatement(string prefix, string workStr, bool isSelectedAssignment)
+	{
+		VHDLStatement st;
+		string lhsName, rhsName;
+		size_t auxPosition, lhsNameLength, tmpCurrentPos, tmpNextPos;
+
+		addText(st, prefix);
+
+		//extract the lhsName
+		if(isSelectedAssignment) {
+			size_t lhsNameStart = workStr.find('?');
+			size_t lhsNameStop  = workStr.find('?', lhsNameStart+2);
+			lhsName = workStr.substr(lhsNameStart+2, lhsNameStop-lhsNameStart-2);
+			auxPosition = lhsNameStop+2;
+		}else{
+			lhsName = workStr.substr(0, workStr.find('?'));
+			addText(st, lhsName);
+			auxPosition = lhsName.size()+2;
+		}
+		lhsNameLength = lhsName.size();
+
+		//check for component instances
+		//	the first parse marks the name of the component as a lhsName
+		//	the rest of the code contains pairs of ??formalName?? => $$actualName$$
+		size_t portMapPos = workStr.find("port map"); // not checking capitalization is OK because this string can only be created by flopoco
+		if(portMapPos != string::npos) {
+			st.type = VHDLStatement::instance;
+			st.lhsName = lhsName;
+			//the instance name is the word before the ":"
+			size_t colonPos = prefix.rfind(':');
+			if(colonPos != string::npos) {
+				size_t spacePos = prefix.rfind(' ', colonPos);
+				size_t beginPos = (spacePos == string::npos ? 0 : spacePos+1);
+				st.instanceName = prefix.substr(beginPos, colonPos-beginPos);
+			}
+
+			tmpCurrentPos = workStr.find("?", portMapPos);
+			if(tmpCurrentPos == string::npos) {
+				//empty port mapping
+				addText(st, workStr.substr(auxPosition, workStr.size()));
+				return st;
+			}
+			//copy the code up to the port mappings
+			addText(st, workStr.substr(auxPosition, tmpCurrentPos-auxPosition));
+
+			//parse a list of ??formalName?? => $$actualName$$
+			//	or ??formalName?? => 'x' or ??formalName?? => "xxxx" or ??formalName?? => open
+			while(tmpCurrentPos != string::npos) {
+				bool singleQuoteSep = false, doubleQuoteSep = false, open = false;
+
+				tmpNextPos = workStr.find("?", tmpCurrentPos+2);
+				string formalName = workStr.substr(tmpCurrentPos+2, tmpNextPos-tmpCurrentPos-2);
+				addText(st, formalName);
+
+				//the code up to the actual
+				tmpCurrentPos = tmpNextPos+2;
+				tmpNextPos = workStr.find("$", tmpCurrentPos);
+				if(workStr.find("\'", tmpCurrentPos) < tmpNextPos) {
+					tmpNextPos = workStr.find("\'", tmpCurrentPos);
+					singleQuoteSep = true;
+				}
+				else if(workStr.find("\"", tmpCurrentPos) < tmpNextPos) {
+					tmpNextPos = workStr.find("\"", tmpCurrentPos);
+					doubleQuoteSep = true;
+				}
+				else if(workStr.find("open", tmpCurrentPos) < tmpNextPos) {
+					tmpNextPos = workStr.find("open", tmpCurrentPos);
+					open = true;
+				}
+				addText(st, workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos));
+
+				//the actual: a 1-bit constant, a multiple bit constant, open, or a signal name
+				if(singleQuoteSep) {
+					tmpCurrentPos = tmpNextPos+1;
+					tmpNextPos = workStr.find("\'", tmpCurrentPos);
+					addText(st, "\'" + workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos) + "\'");
+				}
+				else if(doubleQuoteSep) {
+					tmpCurrentPos = tmpNextPos+1;
+					tmpNextPos = workStr.find("\"", tmpCurrentPos);
+					addText(st, "\"" + workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos) + "\"");
+				}
+				else if(open) {
+					//"open" itself is copied with the code that follows
+					tmpNextPos = tmpNextPos-1;
+				}
+				else {
+					tmpCurrentPos = tmpNextPos+2;
+					tmpNextPos = workStr.find("$", tmpCurrentPos);
+					rhsName = workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos);
+					addSignal(st, VHDLToken::portActual, rhsName, rhsName, 0, formalName);
+				}
+
+				//copy the code up to the next pair
+				size_t skip = (singleQuoteSep || doubleQuoteSep || open ? 1 : 2);
+				tmpCurrentPos = workStr.find("?", tmpNextPos+2);
+				if(tmpCurrentPos != string::npos)
+					addText(st, workStr.substr(tmpNextPos+skip, tmpCurrentPos-tmpNextPos-skip));
+				else
+					addText(st, workStr.substr(tmpNextPos+skip, workStr.size()));
+			}
+			return st;
+		}
+
+		//the lhsName could be of the form (lhsName1, lhsName2, ...)
+		//	the first name in the list is the one that gets scheduled
+		if(lhsName[0] == '(') {
+			size_t count = 1;
+			while((count < lhsName.size()) && (lhsName[count] != ' ') && (lhsName[count] != '\t')
+			      && (lhsName[count] != ',') && (lhsName[count] != ')'))
+				count++;
+			lhsName = lhsName.substr(1, count-1);
+		}
+		st.lhsName = lhsName;
+		st.type = (isSelectedAssignment ? VHDLStatement::selectedAssignment : VHDLStatement::assignment);
+
+		//"with selectName select lhsName <= ...": the select signal, which belongs to the right-hand side,
+		//	comes before the left hand side signal
+		if(isSelectedAssignment) {
+			tmpNextPos = workStr.find('$');
+			rhsName = workStr.substr(0, tmpNextPos);
+			// No functional register possible here
+			addSignal(st, VHDLToken::rhsSignal, rhsName, stripParentheses(rhsName), 0);
+
+			//copy the code up until the lhs signal name, then the lhs signal name
+			tmpCurrentPos = tmpNextPos+2;
+			tmpNextPos = workStr.find('?', tmpCurrentPos);
+			addText(st, workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos));
+			addText(st, lhsName);
+
+			tmpCurrentPos = tmpNextPos+4+lhsNameLength;
+			tmpNextPos = workStr.find('$', tmpCurrentPos);
+			if(tmpNextPos == string::npos) {
+				addText(st, workStr.substr(tmpCurrentPos, workStr.size()-tmpCurrentPos));
+				return st;
+			}
+		}
+		// The lexer adds spaces around select, so a signal with select in its name is not a match
+		if(!isSelectedAssignment || (workStr.find(" select ") == string::npos)) {
+			tmpCurrentPos = lhsNameLength+2;
+			tmpNextPos = workStr.find('$', tmpCurrentPos);
+		}
+
+		//extract the $$rhsName$$, possibly of the form ID_Name^nb_cycles for a functional register
+		while(tmpNextPos != string::npos) {
+			addText(st, workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos));
+			tmpNextPos += 2;
+			rhsName = workStr.substr(tmpNextPos, workStr.find('$', tmpNextPos)-tmpNextPos);
+			string newRhsName = stripParentheses(rhsName);
+			int functionalDelay = 0;
+			if(newRhsName.find('^') != string::npos) {
+				functionalDelay = stoi(newRhsName.substr(newRhsName.find('^')+1));
+				newRhsName = newRhsName.substr(0, newRhsName.find('^'));
+			}
+			addSignal(st, VHDLToken::rhsSignal, newRhsName, newRhsName, functionalDelay);
+
+			tmpCurrentPos = tmpNextPos + rhsName.size() + 2;
+			tmpNextPos = workStr.find('$', tmpCurrentPos);
+		}
+		//copy the code that is left up until the end of the statement
+		addText(st, workStr.substr(tmpCurrentPos, workStr.size()-tmpCurrentPos));
+
+		return st;
 	}
 
 }
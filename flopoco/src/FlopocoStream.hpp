@@ -31,6 +31,45 @@ namespace flopoco{
 	//forward reference to FlopocoStream, in order to overload the << stream operator
 	class FlopocoStream;
 
+	/**
+	 * A piece of a lexed VHDL statement, as seen by the second (scheduling) pass:
+	 * either code that is printed as is, or a signal reference that may get a _dxxx suffix.
+	 */
+	struct VHDLToken {
+		typedef enum {
+			text,       /**< VHDL code printed verbatim */
+			rhsSignal,  /**< a right-hand side signal, delayed to the cycle of the left-hand side */
+			portActual  /**< a signal connected to a port of an instance */
+		} TokenType;
+
+		TokenType type;
+		string code;            /**< the code, or the name printed for the signal */
+		string signalName;      /**< the name under which the signal is looked up */
+		string formalName;      /**< for portActual, the port of the subcomponent */
+		int functionalDelay;    /**< for rhsSignal, the delay of a functional register (ID_Name^nb_cycles) */
+		string delay;           /**< the _dxxx suffix printed after the signal by the second pass, if any */
+	};
+
+	/**
+	 * One statement of the lexed VHDL code.
+	 * The statements are built once, when the lexer output is flushed, and
+	 * applySchedule() walks them to print the final VHDL in a single pass.
+	 * They are kept afterwards, with the delays of their signals, for outputVerilog().
+	 */
+	struct VHDLStatement {
+		typedef enum {
+			text,                 /**< code without signal marks (declarations, comments...) */
+			assignment,           /**< lhs <= ...; possibly conditional */
+			selectedAssignment,   /**< with sel select lhs <= ... */
+			instance              /**< label: Component port map (...) */
+		} StatementType;
+
+		StatementType type;
+		string lhsName;         /**< the left-hand side signal (the first one of a tuple), or the component name of an instance */
+		string instanceName;    /**< for instances, the instance label */
+		vector<VHDLToken> tokens;
+	};
+
 	/**
 	 * The FlopocoStream class.
 	 * Segments of code having the same pipeline informations are scanned
@@ -41,6 +80,8 @@ namespace flopoco{
 	 * The signals with delays are marked as well (ID_Name becomes ID_Name^nb_cycles (pipeline delay)
 	 * or ID_Name^nb_cycles (functional delay)).
 	 * The assignment statements are appended with the name of the left-hand signal (??ID_Name??).
+	 * The marked code is then cut once into a list of VHDLStatement, on which
+	 * the second pass inserts the delays.
 	 */
 	class FlopocoStream{
 		public:
@@ -145,7 +186,7 @@ namespace flopoco{
 
 			/**
 			 * Member function used to set the code resulted after a second parsing
-			 * was performed
+			 * was performed. The statements the code was printed from are kept.
 			 * @param[in] code the 2nd parse level code
 			 */
 			void setSecondLevelCode(string code);
@@ -166,8 +207,23 @@ namespace flopoco{
 			 * of an assignment.
 			 * Because of the parsing stage, lhsName might be of the form (lhsName1, lhsName2, ...),
 			 * which must be fixed.
+			 * @param[in] from only the entries from this index on are processed
 			 */
-			void cleanupDependenceTable();
+			void cleanupDependenceTable(size_t from=0);
+
+			/**
+			 * Cuts the marked code received from the lexer into statements.
+			 * A statement starts at its first mark and ends at the next semicolon.
+			 * @param[in] final if true, a statement whose semicolon is still missing
+			 *                  runs to the end of the code instead of waiting for it
+			 */
+			void buildStatements(bool final=false);
+
+			/**
+			 * Flushes the buffer and returns the statements of the code, including the last
+			 * unterminated one. This is what the second parsing level works on.
+			 */
+			vector<VHDLStatement>& getStatements();
 
 
 			ostringstream vhdlCode;                                 /**< the vhdl code */
@@ -175,6 +231,10 @@ namespace flopoco{
 
 			vector<triplet<string, string, int>> dependenceTable;   /**< table containing the left-hand side - right-hand side dependences, with the possible delay on the edge */
 
+			vector<VHDLStatement> statements;                      /**< the lexed code, cut into statements */
+			string statementBuffer;                                 /**< lexed code not yet cut into statements (a statement waiting for its semicolon) */
+			size_t lastCleanedDependence;                           /**< the dependences added by the previous flush start here */
+
 			//the lexing context
 			string lexLhsName;
 			vector<string> lexExtraRhsNames;
@@ -185,6 +245,20 @@ namespace flopoco{
 
 		protected:
 
+			/**
+			 * Cuts one marked statement into tokens, the same way the second parsing level used to read it from the code.
+			 * @param[in] prefix               the unmarked code before the statement
+			 * @param[in] workStr              the statement, from its first mark (without the mark) up to its semicolon
+			 * @param[in] isSelectedAssignment true if the statement starts with the select signal ($$selectName$$)
+			 */
+			static VHDLStatement parseStatement(string prefix, string workStr, bool isSelectedAssignment);
+
+			static VHDLStatement textStatement(string code);
+
+			static void addText(VHDLStatement &st, string code);
+
+			static void addSignal(VHDLStatement &st, VHDLToken::TokenType type, string code, string signalName, int functionalDelay, string formalName="");
+
 			Operator *op=0;
 			bool codeParsed;
 	};
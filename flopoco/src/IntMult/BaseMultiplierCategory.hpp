@@ -63,6 +63,7 @@ namespace flopoco {
 					bool isFlippedXY() const {return isFlippedXY_;}
 					int getShapePara() const {return shape_para_;}
 				    string getMultType() const {return bmCat_->getType();}
+                    BaseMultiplierCategory const * getMultCategory() const {return bmCat_;}
                     Parametrization tryDSPExpand(int m_x_pos, int m_y_pos, int wX, int wY, bool signedIO);
                     vector<int> getOutputWeights(){return output_weights;}
 
@@ -32,6 +32,7 @@
 #include "TilingStrategyGreedy.hpp"
 #include "TilingStrategyXGreedy.hpp"
 #include "TilingStrategyBeamSearch.hpp"
+#include "TilingStrategyPortfolio.hpp"
 #include "TilingAndCompressionOptILP.hpp"
 
 using namespace std;
@@ -190,6 +191,24 @@ namespace flopoco {
                     multiplierTileCollection,
                     beamRange
             );
+        }
+        else if(tilingMethod.compare("portfolio") == 0) {
+            tilingStrategy = new TilingStrategyPortfolio(
+                    wX,
+                    wY,
+                    wOut + guardBits,
+                    signedIO,
+                    &baseMultiplierCollection,
+                    baseMultiplierCollection.getPreferedMultiplier(),
+                    dspOccupationThreshold,
+                    maxDSP,
+                    useirregular,
+                    use2xk,
+                    superTiles,
+                    useKaratsuba,
+                    multiplierTileCollection,
+                    beamRange
+            );
 		} else if(tilingMethod.compare("optimal") == 0){
             tilingStrategy = new TilingStrategyOptimalILP(
                     wX,
@@ -27,9 +27,19 @@ TilingStrategyOptimalILP::TilingStrategyOptimalILP(
 		occupation_threshold_{occupation_threshold},
 		tiles{mtc_.MultTileCollection}
 	{
-
+		timeout_ = target->getILPTimeout();
 	}
 
+void TilingStrategyOptimalILP::setStartSolution(const list<mult_tile_t>& start)
+{
+    startSolution_ = start;
+}
+
+void TilingStrategyOptimalILP::setTimeout(int timeout)
+{
+    timeout_ = timeout;
+}
+
 void TilingStrategyOptimalILP::solve()
 {
 
@@ -38,7 +48,7 @@ void TilingStrategyOptimalILP::solve()
 #else
     cout << "using ILP solver " << target->getILPSolver() << endl;
     solver = new ScaLP::Solver(ScaLP::newSolverDynamic({target->getILPSolver(),"Gurobi","CPLEX","SCIP","LPSolve"}));
-    solver->timeout = target->getILPTimeout();
+    solver->timeout = timeout_;
 
     constructProblem();
 
@@ -198,6 +208,34 @@ void TilingStrategyOptimalILP::constructProblem()
         solver->addConstraint(truncConstraint);
     }
 
+    //warm start from a known tiling, every variable it does not set is 0
+    if(!startSolution_.empty()){
+        cout << "   seeding the solver with a start solution of " << startSolution_.size() << " tiles..." << endl;
+        ScaLP::Result start;
+        for(int s = 0; s < wS; s++)
+            for(auto &column : solve_Vars[s])
+                for(auto &var : column)
+                    if(var != nullptr)
+                        start.values[var] = 0.0;
+        bool startValid = true;
+        for(auto &tile : startSolution_){
+            int s = 0;
+            while(s < wS && tiles[s] != tile.first.getMultCategory())
+                s++;
+            int xs = tile.second.first, ys = tile.second.second;
+            if(s == wS || xs + x_neg < 0 || xs >= wX || ys + y_neg < 0 || ys >= wY || solve_Vars[s][xs+x_neg][ys+y_neg] == nullptr){
+                startValid = false;
+                break;
+            }
+            start.values[solve_Vars[s][xs+x_neg][ys+y_neg]] = 1.0;
+        }
+        if(startValid){
+            solver->setStartValues(start);
+        } else {
+            cout << "   the start solution places a tile the problem has no variable for, solving without it" << endl;
+        }
+    }
+
     // Set the Objective
     cout << "   setting objective (minimize cost function)..." << endl;
     solver->setObjective(ScaLP::minimize(obj));
@@ -36,6 +36,17 @@ public:
 
     void solve() override;
 
+    /**
+     * @brief seeds the solver with a known tiling, e.g. the one of a heuristic, as a warm start.
+     * The start is dropped when one of its tiles is not a variable of the problem.
+     */
+    void setStartSolution(const list<mult_tile_t>& start);
+
+    /**
+     * @brief replaces the ilpTimeout of the target, in seconds, 0 disables it
+     */
+    void setTimeout(int timeout);
+
 private:
     base_multiplier_id_t small_tile_mult_;
     size_t numUsedMults_;
@@ -43,6 +54,8 @@ private:
     float occupation_threshold_;
     int dpX, dpY, dpS, wS;
     vector<BaseMultiplierCategory*> tiles;
+    list<mult_tile_t> startSolution_;
+    int timeout_;
 #ifdef HAVE_SCALP
     void constructProblem();
 
@@ -0,0 +1,139 @@
+#include "TilingStrategyPortfolio.hpp"
+#include "TilingStrategyGreedy.hpp"
+#include "TilingStrategyXGreedy.hpp"
+#include "TilingStrategyBeamSearch.hpp"
+#include "TilingStrategyOptimalILP.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace flopoco {
+    TilingStrategyPortfolio::TilingStrategyPortfolio(
+            unsigned int wX,
+            unsigned int wY,
+            unsigned int wOut,
+            bool signedIO,
+            BaseMultiplierCollection* bmc,
+            base_multiplier_id_t prefered_multiplier,
+            float occupation_threshold,
+            size_t maxPrefMult,
+            bool useIrregular,
+            bool use2xk,
+            bool useSuperTiles,
+            bool useKaratsuba,
+            MultiplierTileCollection& tiles,
+            unsigned int beamRange):TilingStrategy(wX, wY, wOut, signedIO, bmc),
+                                prefered_multiplier_{prefered_multiplier},
+                                occupation_threshold_{occupation_threshold},
+                                max_pref_mult_{maxPrefMult},
+                                tileCollection_{tiles},
+                                bestLUTCost_{0.0},
+                                bestDSPCost_{0}
+    {
+        //the constructors share the tile collection, only the solving runs in parallel
+        heuristics_.push_back(make_pair("heuristicGreedyTiling", new TilingStrategyGreedy(wX, wY, wOut, signedIO, bmc, prefered_multiplier, occupation_threshold, maxPrefMult, useIrregular, use2xk, useSuperTiles, useKaratsuba, tiles)));
+        heuristics_.push_back(make_pair("heuristicXGreedyTiling", new TilingStrategyXGreedy(wX, wY, wOut, signedIO, bmc, prefered_multiplier, occupation_threshold, maxPrefMult, useIrregular, use2xk, useSuperTiles, useKaratsuba, tiles)));
+        heuristics_.push_back(make_pair("heuristicBeamSearchTiling", new TilingStrategyBeamSearch(wX, wY, wOut, signedIO, bmc, prefered_multiplier, occupation_threshold, maxPrefMult, useIrregular, use2xk, useSuperTiles, useKaratsuba, tiles, beamRange)));
+    }
+
+    TilingStrategyPortfolio::~TilingStrategyPortfolio() {
+        for(auto& heuristic: heuristics_) {
+            delete heuristic.second;
+        }
+    }
+
+    bool TilingStrategyPortfolio::evaluate(const list<mult_tile_t>& tiling, double& lutCost, unsigned int& dspCost) {
+        lutCost = 0.0;
+        dspCost = 0;
+        for(auto& tile: tiling) {
+            //greedy with 2xk tiles places categories of its own, so cost every tile from its category rather than the collection
+            //getLUTCost only computes, it is just not declared const
+            BaseMultiplierCategory* category = const_cast<BaseMultiplierCategory*>(tile.first.getMultCategory());
+            if(category == nullptr) {
+                return false;
+            }
+            lutCost += category->getLUTCost(tile.second.first, tile.second.second, wX, wY);
+            dspCost += category->getDSPCost();
+        }
+        return true;
+    }
+
+    void TilingStrategyPortfolio::offer(const string& name, const list<mult_tile_t>& tiling) {
+        double lutCost;
+        unsigned int dspCost;
+        if(tiling.empty() || !evaluate(tiling, lutCost, dspCost)) {
+            cout << "Portfolio: " << name << " gave no tiling, ignored" << endl;
+            return;
+        }
+        if(dspCost > max_pref_mult_) {
+            cout << "Portfolio: " << name << " uses " << dspCost << " DSPs, over the limit of " << max_pref_mult_ << ", ignored" << endl;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(bestMutex_);
+        cout << "Portfolio: " << name << " costs " << lutCost << " LUTs and " << dspCost << " DSPs" << endl;
+        if(solution.empty() || lutCost < bestLUTCost_ || (lutCost == bestLUTCost_ && dspCost < bestDSPCost_)) {
+            solution = tiling;
+            bestName_ = name;
+            bestLUTCost_ = lutCost;
+            bestDSPCost_ = dspCost;
+        }
+    }
+
+    void TilingStrategyPortfolio::solve() {
+        auto start = std::chrono::steady_clock::now();
+
+        vector<std::thread> threads;
+        vector<string> errors(heuristics_.size());
+        for(unsigned int i = 0; i < heuristics_.size(); i++) {
+            threads.push_back(std::thread([this, i, &errors]() {
+                try {
+                    heuristics_[i].second->solve();
+                    offer(heuristics_[i].first, heuristics_[i].second->getSolution());
+                }
+                catch(const string& e) {
+                    errors[i] = e;
+                }
+                catch(...) {
+                    errors[i] = "unknown error";
+                }
+            }));
+        }
+        for(auto& thread: threads) {
+            thread.join();
+        }
+        for(unsigned int i = 0; i < heuristics_.size(); i++) {
+            if(!errors[i].empty()) {
+                cout << "Portfolio: " << heuristics_[i].first << " failed: " << errors[i] << endl;
+            }
+        }
+
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        cout << "Portfolio: heuristics done in " << elapsed << "s, best is " << bestName_ << endl;
+
+#ifdef HAVE_SCALP
+        //the ILP gets what the heuristics left of the budget, 0 means no timeout
+        int timeout = target->getILPTimeout();
+        if(timeout > 0) {
+            timeout = std::max(1, timeout - (int)elapsed);
+        }
+        TilingStrategyOptimalILP ilp(wX, wY, wOut, signedIO, baseMultiplierCollection, prefered_multiplier_, occupation_threshold_, max_pref_mult_, tileCollection_);
+        ilp.setTimeout(timeout);
+        if(!solution.empty()) {
+            ilp.setStartSolution(solution);
+        }
+        try {
+            ilp.solve();
+            offer("optimal", ilp.getSolution());
+        }
+        catch(...) {
+            cout << "Portfolio: the ILP solver failed, keeping the tiling of " << bestName_ << endl;
+        }
+#endif
+
+        if(solution.empty()) {
+            throw string("TilingStrategyPortfolio::solve(): none of the strategies found a tiling");
+        }
+        cout << "Portfolio: keeping the tiling of " << bestName_ << ", " << bestLUTCost_ << " LUTs and " << bestDSPCost_ << " DSPs" << endl;
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef FLOPOCO_TILINGSTRATEGYPORTFOLIO_HPP
+#define FLOPOCO_TILINGSTRATEGYPORTFOLIO_HPP
+
+#include <mutex>
+
+#include "TilingStrategy.hpp"
+#include "MultiplierTileCollection.hpp"
+
+namespace flopoco {
+
+/*!
+ * The TilingStrategyPortfolio class runs the greedy, XGreedy and beam search tilings in parallel threads and keeps
+ * the cheapest of their solutions. With ScaLP, this solution then seeds the optimal ILP tiling as a warm start,
+ * which gets what the heuristics left of the ilpTimeout budget and replaces it only if it found a cheaper one.
+ */
+    class TilingStrategyPortfolio : public TilingStrategy {
+    public:
+        TilingStrategyPortfolio(
+                unsigned int wX,
+                unsigned int wY,
+                unsigned int wOut,
+                bool signedIO,
+                BaseMultiplierCollection* bmc,
+                base_multiplier_id_t prefered_multiplier,
+                float occupation_threshold,
+                size_t maxPrefMult,
+                bool useIrregular,
+                bool use2xk,
+                bool useSuperTiles,
+                bool useKaratsuba,
+                MultiplierTileCollection& tiles,
+                unsigned int beamRange);
+        ~TilingStrategyPortfolio();
+        void solve() override;
+
+        /**
+         * @brief computes the LUT cost and the DSP count of a tiling, from the category of each tile.
+         * Only reads the tiles, so the solving threads can call it concurrently.
+         * @return false if a tile has no category
+         */
+        bool evaluate(const list<mult_tile_t>& tiling, double& lutCost, unsigned int& dspCost);
+
+    private:
+        /**
+         * @brief keeps the tiling if it is the cheapest one so far: least LUT cost within the DSP limit, then least DSPs
+         */
+        void offer(const string& name, const list<mult_tile_t>& tiling);
+
+        base_multiplier_id_t prefered_multiplier_;
+        float occupation_threshold_;
+        size_t max_pref_mult_;
+        MultiplierTileCollection& tileCollection_;
+        vector<pair<string, TilingStrategy*>> heuristics_;
+
+        std::mutex bestMutex_;          /**< guards the best solution, which the heuristic threads offer to */
+        string bestName_;
+        double bestLUTCost_;
+        unsigned int bestDSPCost_;
+    };
+}
+
+
+#endif
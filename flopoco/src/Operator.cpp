@@ -44,6 +44,7 @@
 #include <set>
 #include "Operator.hpp"  // Useful only for reporting. TODO split out the REPORT and THROWERROR #defines from Operator to another include.
 #include "utils.hpp"
+#include "VHDLToVerilog.hpp"
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <boost/random/normal_distribution.hpp>
@@ -67,6 +68,9 @@ namespace flopoco{
 		stdLibType_                 = 0;						// unfortunately this is the historical default.
 		target_                     = target;
 		pipelineDepth_              = 0;
+		cost                        = 0;
+		creationTime_               = std::chrono::steady_clock::now();
+		generationTime_             = -1;
 
 		myuid                       = getNewUId();
 		architectureName_			= "arch";
@@ -118,6 +122,7 @@ namespace flopoco{
 
 
 	void Operator::addSubComponent(OperatorPtr op) {
+		op->markGenerated();
 		// Check it is already present
 		OperatorPtr alreadyPresent=nullptr;
 		for (auto i: subComponentList_){
@@ -760,6 +765,10 @@ namespace flopoco{
 		this->outputVHDL(o, this->uniqueName_);
 	}
 
+	void Operator::outputVerilog(std::ostream& o) {
+		this->outputVerilog(o, this->uniqueName_);
+	}
+
 	bool Operator::isSequential() {
 		return isSequential_;
 	}
@@ -1809,6 +1818,73 @@ namespace flopoco{
 	}
 
 
+	string  Operator::buildVerilogSignalDeclarations() {
+		ostringstream o;
+
+		// as in buildVHDLSignalDeclarations(): the wires with their delayed copies, then the delayed copies of the I/Os
+		for(auto s: signalList_) {
+			if((s->type() == Signal::constant) || (s->type() == Signal::in) || (s->type() == Signal::out))
+				continue;
+			o << tab << s->toVerilogType() << " " << VHDLToVerilog::identifier(s->getName());
+			for(int j=1; j <= s->getLifeSpan(); j++)
+				o << ", " << VHDLToVerilog::identifier(s->delayedName(j));
+			o << ";" << endl;
+		}
+		for(auto s: ioList_) {
+			if(s->getLifeSpan() == 0)
+				continue;
+			o << tab << s->toVerilogType() << " " << VHDLToVerilog::identifier(s->delayedName(1));
+			for(int j=2; j <= s->getLifeSpan(); j++)
+				o << ", " << VHDLToVerilog::identifier(s->delayedName(j));
+			o << ";" << endl;
+		}
+		return o.str();
+	}
+
+
+	string  Operator::buildVerilogRegisters() {
+		ostringstream o;
+
+		if (isSequential()){
+			vector<Signal*> siglist;
+			siglist.insert( siglist.end(), signalList_.begin(), signalList_.end() );
+			siglist.insert( siglist.end(), ioList_.begin(), ioList_.end() );
+
+			// one always_ff block per reset type, as in buildVHDLRegisters()
+			string recTab = (hasClockEnable() ? tab : "");
+			ostringstream regs[3], regsinit[3];
+			for(auto s: siglist) {
+				for(int j=1; j <= s->getLifeSpan(); j++) {
+					int r = s->resetType();
+					regs[r] << recTab << tab << tab << VHDLToVerilog::identifier(s->delayedName(j)) << " <= " << VHDLToVerilog::identifier(s->delayedName(j-1)) << ";" << endl;
+					regsinit[r] << tab << tab << tab << VHDLToVerilog::identifier(s->delayedName(j)) << " <= '0;" << endl;
+				}
+			}
+
+			for(int r: {Signal::noReset, Signal::asyncReset, Signal::syncReset}) {
+				if (regs[r].str() == "")
+					continue;
+				o << tab << "always_ff @(posedge clk" << (r==Signal::asyncReset ? " or posedge rst" : "") << ")" << endl;
+				if (r == Signal::noReset)
+					o << tab << tab << "begin" << endl;
+				else {
+					o << tab << tab << "if (rst) begin" << endl;
+					o << regsinit[r].str();
+					o << tab << tab << "end" << endl;
+					o << tab << tab << "else begin" << endl;
+				}
+				if (hasClockEnable())
+					o << tab << tab << tab << "if (ce) begin" << endl;
+				o << regs[r].str();
+				if (hasClockEnable())
+					o << tab << tab << tab << "end" << endl;
+				o << tab << tab << "end" << endl;
+			}
+		}
+		return o.str();
+	}
+
+
 	void Operator::signalSignature(std::ostream &o)
 	{
 		stringstream inlist;
@@ -1889,6 +1965,22 @@ namespace flopoco{
 		return cost;
 	}
 
+	void Operator::markGenerated(){
+		if(generationTime_ < 0)
+			generationTime_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - creationTime_).count();
+	}
+
+	double Operator::getGenerationTime(){
+		return generationTime_;
+	}
+
+	double Operator::getMaxCriticalPath(){
+		double cp = 0;
+		for(auto it: signalMap_)
+			cp = max(cp, it.second->getCriticalPath());
+		return cp;
+	}
+
 	map<string, Signal*> Operator::getSignalMap(){
 		return signalMap_;
 	}
@@ -1990,416 +2082,187 @@ namespace flopoco{
 	}
 
 
+	void Operator::outputVerilog(std::ostream& o, std::string name) {
+		// same safety checks as outputVHDL(); library components have no code of their own
+		if((isShared() && (getName().find("_copy_") != string::npos))
+			 || isLibraryComponent() || vhdl.isEmpty())
+			{
+				return;
+			}
 
+		// the header comments, VHDL style converted to Verilog style
+		ostringstream header;
+		licence(header);
+		pipelineInfo(header);
+		signalSignature(header);
+		istringstream lines(header.str());
+		string line;
+		while(getline(lines, line)) {
+			if(line.compare(0, 2, "--") == 0)
+				line = "//" + line.substr(2);
+			o << line << endl;
+		}
+		o << endl;
 
-	// Comment by F2D: this whas parse2().
-	// This code is suspected to be OK except for the handling of functional delays
-	// It could probably be simplified: it is a lexer
-	void Operator::doApplySchedule()
-	{
-		ostringstream newStr;
-		string oldStr, workStr;
-		size_t currentPos, nextPos, tmpCurrentPos, tmpNextPos;
-		int count, lhsNameLength, rhsNameLength;
-		bool unknownLHSName = false, unknownRHSName = false;
+		// the widths of the signals size the (others => ...) aggregates
+		VHDLToVerilog translator(tab, [this](const string &n) {
+				try {
+					return getSignalByName(n)->width();
+				}
+				catch(...) {
+					return -1;
+				}
+			});
 
-		REPORT(DEBUG, "doApplySchedule(): entering operator " << getName());
-		REPORT(FULL, "doApplySchedule: vhdl stream after first lexing " << endl << vhdl.str());
-		//reset the new vhdl code buffer
-		newStr.str("");
-
-		//set the old code to the vhdl code stored in the FlopocoStream
-		oldStr = vhdl.str();
-
-		//iterate through the old code, one statement at the time
-		// code that doesn't need to be modified: goes directly to the new vhdl code buffer
-		// code that needs to be modified: ?? should be removed from lhs_name, $$ should be removed from rhs_name,
-		//		delays of the type rhs_name_dxxx should be added for the right-hand side signals
-		bool isSelectedAssignment = (oldStr.find('?') > oldStr.find('$'));
-		currentPos = 0;
-		nextPos = (isSelectedAssignment ? oldStr.find('$') : oldStr.find('?'));
-		while(nextPos !=  string::npos)
-			{
-				string lhsName, rhsName;
-				size_t auxPosition, auxPosition2;
-				Signal *lhsSignal, *rhsSignal;
+		o << "module " << name << " (";
+		string separator = "";
+		if(isSequential()) {
+			o << "input logic clk";
+			if(hasReset())
+				o << ", rst";
+			if(hasClockEnable())
+				o << ", ce";
+			separator = ",";
+		}
+		for(auto s: ioList_) {
+			o << separator << endl << "          " << (s->type()==Signal::in ? "input " : "output ")
+			  << s->toVerilogType() << " " << VHDLToVerilog::identifier(s->getName());
+			separator = ",";
+		}
+		o << ");" << endl << endl;
 
-				unknownLHSName = false;
-				unknownRHSName = false;
+		for(auto &t: types_)
+			o << translator.typeDeclaration(t.first, t.second);
+		for(auto &c: constants_)
+			o << translator.constantDeclaration(c.first, c.second.first, c.second.second);
+		o << buildVerilogSignalDeclarations();
+		o << endl;
+		o << buildVerilogRegisters();
+		Operator* op = (getIndirectOperator() ? getIndirectOperator() : this);
+		o << translator.statements(op->vhdl.getStatements());
+		o << "endmodule" << endl << endl;
 
-				//copy the code from the beginning to this position directly to the new vhdl buffer
-				newStr << oldStr.substr(currentPos, nextPos-currentPos);
+		if(translator.untranslated() > 0)
+			REPORT(INFO, "WARNING: " << translator.untranslated() << " VHDL construct(s) of " << name
+			       << " could not be translated to SystemVerilog and were left as comments");
+	}
 
-				//now get a new line to parse
-				workStr = oldStr.substr(nextPos+2, oldStr.find(';', nextPos)+1-nextPos-2);
 
-				REPORT(FULL, "doApplySchedule: processing " << workStr);
-				//extract the lhs_name
-				if(isSelectedAssignment == true)
-					{
-						int lhsNameStart, lhsNameStop;
 
-						lhsNameStart = workStr.find('?');
-						lhsNameStop  = workStr.find('?', lhsNameStart+2);
-						lhsName = workStr.substr(lhsNameStart+2, lhsNameStop-lhsNameStart-2);
-						auxPosition = lhsNameStop+2;
-					}else
-					{
-						lhsName = workStr.substr(0, workStr.find('?'));
 
-						//copy lhsName to the new vhdl buffer
-						newStr << lhsName;
+	// Comment by F2D: this whas parse2().
+	// The lexed code has been cut into statements by the FlopocoStream as it was flushed:
+	// here we only resolve the signal references of each statement and print the delays, in a single pass.
+	// The delays are also recorded in the tokens, which outputVerilog() walks later.
+	void Operator::doApplySchedule()
+	{
+		ostringstream newStr;
 
-						auxPosition = lhsName.size()+2;
-					}
-				lhsNameLength = lhsName.size();
-
-				//check for component instances
-				//	the first parse marks the name of the component as a lhsName
-				//	must remove the markings
-				//the rest of the code contains pairs of ??lhsName?? => $$rhsName$$ pairs
-				//	for which the helper signals must be removed and delays _dxxx must be added
-				auxPosition2 = workStr.find("port map"); // not checking capitalization is OK because this string can only be created by flopoco
-
-				if(auxPosition2 != string::npos)	{
-					// we have the position of "port map"; we need the name of the instance name.
-					// It is the word before the ":"; all this looks terribly fragile and depends on the fact that this VHDL is created here in flopoco.
-					size_t i=nextPos;
-					while(oldStr[i]!=':')
-						i--;
-					size_t endInstanceName = i;
-					while(oldStr[i]!=' ')
-						i--;
-					size_t beginInstanceName = i+1;
-					string instanceName = oldStr.substr(beginInstanceName, endInstanceName-beginInstanceName);
-					REPORT(FULL,"doApplySchedule found instance name >>>>"<<instanceName<<"<<<<");
-
-					string subOpName=lhsName;
-					OperatorPtr subop = getSubComponent(subOpName);
-					if(subop==nullptr)
-						THROWERROR("doApplySchedule(): " << subOpName << " does not seem to be a subcomponent of " << getName());
-					REPORT(DEBUG, "doApplySchedule: found instance: " << subOpName);//workStr.substr(auxPosition, auxPosition2));
-					//try to parse the names of the signals in the port mapping
-					if(workStr.find("?", auxPosition2) == string::npos) {
-						//empty port mapping
-						newStr << workStr.substr(auxPosition, workStr.size());
-					} else {
-						//parse a list of ??lhsName?? => $$rhsName$$
-						//	or ??lhsName?? => 'x' or ??lhsName?? => "xxxx"
-						size_t tmpCurrentPos, tmpNextPos;
-
-						//copy the code up to the port mappings
-						newStr << workStr.substr(auxPosition, workStr.find("?", auxPosition2)-auxPosition);
-
-						tmpCurrentPos = workStr.find("?", auxPosition2);
-						while(tmpCurrentPos != string::npos)	{
-							bool singleQuoteSep = false, doubleQuoteSep = false, open = false;
-							bool rhsIsSignal=false;
-							//extract a lhsName
-							tmpNextPos = workStr.find("?", tmpCurrentPos+2);
-							lhsName = workStr.substr(tmpCurrentPos+2, tmpNextPos-tmpCurrentPos-2);
-							REPORT(FULL, "doApplySchedule: instance lhsName=" << lhsName);
-
-							//copy lhsName (the formal input/output) to the new vhdl buffer
-							newStr << lhsName;
-
-							//copy the code up to the next rhsName to the new vhdl buffer
-							tmpCurrentPos = tmpNextPos+2;
-							tmpNextPos = workStr.find("$", tmpCurrentPos);
-
-							//check for constant as rhs name
-							if(workStr.find("\'", tmpCurrentPos) < tmpNextPos)	{
-								tmpNextPos = workStr.find("\'", tmpCurrentPos);
-								singleQuoteSep = true;
-							}
-							else if(workStr.find("\"", tmpCurrentPos) < tmpNextPos)  {
-								tmpNextPos = workStr.find("\"", tmpCurrentPos);
-								doubleQuoteSep = true;
-							}
-							else if(workStr.find("open", tmpCurrentPos) < tmpNextPos)	{
-								tmpNextPos = workStr.find("open", tmpCurrentPos);
-								open = true;
-							}
+		REPORT(DEBUG, "doApplySchedule(): entering operator " << getName());
+		REPORT(FULL, "doApplySchedule: vhdl stream after first lexing " << endl << vhdl.str());
 
-							REPORT(FULL, "doApplySchedule/instance skipping: " << workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos));
-							newStr << workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos);
+		// code that doesn't need to be modified goes directly to the new vhdl code buffer
+		// signal references may get delays of the type rhs_name_dxxx
+		for(auto &st: vhdl.getStatements())
+			{
+				if(st.type == VHDLStatement::text) {
+					for(auto &t: st.tokens)
+						newStr << t.code;
+					continue;
+				}
 
-							//extract a rhsName
-							//	this might be a constant
-							if(singleQuoteSep) {
-								//a 1-bit constant
-								tmpCurrentPos = tmpNextPos+1;
-								tmpNextPos = workStr.find("\'", tmpCurrentPos);
-							}
-							else if(doubleQuoteSep) {
-								//a multiple bit constant
-								tmpCurrentPos = tmpNextPos+1;
-								tmpNextPos = workStr.find("\"", tmpCurrentPos);
-							}
-							else if(open) {
-								//a open output
-								tmpNextPos = workStr.find("open", tmpCurrentPos)-1; //has to be one less as we want the 'o' of "open"
-								tmpCurrentPos = tmpNextPos+1;
-							}
-							else {
-								//a regular signal name
-								tmpCurrentPos = tmpNextPos+2;
-								tmpNextPos = workStr.find("$", tmpCurrentPos);
-								rhsIsSignal = true;
-							}
+				if(st.type == VHDLStatement::instance) {
+					REPORT(FULL,"doApplySchedule found instance name >>>>" << st.instanceName << "<<<<");
+					OperatorPtr subop = getSubComponent(st.lhsName);
+					if(subop==nullptr)
+						THROWERROR("doApplySchedule(): " << st.lhsName << " does not seem to be a subcomponent of " << getName());
+					REPORT(DEBUG, "doApplySchedule: found instance: " << st.lhsName);
 
-							rhsName = workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos);
-							REPORT(FULL, "doApplySchedule/instance rhsname= " << rhsName);
-
-							//						rhsSignal = NULL;
-							//						lhsSignal = NULL;
-
-							//copy rhsName to the new vhdl buffer
-							if(!open)
-								newStr << (singleQuoteSep ? "\'" : doubleQuoteSep ? "\"" : "") << rhsName << (singleQuoteSep ? "\'" : doubleQuoteSep ? "\"" : "");
-							//                        else
-							//                            newStr << "open";
-
-							// All the inputs should be synchronized.
-							// We do this by comparing their cycle to the cycle of the first output of the instance.
-							try {
-								//	delay it if necessary, i.e. if it is a shared instance with a dependency to a later signal
-								if(isSequential()
-									 && rhsIsSignal // rhs is not a constant
-									 && subop->isShared() // otherwise the dependency graph takes care of all the pipelining
-									 && subop->getSignalByName(lhsName)->type() == Signal::in
-									 ) {// the lhs is a input of the subcomponent
-									// In this case, we have in the dep graph the dependencies (actualIn->actualOut): extract the first one
-									Signal* subopInput = getSignalByName(rhsName);
-									//look for the first output
-									int i=0;
-									while((*subop->getIOList())[i]->type() != Signal::out)
-										i++;
-									vector<string> actualIO = instanceActualIO_[instanceName];
-									Signal* subopOutput = getSignalByName(actualIO[i]);
-
-									// was								subopOutput = (*subopInput->successors())[0].first; // but bug if the actual input has other successors
-									REPORT(DEBUG, "doApplySchedule: shared instance: " << instanceName << " has input " << subopInput->getName() << " and output " << subopOutput->getName());//workStr.substr(auxPosition, auxPosition2));
-									int deltaCycle =subopOutput->getCycle() - subopInput->getCycle();
-									if( deltaCycle> 0) {
-										newStr << "_d" << vhdlize(deltaCycle);
-										subopInput -> updateLifeSpan(deltaCycle);
-									}
+					for(auto &t: st.tokens) {
+						newStr << t.code;
+						t.delay = "";
+						if(t.type != VHDLToken::portActual)
+							continue;
+						// All the inputs should be synchronized.
+						// We do this by comparing their cycle to the cycle of the first output of the instance.
+						try {
+							//	delay it if necessary, i.e. if it is a shared instance with a dependency to a later signal
+							if(isSequential()
+								 && subop->isShared() // otherwise the dependency graph takes care of all the pipelining
+								 && subop->getSignalByName(t.formalName)->type() == Signal::in
+								 ) {// the formal is a input of the subcomponent
+								// In this case, we have in the dep graph the dependencies (actualIn->actualOut): extract the first one
+								Signal* subopInput = getSignalByName(t.signalName);
+								//look for the first output
+								int i=0;
+								while((*subop->getIOList())[i]->type() != Signal::out)
+									i++;
+								vector<string> actualIO = instanceActualIO_[st.instanceName];
+								Signal* subopOutput = getSignalByName(actualIO[i]);
+
+								REPORT(DEBUG, "doApplySchedule: shared instance: " << st.instanceName << " has input " << subopInput->getName() << " and output " << subopOutput->getName());
+								int deltaCycle =subopOutput->getCycle() - subopInput->getCycle();
+								if( deltaCycle> 0) {
+									t.delay = "_d" + vhdlize(deltaCycle);
+									newStr << t.delay;
+									subopInput -> updateLifeSpan(deltaCycle);
 								}
 							}
-							catch(string &e) {
-								REPORT(FULL, "doApplySchedule caught " << e << " and is ignoring it.");
-							}
-							catch(char const *e) {
-								REPORT(FULL, "doApplySchedule caught " << e << " and is ignoring it.");
-							}
-
-							//prepare to parse a new pair
-							tmpCurrentPos = workStr.find("?", tmpNextPos+2);
-
-							//copy the rest of the code to the new vhdl buffer
-							if(tmpCurrentPos != string::npos)
-								newStr << workStr.substr(tmpNextPos+(singleQuoteSep||doubleQuoteSep||open ? 1 : 2),
-																				 tmpCurrentPos-tmpNextPos-(singleQuoteSep||doubleQuoteSep||open ? 1 : 2));
-							else
-								newStr << workStr.substr(tmpNextPos+(singleQuoteSep||doubleQuoteSep||open ? 1 : 2), workStr.size());
 						}
-					}
-
-					//prepare for a new instruction to be parsed
-					currentPos = nextPos + workStr.size() + 2;
-					nextPos = oldStr.find('?', currentPos);
-					//special case for the selected assignment statements
-					isSelectedAssignment = false;
-					if(oldStr.find('$', currentPos) < nextPos)
-						{
-							nextPos = oldStr.find('$', currentPos);
-							isSelectedAssignment = true;
+						catch(string &e) {
+							REPORT(FULL, "doApplySchedule caught " << e << " and is ignoring it.");
 						}
-
+						catch(char const *e) {
+							REPORT(FULL, "doApplySchedule caught " << e << " and is ignoring it.");
+						}
+					}
 					continue;
 				}
 
-				//the lhsName could be of the form (lhsName1, lhsName2, ...)
-				//	extract the first name in the list
-				if(lhsName[0] == '(')
-					{
-						count = 1;
-						while((lhsName[count] != ' ') && (lhsName[count] != '\t')
-									&& (lhsName[count] != ',') && (lhsName[count] != ')'))
-							count++;
-						lhsName = lhsName.substr(1, count-1);
-					}
-
+				// assignments and selected assignments: the right-hand side signals are delayed to the cycle of the lhs
+				Signal *lhsSignal = nullptr;
+				bool unknownLHSName = false;
 				//this could be a user-defined name
-				try			{
-			    lhsSignal = getSignalByName(lhsName);
+				try {
+					lhsSignal = getSignalByName(st.lhsName);
 				}
-				catch(string &e)	{
-			    lhsSignal = NULL;
-			    unknownLHSName = true;
+				catch(string &e) {
+					unknownLHSName = true;
 				}
-				//check for "select" signal assignments
-				//	with signal_name select... etc
-				//	the problem is there is a signal belonging to the right hand side
-				//	on the left-hand side, before the left hand side signal, which breaks the regular flow
-				if(isSelectedAssignment == true)		{
-					//extract the first rhs signal name
-					tmpCurrentPos = 0;
-					tmpNextPos = workStr.find('$');
-
-					assert(tmpNextPos != string::npos);
-
-					rhsName = workStr.substr(tmpCurrentPos, tmpNextPos);
-
-					//remove the possible parentheses around the rhsName
-					string newRhsName = rhsName;
-					if(rhsName.find("(") != string::npos)	{
-						newRhsName = newRhsName.substr(rhsName.find("(")+1, rhsName.find(")")-rhsName.find("(")-1);
-					}
-					// No functional register possible here
-					try			{
-						rhsSignal = getSignalByName(newRhsName);
-					}
-					catch(...){
-						//this i must be user-defined name
-						rhsSignal = NULL;
-						unknownRHSName = true;
-					}
-
-					//output the rhs signal name
-					newStr << rhsName;
-
-					if(isSequential() && !unknownLHSName  && !unknownRHSName) {
-						int deltaCycle = lhsSignal->getCycle()-rhsSignal->getCycle();
-						if( deltaCycle> 0)
-							newStr << "_d" << vhdlize(deltaCycle);
-					}
-					//copy the code up until the lhs signal name
-					tmpCurrentPos = tmpNextPos+2;
-					tmpNextPos = workStr.find('?', tmpCurrentPos);
-
-					newStr << workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos);
-
-					//copy the lhs signal name
-					newStr << lhsName;
-
-					//prepare to parse a new rhs name
-					tmpCurrentPos = tmpNextPos+4+lhsNameLength;
-					tmpNextPos = workStr.find('$', tmpCurrentPos);
-
-					//if there are is more code that needs preparing, then just pass
-					//to the next instruction
-					if(tmpNextPos == string::npos)
-						{
-							//copy the rest of the code
-							assert(workStr.size()-tmpCurrentPos > 0);
-							newStr << workStr.substr(tmpCurrentPos, workStr.size()-tmpCurrentPos);
-
-							//prepare for a new instruction to be parsed
-							currentPos = nextPos + workStr.size() + 2;
-							nextPos = oldStr.find('?', currentPos);
-							//special case for the selected assignment statements
-							isSelectedAssignment = false;
-							if(oldStr.find('$', currentPos) < nextPos)
-								{
-									nextPos = oldStr.find('$', currentPos);
-									isSelectedAssignment = true;
-								}
 
-							continue;
-						}
-				}
-				//extract the rhsNames and annotate them find the position of the rhsName, and copy
-				// the vhdl code up to the rhsName in the new vhdl code buffer
-				// There was a bug here  if one variable is had select in its name
-				// Took me 2hours to figure out
-				// Bug fixed by having the lexer add spaces around select (so no need to test for all the space/tab/enter possibilibits.
-				// I wonder how many such bugs remain
-				if(workStr.find(" select ") == string::npos	 )			{
-					tmpCurrentPos = lhsNameLength+2;
-					tmpNextPos = workStr.find('$', lhsNameLength+2);
-				}
-				while(tmpNextPos != string::npos)	{
-					unknownRHSName = false;
-
-					//copy into the new vhdl stream the code that doesn't need to be modified
-					newStr << workStr.substr(tmpCurrentPos, tmpNextPos-tmpCurrentPos);
-
-					//skip the '$$'
-					tmpNextPos += 2;
-
-					//extract a new rhsName
-					rhsName = workStr.substr(tmpNextPos, workStr.find('$', tmpNextPos)-tmpNextPos);
-					rhsNameLength = rhsName.size();
-					//remove the possible parentheses around the rhsName
-					string newRhsName = rhsName;
-					if(rhsName.find("(") != string::npos)	{
-						newRhsName = newRhsName.substr(rhsName.find("(")+1, rhsName.find(")")-rhsName.find("(")-1);
-					}
-					//this could also be a delayed signal name
-					int functionalDelay=0;
-					if(newRhsName.find('^') != string::npos){
-						string sdelay = newRhsName.substr(newRhsName.find('^') + 1, string::npos-1);
-						newRhsName = newRhsName.substr(0, newRhsName.find('^'));
-						REPORT(FULL, "doApplySchedule: Found funct. delayed signal  : " << newRhsName << " delay:" << sdelay );
-						functionalDelay = stoi(sdelay);
-					}
+				for(auto &t: st.tokens) {
+					newStr << t.code;
+					t.delay = "";
+					if(t.type != VHDLToken::rhsSignal)
+						continue;
 
-					try			{
-						rhsSignal = getSignalByName(newRhsName);
+					Signal *rhsSignal = nullptr;
+					bool unknownRHSName = false;
+					try {
+						rhsSignal = getSignalByName(t.signalName);
 					}
-					catch(...){
-						//this i must be user-defined name
-						rhsSignal = NULL;
+					catch(...) {
+						//this must be a user-defined name
 						unknownRHSName = true;
 					}
 
-
-					//copy the rhsName with the delay information into the new vhdl buffer
-					//	rhsName becomes rhsName_dxxx, if the rhsName signal is declared at a previous cycle
-					newStr << newRhsName;
 					if(isSequential() && !unknownLHSName && !unknownRHSName) {
 						// Should we insert a pipeline register ?
 						int deltaCycle = lhsSignal->getCycle() - rhsSignal->getCycle();
 						if(deltaCycle>0)
-							newStr << "_d" << vhdlize(deltaCycle);
+							t.delay += "_d" + vhdlize(deltaCycle);
 
 						// Should we insert a functional register ? This case is exclusive with the previous as long as functional delays are introduced only by the functionalRegister method.
-						if(functionalDelay>0) {
-							getSignalByName(newRhsName) -> updateLifeSpan(functionalDelay); // wonder where it is done for pipeline registers???
-							newStr << "_d" << vhdlize(functionalDelay);
+						if(t.functionalDelay>0) {
+							REPORT(FULL, "doApplySchedule: Found funct. delayed signal  : " << t.signalName << " delay:" << t.functionalDelay);
+							rhsSignal -> updateLifeSpan(t.functionalDelay); // wonder where it is done for pipeline registers???
+							t.delay += "_d" + vhdlize(t.functionalDelay);
 						}
+						newStr << t.delay;
 					}
-
-					//find the next rhsName, if there is one
-					tmpCurrentPos = tmpNextPos + rhsNameLength + 2;
-					tmpNextPos = workStr.find('$', tmpCurrentPos);
 				}
-
-				//copy the code that is left up until the end of the line in
-				//	the new vhdl code buffer, without changing it
-				newStr << workStr.substr(tmpCurrentPos, workStr.size()-tmpCurrentPos);
-
-				//get a new line to parse
-				currentPos = nextPos + workStr.size() + 2;
-				nextPos = oldStr.find('?', currentPos);
-				//special case for the selected assignment statements
-				isSelectedAssignment = false;
-				if(oldStr.find('$', currentPos) < nextPos)
-					{
-						nextPos = oldStr.find('$', currentPos);
-						isSelectedAssignment = true;
-					}
 			}
 
-		//the remaining code might contain identifiers that were marked
-		//	with ??; these must also be removed
-		//if(nextPos == string::npos) && (oldStr.find )
-
-		//copy the remaining code to the vhdl code buffer
-		newStr << oldStr.substr(currentPos, oldStr.size()-currentPos);
-
 		vhdl.setSecondLevelCode(newStr.str());
 
 		REPORT(DEBUG, "doApplySchedule: finished " << getName());
@@ -3286,9 +3149,14 @@ namespace flopoco{
 		vhdl.vhdlCodeBuffer.str(op->vhdl.vhdlCodeBuffer.str());
 
 		vhdl.dependenceTable        = op->vhdl.dependenceTable;
+		vhdl.statements             = op->vhdl.statements;
+		vhdl.statementBuffer        = op->vhdl.statementBuffer;
+		vhdl.lastCleanedDependence  = op->vhdl.lastCleanedDependence;
 
 		srcFileName                 = op->getSrcFileName();
 		cost                        = op->getOperatorCost();
+		creationTime_               = op->creationTime_;
+		generationTime_             = op->getGenerationTime();
 		subComponentList_           = op->getSubComponentList();
 		stdLibType_                 = op->getStdLibType();
 		isSequential_               = op->isSequential();
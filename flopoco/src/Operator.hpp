@@ -12,6 +12,7 @@
 #include <gmpxx.h>
 #include <float.h>
 #include <utility>
+#include <chrono>
 
 #include "Target.hpp"
 #include "Signal.hpp"
@@ -829,6 +830,16 @@ namespace flopoco {
 		 */
 		string buildVHDLRegisters();
 
+		/**
+		 * Build the SystemVerilog equivalent of buildVHDLRegisters(): one always_ff block per reset type
+		 */
+		string buildVerilogRegisters();
+
+		/**
+		 * Build the SystemVerilog equivalent of buildVHDLSignalDeclarations(), from the signals themselves
+		 */
+		string buildVerilogSignalDeclarations();
+
 		/**
 		 * Build all the type declarations.
 		 */
@@ -864,6 +875,22 @@ namespace flopoco {
 		 */
 		void outputVHDL(std::ostream& o);
 
+		/**
+		 * Outputs the operator as a SystemVerilog module, for simulation with Verilator.
+		 * The ports, signals and registers come from the signals of the operator, and the statements
+		 * of the architecture, with the delays the scheduler gave their signals, are translated by
+		 * VHDLToVerilog, so the registers and the subcomponent instances are the same as in the VHDL.
+		 * @param o the stream where the module will be output
+		 * @param name the name of the module
+		 */
+		virtual void outputVerilog(std::ostream& o, std::string name);
+
+		/**
+		 * Outputs the operator as a SystemVerilog module, with name = uniqueName
+		 * @param o the stream where the module will be output
+		 */
+		void outputVerilog(std::ostream& o);
+
 
 
 		/**
@@ -1098,6 +1125,22 @@ namespace flopoco {
 
 		int getOperatorCost();
 
+		/**
+		 * Records the time elapsed since construction as the generation time of this operator.
+		 * Called when the operator is added to its parent or to the global operator list; only the first call counts.
+		 */
+		void markGenerated();
+
+		/**
+		 * Returns the generation time in seconds, or a negative value if the operator was never marked generated
+		 */
+		double getGenerationTime();
+
+		/**
+		 * Returns the worst critical path contribution within a cycle over all the signals of this operator, in seconds
+		 */
+		double getMaxCriticalPath();
+
 		map<string, Signal*> getSignalMap();
 
 		map<string, pair<string, string> > getConstants();
@@ -1730,6 +1773,8 @@ protected:
 
 	int                  myuid;                             /**< Unique id */
 	int                  cost;                              /**< The cost of the operator depending on different metrics */
+	std::chrono::steady_clock::time_point creationTime_;    /**< When the constructor was entered, used for the generation report */
+	double               generationTime_;                   /**< Seconds from construction to insertion in the design, negative until known */
 
 
 private:
@@ -28,7 +28,8 @@ namespace flopoco{
 			int lsb_summand,
 			int chunk_size,
 			double dspOccupationThreshold,
-			bool has_HSSD):
+			bool has_HSSD,
+			int packing):
 				Operator(parentOp, target),
 				m_scale_width(scale_width),
 				m_fraction_width(fraction_width),
@@ -38,11 +39,13 @@ namespace flopoco{
 				m_lsb_summand(lsb_summand),
 				m_chunk_size(chunk_size),
 				m_dspOccupationThreshold(dspOccupationThreshold),
-				m_has_HSSD(has_HSSD) {
+				m_has_HSSD(has_HSSD),
+				m_packing(packing) {
 
 		ostringstream module_name;
 		module_name << "PE_S3_" << scale_width << "_" << fraction_width;
 		if(m_has_HSSD) module_name << "_HSSD";
+		if(m_packing > 1) module_name << "_P" << m_packing;
 		setNameWithFreqAndUID(module_name.str());
 		setCopyrightString("Ledoux Louis - BSC / UPC");
 
@@ -56,7 +59,8 @@ namespace flopoco{
 			m_lsb_summand,
 			m_chunk_size,
 			m_dspOccupationThreshold,
-			m_has_HSSD);
+			m_has_HSSD,
+			m_packing);
 		s3fdp_dummy->setName("s3fdp");
 		s3fdp_dummy->schedule();
 		s3fdp_dummy->applySchedule();
@@ -65,17 +69,18 @@ namespace flopoco{
 		int wCOutput = s3fdp_dummy->get_wC();
 
 		// IOs declaration
+		// a packed PE holds packing columns of the array: one B and one C per column, first column at lsb
 		addInput("s3_row_i_A", S3_size);
-		addInput("s3_col_j_B", S3_size);
-		if (m_has_HSSD) addInput("C_out", wLAICPT2+wCOutput+1);  // accumulator + carry bits + nan
+		addInput("s3_col_j_B", m_packing*S3_size);
+		if (m_has_HSSD) addInput("C_out", m_packing*(wLAICPT2+wCOutput+1));  // accumulator + carry bits + nan
 		addInput("SOB");  // active high boolean to put the accumulator registers to 0
 		if (m_has_HSSD) addInput("EOB");  // active high boolean to indicate the end of an accumulation
 
 		addOutput("s3_row_im1_A", S3_size);
-		addOutput("s3_col_jm1_B", S3_size);
+		addOutput("s3_col_jm1_B", m_packing*S3_size);
 		addOutput("SOB_Q");
 		if (m_has_HSSD) addOutput("EOB_Q");
-		addOutput("C_out_Q", wLAICPT2+wCOutput+1);  // accumulator + carry bits + nan
+		addOutput("C_out_Q", m_packing*(wLAICPT2+wCOutput+1));  // accumulator + carry bits + nan
 
 		// Delay the S3 buses
 		addFullComment("Functional delay z-1 of inputs");
@@ -115,27 +120,43 @@ namespace flopoco{
 		// vhdl << endl;
 		// std::cout << "here2" << std::endl;
 
+		// The S3FDP results as C words, one per column
+		ostringstream s3fdp_out;
+		if (m_packing == 1) {
+			s3fdp_out << (wCOutput>0 ? "isNaN_s3fdp & A_s3fdp & C_s3fdp" : "isNaN_s3fdp & A_s3fdp");
+		} else {
+			for (int l = m_packing-1 ; l >= 0 ; l--) {
+				s3fdp_out << "isNaN_s3fdp" << of(l) << " & A_s3fdp" << range((l+1)*wLAICPT2-1, l*wLAICPT2);
+				if (wCOutput > 0) s3fdp_out << " & C_s3fdp" << range((l+1)*wCOutput-1, l*wCOutput);
+				if (l > 0) s3fdp_out << " & ";
+			}
+		}
+
 		// Eventually create the Half Speed Sink Down
 		// for paper purpose we have to remove HSSD to compare with nothing
 		if (m_has_HSSD) {
 			addFullComment("Half Speed Sink Down");
-			vhdl << tab << "with EOB_s3fdp select " << declare(getTarget()->logicDelay(wLAICPT2+wCOutput+1), "mux_C_out", (wLAICPT2+wCOutput+1), true, Signal::wire) << " <= " << endl <<
-				tab << "     (" << (wCOutput>0 ? "isNaN_s3fdp & A_s3fdp & C_s3fdp" : "isNaN_s3fdp & A_s3fdp") << ") when '1', " << endl <<
+			vhdl << tab << "with EOB_s3fdp select " << declare(getTarget()->logicDelay(wLAICPT2+wCOutput+1), "mux_C_out", m_packing*(wLAICPT2+wCOutput+1), true, Signal::wire) << " <= " << endl <<
+				tab << "     (" << s3fdp_out.str() << ") when '1', " << endl <<
 				tab << "     C_out" << " when others;" << endl;
 			addRegisteredSignalCopy("mux_C_out_HSSD", "mux_C_out", Signal::noReset, 2);
 			vhdl << endl;
 		} else {
 			addFullComment("without Half Speed Sink Down");
-			vhdl << tab << declare(getTarget()->logicDelay(0), "out_s3fdp", (wLAICPT2+wCOutput+1), true, Signal::wire) << " <= " << (wCOutput>0 ? "isNaN_s3fdp & A_s3fdp & C_s3fdp" : "isNaN_s3fdp & A_s3fdp") << ";";
+			vhdl << tab << declare(getTarget()->logicDelay(0), "out_s3fdp", m_packing*(wLAICPT2+wCOutput+1), true, Signal::wire) << " <= " << s3fdp_out.str() << ";";
 			vhdl << endl << endl;
 		}
 
 		setNoParseNoSchedule();
 		addFullComment("Instantiates the S3FDP");
-		if (wCOutput > 0) declare(0,"C_s3fdp",wCOutput);
-		declare(0,"isNaN_s3fdp");
+		if (wCOutput > 0) declare(0,"C_s3fdp",m_packing*wCOutput);
+		if (m_packing > 1) {
+			declare(0,"isNaN_s3fdp",m_packing);
+		} else {
+			declare(0,"isNaN_s3fdp");
+		}
 		if (m_has_HSSD) declare(0,"EOB_s3fdp");
-		declare(0,"A_s3fdp", wLAICPT2);
+		declare(0,"A_s3fdp", m_packing*wLAICPT2);
 		vhdl << tab << "s3fdp_inst: s3fdp" << endl;
 		vhdl << tab << tab << "port map ( clk => clk," << endl;
         vhdl << tab << tab << "           rst  => rst," << endl;
@@ -180,6 +201,7 @@ namespace flopoco{
 		int chunk_size;
 		double dspOccupationThreshold;
 		bool has_HSSD;
+		int packing;
 		UserInterface::parseInt(args, "scale_width", &scale_width);
 		UserInterface::parseInt(args, "fraction_width", &fraction_width);
 		UserInterface::parseInt(args, "bias", &bias);
@@ -189,6 +211,7 @@ namespace flopoco{
 		UserInterface::parseInt(args, "chunk_size", &chunk_size);
 		UserInterface::parseFloat(args, "dspThreshold", &dspOccupationThreshold);
 		UserInterface::parseBoolean(args, "has_HSSD", &has_HSSD);
+		UserInterface::parseInt(args, "packing", &packing);
 
 		return new PE_S3(parentOp, target,
 				scale_width,
@@ -199,7 +222,8 @@ namespace flopoco{
 				lsb_summand,
 				chunk_size,
 				dspOccupationThreshold,
-				has_HSSD);
+				has_HSSD,
+				packing);
 	}
 
 	void PE_S3::registerFactory() {
@@ -214,9 +238,10 @@ namespace flopoco{
 			 nb_bits_ovf(int)=-1: The number of bits prepended before the actual MSB weight of summands. One bit adds one binade to prevent overflow in non cancellation accumulations. These bits affect the size of the adder but not of the shifter, they are not too expansive; \
 			 msb_summand(int)=-1: The expected biggest product value weight. If not precised, the tool will go to full precision (aka exact); \
 			 lsb_summand(int)=-1: The expected smallest product value weight. If not precised, the tool will go to full precision (aka exact); \
-			 chunk_size(int)=-1: An expert can suggest a size for a sub adder chunk for the carry save accum. This should be target specific calculated by the tool; \
+			 chunk_size(int)=-1: An expert can suggest a size for a sub adder chunk for the carry save accum. This should be target specific calculated by the tool, 0 lets S3FDPTuner pick it for the frequency; \
 			 dspThreshold(real)=0.0: The ratio of dsp over logic for mantissa product; \
-			 has_HSSD(bool)=true: indicates the presence of the Half Speed Sink Down chain",
+			 has_HSSD(bool)=true: indicates the presence of the Half Speed Sink Down chain; \
+			 packing(int)=1: The number of adjacent columns the PE holds, their products with the row share one multiplier",
 			"",  // More documentation for the HTML pages. If you want to link to your blog, it is here.
 			PE_S3::parseArguments
 		) ;
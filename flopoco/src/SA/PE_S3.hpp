@@ -7,6 +7,7 @@
   Delay left (row J of Mat A) by 1
   Delay top (col I of Mat B) by 1
   Instantiates a S3FDP and feeds it with current A in and B in
+  With packing, holds that many adjacent columns whose products share the S3FDP multiplier
   Author: Ledoux Louis
 
  */
@@ -35,6 +36,7 @@ namespace flopoco{
 		 * @param[in] {int=-1} chunk_size : The user-suggested size of a chunk in the partial CSA. Computed by flopoco if not provided.
 		 * @param[in] {float=0.0} dspOccupationThreshold : the ratio of DSP to be used in the mantissa product
 		 * @param[in] {bool=true} has_HSSD : indicates if the PE contains the half speed sink down chain
+		 * @param[in] {int=1} packing : the number of adjacent columns held by the PE, sharing one multiplier
 		 **/
 		PE_S3(OperatorPtr parentOp, Target* target,
 				int scale_width,
@@ -45,7 +47,8 @@ namespace flopoco{
 				int lsb_summand=-1,
 				int chunk_size=-1,
 				double dspOccupationThreshold = 0.0,
-				bool has_HSSD=true);
+				bool has_HSSD=true,
+				int packing=1);
 
 		/**
 		 * PE_S3 destructor
@@ -74,6 +77,7 @@ namespace flopoco{
 		int m_chunk_size;
 		float m_dspOccupationThreshold;
 		bool m_has_HSSD;
+		int m_packing;
 
 	};
 }
@@ -7,6 +7,7 @@
 
 #include "SA/PositUtils.hpp"
 #include "S3FDP.hpp"
+#include "SA/S3FDPTuner.hpp"
 
 #include <vector>
 #include <sstream>
@@ -34,7 +35,8 @@ namespace flopoco{
 			int lsb_summand,
 			int chunk_size,
 			double dspOccupationThreshold,
-			bool has_HSSD):
+			bool has_HSSD,
+			int packing):
 				Operator(parentOp, target),
 				m_scale_width(scale_width),
 				m_fraction_width(fraction_width),
@@ -44,13 +46,15 @@ namespace flopoco{
 				m_lsb_summand(lsb_summand),
 				m_chunk_size(chunk_size),
 				m_dspOccupationThreshold(dspOccupationThreshold),
-				m_has_HSSD(has_HSSD) {
+				m_has_HSSD(has_HSSD),
+				m_packing(packing) {
 
 		setHasDelay1Feedbacks();
 
 		ostringstream module_name;
 		module_name << "S3FDP_" << scale_width << "_" << fraction_width;
 		if (m_has_HSSD) module_name << "_HSDD";
+		if (m_packing > 1) module_name << "_P" << m_packing;
 		setNameWithFreqAndUID(module_name.str());
 		setCopyrightString("Ledoux Louis - BSC / UPC");
 		m_reset_type = Signal::asyncReset;  // {noReset | asyncReset | syncReset}
@@ -60,9 +64,12 @@ namespace flopoco{
 		m_ftz_clock_positions.push_back(0);
 		m_ftz_clock_positions.push_back(30);
 
+		if (m_packing < 1) {
+			THROWERROR("packing must be at least 1, got " << m_packing);
+		}
+
 		if (m_nb_bits_ovf == -1) {
 			REPORT(DETAILED, "bits ovf not user-given, going for " <<m_scale_width+m_fraction_width-1<<"b.")
-			m_nb_bits_ovf=m_scale_width+m_fraction_width-1;  // arbitrary size that increases proportionally with the "problem" size
 		} else {
 			REPORT(DETAILED, "bits ovf: " << m_nb_bits_ovf);
 		}
@@ -78,19 +85,18 @@ namespace flopoco{
 		// might be useless
 		//const int msb_q = m_msb_summand + m_nb_bits_ovf;
 
-		if (m_msb_summand == -1) {
-			m_msb_summand = ((int)(pow(m_scale_width,2))-1)<<1;
-		}
-		if (m_lsb_summand == -1) {
-			m_lsb_summand = -(((int)(pow(m_scale_width,2))-1)<<1);
-		}
-
-		m_wLAICPT2 = m_msb_summand + m_nb_bits_ovf - m_lsb_summand + 1;  // add one bit for the sign
+		m_wLAICPT2 = resolveWindow(m_scale_width, m_fraction_width, m_nb_bits_ovf, m_msb_summand, m_lsb_summand);
 
 		if (m_chunk_size == -1) {
   			// TODO(lledoux): the VUP target yields a 412bits adder for 400MHz which is a lot
-			// TODO(2)(lledoux): i could create a suggestAccChunk method that takes into account the looped fanout(ed) routing
+			// chunk_size=0 asks S3FDPTuner instead, which takes into account the looped fanout(ed) routing
 			target->suggestSubaddSize(m_chunk_size, m_wLAICPT2);
+		} else if (m_chunk_size == 0) {
+			S3FDPTuner tuner(target, m_wLAICPT2, 1, m_packing, m_packing);
+			S3FDPConfig best = tuner.getBest(m_has_HSSD);
+			m_chunk_size = best.chunk_size;
+			REPORT(DETAILED, "tuned chunk_size: " << m_chunk_size << ", estimated critical path " << best.critical_path*1e9 << "ns"
+				<< (best.feasible ? "" : ", which misses the period"));
 		}
 
 		m_nb_chunk = ceil(double(m_wLAICPT2)/double(m_chunk_size));
@@ -107,13 +113,20 @@ namespace flopoco{
 				" / nb_chunk=" << m_nb_chunk <<
 				" / chunk_size=" << m_chunk_size <<
 				" / last_chunk_size=" << m_last_chunk_size <<
-				" / has_HSSD=" << m_has_HSSD;
+				" / has_HSSD=" << m_has_HSSD <<
+				" / packing=" << m_packing;
 		REPORT(DETAILED, report_parameters.str());
 
 		const int S3_size = scale_width + fraction_width + 3;
+		// one suffix per lane, none when there is a single one so the signal names stay the historical ones
+		vector<string> lane;
+		for (int l = 0 ; l < m_packing ; l++) {
+			lane.push_back(m_packing > 1 ? "_l" + to_string(l) : "");
+		}
 		// IOs declaration
+		// With packing, S3_y holds one S3 per lane (lane 0 at lsb) and A, C and isNaN one result per lane
 		addInput("S3_x", S3_size);
-		addInput("S3_y", S3_size);
+		addInput("S3_y", m_packing*S3_size);
 		addInput("FTZ");
 		// Note on FTZ:
 		// active high boolean to put the accumulator registers to 0. Sync with incoming data
@@ -123,27 +136,35 @@ namespace flopoco{
 		// stands for End Of Block, we input an active high boolean indicating the end of an accumulation in order to
 		// propagates it with the inner delay of this operator
 
-		addOutput("A", m_wLAICPT2);  // Partial accumulation
+		addOutput("A", m_packing*m_wLAICPT2);  // Partial accumulation
 		if (m_nb_chunk > 1) {
 			// addOutput("C", m_wLAICPT2);  // Carry to ripple with intermediate low-entropy 0s
 			// TODO(lledoux): only carry the carry bits and not full a LAICPT2 full of zeroes
-			addOutput("C", m_nb_chunk-1);
+			addOutput("C", m_packing*(m_nb_chunk-1));
 		}
 		if (m_has_HSSD) addOutput("EOB_Q");
-		addOutput("isNaN");
+		if (m_packing > 1) {
+			addOutput("isNaN", m_packing);
+		} else {
+			addOutput("isNaN");
+		}
 
 		// sign product processing
 		addFullComment("sign product processing");
 		vhdl << tab << declare(.0, "sign_X", 1, false, Signal::wire) << " <= S3_x" << of(S3_size-2) << ";" << endl;
-		vhdl << tab << declare(.0, "sign_Y", 1, false, Signal::wire) << " <= S3_y" << of(S3_size-2) << ";" << endl;
-		vhdl << tab << declare(target->logicDelay(2), "sign_M", 1, false, Signal::wire) << " <= sign_X xor sign_Y;" << endl;
+		for (int l = 0 ; l < m_packing ; l++) {
+			vhdl << tab << declare(.0, "sign_Y"+lane[l], 1, false, Signal::wire) << " <= S3_y" << of(l*S3_size+S3_size-2) << ";" << endl;
+			vhdl << tab << declare(target->logicDelay(2), "sign_M"+lane[l], 1, false, Signal::wire) << " <= sign_X xor sign_Y" << lane[l] << ";" << endl;
+		}
 		vhdl << endl;
 
 		// NaN product processing
 		addFullComment("NaN product processing");
 		vhdl << tab << declare(.0, "isNaN_X", 1, false, Signal::wire) << " <= S3_x" << of(S3_size-1) << ";" << endl;
-		vhdl << tab << declare(.0, "isNaN_Y", 1, false, Signal::wire) << " <= S3_y" << of(S3_size-1) << ";" << endl;
-		vhdl << tab << declare(target->logicDelay(2), "isNaN_M", 1, false, Signal::wire) << " <= isNaN_X or isNaN_Y;" << endl;
+		for (int l = 0 ; l < m_packing ; l++) {
+			vhdl << tab << declare(.0, "isNaN_Y"+lane[l], 1, false, Signal::wire) << " <= S3_y" << of(l*S3_size+S3_size-1) << ";" << endl;
+			vhdl << tab << declare(target->logicDelay(2), "isNaN_M"+lane[l], 1, false, Signal::wire) << " <= isNaN_X or isNaN_Y" << lane[l] << ";" << endl;
+		}
 		vhdl << endl;
 
 		// significand product processing
@@ -152,24 +173,56 @@ namespace flopoco{
 		addFullComment("significand processing");
 		const int significand_product_width = 2*(fraction_width+1);
 		vhdl << tab << declare(.0, "significand_X", 1 + fraction_width, true, Signal::wire) << " <= S3_x" << range(S3_size-3,scale_width) << ";" << endl;
-		vhdl << tab << declare(.0, "significand_Y", 1 + fraction_width, true, Signal::wire) << " <= S3_y" << range(S3_size-3,scale_width) << ";" << endl;
+		for (int l = 0 ; l < m_packing ; l++) {
+			vhdl << tab << declare(.0, "significand_Y"+lane[l], 1 + fraction_width, true, Signal::wire) << " <= S3_y" << range(l*S3_size+S3_size-3,l*S3_size+scale_width) << ";" << endl;
+		}
 		ostringstream parametric_mult, inputs_mult, outputs_mult;
-		parametric_mult << "wX=" << fraction_width + 1;
-		parametric_mult << " wY=" << fraction_width + 1;
-		parametric_mult << " wOut=" << significand_product_width;
-		parametric_mult << " dspThreshold=" << m_dspOccupationThreshold;
-		inputs_mult << "X=>significand_X,";
-		inputs_mult << "Y=>significand_Y";
-		outputs_mult << "R=>significand_product";
-		newInstance("IntMultiplier", "significand_product_inst", parametric_mult.str(), inputs_mult.str(), outputs_mult.str());
+		if (m_packing == 1) {
+			parametric_mult << "wX=" << fraction_width + 1;
+			parametric_mult << " wY=" << fraction_width + 1;
+			parametric_mult << " wOut=" << significand_product_width;
+			parametric_mult << " dspThreshold=" << m_dspOccupationThreshold;
+			inputs_mult << "X=>significand_X,";
+			inputs_mult << "Y=>significand_Y";
+			outputs_mult << "R=>significand_product";
+			newInstance("IntMultiplier", "significand_product_inst", parametric_mult.str(), inputs_mult.str(), outputs_mult.str());
+		} else {
+			// The significands are unsigned and a product of two fits significand_product_width bits,
+			// so the Y significands placed that many bits apart give the lane products side by side
+			// in one product, which the multiplier tiling maps to one DSP when it is narrow enough.
+			const int packed_width = (m_packing-1)*significand_product_width + fraction_width + 1;
+			int dsp_x, dsp_y;
+			target->getMaxDSPWidths(dsp_x, dsp_y);
+			if (packed_width > dsp_x || fraction_width + 1 > dsp_y) {
+				REPORT(INFO, "the " << m_packing << " packed products need a " << fraction_width+1 << "x" << packed_width << " multiplier, more than the " << dsp_y << "x" << dsp_x << " of one DSP");
+			}
+			vhdl << tab << declare(.0, "significand_Y_packed", packed_width, true, Signal::wire) << " <= ";
+			for (int l = m_packing-1 ; l > 0 ; l--) {
+				vhdl << "significand_Y" << lane[l] << " & " << zg(significand_product_width-fraction_width-1) << " & ";
+			}
+			vhdl << "significand_Y" << lane[0] << ";" << endl;
+			parametric_mult << "wX=" << fraction_width + 1;
+			parametric_mult << " wY=" << packed_width;
+			parametric_mult << " wOut=" << m_packing*significand_product_width;
+			parametric_mult << " dspThreshold=" << m_dspOccupationThreshold;
+			inputs_mult << "X=>significand_X,";
+			inputs_mult << "Y=>significand_Y_packed";
+			outputs_mult << "R=>significand_product_packed";
+			newInstance("IntMultiplier", "significand_product_inst", parametric_mult.str(), inputs_mult.str(), outputs_mult.str());
+			for (int l = 0 ; l < m_packing ; l++) {
+				vhdl << tab << declare(.0, "significand_product"+lane[l], significand_product_width, true, Signal::wire) << " <= significand_product_packed" << range((l+1)*significand_product_width-1,l*significand_product_width) << ";" << endl;
+			}
+		}
 		vhdl << endl;
 
 		// scale processing
 		const int scale_product_width = scale_width+1;
 		addFullComment("scale processing");
 		vhdl << tab << declare(.0, "scale_X_biased", scale_width, true, Signal::wire) << " <= S3_x" << range(scale_width-1,0) << ";" << endl;
-		vhdl << tab << declare(.0, "scale_Y_biased", scale_width, true, Signal::wire) << " <= S3_y" << range(scale_width-1,0) << ";" << endl;
-		vhdl << tab << declare(getTarget()->adderDelay(scale_product_width), "scale_product_twice_biased", scale_product_width) << " <= (\"0\" & scale_X_biased) + (\"0\" & scale_Y_biased);" << endl;
+		for (int l = 0 ; l < m_packing ; l++) {
+			vhdl << tab << declare(.0, "scale_Y_biased"+lane[l], scale_width, true, Signal::wire) << " <= S3_y" << range(l*S3_size+scale_width-1,l*S3_size) << ";" << endl;
+			vhdl << tab << declare(getTarget()->adderDelay(scale_product_width), "scale_product_twice_biased"+lane[l], scale_product_width) << " <= (\"0\" & scale_X_biased) + (\"0\" & scale_Y_biased" << lane[l] << ");" << endl;
+		}
 		vhdl << endl;
 
 		// Start cpt2 process before shifting part
@@ -177,7 +230,9 @@ namespace flopoco{
 		// we can do the cpt1 before the shift as it will result in a smaller xor as long as the shifter can right pad 0s or 1s (sign bit)
 		// Cpt1 here:
 		addFullComment("pre-shift xoring (cpt1)");
-		vhdl << tab << declare(target->logicDelay(significand_product_width), "significand_product_cpt1", significand_product_width, true) << " <= significand_product when sign_M='0' else not(significand_product);"<< endl;
+		for (int l = 0 ; l < m_packing ; l++) {
+			vhdl << tab << declare(target->logicDelay(significand_product_width), "significand_product_cpt1"+lane[l], significand_product_width, true) << " <= significand_product" << lane[l] << " when sign_M" << lane[l] << "='0' else not(significand_product" << lane[l] << ");"<< endl;
+		}
 		vhdl << endl;
 
 
@@ -190,146 +245,168 @@ namespace flopoco{
     	// 	}
 		const int shifted_product_size = max_shift + significand_product_width;
 		const int offset = (2*m_bias + m_lsb_summand - 1);  // 1 comes from the fact that the product msb is 2^1 and not 2^0
-		addFullComment("significand product shifting");
-		//vhdl << tab << declare(target->adderDelay(scale_product_width), "shift_value", scale_product_width) << " <= scale_product_twice_biased - CONV_STD_LOGIC_VECTOR(" << offset << ",\"" << scale_product_width << "\");" << endl;
-		//vhdl << tab << declare(target->adderDelay(scale_product_width), "shift_value", scale_product_width) << " <= scale_product_twice_biased - " << offset << ";" << endl;
-		vhdl << tab << declare(target->adderDelay(scale_product_width), "shift_value", scale_product_width) << " <= (scale_product_twice_biased) - (" << offset << ");" << endl;
-
-		// TODO(lledoux): check the size of shift_value : scale_product_width or intlog2(max_shift)
-
-		ostringstream parametric_shifter, inputs_shifter, outputs_shifter;
-		parametric_shifter << "wIn=" << significand_product_width;
-		parametric_shifter << " maxShift=" << max_shift;
-		parametric_shifter << " dir=" << Shifter::Left;
-		parametric_shifter << " wOut=" << shifted_product_size;
-		parametric_shifter << " computeSticky=False";
-		parametric_shifter << " inputPadBit=True";
-		inputs_shifter << "X=>significand_product_cpt1,";
-		inputs_shifter << "padBit=>sign_M,";
-		inputs_shifter << "S=>shift_value";
-		outputs_shifter << "R=>shifted_significand";
-		newInstance("Shifter", "significand_product_shifter_inst", parametric_shifter.str(), inputs_shifter.str(), outputs_shifter.str());
-		vhdl << endl;
-
-		// add 0 when shiftval is negative
-		addFullComment("detect too low scale for this specific scratchpad");
-		vhdl << tab << declare("too_small") << " <= '1' when (shift_value" << of(scale_product_width-1)<<"='1') else '0';" << endl;
-		vhdl << endl;
-
-		// detect too_big to put in the NaN Flip-Flop
-		addFullComment("detect too big scale for this specific scratchpad");
-		//vhdl << tab << declare("too_big") << " <= '1' when (shift_value > CONV_STD_LOGIC_VECTOR(" << allowed_max_shift << "," << intlog2(allowed_max_shift) << ")) else '0';" << endl;
-		vhdl << tab << declare("too_big") << " <= '1' when (unsigned(shift_value) > " << allowed_max_shift << " and too_small='0') else '0';" << endl;
-		vhdl << endl;
-
-		// part select from the shifted significand to partially form the summand
 		const int summand_size = max_shift + 1;  // we do sign extension up to this number of bit
-		if ( (m_msb_summand - m_lsb_summand + 1) < summand_size ) {
-			addFullComment("shifted significand part select to form summand");
-			//vhdl << tab << declare("ext_summand1c",m_wLAICPT2,true) << " <= " << zg(m_wLAICPT2) << " when too_small='1' else shifted_significand" << range(m_wLAICPT2-1,0) << ";" << endl;
-			//vhdl << tab << declare("ext_summand1c",m_wLAICPT2,true) << " <= " << zg(m_wLAICPT2) << " when too_small='1' else shifted_significand" << range(m_wLAICPT2-1+significand_product_width,significand_product_width) << ";" << endl;
-			vhdl << tab << declare("ext_summand1c",m_wLAICPT2,true) << " <= " << zg(m_wLAICPT2) << " when too_small='1' else shifted_significand" << range(m_wLAICPT2-1+significand_product_width-1,significand_product_width-1) << ";" << endl;
-		} else {
-			addFullComment("shifted significand part select to form summand");
-			vhdl << tab << declare("summand1c", summand_size, true, Signal::wire) << " <= shifted_significand" << range(shifted_product_size-1,shifted_product_size-summand_size)<<";" << endl;
+		for (int l = 0 ; l < m_packing ; l++) {
+			addFullComment("significand product shifting" + lane[l]);
+			//vhdl << tab << declare(target->adderDelay(scale_product_width), "shift_value", scale_product_width) << " <= scale_product_twice_biased - CONV_STD_LOGIC_VECTOR(" << offset << ",\"" << scale_product_width << "\");" << endl;
+			//vhdl << tab << declare(target->adderDelay(scale_product_width), "shift_value", scale_product_width) << " <= scale_product_twice_biased - " << offset << ";" << endl;
+			vhdl << tab << declare(target->adderDelay(scale_product_width), "shift_value"+lane[l], scale_product_width) << " <= (scale_product_twice_biased" << lane[l] << ") - (" << offset << ");" << endl;
+
+			// TODO(lledoux): check the size of shift_value : scale_product_width or intlog2(max_shift)
+
+			ostringstream parametric_shifter, inputs_shifter, outputs_shifter;
+			parametric_shifter << "wIn=" << significand_product_width;
+			parametric_shifter << " maxShift=" << max_shift;
+			parametric_shifter << " dir=" << Shifter::Left;
+			parametric_shifter << " wOut=" << shifted_product_size;
+			parametric_shifter << " computeSticky=False";
+			parametric_shifter << " inputPadBit=True";
+			inputs_shifter << "X=>significand_product_cpt1" << lane[l] << ",";
+			inputs_shifter << "padBit=>sign_M" << lane[l] << ",";
+			inputs_shifter << "S=>shift_value" << lane[l];
+			outputs_shifter << "R=>shifted_significand" << lane[l];
+			newInstance("Shifter", "significand_product_shifter_inst"+lane[l], parametric_shifter.str(), inputs_shifter.str(), outputs_shifter.str());
+			vhdl << endl;
 
-			// 2nd part of cpt2 building is sign extension in cpt1
-			// leave the +1 for carry in of the 1st chunk in accumulation
-			vhdl << tab << declare("ext_summand1c",m_wLAICPT2,true) << " <= " << zg(m_wLAICPT2) << " when too_small='1' else (" << (m_wLAICPT2-1<summand_size?"":rangeAssign(m_wLAICPT2-1, summand_size, "sign_M") + " & ") << "summand1c);" << endl;
+			// add 0 when shiftval is negative
+			addFullComment("detect too low scale for this specific scratchpad");
+			vhdl << tab << declare("too_small"+lane[l]) << " <= '1' when (shift_value" << lane[l] << of(scale_product_width-1)<<"='1') else '0';" << endl;
 			vhdl << endl;
+
+			// detect too_big to put in the NaN Flip-Flop
+			addFullComment("detect too big scale for this specific scratchpad");
+			//vhdl << tab << declare("too_big") << " <= '1' when (shift_value > CONV_STD_LOGIC_VECTOR(" << allowed_max_shift << "," << intlog2(allowed_max_shift) << ")) else '0';" << endl;
+			vhdl << tab << declare("too_big"+lane[l]) << " <= '1' when (unsigned(shift_value" << lane[l] << ") > " << allowed_max_shift << " and too_small" << lane[l] << "='0') else '0';" << endl;
+			vhdl << endl;
+
+			// part select from the shifted significand to partially form the summand
+			if ( (m_msb_summand - m_lsb_summand + 1) < summand_size ) {
+				addFullComment("shifted significand part select to form summand");
+				//vhdl << tab << declare("ext_summand1c",m_wLAICPT2,true) << " <= " << zg(m_wLAICPT2) << " when too_small='1' else shifted_significand" << range(m_wLAICPT2-1,0) << ";" << endl;
+				//vhdl << tab << declare("ext_summand1c",m_wLAICPT2,true) << " <= " << zg(m_wLAICPT2) << " when too_small='1' else shifted_significand" << range(m_wLAICPT2-1+significand_product_width,significand_product_width) << ";" << endl;
+				vhdl << tab << declare("ext_summand1c"+lane[l],m_wLAICPT2,true) << " <= " << zg(m_wLAICPT2) << " when too_small" << lane[l] << "='1' else shifted_significand" << lane[l] << range(m_wLAICPT2-1+significand_product_width-1,significand_product_width-1) << ";" << endl;
+			} else {
+				addFullComment("shifted significand part select to form summand");
+				vhdl << tab << declare("summand1c"+lane[l], summand_size, true, Signal::wire) << " <= shifted_significand" << lane[l] << range(shifted_product_size-1,shifted_product_size-summand_size)<<";" << endl;
+
+				// 2nd part of cpt2 building is sign extension in cpt1
+				// leave the +1 for carry in of the 1st chunk in accumulation
+				vhdl << tab << declare("ext_summand1c"+lane[l],m_wLAICPT2,true) << " <= " << zg(m_wLAICPT2) << " when too_small" << lane[l] << "='1' else (" << (m_wLAICPT2-1<summand_size?"":rangeAssign(m_wLAICPT2-1, summand_size, "sign_M"+lane[l]) + " & ") << "summand1c" << lane[l] << ");" << endl;
+				vhdl << endl;
+			}
 		}
 		// syncing signals
 		addFullComment("Syncing some signals");
 		vhdl << tab << declare(target->logicDelay(1), "not_ftz", 1, false, Signal::wire) << " <= not FTZ;" << endl;
 		if (m_has_HSSD) vhdl << tab << declare("EOB_internal") << " <= EOB;" << endl;
-		Signal *not_ftz, *ext_summand1c, *carry_0, *EOB_internal, *isNaN_M, *too_big;
+		Signal *not_ftz, *EOB_internal;
 		not_ftz = getSignalByName("not_ftz");
-		ext_summand1c = getSignalByName("ext_summand1c");
-		carry_0 = getSignalByName("sign_M");
 		if (m_has_HSSD) EOB_internal = getSignalByName("EOB_internal");
-		isNaN_M = getSignalByName("isNaN_M");
-		too_big = getSignalByName("too_big");
 		// we schedule here to have the cycle of ext_summand1c to sync not_ftz and other signals
 		schedule();
 		// applySchedule();
+		// the lanes are alike, they all reach ext_summand1c on the same cycle, the one of the accumulators
 		int d1 = not_ftz->getCycle();
-		int d2 = ext_summand1c->getCycle();
-		int d3 = carry_0->getCycle();
+		int d2 = getSignalByName("ext_summand1c"+lane[0])->getCycle();
 		int d4 = 0;
         if (m_has_HSSD) d4 = EOB_internal->getCycle();
-		int d5 = isNaN_M->getCycle();
-		int d6 = too_big->getCycle();
-		if (d2<d1 || d2<d3 || d2<d4 || d2<d5 || d2<d6) throw "develop sync the other way";
+		if (d2<d1 || d2<d4) throw "develop sync the other way";
 		addRegisteredSignalCopy("not_ftz_sync", "not_ftz", Signal::noReset, d2-d1);
-		addRegisteredSignalCopy("carry_0_sync", "sign_M", Signal::noReset, d2-d3);
-		if (m_has_HSSD) addRegisteredSignalCopy("EOB_internal_delayed", "EOB_internal", Signal::noReset, d2-d4+1);
-		addRegisteredSignalCopy("isNaN_M_sync", "isNaN_M", Signal::noReset, d2-d5);
-		addRegisteredSignalCopy("too_big_sync", "too_big", Signal::noReset, d2-d6);
+		for (int l = 0 ; l < m_packing ; l++) {
+			int d3 = getSignalByName("sign_M"+lane[l])->getCycle();
+			int d5 = getSignalByName("isNaN_M"+lane[l])->getCycle();
+			int d6 = getSignalByName("too_big"+lane[l])->getCycle();
+			if (getSignalByName("ext_summand1c"+lane[l])->getCycle() != d2 || d2<d3 || d2<d5 || d2<d6) throw "develop sync the other way";
+			addRegisteredSignalCopy("carry_0_sync"+lane[l], "sign_M"+lane[l], Signal::noReset, d2-d3);
+			if (l == 0 && m_has_HSSD) addRegisteredSignalCopy("EOB_internal_delayed", "EOB_internal", Signal::noReset, d2-d4+1);
+			addRegisteredSignalCopy("isNaN_M_sync"+lane[l], "isNaN_M"+lane[l], Signal::noReset, d2-d5);
+			addRegisteredSignalCopy("too_big_sync"+lane[l], "too_big"+lane[l], Signal::noReset, d2-d6);
+		}
 		vhdl << endl;
 
 		// The output NaN latch
 		addFullComment("Output isNaN latch");
-		vhdl << tab << declare(target->logicDelay(4), "isNaN_o", 1, false, Signal::wire) << " <= (too_big_sync or isNaN_M_sync or isNaN_delayed) when not_ftz_sync='1' else '0';" << endl;
-		addRegisteredSignalCopy("isNaN_delayed", "isNaN_o", m_reset_type);
+		for (int l = 0 ; l < m_packing ; l++) {
+			vhdl << tab << declare(target->logicDelay(4), "isNaN_o"+lane[l], 1, false, Signal::wire) << " <= (too_big_sync" << lane[l] << " or isNaN_M_sync" << lane[l] << " or isNaN_delayed" << lane[l] << ") when not_ftz_sync='1' else '0';" << endl;
+			addRegisteredSignalCopy("isNaN_delayed"+lane[l], "isNaN_o"+lane[l], m_reset_type);
+		}
 		vhdl << endl;
 
 		// The Accumulation itself as a partial Carry Save Accumulator if m_nb_chunk is > 1
 		addFullComment("Carry Save Accumulator");
 		vhdl << tab << "-- DQ logic" << endl;
-		for (int i = 0 ; i < m_nb_chunk ; ++i) {
-		 	bool lc_i = (i==m_nb_chunk-1);  // lc : last chunk
-		 	int chunk_size_i = lc_i ? m_last_chunk_size : m_chunk_size;
-		 	string carry_i, summand_i, acc_i, summand_and_carry_i;
-		 	summand_i = "summand_" + to_string(i);
-		 	carry_i = "carry_" + to_string(i);
-		 	acc_i = "acc_" + to_string(i);
-			summand_and_carry_i = "summand_and_carry_" + to_string(i);
-			declare(carry_i, 1, false, Signal::wire);
-			declare(summand_i, chunk_size_i, true);
-			declare(summand_and_carry_i, chunk_size_i+1, true);
-			declare(acc_i, chunk_size_i+1, true);
-		 	addRegisteredSignalCopy(acc_i+"_q", acc_i, m_reset_type);
+		for (int l = 0 ; l < m_packing ; l++) {
+			for (int i = 0 ; i < m_nb_chunk ; ++i) {
+			 	bool lc_i = (i==m_nb_chunk-1);  // lc : last chunk
+			 	int chunk_size_i = lc_i ? m_last_chunk_size : m_chunk_size;
+			 	string carry_i, summand_i, acc_i, summand_and_carry_i;
+			 	summand_i = "summand" + lane[l] + "_" + to_string(i);
+			 	carry_i = "carry" + lane[l] + "_" + to_string(i);
+			 	acc_i = "acc" + lane[l] + "_" + to_string(i);
+				summand_and_carry_i = "summand_and_carry" + lane[l] + "_" + to_string(i);
+				declare(carry_i, 1, false, Signal::wire);
+				declare(summand_i, chunk_size_i, true);
+				declare(summand_and_carry_i, chunk_size_i+1, true);
+				declare(acc_i, chunk_size_i+1, true);
+			 	addRegisteredSignalCopy(acc_i+"_q", acc_i, m_reset_type);
+			}
 		}
 
 		// from here we do not schedule, we just connect loop FF in direct vhdl
 		setNoParseNoSchedule();
 
 		vhdl << endl << tab << "-- sequential addition logic" << endl;
-		for (int i = 0 ; i < m_nb_chunk ; ++i) {
-		 	bool fc_i = (i==0);  // fc : first chunk
-		 	bool lc_i = (i==m_nb_chunk-1);  // lc : last chunk
-		 	int chunk_size_i = lc_i ? m_last_chunk_size : m_chunk_size;
-		 	int part_select_offset = (lc_i? m_wLAICPT2 : (m_chunk_size*(i+1)));
-		 	vhdl << tab << "carry_" << i << " <= " << (fc_i ? "carry_0_sync":("acc_" + to_string(i-1) + "_q" + of(m_chunk_size))) << ";" << endl;
-			vhdl << tab << "summand_" << i << " <= ext_summand1c" << range(part_select_offset-1, part_select_offset - chunk_size_i) << ";" << endl;
-			vhdl << tab << "summand_and_carry_" << i << " <= (\"0\" & summand_" << i << ") + carry_" << i << ";" << endl;
-			vhdl << tab << "acc_" << i << " <= ((\"0\" & acc_" << i << "_q" << range(chunk_size_i-1,0) << ") + summand_and_carry_" << i << ") when (not_ftz_sync='1') else" << endl
-				 << tab << "         summand_and_carry_" << i << ";" << endl;
+		for (int l = 0 ; l < m_packing ; l++) {
+			string acc = "acc" + lane[l] + "_";
+			for (int i = 0 ; i < m_nb_chunk ; ++i) {
+			 	bool fc_i = (i==0);  // fc : first chunk
+			 	bool lc_i = (i==m_nb_chunk-1);  // lc : last chunk
+			 	int chunk_size_i = lc_i ? m_last_chunk_size : m_chunk_size;
+			 	int part_select_offset = (lc_i? m_wLAICPT2 : (m_chunk_size*(i+1)));
+			 	vhdl << tab << "carry" << lane[l] << "_" << i << " <= " << (fc_i ? "carry_0_sync" + lane[l] : (acc + to_string(i-1) + "_q" + of(m_chunk_size))) << ";" << endl;
+				vhdl << tab << "summand" << lane[l] << "_" << i << " <= ext_summand1c" << lane[l] << range(part_select_offset-1, part_select_offset - chunk_size_i) << ";" << endl;
+				vhdl << tab << "summand_and_carry" << lane[l] << "_" << i << " <= (\"0\" & summand" << lane[l] << "_" << i << ") + carry" << lane[l] << "_" << i << ";" << endl;
+				vhdl << tab << acc << i << " <= ((\"0\" & " << acc << i << "_q" << range(chunk_size_i-1,0) << ") + summand_and_carry" << lane[l] << "_" << i << ") when (not_ftz_sync='1') else" << endl
+					 << tab << "         summand_and_carry" << lane[l] << "_" << i << ";" << endl;
+			}
 		}
 		vhdl << endl;
 
 		// compose Output
 		addFullComment("Output Compose");
 		vhdl << tab << "A <= ";
-		for (int i = m_nb_chunk - 1 ; i >= 0 ; i--) {
-			vhdl << join("acc_",i,"_q") << range(((i==m_nb_chunk-1)?m_last_chunk_size:m_chunk_size)-1,0) << (i>0?" & ":";\n");
+		for (int l = m_packing - 1 ; l >= 0 ; l--) {
+			for (int i = m_nb_chunk - 1 ; i >= 0 ; i--) {
+				vhdl << join("acc" + lane[l] + "_",i,"_q") << range(((i==m_nb_chunk-1)?m_last_chunk_size:m_chunk_size)-1,0) << ((i>0 || l>0)?" & ":";\n");
+			}
 		}
 
 		if (m_nb_chunk > 1) {
-			if (m_nb_chunk>2) {
+			if (m_packing > 1) {
+				vhdl << tab << "C <= ";
+			} else if (m_nb_chunk>2) {
 				vhdl << tab << "C" << range(m_nb_chunk-2,0) << " <= ";
 			} else {  // one bit
 				vhdl << tab << "C(0) <= ";
 			}
+			for (int l = m_packing - 1 ; l >= 0 ; l--) {
 				for (int i=m_nb_chunk-1;i>=0; i--){
-					vhdl << ((i<m_nb_chunk-1)?join("acc_",i,"_q")+ of(m_chunk_size) +((i>0)?" & ":""):"");
+					vhdl << ((i<m_nb_chunk-1)?join("acc" + lane[l] + "_",i,"_q")+ of(m_chunk_size) +((i>0 || l>0)?" & ":""):"");
 					// Uncomment the following line to generate the 0s for a direct rippling addition of A and C. Here we save bits for systolic array transports.
 					// vhdl << (i==m_nb_chunk-1?zg(m_last_chunk_size-(i>0?1:0))+(i>0?" & ":""):(i>0?zg(m_chunk_size-1)+" & ":zg(m_chunk_size)));
-				}vhdl << ";";
+				}
 			}
+			vhdl << ";";
+		}
 		vhdl << endl;
 		if (m_has_HSSD) vhdl << tab << "EOB_Q <= EOB_internal_delayed;" << endl;
-		vhdl << tab << "isNaN <= isNaN_delayed;";
+		if (m_packing > 1) {
+			for (int l = 0 ; l < m_packing ; l++) {
+				vhdl << tab << "isNaN(" << l << ") <= isNaN_delayed" << lane[l] << ";" << endl;
+			}
+		} else {
+			vhdl << tab << "isNaN <= isNaN_delayed;";
+		}
 		vhdl << endl;
 
 	}
@@ -451,17 +528,28 @@ namespace flopoco{
 		return tc;
 	}
 
+	int S3FDP::resolveWindow(int scale_width, int fraction_width, int &nb_bits_ovf, int &msb_summand, int &lsb_summand) {
+		if (nb_bits_ovf == -1) {
+			nb_bits_ovf = scale_width+fraction_width-1;  // arbitrary size that increases proportionally with the "problem" size
+		}
+		if (msb_summand == -1) {
+			msb_summand = ((int)(pow(scale_width,2))-1)<<1;
+		}
+		if (lsb_summand == -1) {
+			lsb_summand = -(((int)(pow(scale_width,2))-1)<<1);
+		}
+		return msb_summand + nb_bits_ovf - lsb_summand + 1;  // add one bit for the sign
+	}
+
 	int S3FDP::get_wLAICPT2() {
 		return m_wLAICPT2;
 	}
 
 	int S3FDP::getPipelineDepth() {
 		// works only for this component, it is mult + shift + 1
-		int PP_sum = 0;
-		for (auto i : getSubComponentList()) {
-			PP_sum += (i->getPipelineDepth());
-		}
-		return PP_sum+1;
+		// the shifters of the lanes of a packed S3FDP are alike and work side by side, count one
+		vector<Operator*> sub_components = getSubComponentList();
+		return sub_components[0]->getPipelineDepth() + sub_components[1]->getPipelineDepth() + 1;
 	}
 
 
@@ -473,6 +561,7 @@ namespace flopoco{
 		int chunk_size;
 		double dspOccupationThreshold;
 		bool has_HSSD;
+		int packing;
 
 		UserInterface::parseInt(args, "scale_width", &scale_width);
 		UserInterface::parseInt(args, "fraction_width", &fraction_width);
@@ -483,6 +572,7 @@ namespace flopoco{
 		UserInterface::parseInt(args, "chunk_size", &chunk_size);
 		UserInterface::parseFloat(args, "dspThreshold", &dspOccupationThreshold);
 		UserInterface::parseBoolean(args, "has_HSSD", &has_HSSD);
+		UserInterface::parseInt(args, "packing", &packing);
 
 		return new S3FDP(parentOp, target,
 				scale_width,
@@ -493,7 +583,8 @@ namespace flopoco{
 				lsb_summand,
 				chunk_size,
 				dspOccupationThreshold,
-				has_HSSD);
+				has_HSSD,
+				packing);
 	}
 
 	void S3FDP::registerFactory() {
@@ -508,9 +599,10 @@ namespace flopoco{
 			 nb_bits_ovf(int)=-1: The number of bits prepended before the actual MSB weight of summands. One bit adds one binade to prevent overflow in non cancellation accumulations. These bits affect the size of the adder but not of the shifter, they are not too expansive; \
 			 msb_summand(int)=-1: The expected biggest product value weight. If not precised, the tool will go to full precision (aka exact); \
 			 lsb_summand(int)=-1: The expected smallest product value weight. If not precised, the tool will go to full precision (aka exact); \
-			 chunk_size(int)=-1: An expert can suggest a size for a sub adder chunk for the carry save accum. This should be target specific calculated by the tool; \
+			 chunk_size(int)=-1: An expert can suggest a size for a sub adder chunk for the carry save accum. This should be target specific calculated by the tool, 0 lets S3FDPTuner pick it for the frequency; \
 			 dspThreshold(real)=0.0: The ratio of dsp over logic for mantissa product; \
-			 has_HSSD(bool)=true: indicates the presence of the Half Speed Sink Down chain",
+			 has_HSSD(bool)=true: indicates the presence of the Half Speed Sink Down chain; \
+			 packing(int)=1: The number of S3_y lanes multiplied by S3_x in one multiplier, each with its own accumulator",
 			"",  // More documentation for the HTML pages. If you want to link to your blog, it is here.
 			S3FDP::parseArguments
 		) ;
@@ -28,9 +28,10 @@ namespace flopoco{
 		 * @param[in] {int=n-1} nb_bits_ovf : The number of bits prepended before the actual MSB weight of summands
 		 * @param[in] {int= 2*(2^(scale_width-1)-1)} msb_summand : The expected biggest product value weight
 		 * @param[in] {int=-2*(2^(scale_width-1)-1)} lsb_summand : The expected smallest product value wieght
-		 * @param[in] {int=-1} chunk_size : The user-suggested size of a chunk in the partial CSA. Computed by flopoco if not provided.
+		 * @param[in] {int=-1} chunk_size : The user-suggested size of a chunk in the partial CSA. Computed by flopoco if not provided, by S3FDPTuner if 0.
 		 * @param[in] {float=0.0} dspOccupationThreshold : the ratio of DSP to be used in the mantissa product
 		 * @param[in] {bool=true} has_HSSD : indicates if the PE contains the half speed sink down chain
+		 * @param[in] {int=1} packing : the number of S3_y lanes whose products with S3_x share one multiplier
 		 **/
 		S3FDP(OperatorPtr parentOp, Target* target,
 				int scale_width,
@@ -41,7 +42,8 @@ namespace flopoco{
 				int lsb_summand=-1,
 				int chunk_size=-1,
 				double dspOccupationThreshold = 0.0,
-				bool has_HSSD=true);
+				bool has_HSSD=true,
+				int packing=1);
 
 		/**
 		 * S3FDP destructor
@@ -63,6 +65,12 @@ namespace flopoco{
 
 		int get_wLAICPT2();
 
+		/**
+		 * @brief fills the defaults (-1) of the accumulation window like the constructor does
+		 * @return {int} the accumulator width wLAICPT2, sign and overflow bits included
+		 */
+		static int resolveWindow(int scale_width, int fraction_width, int &nb_bits_ovf, int &msb_summand, int &lsb_summand);
+
 		int getPipelineDepth();
 
 
@@ -81,6 +89,7 @@ namespace flopoco{
 		int m_chunk_size;
 		float m_dspOccupationThreshold;
 		bool m_has_HSSD;
+		int m_packing;  // lanes per multiplier
 
 		Signal::ResetType m_reset_type;
 		std::list<int> m_ftz_clock_positions; // for testbench
@@ -0,0 +1,133 @@
+#include "SA/S3FDPTuner.hpp"
+
+namespace flopoco {
+
+	S3FDPTuner::S3FDPTuner(Target* target, int wLAICPT2, int N, int M, int packing):
+			m_target(target),
+			m_wLAICPT2(wLAICPT2),
+			m_N(N),
+			m_M(M),
+			m_packing(packing) {
+		for (int h = 1 ; h >= 0 ; h--) {
+			// chunks go by CARRY8, the last one is the whole accumulator
+			for (int chunk_size = 8 ; ; chunk_size += 8) {
+				S3FDPConfig c;
+				c.chunk_size = min(chunk_size, m_wLAICPT2);
+				c.has_HSSD = (h == 1);
+				estimate(c);
+				m_configs.push_back(c);
+				if (chunk_size >= m_wLAICPT2) break;
+			}
+		}
+		// a configuration is on the Pareto front when no other one is as fast and as small
+		for (unsigned i = 0 ; i < m_configs.size() ; i++) {
+			S3FDPConfig & c = m_configs[i];
+			c.pareto = true;
+			for (unsigned j = 0 ; j < m_configs.size() && c.pareto ; j++) {
+				S3FDPConfig & d = m_configs[j];
+				if (i != j && d.critical_path <= c.critical_path && d.luts <= c.luts && d.ffs <= c.ffs
+						&& (d.critical_path < c.critical_path || d.luts < c.luts || d.ffs < c.ffs)) {
+					c.pareto = false;
+				}
+			}
+		}
+	}
+
+	void S3FDPTuner::estimate(S3FDPConfig & c) {
+		const double period = 1.0/m_target->frequency();
+		const long pes = (long)m_N*(m_M/m_packing);
+		const int fanout_cols = min(m_N, m_M/m_packing);
+		c.nb_chunk = (m_wLAICPT2 + c.chunk_size - 1)/c.chunk_size;
+		const int wC = c.nb_chunk - 1;
+		const int wOut = m_wLAICPT2 + wC + 1;  // accumulator, carries and NaN of a column
+
+		// each chunk adds into its own register, which also feeds the carry of the next one
+		c.loop_delay = m_target->ffDelay() + m_target->fanoutDelay(2) + m_target->adderDelay(c.chunk_size+1);
+		// the accumulate or load mux sits in the LUTs in front of the carry chain of the chunk
+		c.select_delay = m_target->ffDelay() + m_target->fanoutDelay(m_packing*(c.chunk_size+1)) + m_target->adderDelay(c.chunk_size+1);
+		// the one-hot mux of a column ORs N (select, PE) pairs in a tree of 6-input LUTs
+		int mux_levels = 0;
+		long mux_luts = 0;
+		for (int inputs = 2*m_N ; inputs > 1 ; inputs = (inputs+5)/6) {
+			mux_levels++;
+			mux_luts += (inputs+5)/6;
+		}
+		if (c.has_HSSD) {
+			c.drain_delay = m_target->ffDelay() + m_target->fanoutDelay(m_packing*wOut) + m_target->lutDelay();
+		} else {
+			// an EOB_select tap selects the PEs of one anti-diagonal, up to min(N, M/packing) of them
+			c.drain_delay = m_target->ffDelay() + m_target->fanoutDelay(fanout_cols*m_packing*wOut)
+				+ mux_levels*(m_target->lutDelay() + m_target->fanoutDelay(1));
+		}
+		c.critical_path = max(c.loop_delay, max(c.select_delay, c.drain_delay));
+		c.slack = period - c.critical_path;
+		c.feasible = (c.slack >= 0);
+
+		// two adders per chunk, the carry increment and the accumulation, one LUT per bit each,
+		// the accumulator registers and one copy of the select per chunk
+		c.luts = pes*2*m_packing*(m_wLAICPT2 + c.nb_chunk);
+		c.ffs = pes*(m_packing*(m_wLAICPT2 + c.nb_chunk) + c.nb_chunk);
+		if (c.has_HSSD) {
+			// two bits of 2:1 mux per LUT, two register stages down the column
+			c.luts += pes*((m_packing*wOut+1)/2);
+			c.ffs += pes*2*m_packing*wOut;
+		} else {
+			c.luts += (long)m_M*wOut*mux_luts;
+			c.ffs += m_N + m_M/m_packing;
+		}
+	}
+
+	double S3FDPTuner::cost(const S3FDPConfig & c) {
+		return c.luts + c.ffs/2.0;
+	}
+
+	S3FDPConfig S3FDPTuner::pick(bool any_HSSD, bool has_HSSD) {
+		int best = -1;
+		for (unsigned i = 0 ; i < m_configs.size() ; i++) {
+			S3FDPConfig & c = m_configs[i];
+			if (!any_HSSD && c.has_HSSD != has_HSSD) continue;
+			if (best < 0) {
+				best = i;
+				continue;
+			}
+			S3FDPConfig & b = m_configs[best];
+			if (c.feasible != b.feasible) {
+				if (c.feasible) best = i;
+			} else if (c.feasible || c.slack == b.slack) {
+				// the cheapest of the ones meeting the period, or of the equally late ones
+				if (cost(c) < cost(b) || (cost(c) == cost(b) && c.slack > b.slack)) best = i;
+			} else if (c.slack > b.slack) {
+				best = i;
+			}
+		}
+		return m_configs[best];
+	}
+
+	const vector<S3FDPConfig> & S3FDPTuner::getConfigs() {
+		return m_configs;
+	}
+
+	S3FDPConfig S3FDPTuner::getBest() {
+		return pick(true, true);
+	}
+
+	S3FDPConfig S3FDPTuner::getBest(bool has_HSSD) {
+		return pick(false, has_HSSD);
+	}
+
+	void S3FDPTuner::outputReport(ostream & o, const S3FDPConfig & chosen) {
+		o << "# S3FDP tuning at " << m_target->frequencyMHz() << "MHz on " << m_target->getID()
+		  << ", wLAICPT2=" << m_wLAICPT2 << ", N=" << m_N << ", M=" << m_M << ", packing=" << m_packing << endl;
+		o << "has_HSSD,chunk_size,nb_chunk,loop_ns,select_ns,drain_ns,critical_path_ns,slack_ns,luts,ffs,feasible,pareto,chosen" << endl;
+		for (unsigned i = 0 ; i < m_configs.size() ; i++) {
+			S3FDPConfig & c = m_configs[i];
+			o << c.has_HSSD << "," << c.chunk_size << "," << c.nb_chunk
+			  << "," << c.loop_delay*1e9 << "," << c.select_delay*1e9 << "," << c.drain_delay*1e9
+			  << "," << c.critical_path*1e9 << "," << c.slack*1e9
+			  << "," << c.luts << "," << c.ffs
+			  << "," << c.feasible << "," << c.pareto
+			  << "," << (c.has_HSSD == chosen.has_HSSD && c.chunk_size == chosen.chunk_size) << endl;
+		}
+	}
+
+}
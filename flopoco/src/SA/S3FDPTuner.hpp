@@ -0,0 +1,95 @@
+/*
+  S3FDPTuner: chunk size and HSSD choice of the S3FDP accumulators against a frequency target
+
+  Author: Ledoux Louis
+
+ */
+
+#ifndef S3FDPTUNER_HPP
+#define S3FDPTUNER_HPP
+#include <vector>
+#include <ostream>
+
+#include "Target.hpp"
+
+namespace flopoco {
+
+	/**
+	 * @brief One candidate accumulator configuration and its estimated cost
+	 * Delays are in seconds, resources count the whole array (N*M/packing PEs).
+	 */
+	typedef struct S3FDPConfig {
+		int chunk_size;
+		bool has_HSSD;
+		int nb_chunk;
+		double loop_delay;      // acc_q -> chunk adder -> acc
+		double select_delay;    // not_ftz_sync fanned out over the mux LUTs of a chunk -> chunk adder -> acc
+		double drain_delay;     // EOB fanned out over the HSSD muxes, or over the one-hot mux trees at the bottom
+		double critical_path;
+		double slack;
+		long luts;
+		long ffs;
+		bool feasible;
+		bool pareto;
+	} S3FDPConfig;
+
+	/**
+	 * @brief Enumerates the chunk sizes (multiples of 8, the CARRY8 of the target, up to wLAICPT2)
+	 * and both HSSD options of the accumulators of an N x M array, estimates their paths and
+	 * resources with the delay model of the target, and picks the cheapest one meeting the period.
+	 *
+	 * Unlike Target::suggestSubaddSize, the select path counts the routing of not_ftz_sync, which
+	 * fans out to the chunk+1 mux LUTs of every chunk of every lane (the synthesizer replicates
+	 * its driver per carry chain, the tuner charges one FF per chunk for it).
+	 * The cost of a configuration is luts + ffs/2, as a slice holds twice as many FFs as LUTs.
+	 */
+	class S3FDPTuner
+	{
+	public:
+
+		/**
+		 * @brief The S3FDPTuner constructor, enumerates and estimates all the configurations
+		 * @param[in] {Target*} target : the target device, whose frequency is the goal
+		 * @param[in] {int} wLAICPT2 : the accumulator width, sign and overflow bits included
+		 * @param[in] {int=1} N : the number of rows of the array
+		 * @param[in] {int=1} M : the number of columns of the array
+		 * @param[in] {int=1} packing : the number of columns, hence accumulators, per PE
+		 */
+		S3FDPTuner(Target* target, int wLAICPT2, int N=1, int M=1, int packing=1);
+
+		/**
+		 * @brief the configurations, by HSSD option then increasing chunk size
+		 */
+		const vector<S3FDPConfig> & getConfigs();
+
+		/**
+		 * @brief the feasible configuration of least cost, or the one of most slack if none meets the period
+		 */
+		S3FDPConfig getBest();
+
+		/**
+		 * @brief same as getBest, among the configurations with the given HSSD option
+		 */
+		S3FDPConfig getBest(bool has_HSSD);
+
+		/**
+		 * @brief writes the configurations as CSV, one line each, the chosen one flagged
+		 */
+		void outputReport(ostream & o, const S3FDPConfig & chosen);
+
+	private:
+
+		void estimate(S3FDPConfig & c);
+		S3FDPConfig pick(bool any_HSSD, bool has_HSSD);
+		static double cost(const S3FDPConfig & c);
+
+		Target* m_target;
+		int m_wLAICPT2;
+		int m_N;
+		int m_M;
+		int m_packing;
+		vector<S3FDPConfig> m_configs;
+	};
+
+}
+#endif  // S3FDPTUNER_HPP
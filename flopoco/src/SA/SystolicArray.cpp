@@ -1,6 +1,7 @@
 /*
 
-  Systolic Array implementation. Orthogonal N*M for the moment.
+  Systolic Array implementation. Orthogonal N*M, or weight stationary
+  around an orthogonal one.
 
   Author: Ledoux Louis
 
@@ -11,12 +12,14 @@
 
 #include <vector>
 #include <sstream>
+#include <fstream>
 
 #include "Operator.hpp"
 #include "SA/SystolicArrayKernel.hpp"
 #include "SA/IEEE_to_S3.hpp"
 #include "SA/Posit_to_S3.hpp"
 #include "SA/LAICPT2_to_arith.hpp"
+#include "SA/S3FDPTuner.hpp"
 
 using namespace std;
 
@@ -34,7 +37,12 @@ namespace flopoco{
 			int lsb_summand,
 			int chunk_size,
 			double dspOccupationThreshold,
-			bool has_HSSD):
+			bool has_HSSD,
+			string topology,
+			int b_depth,
+			int packing,
+			vector<vector<string> > arithmetic_alt,
+			bool tune):
 				Operator(parentOp, target),
 				m_N(N),
 				m_M(M),
@@ -43,7 +51,12 @@ namespace flopoco{
 				m_lsb_summand(lsb_summand),
 				m_chunk_size(chunk_size),
 				m_dspOccupationThreshold(dspOccupationThreshold),
-				m_has_HSSD(has_HSSD) {
+				m_has_HSSD(has_HSSD),
+				m_topology(topology),
+				m_b_depth(b_depth),
+				m_packing(packing),
+				m_arithmetic_alt(arithmetic_alt),
+				m_tune(tune) {
 
 		// 1.  We detect the incoming arithmetic and do some checkings
 		// 2.  We part select the inputs buses to get right rows and cols
@@ -68,14 +81,69 @@ namespace flopoco{
 		} else {
 			parse_arithmetic(arithmetic_out, m_scale_width_out, m_fraction_width_out, m_bias_out, m_subnormals_out, m_dense_out);
 		}
+		// With alternate arithmetics the kernel works on an S3 holding all of them: the widest
+		// fraction, and a scale biased by the largest bias reaching up to the largest top scale.
+		// The outputs stay in the arithmetic_in format, and so do the bus slots, which must hold
+		// every alternate format in their low bits.
+		if (m_arithmetic_alt.size() > 3) {
+			THROWERROR("at most 3 alternate arithmetics, got " << m_arithmetic_alt.size());
+		}
+		int top_scale = (1 << m_scale_width_in) - 1 - m_bias_in;
+		for (unsigned f = 0 ; f < m_arithmetic_alt.size() ; f++) {
+			int scale_width, fraction_width, bias, dense;
+			bool subnormals;
+			parse_arithmetic(&m_arithmetic_alt[f], scale_width, fraction_width, bias, subnormals, dense);
+			if (dense > m_dense_in) {
+				THROWERROR("alternate arithmetic " << boost::algorithm::join(m_arithmetic_alt[f], ":") << " is wider than arithmetic_in");
+			}
+			m_fraction_width_in = max(m_fraction_width_in, fraction_width);
+			m_bias_in = max(m_bias_in, bias);
+			top_scale = max(top_scale, (1 << scale_width) - 1 - bias);
+		}
+		if (!m_arithmetic_alt.empty()) {
+			m_scale_width_in = intlog2(top_scale + m_bias_in);
+		}
 		m_s3_in = m_scale_width_in + m_fraction_width_in + 3;
+		if (m_packing < 1 || m_M % m_packing != 0) {
+			THROWERROR("packing must divide M=" << m_M << ", got " << m_packing);
+		}
+		// the columns of a packed PE enter and leave the kernel together, so the skews go by PE column
+		const int pe_cols = m_M / m_packing;
+
+		// The accumulators are tuned here rather than in S3FDP, which does not know the array size
+		// the drain paths and resources depend on
+		if (m_tune || m_chunk_size == 0) {
+			int nb_bits_ovf = m_nb_bits_ovf, msb_summand = m_msb_summand, lsb_summand = m_lsb_summand;
+			int wLAICPT2 = S3FDP::resolveWindow(m_scale_width_in, m_fraction_width_in, nb_bits_ovf, msb_summand, lsb_summand);
+			S3FDPTuner tuner(target, wLAICPT2, m_N, m_M, m_packing);
+			S3FDPConfig best = m_tune ? tuner.getBest() : tuner.getBest(m_has_HSSD);
+			m_chunk_size = best.chunk_size;
+			m_has_HSSD = best.has_HSSD;
+			REPORT(INFO, "tuned chunk_size=" << m_chunk_size << " has_HSSD=" << m_has_HSSD << ", estimated critical path "
+				<< best.critical_path*1e9 << "ns" << (best.feasible ? "" : ", which misses the period")
+				<< ", all candidates in S3FDP_tuning.csv");
+			ofstream report_file("S3FDP_tuning.csv", ios::out);
+			tuner.outputReport(report_file, best);
+			report_file.close();
+		}
+
+		if (m_topology.compare("weight_stationary") == 0) {
+			buildWeightStationary(target, arithmetic_in, arithmetic_out);
+			return;
+		}
+		if (m_topology.compare("orthogonal") != 0) {
+			THROWERROR("Unknown topology " << m_topology << ", expected orthogonal or weight_stationary");
+		}
 
 		ostringstream module_name;
-		std::string topology = "orthogonal";  // only orthogonal for the moment
-		module_name << "SA_" << topology << "_" <<  N << "w" << M << "h_";
+		module_name << "SA_" << m_topology << "_" <<  N << "w" << M << "h_";
 		std::string joined = boost::algorithm::join(*arithmetic_in, "_");
 		module_name << joined;
+		for (unsigned f = 0 ; f < m_arithmetic_alt.size() ; f++) {
+			module_name << "_or_" << boost::algorithm::join(m_arithmetic_alt[f], "_");
+		}
 		if (m_has_HSSD) module_name << "_HSSD";
+		if (m_packing > 1) module_name << "_P" << m_packing;
 		setNameWithFreqAndUID(module_name.str());
 		setCopyrightString("Ledoux Louis - BSC / UPC");
 
@@ -85,6 +153,7 @@ namespace flopoco{
 		addInput("colsB",m_M*m_dense_in,true);
 		addInput("SOB");
 		addInput("EOB");
+		addInput("FORMAT", 2);  // 0 for arithmetic_in, f for the alternate f, held for the whole job; unused without alternates
 
 		PE_S3* pe = new PE_S3(nullptr, target,
 				m_scale_width_in,
@@ -95,7 +164,8 @@ namespace flopoco{
 				m_lsb_summand,
 				m_chunk_size,
 				m_dspOccupationThreshold,
-				m_has_HSSD);
+				m_has_HSSD,
+				m_packing);
 		vector<Operator*> pe_sub_components = pe->getSubComponentList();
 		S3FDP* s3fdp = (S3FDP*)pe_sub_components[0];
 		s3fdp->schedule();
@@ -131,26 +201,25 @@ namespace flopoco{
 			vhdl << tab << declare(join("arith_in_col_", j), m_dense_in) << " <= colsB(" <<(((j+1)*m_dense_in)-1)<< " downto " <<(j*m_dense_in)<< ");" << endl;
 			s = getSignalByName(join("arith_in_col_",j));
 			s->setResetType(Signal::noReset);
-			delayed_arith_in << "arith_in_col_" << j << "_q" << j;
-			vhdl << tab << declare(delayed_arith_in.str(),m_dense_in) << " <= arith_in_col_" << j << "^" << j <<";" << endl;
+			delayed_arith_in << "arith_in_col_" << j << "_q" << j/m_packing;
+			vhdl << tab << declare(delayed_arith_in.str(),m_dense_in) << " <= arith_in_col_" << j << "^" << j/m_packing <<";" << endl;
 			getSignalByName(delayed_arith_in.str())->setHasBeenScheduled(true);
 			delayed_arith_in.str("");
 		}
 		vhdl << endl;
 
-		Operator* a2s3;
-		if (arithmetic_in->at(0).compare("posit") == 0) {
-			int es = 0;
-			if (arithmetic_in->size() >= 3) {es = stoi(arithmetic_in->at(2));}else {es = 2;}
-			a2s3 = new Posit_to_S3(target, nullptr, m_dense_in, es);
-		} else {
-			a2s3 = new IEEE_to_S3(target, nullptr, m_scale_width_in, m_fraction_width_in);
+		// one Arith_to_S3 per input arithmetic, the SAK waits for the slowest
+		vector<vector<string>*> arithmetics(1, arithmetic_in);
+		for (unsigned f = 0 ; f < m_arithmetic_alt.size() ; f++) {
+			arithmetics.push_back(&m_arithmetic_alt[f]);
+		}
+		vector<Operator*> a2s3;
+		int a2s3_ppDepth = 0;
+		for (unsigned f = 0 ; f < arithmetics.size() ; f++) {
+			a2s3.push_back(buildArithToS3(target, arithmetics[f], f == 0 ? "Arith_to_S3" : join("Arith_to_S3_", f)));
+			a2s3_ppDepth = max(a2s3_ppDepth, a2s3[f]->getPipelineDepth());
+			addSubComponent(a2s3[f]);
 		}
-		a2s3->setName("Arith_to_S3");
-		a2s3->schedule();
-		a2s3->applySchedule();
-		int a2s3_ppDepth = a2s3->getPipelineDepth();
-		addSubComponent(a2s3);
 
 		// TODO(lledoux): update constructor params
 		std::string joined_tmp = boost::algorithm::join(*arithmetic_out, "_");
@@ -188,8 +257,8 @@ namespace flopoco{
 			vhdl << tab << declare(join("arith_out_col_out_", j), m_dense_out) << " <= LAICPT2_to_arith(" <<(((j+1)*m_dense_out)-1)<< " downto " <<(j*m_dense_out)<< ");" << endl;
 			s = getSignalByName(join("arith_out_col_out_",j));
 			s->setResetType(Signal::noReset);
-			delayed_arith_out << "arith_out_col_out_" << j << "_q" << m_M-1-j;
-			vhdl << tab << declare(delayed_arith_out.str(),m_dense_out) << " <= arith_out_col_out_" << j << "^" << m_M-1-j <<";" << endl;
+			delayed_arith_out << "arith_out_col_out_" << j << "_q" << pe_cols-1-j/m_packing;
+			vhdl << tab << declare(delayed_arith_out.str(),m_dense_out) << " <= arith_out_col_out_" << j << "^" << pe_cols-1-j/m_packing <<";" << endl;
 			getSignalByName(delayed_arith_out.str())->setHasBeenScheduled(true);
 			delayed_arith_out.str("");
 		}
@@ -197,7 +266,7 @@ namespace flopoco{
 
 		if (!m_has_HSSD) {
 			addFullComment("Generate Shift-register for EOB time-alignment");
-			addRegisteredSignalCopy("EOB_aligned", "EOB_select", Signal::noReset, s3fdp_ppDepth+m_N+m_M-1);
+			addRegisteredSignalCopy("EOB_aligned", "EOB_select", Signal::noReset, s3fdp_ppDepth+m_N+pe_cols-1);
 			vhdl << endl;
 		}
 
@@ -212,7 +281,7 @@ namespace flopoco{
 			for (int j=0 ; j < m_M ; j++) {
 				vhdl << tab << "colsC_LAICPT2_muxed" << range((j+1)*(wLAICPT2+wCOutput+1)-1, j*(wLAICPT2+wCOutput+1)) << " <= " << endl;
 				for (int i=0 ; i < m_N ; i++) {
-					vhdl << tab << tab << "colsC_LAICPT2" << range(((j*m_N)+i+1)*(wLAICPT2+wCOutput+1)-1,((j*m_N)+i)*(wLAICPT2+wCOutput+1)) << " when (EOB_select_d" << s3fdp_ppDepth-1+i+j << "='1') else " << endl;
+					vhdl << tab << tab << "colsC_LAICPT2" << range(((j*m_N)+i+1)*(wLAICPT2+wCOutput+1)-1,((j*m_N)+i)*(wLAICPT2+wCOutput+1)) << " when (EOB_select_d" << s3fdp_ppDepth-1+i+j/m_packing << "='1') else " << endl;
 					if (i==m_N-1) {vhdl << tab << tab << "\"" << string((wLAICPT2+wCOutput+1), '0') << "\";" << endl;}
 				}
 			}
@@ -230,13 +299,17 @@ namespace flopoco{
 		for (int i = 0 ; i < m_N ; i++) {
 			vhdl << tab << "rows_i_arith("<<i<<") <= " << "arith_in_row_" << i << "_q" << i << ";" << endl;
 		}
-		vhdl << tab << "rows_a2s3: for II in 0 to " << m_N-1 << " generate" << endl;
-		vhdl << tab << tab << "a2s3_i: Arith_to_S3" << endl;
-		vhdl << tab << tab << tab << "port map ( clk => clk," << endl;
-		vhdl << tab << tab << tab << "           arith_i => rows_i_arith(II)," << endl;
-		vhdl << tab << tab << tab << "           s3_o => rows_i_s3(((II+1)*"<< m_s3_in <<")-1 downto II*"<< m_s3_in<<"));" << endl;
-		vhdl << tab << "end generate;" << endl;
-		vhdl << endl;
+		if (m_arithmetic_alt.empty()) {
+			vhdl << tab << "rows_a2s3: for II in 0 to " << m_N-1 << " generate" << endl;
+			vhdl << tab << tab << "a2s3_i: Arith_to_S3" << endl;
+			vhdl << tab << tab << tab << "port map ( clk => clk," << endl;
+			vhdl << tab << tab << tab << "           arith_i => rows_i_arith(II)," << endl;
+			vhdl << tab << tab << tab << "           s3_o => rows_i_s3(((II+1)*"<< m_s3_in <<")-1 downto II*"<< m_s3_in<<"));" << endl;
+			vhdl << tab << "end generate;" << endl;
+			vhdl << endl;
+		} else {
+			buildFormatSelect(arithmetics, a2s3, a2s3_ppDepth, "rows_i", "II", m_N);
+		}
 
 		addFullComment("Generate Arith_to_S3 for cols and connect them");
 		declare("cols_j_arith", m_M*m_dense_in);
@@ -247,16 +320,20 @@ namespace flopoco{
 		addType("array_M_dense", type_array_M_dense.str());
 		addType("array_M_s3", type_array_M_s3.str());
 		for (int j = 0 ; j < m_M ; j++) {
-			vhdl << tab << "cols_j_arith("<<j<<") <= " << "arith_in_col_" << j << "_q" << j << ";" << endl;
+			vhdl << tab << "cols_j_arith("<<j<<") <= " << "arith_in_col_" << j << "_q" << j/m_packing << ";" << endl;
 		}
 
-		vhdl << tab << "cols_a2s3: for JJ in 0 to " << m_M-1 << " generate" << endl;
-		vhdl << tab << tab << "a2s3_j: Arith_to_S3" << endl;
-		vhdl << tab << tab << tab << "port map ( clk => clk," << endl;
-		vhdl << tab << tab << tab << "           arith_i => cols_j_arith(JJ)," << endl;
-		vhdl << tab << tab << tab << "           s3_o => cols_j_s3(((JJ+1)*"<< m_s3_in <<")-1 downto JJ*"<< m_s3_in<<"));" << endl;
-		vhdl << tab << "end generate;" << endl;
-		vhdl << endl;
+		if (m_arithmetic_alt.empty()) {
+			vhdl << tab << "cols_a2s3: for JJ in 0 to " << m_M-1 << " generate" << endl;
+			vhdl << tab << tab << "a2s3_j: Arith_to_S3" << endl;
+			vhdl << tab << tab << tab << "port map ( clk => clk," << endl;
+			vhdl << tab << tab << tab << "           arith_i => cols_j_arith(JJ)," << endl;
+			vhdl << tab << tab << tab << "           s3_o => cols_j_s3(((JJ+1)*"<< m_s3_in <<")-1 downto JJ*"<< m_s3_in<<"));" << endl;
+			vhdl << tab << "end generate;" << endl;
+			vhdl << endl;
+		} else {
+			buildFormatSelect(arithmetics, a2s3, a2s3_ppDepth, "cols_j", "JJ", m_M);
+		}
 
 		addFullComment("Instantiate the Systolic Array Kernel");
 		SystolicArrayKernel* sak = new SystolicArrayKernel(nullptr, target,
@@ -270,7 +347,8 @@ namespace flopoco{
 			m_lsb_summand,
 			m_chunk_size,
 			m_dspOccupationThreshold,
-			m_has_HSSD);
+			m_has_HSSD,
+			m_packing);
 
 		sak->setName("SystolicArrayKernel");
 		addSubComponent(sak);
@@ -305,15 +383,218 @@ namespace flopoco{
 
 		addFullComment("Connect outgoing delayed dense arith words to colsC output bus");
 		for( int j=0 ; j < m_M ; j++) {
-			vhdl << tab << "colsC(" <<(((j+1)*m_dense_out)-1)<< " downto " <<(j*m_dense_out)<< ") <= arith_out_col_out_" << j << "_q" << m_M-1-j << ";" << endl;
+			vhdl << tab << "colsC(" <<(((j+1)*m_dense_out)-1)<< " downto " <<(j*m_dense_out)<< ") <= arith_out_col_out_" << j << "_q" << pe_cols-1-j/m_packing << ";" << endl;
 		}
 		vhdl << endl;
 
 		if (!m_has_HSSD) {
-			vhdl << tab << "EOB_Q_o <= EOB_select_d" << s3fdp_ppDepth + m_M + m_N - 1 << ";" << endl;
+			vhdl << tab << "EOB_Q_o <= EOB_select_d" << s3fdp_ppDepth + pe_cols + m_N - 1 << ";" << endl;
 		}
 	}
 
+	void SystolicArray::buildWeightStationary(Target* target, vector<string>* arithmetic_in, vector<string>* arithmetic_out) {
+
+		// The B band is written once to a buffer holding b_depth k steps, by bus words flagged LDB,
+		// then read back one k step per A word, for each A band that uses it. The buffer output is
+		// registered (block RAM), A and the SOB/EOB flags get the same register, and the whole feeds an
+		// orthogonal array that sees the usual stream, one cycle later.
+		// SOB rewinds both addresses. LDB words carry no A: the array gets zeros and neither their SOB
+		// nor their EOB, so a longer k can be loaded a slice at a time without clearing the accumulators.
+		// Cycles without VALID feed zeros and move no address.
+		if (m_b_depth < 2 || (m_b_depth & (m_b_depth-1)) != 0) {
+			THROWERROR("b_depth must be a power of two, at least 2, got " << m_b_depth);
+		}
+		const int addr_width = intlog2(m_b_depth-1);
+
+		SystolicArray* core = new SystolicArray(nullptr, target,
+			m_N,
+			m_M,
+			arithmetic_in,
+			arithmetic_out,
+			m_nb_bits_ovf,
+			m_msb_summand,
+			m_lsb_summand,
+			m_chunk_size,
+			m_dspOccupationThreshold,
+			m_has_HSSD,
+			"orthogonal",
+			m_b_depth,
+			m_packing,
+			m_arithmetic_alt);
+		addSubComponent(core);
+		m_dense_out = core->getSignalByName("colsC")->width() / m_M;
+
+		ostringstream module_name;
+		module_name << "SA_" << m_topology << "_" <<  m_N << "w" << m_M << "h_";
+		module_name << boost::algorithm::join(*arithmetic_in, "_");
+		for (unsigned f = 0 ; f < m_arithmetic_alt.size() ; f++) {
+			module_name << "_or_" << boost::algorithm::join(m_arithmetic_alt[f], "_");
+		}
+		module_name << "_B" << m_b_depth;
+		if (m_has_HSSD) module_name << "_HSSD";
+		if (m_packing > 1) module_name << "_P" << m_packing;
+		setNameWithFreqAndUID(module_name.str());
+		setCopyrightString("Ledoux Louis - BSC / UPC");
+
+		// IOs declaration
+		// A rows, and B columns which are only read on LDB words
+		addInput("rowsA",m_N*m_dense_in,true);
+		addInput("colsB",m_M*m_dense_in,true);
+		addInput("SOB");
+		addInput("EOB");
+		addInput("LDB");  // active high: this word loads colsB in the B buffer
+		addInput("VALID");  // active high: this word is a bus word, not a bubble
+		addInput("FORMAT", 2);
+		addOutput("colsC", m_M*m_dense_out, true);
+		addOutput("EOB_Q_o");
+
+		setNoParseNoSchedule();
+
+		ostringstream type_b_buffer;
+		type_b_buffer << "array(0 to " << m_b_depth-1 << ") of std_logic_vector(" << m_M*m_dense_in-1 << " downto 0)";
+		addType("b_buffer_t", type_b_buffer.str());
+		declare("b_buffer", 4);
+		declare("b_wr_addr", addr_width);
+		declare("b_wr_next", addr_width);
+		declare("b_rd_addr", addr_width);
+		declare("b_rd_next", addr_width);
+		declare("b_q", m_M*m_dense_in);
+		declare("b_valid_q");
+		declare("rowsA_q", m_N*m_dense_in);
+		declare("colsB_q", m_M*m_dense_in);
+		declare("SOB_q");
+		declare("EOB_q");
+
+		addFullComment("SOB rewinds the B buffer");
+		vhdl << tab << "b_wr_addr <= " << zg(addr_width) << " when SOB = '1' else b_wr_next;" << endl;
+		vhdl << tab << "b_rd_addr <= " << zg(addr_width) << " when SOB = '1' else b_rd_next;" << endl;
+		vhdl << endl;
+
+		addFullComment("B buffer, and the register aligning A and the flags with its output");
+		vhdl << tab << "process(clk)" << endl;
+		vhdl << tab << tab << "begin" << endl;
+		vhdl << tab << tab << tab << "if clk'event and clk = '1' then" << endl;
+		vhdl << tab << tab << tab << tab << "if LDB = '1' and VALID = '1' then" << endl;
+		vhdl << tab << tab << tab << tab << tab << "b_buffer(conv_integer(b_wr_addr)) <= colsB;" << endl;
+		vhdl << tab << tab << tab << tab << tab << "b_wr_next <= b_wr_addr + 1;" << endl;
+		vhdl << tab << tab << tab << tab << tab << "b_rd_next <= b_rd_addr;" << endl;
+		vhdl << tab << tab << tab << tab << "elsif VALID = '1' then" << endl;
+		vhdl << tab << tab << tab << tab << tab << "b_wr_next <= b_wr_addr;" << endl;
+		vhdl << tab << tab << tab << tab << tab << "b_rd_next <= b_rd_addr + 1;" << endl;
+		vhdl << tab << tab << tab << tab << "end if;" << endl;
+		vhdl << tab << tab << tab << tab << "b_q <= b_buffer(conv_integer(b_rd_addr));" << endl;
+		vhdl << tab << tab << tab << tab << "b_valid_q <= VALID and not LDB;" << endl;
+		vhdl << tab << tab << tab << tab << "if LDB = '0' and VALID = '1' then" << endl;
+		vhdl << tab << tab << tab << tab << tab << "rowsA_q <= rowsA;" << endl;
+		vhdl << tab << tab << tab << tab << tab << "SOB_q <= SOB;" << endl;
+		vhdl << tab << tab << tab << tab << tab << "EOB_q <= EOB;" << endl;
+		vhdl << tab << tab << tab << tab << "else" << endl;
+		vhdl << tab << tab << tab << tab << tab << "rowsA_q <= " << zg(m_N*m_dense_in) << ";" << endl;
+		vhdl << tab << tab << tab << tab << tab << "SOB_q <= '0';" << endl;
+		vhdl << tab << tab << tab << tab << tab << "EOB_q <= '0';" << endl;
+		vhdl << tab << tab << tab << tab << "end if;" << endl;
+		vhdl << tab << tab << tab << "end if;" << endl;
+		vhdl << tab << tab << "end process;" << endl;
+		vhdl << endl;
+
+		addFullComment("Bubbles and LDB words multiply zeros by zeros, whatever the buffer holds");
+		vhdl << tab << "colsB_q <= b_q when b_valid_q = '1' else " << zg(m_M*m_dense_in) << ";" << endl;
+		vhdl << endl;
+
+		addFullComment("Instantiate the orthogonal array");
+		vhdl << tab << "core: " << core->getName() << endl;
+		vhdl << tab << tab << "port map ( clk => clk," << endl;
+		vhdl << tab << tab << "           rst => rst," << endl;
+		vhdl << tab << tab << "           rowsA => rowsA_q," << endl;
+		vhdl << tab << tab << "           colsB => colsB_q," << endl;
+		vhdl << tab << tab << "           SOB => SOB_q," << endl;
+		vhdl << tab << tab << "           EOB => EOB_q," << endl;
+		vhdl << tab << tab << "           FORMAT => FORMAT," << endl;
+		vhdl << tab << tab << "           colsC => colsC," << endl;
+		vhdl << tab << tab << "           EOB_Q_o => EOB_Q_o );" << endl;
+	}
+
+	Operator* SystolicArray::buildArithToS3(Target* target, vector<string>* arithmetic, string name) {
+		int scale_width, fraction_width, bias, dense;
+		bool subnormals;
+		parse_arithmetic(arithmetic, scale_width, fraction_width, bias, subnormals, dense);
+		Operator* a2s3;
+		if (arithmetic->at(0).compare("posit") == 0) {
+			int es = 0;
+			if (arithmetic->size() >= 3) {es = stoi(arithmetic->at(2));}else {es = 2;}
+			a2s3 = new Posit_to_S3(target, nullptr, dense, es);
+		} else {
+			a2s3 = new IEEE_to_S3(target, nullptr, scale_width, fraction_width);
+		}
+		a2s3->setName(name);
+		a2s3->schedule();
+		a2s3->applySchedule();
+		return a2s3;
+	}
+
+	void SystolicArray::buildFormatSelect(vector<vector<string>*> arithmetics, vector<Operator*> a2s3, int a2s3_ppDepth, string bus, string index, int count) {
+		// Every format converts the whole bus, reading its elements in the low bits of the slots.
+		// Its S3 is widened to the one of the SAK: the fraction padded at the lsb and the scale
+		// rebiased, then delayed to the slowest Arith_to_S3, and FORMAT picks one of them.
+		vector<string> aligned;
+		bool delayed = false;
+		for (unsigned f = 0 ; f < arithmetics.size() ; f++) {
+			int scale_width, fraction_width, bias, dense;
+			bool subnormals;
+			parse_arithmetic(arithmetics[f], scale_width, fraction_width, bias, subnormals, dense);
+			const int s3 = scale_width + fraction_width + 3;
+			const string s3_f = join(bus + "_s3_f", f);
+			const string widened = join(bus + "_s3_w", f);
+			declare(s3_f, count*s3);
+			declare(widened, count*m_s3_in);
+			vhdl << tab << bus << "_a2s3_f" << f << ": for " << index << " in 0 to " << count-1 << " generate" << endl;
+			vhdl << tab << tab << "a2s3_inst: " << a2s3[f]->getName() << endl;
+			vhdl << tab << tab << tab << "port map ( clk => clk," << endl;
+			vhdl << tab << tab << tab << "           arith_i => " << bus << "_arith(" << index << ")" << (dense < m_dense_in ? range(dense-1, 0) : "") << "," << endl;
+			vhdl << tab << tab << tab << "           s3_o => " << s3_f << "(((" << index << "+1)*" << s3 << ")-1 downto " << index << "*" << s3 << "));" << endl;
+			vhdl << tab << tab << widened << "(((" << index << "+1)*" << m_s3_in << ")-1 downto " << index << "*" << m_s3_in << ") <= ";
+			vhdl << s3_f << "(((" << index << "+1)*" << s3 << ")-1 downto " << index << "*" << s3 << "+" << scale_width << ")";
+			if (m_fraction_width_in > fraction_width) vhdl << " & " << zg(m_fraction_width_in-fraction_width);
+			vhdl << " & ((";
+			if (m_scale_width_in > scale_width) vhdl << zg(m_scale_width_in-scale_width) << " & ";
+			vhdl << s3_f << "(" << index << "*" << s3 << "+" << scale_width-1 << " downto " << index << "*" << s3 << "))";
+			if (m_bias_in > bias) vhdl << " + \"" << unsignedBinary(mpz_class(m_bias_in-bias), m_scale_width_in) << "\"";
+			vhdl << ");" << endl;
+			vhdl << tab << "end generate;" << endl;
+			vhdl << endl;
+
+			const int delay = a2s3_ppDepth - a2s3[f]->getPipelineDepth();
+			for (int d = 1 ; d <= delay ; d++) {
+				declare(join(widened, "_d", d), count*m_s3_in);
+			}
+			aligned.push_back(delay > 0 ? join(widened, "_d", delay) : widened);
+			delayed = delayed || delay > 0;
+		}
+
+		if (delayed) {
+			vhdl << tab << "process(clk)" << endl;
+			vhdl << tab << tab << "begin" << endl;
+			vhdl << tab << tab << tab << "if clk'event and clk = '1' then" << endl;
+			for (unsigned f = 0 ; f < arithmetics.size() ; f++) {
+				const string widened = join(bus + "_s3_w", f);
+				const int delay = a2s3_ppDepth - a2s3[f]->getPipelineDepth();
+				for (int d = 1 ; d <= delay ; d++) {
+					vhdl << tab << tab << tab << tab << widened << "_d" << d << " <= " << (d == 1 ? widened : join(widened, "_d", d-1)) << ";" << endl;
+				}
+			}
+			vhdl << tab << tab << tab << "end if;" << endl;
+			vhdl << tab << tab << "end process;" << endl;
+			vhdl << endl;
+		}
+
+		vhdl << tab << bus << "_s3 <= ";
+		for (unsigned f = 0 ; f+1 < arithmetics.size() ; f++) {
+			vhdl << aligned[f] << " when FORMAT = \"" << unsignedBinary(mpz_class(f), 2) << "\" else" << endl << tab << tab;
+		}
+		vhdl << aligned.back() << ";" << endl;
+		vhdl << endl;
+	}
+
 	SystolicArray::~SystolicArray() {}
 
 	string SystolicArray::buildVHDLSignalDeclarations() {
@@ -326,7 +607,9 @@ namespace flopoco{
 				 (signalList_[i]->type() == Signal::in) || (signalList_[i]->type() == Signal::out))
 				continue;
 
-			if(signalList_[i]->getName()=="rows_i_arith") {
+			if(signalList_[i]->getName()=="b_buffer") {
+				o << "signal b_buffer : b_buffer_t;" << endl;
+			} else if(signalList_[i]->getName()=="rows_i_arith") {
 				o << "signal rows_i_arith : array_N_dense;" << endl;
 			} else if(signalList_[i]->getName()=="cols_j_arith") {
 				o << "signal cols_j_arith : array_M_dense;" << endl;
@@ -392,6 +675,11 @@ namespace flopoco{
 		int chunk_size;
 		double dspOccupationThreshold;
 		bool has_HSSD;
+		string topology;
+		int b_depth;
+		int packing;
+		string arithmetic_alt;
+		bool tune;
 		UserInterface::parseInt(args, "N", &SA_width);
 		UserInterface::parseInt(args, "M", &SA_height);
 		UserInterface::parseColonSeparatedStringList(args, "arithmetic_in", &arithmetic_in);
@@ -402,6 +690,25 @@ namespace flopoco{
 		UserInterface::parseInt(args, "chunk_size", &chunk_size);
 		UserInterface::parseFloat(args, "dspThreshold", &dspOccupationThreshold);
 		UserInterface::parseBoolean(args, "has_HSSD", &has_HSSD);
+		UserInterface::parseString(args, "topology", &topology);
+		UserInterface::parseInt(args, "b_depth", &b_depth);
+		UserInterface::parseInt(args, "packing", &packing);
+		UserInterface::parseString(args, "arithmetic_alt", &arithmetic_alt);
+		UserInterface::parseBoolean(args, "tune", &tune);
+		// plus-separated list of colon-separated lists
+		std::vector<std::vector<std::string> > alternates;
+		if (arithmetic_alt.compare("none") != 0) {
+			std::stringstream alt_stream(arithmetic_alt);
+			std::string alt;
+			while (std::getline(alt_stream, alt, '+')) {
+				std::stringstream param_stream(alt);
+				std::string param;
+				alternates.push_back(std::vector<std::string>());
+				while (std::getline(param_stream, param, ':')) {
+					alternates.back().push_back(param);
+				}
+			}
+		}
 		return new SystolicArray(parentOp, target,
 				SA_width,
 				SA_height,
@@ -412,13 +719,18 @@ namespace flopoco{
 				lsb_summand,
 				chunk_size,
 				dspOccupationThreshold,
-				has_HSSD);
+				has_HSSD,
+				topology,
+				b_depth,
+				packing,
+				alternates,
+				tune);
 	}
 
 	void SystolicArray::registerFactory() {
 		UserInterface::add(
 			"SystolicArray",  // name
-			"Build the raw orthogonal Systolic Array with data alignment and denormalization of I/Os",  // description, string
+			"Build the raw orthogonal or weight stationary Systolic Array with data alignment and denormalization of I/Os",  // description, string
 			"SA",  // category, from the list defined in UserInterface.cpp
 			"",  //seeAlso
 			"N(int): The Systolic Array width; \
@@ -427,10 +739,15 @@ namespace flopoco{
 			 nb_bits_ovf(int)=-1: The number of bits prepended before the actual MSB weight of summands. One bit adds one binade to prevent overflow in non cancellation accumulations. These bits affect the size of the adder but not of the shifter, they are not too expansive; \
 			 msb_summand(int)=-1: The expected biggest product value weight. If not precised, the tool will go to full precision (aka exact); \
 			 lsb_summand(int)=-1: The expected smallest product value weight. If not precised, the tool will go to full precision (aka exact); \
-			 chunk_size(int)=-1: An expert can suggest a size for a sub adder chunk for the carry save accum. This should be target specific calculated by the tool; \
+			 chunk_size(int)=-1: An expert can suggest a size for a sub adder chunk for the carry save accum. This should be target specific calculated by the tool, 0 lets S3FDPTuner pick it for the frequency; \
 			 arithmetic_out(string): colon-separated list of output arith parameters. Example : \"exact\", \"same\" or specified : \"posit:32\"(new posit, es=2),\"posit:16:1\"(old posit), \"ieee:8:23\", or \"bfloat16\"; \
 			 dspThreshold(real)=0.0: The ratio of dsp over logic for mantissa product; \
-			 has_HSSD(bool)=true: indicates the presence of the Half Speed Sink Down chain",
+			 has_HSSD(bool)=true: indicates the presence of the Half Speed Sink Down chain; \
+			 topology(string)=orthogonal: orthogonal streams A rows and B columns, weight_stationary preloads B with LDB words and streams A only; \
+			 b_depth(int)=1024: with weight_stationary, the number of k steps of B the array holds, a power of two; \
+			 packing(int)=1: The number of adjacent columns per PE whose significand products share one multiplier, divides M; \
+			 arithmetic_alt(string)=none: plus-separated list of up to three further input arithmetics the FORMAT input selects instead of arithmetic_in, no wider than it. Example : \"bfloat16+posit:16:1\"; \
+			 tune(bool)=false: S3FDPTuner estimates the paths and resources of every chunk size and HSSD option at the frequency, picks the cheapest one meeting it over the given chunk_size and has_HSSD, and writes them all to S3FDP_tuning.csv",
 			"",  // More documentation for the HTML pages. If you want to link to your blog, it is here.
 			SystolicArray::parseArguments
 		) ;
@@ -27,10 +27,15 @@ namespace flopoco{
 		 * @param[in] {int=n-1} nb_bits_ovf : The number of bits prepended before the actual MSB weight of summands
 		 * @param[in] {int= 2*(2^(scale_width-1)-1)} msb_summand : The expected biggest product value weight
 		 * @param[in] {int=-2*(2^(scale_width-1)-1)} lsb_summand : The expected smallest product value wieght
-		 * @param[in] {int=-1} chunk_size : The user-suggested size of a chunk in the partial CSA. Computed by flopoco if not provided.
+		 * @param[in] {int=-1} chunk_size : The user-suggested size of a chunk in the partial CSA. Computed by flopoco if not provided, by S3FDPTuner if 0.
 		 * @param[in] {vector<string>} arithmetic_out : The arithmetic used after the array to return to the external world as a list of parameters
 		 * @param[in] {float=0.0} dspOccupationThreshold : the ratio of DSP to be used in the mantissa product
 		 * @param[in] {bool=true} has_HSSD : indicates if the PE contains the half speed sink down chain
+		 * @param[in] {string="orthogonal"} topology : "orthogonal" streams A and B, "weight_stationary" preloads B and streams A only
+		 * @param[in] {int=1024} b_depth : with weight_stationary, the number of k steps of B held on chip
+		 * @param[in] {int=1} packing : the number of adjacent columns per PE, their products sharing one multiplier
+		 * @param[in] {vector<vector<string>>} arithmetic_alt : up to three further input arithmetics, selected instead of arithmetic_in by the FORMAT input
+		 * @param[in] {bool=false} tune : S3FDPTuner picks chunk_size and has_HSSD for the frequency, overriding the given ones
 	     **/
 		SystolicArray(OperatorPtr parentOp, Target* target,
 			int N,
@@ -42,7 +47,12 @@ namespace flopoco{
 			int lsb_summand=-1,
 			int chunk_size=-1,
 			double dspOccupationThreshold = 0.0,
-			bool has_HSSD=true);
+			bool has_HSSD=true,
+			string topology="orthogonal",
+			int b_depth=1024,
+			int packing=1,
+			vector<vector<string> > arithmetic_alt=vector<vector<string> >(),
+			bool tune=false);
 
 		/**
 		 * destructor
@@ -65,6 +75,23 @@ namespace flopoco{
 		static void registerFactory();
 
 	protected:
+		/**
+		 * Builds the weight stationary front end: B is written to a buffer by the LDB words
+		 * and replayed from it, k step by k step, for every A band, into an orthogonal array
+		 */
+		void buildWeightStationary(Target* target, vector<string>* arithmetic_in, vector<string>* arithmetic_out);
+
+		/**
+		 * Builds the Arith_to_S3 of one input arithmetic, named name
+		 */
+		Operator* buildArithToS3(Target* target, vector<string>* arithmetic, string name);
+
+		/**
+		 * Converts the rows_i or cols_j bus with every input arithmetic and drives its S3 with
+		 * the one FORMAT selects, widened to the S3 of the kernel
+		 */
+		void buildFormatSelect(vector<vector<string>*> arithmetics, vector<Operator*> a2s3, int a2s3_ppDepth, string bus, string index, int count);
+
 		int m_N;  // width of the Systolic Array
 		int m_M;  // height of the Systolic Array
 		// pre SA section
@@ -89,6 +116,11 @@ namespace flopoco{
 		// global param section
 		float m_dspOccupationThreshold;
 		bool m_has_HSSD;
+		string m_topology;
+		int m_b_depth;
+		int m_packing;
+		vector<vector<string> > m_arithmetic_alt;  // the formats FORMAT selects after arithmetic_in
+		bool m_tune;
 
 	};
 }
@@ -31,7 +31,8 @@ namespace flopoco{
 			int lsb_summand,
 			int chunk_size,
 			double dspOccupationThreshold,
-			bool has_HSSD):
+			bool has_HSSD,
+			int packing):
 				Operator(parentOp, target),
 				m_N(N),
 				m_M(M),
@@ -43,7 +44,8 @@ namespace flopoco{
 				m_lsb_summand(lsb_summand),
 				m_chunk_size(chunk_size),
 				m_dspOccupationThreshold(dspOccupationThreshold),
-				m_has_HSSD(has_HSSD) {
+				m_has_HSSD(has_HSSD),
+				m_packing(packing) {
 
 		setNoParseNoSchedule();  // we do not Schedule this operator
 
@@ -53,6 +55,13 @@ namespace flopoco{
 		// this constructor does:
 		// 1) Build with flopoco and schedule one processing element and the underneath operators and add it to this
 		// 2) Build by hand the HDL with for generate (flopoco can not instantiate only one shared thing) the SA
+		// With packing, one PE holds packing adjacent columns, so there are M/packing PE columns, each one
+		// passing packing B words down and packing C words out.
+
+		if (m_packing < 1 || m_M % m_packing != 0) {
+			THROWERROR("packing must divide M=" << m_M << ", got " << m_packing);
+		}
+		const int pe_cols = m_M / m_packing;
 
 		PE_S3* pe = new PE_S3(nullptr, target,
 				m_scale_width,
@@ -63,7 +72,8 @@ namespace flopoco{
 				m_lsb_summand,
 				m_chunk_size,
 				m_dspOccupationThreshold,
-				m_has_HSSD);
+				m_has_HSSD,
+				m_packing);
 		vector<Operator*> pe_sub_components = pe->getSubComponentList();
 		S3FDP* s3fdp = (S3FDP*)pe_sub_components[0];
 		int wLAICPT2 = s3fdp->get_wLAICPT2();
@@ -77,10 +87,13 @@ namespace flopoco{
 		std::string topology = "orthogonal";  // only orthogonal for the moment
 		module_name << "SA_kernel_" << topology << "_" <<  m_N << "w" << m_M << "h";
 		if(m_has_HSSD) module_name << "_HSSD";
+		if(m_packing > 1) module_name << "_P" << m_packing;
 		setNameWithFreqAndUID(module_name.str());
 		setCopyrightString("Ledoux Louis - BSC / UPC");
 
 		const int S3_size = m_scale_width + m_fraction_width + 3;
+		const int col_size = m_packing*S3_size;  // the B words of one PE column
+		const int c_size = m_packing*(wLAICPT2+wCOutput+1);  // the C words of one PE column
 
 		// IOs declaration
 		// One Bus for A rows, One bus for B columns
@@ -103,19 +116,19 @@ namespace flopoco{
 		//type_2d_val_n_m << "array(" << N-1 << " downto 0, " << M-1 << " downto 0) of std_logic";
 		//addType("T_2D_n_m", type_2d_val_n_m.str());
 		ostringstream type_2d_val_np1_m;
-		type_2d_val_np1_m << "array(" << N << " downto 0, " << M-1 << " downto 0) of std_logic_vector(" << S3_size-1 << " downto 0)";
+		type_2d_val_np1_m << "array(" << N << " downto 0, " << pe_cols-1 << " downto 0) of std_logic_vector(" << col_size-1 << " downto 0)";
 		addType("T_2D_np1_m", type_2d_val_np1_m.str());
 
 		ostringstream type_2d_val_np1_m_logic;
-		type_2d_val_np1_m_logic << "array(" << N << " downto 0, " << M-1 << " downto 0) of std_logic";
+		type_2d_val_np1_m_logic << "array(" << N << " downto 0, " << pe_cols-1 << " downto 0) of std_logic";
 		addType("T_2D_np1_m_logic", type_2d_val_np1_m_logic.str());
 
 		ostringstream type_2d_val_n_mp1;
-		type_2d_val_n_mp1 << "array(" << N-1 << " downto 0, " << M << " downto 0) of std_logic_vector(" << S3_size-1 << " downto 0)";
+		type_2d_val_n_mp1 << "array(" << N-1 << " downto 0, " << pe_cols << " downto 0) of std_logic_vector(" << S3_size-1 << " downto 0)";
 		addType("T_2D_n_mp1", type_2d_val_n_mp1.str());
 
 		ostringstream type_2d_val_LAICPT2_np1_m;
-		type_2d_val_LAICPT2_np1_m << "array(" << N << " downto 0, " << M-1 << " downto 0) of std_logic_vector(" << (wLAICPT2+wCOutput+1-1) << " downto 0)";
+		type_2d_val_LAICPT2_np1_m << "array(" << N << " downto 0, " << pe_cols-1 << " downto 0) of std_logic_vector(" << c_size-1 << " downto 0)";
 		addType("T_2D_LAICPT2_np1_m", type_2d_val_LAICPT2_np1_m.str());
 
 		declare("systolic_wires_rows_2D", 4);
@@ -126,8 +139,8 @@ namespace flopoco{
 		vhdl << endl;
 
 		addFullComment("Connect bus of B columns to top edges SA PEs");
-		vhdl << tab << "cols_in: for JJ in 0 to " << M-1 << " generate" << endl;
-		vhdl << tab << tab << "systolic_wires_cols_2D(0,JJ) <= colsB(((JJ+1)*" << S3_size << ")-1 downto (JJ*" << S3_size << "));" << endl;
+		vhdl << tab << "cols_in: for JJ in 0 to " << pe_cols-1 << " generate" << endl;
+		vhdl << tab << tab << "systolic_wires_cols_2D(0,JJ) <= colsB(((JJ+1)*" << col_size << ")-1 downto (JJ*" << col_size << "));" << endl;
 		vhdl << tab << "end generate;" << endl;
 		vhdl << endl;
 
@@ -139,7 +152,7 @@ namespace flopoco{
 
 		addFullComment("Connect the Start of Block signals of the TOP PEs");
 		vhdl << tab << "systolic_sob_2D(0,0) <= SOB;" << endl;
-		vhdl << tab << "sob_1st_row: for JJ in 1 to " << m_M-1 << " generate" << endl;
+		vhdl << tab << "sob_1st_row: for JJ in 1 to " << pe_cols-1 << " generate" << endl;
 		vhdl << tab << tab << "systolic_sob_2D(0,JJ) <= systolic_sob_2D(1,JJ-1);" << endl;
 		vhdl << tab << "end generate;" << endl;
 		vhdl << endl;
@@ -147,20 +160,20 @@ namespace flopoco{
 		if (m_has_HSSD) {
 			addFullComment("Connect the End of Block signals of the TOP PEs");
 			vhdl << tab << "systolic_eob_2D(0,0) <= EOB;" << endl;
-			vhdl << tab << "eob_1st_row: for JJ in 1 to " << m_M-1 << " generate" << endl;
+			vhdl << tab << "eob_1st_row: for JJ in 1 to " << pe_cols-1 << " generate" << endl;
 			vhdl << tab << tab << "systolic_eob_2D(0,JJ) <= systolic_eob_2D(1,JJ-1);" << endl;
 			vhdl << tab << "end generate;" << endl;
 			vhdl << endl;
 			addFullComment("Connect with 0s the input C carry out scheme of TOP PEs");
-			vhdl << tab << "C_out_input_1st_row: for JJ in 0 to " << m_M-1 << " generate" << endl;
-			vhdl << tab << tab << "systolic_C_out_2D(0,JJ) <= " << zg(wLAICPT2+wCOutput+1,0) << ";" << endl;
+			vhdl << tab << "C_out_input_1st_row: for JJ in 0 to " << pe_cols-1 << " generate" << endl;
+			vhdl << tab << tab << "systolic_C_out_2D(0,JJ) <= " << zg(c_size,0) << ";" << endl;
 			vhdl << tab << "end generate;" << endl;
 			vhdl << endl;
 		}
 
 		addFullComment("Connect PEs locally together");
 		vhdl << tab << "rows: for II in 0 to " << m_N-1 << " generate" << endl;
-		vhdl << tab << tab << "cols: for JJ in 0 to " << m_M-1 << " generate" << endl;
+		vhdl << tab << tab << "cols: for JJ in 0 to " << pe_cols-1 << " generate" << endl;
 		vhdl << tab << tab << tab << "PE_ij: PE_S3" << endl;
 		vhdl << tab << tab << tab << tab << "port map ( clk => clk," << endl;
 		vhdl << tab << tab << tab << tab << "           rst => rst," << endl;
@@ -180,22 +193,22 @@ namespace flopoco{
 
 		if (m_has_HSSD) {
 			addFullComment("Connect last row output C to output C bus");
-			vhdl << tab << "cols_C_out: for JJ in 0 to " << m_M-1 << " generate" << endl;
-			vhdl << tab << tab << "colsC(((JJ+1)*" << wLAICPT2+wCOutput+1 << ")-1 downto (JJ*" << wLAICPT2+wCOutput+1 << ")) <= systolic_C_out_2D(" << m_N << ",JJ);" << endl;
+			vhdl << tab << "cols_C_out: for JJ in 0 to " << pe_cols-1 << " generate" << endl;
+			vhdl << tab << tab << "colsC(((JJ+1)*" << c_size << ")-1 downto (JJ*" << c_size << ")) <= systolic_C_out_2D(" << m_N << ",JJ);" << endl;
 			vhdl << tab << "end generate;" << endl;
 			vhdl << endl;
 		} else {
 			addFullComment("Connect PEs C's output to output C bus");
 			vhdl << tab << "cols_C_out_i: for II in 1 to " << m_N << " generate" << endl;
-			vhdl << tab << tab << "cols_C_out_j: for JJ in 0 to " << m_M-1 << " generate" << endl;
-			vhdl << tab << tab << tab << "colsC((((((II-1)*"<< m_M <<")+JJ+1)*" << wLAICPT2+wCOutput+1 << ")-1) downto ((((II-1)*"<< m_M <<")+JJ)*" << wLAICPT2+wCOutput+1 << ")) <= systolic_C_out_2D(II,JJ);" << endl;
+			vhdl << tab << tab << "cols_C_out_j: for JJ in 0 to " << pe_cols-1 << " generate" << endl;
+			vhdl << tab << tab << tab << "colsC((((((II-1)*"<< pe_cols <<")+JJ+1)*" << c_size << ")-1) downto ((((II-1)*"<< pe_cols <<")+JJ)*" << c_size << ")) <= systolic_C_out_2D(II,JJ);" << endl;
 			vhdl << tab << tab << "end generate;" << endl;
 			vhdl << tab << "end generate;" << endl;
 		}
 
 		if (m_has_HSSD) {
 			addFullComment("Connect PE(N-1,M-1) EOB_Q to out world for valid data computation");
-			vhdl << tab << "EOB_Q_o <= systolic_eob_2D(" << m_N << "," << m_M-1 << ");" << endl;
+			vhdl << tab << "EOB_Q_o <= systolic_eob_2D(" << m_N << "," << pe_cols-1 << ");" << endl;
 			vhdl << endl;
 		}
 	}
@@ -250,6 +263,7 @@ namespace flopoco{
 		int chunk_size;
 		double dspOccupationThreshold;
 		bool has_HSSD;
+		int packing;
 		UserInterface::parseInt(args, "N", &SA_width);
 		UserInterface::parseInt(args, "M", &SA_height);
 		UserInterface::parseInt(args, "scale_width", &scale_width);
@@ -261,6 +275,7 @@ namespace flopoco{
 		UserInterface::parseInt(args, "chunk_size", &chunk_size);
 		UserInterface::parseFloat(args, "dspThreshold", &dspOccupationThreshold);
 		UserInterface::parseBoolean(args, "has_HSSD", &has_HSSD);
+		UserInterface::parseInt(args, "packing", &packing);
 		return new SystolicArrayKernel(parentOp, target,
 				SA_width,
 				SA_height,
@@ -272,7 +287,8 @@ namespace flopoco{
 				lsb_summand,
 				chunk_size,
 				dspOccupationThreshold,
-				has_HSSD);
+				has_HSSD,
+				packing);
 	}
 
 	void SystolicArrayKernel::registerFactory() {
@@ -291,7 +307,8 @@ namespace flopoco{
 			 lsb_summand(int)=-1: The expected smallest product value weight. If not precised, the tool will go to full precision (aka exact); \
 			 chunk_size(int)=-1: An expert can suggest a size for a sub adder chunk for the carry save accum. This should be target specific calculated by the tool; \
 			 dspThreshold(real)=0.0: The ratio of dsp over logic for mantissa product; \
-			 has_HSSD(bool)=true: indicates the presence of the Half Speed Sink Down chain",
+			 has_HSSD(bool)=true: indicates the presence of the Half Speed Sink Down chain; \
+			 packing(int)=1: The number of adjacent columns per PE sharing one significand multiplier, divides M",
 			"",  // More documentation for the HTML pages. If you want to link to your blog, it is here.
 			SystolicArrayKernel::parseArguments
 		) ;
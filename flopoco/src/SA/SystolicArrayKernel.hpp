@@ -34,6 +34,7 @@ namespace flopoco{
 		 * @param[in] {int=-1} chunk_size : The user-suggested size of a chunk in the partial CSA. Computed by flopoco if not provided.
 		 * @param[in] {float=0.0} dspOccupationThreshold : the ratio of DSP to be used in the mantissa product
 		 * @param[in] {bool=true} has_HSSD : indicates if the PE contains the half speed sink down chain
+		 * @param[in] {int=1} packing : the number of adjacent columns per PE, sharing one multiplier
 		 **/
 		SystolicArrayKernel(OperatorPtr parentOp, Target* target,
 				int N,
@@ -46,7 +47,8 @@ namespace flopoco{
 				int lsb_summand=-1,
 				int chunk_size=-1,
 				double dspOccupationThreshold = 0.0,
-				bool has_HSSD=true);
+				bool has_HSSD=true,
+				int packing=1);
 
 		/**
 		 * SystolicArrayKernel destructor
@@ -76,6 +78,7 @@ namespace flopoco{
 		int m_chunk_size;
 		float m_dspOccupationThreshold;
 		bool m_has_HSSD;
+		int m_packing;
 
 	};
 }
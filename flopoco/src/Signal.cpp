@@ -448,6 +448,20 @@ namespace flopoco{
 
 
 
+	string Signal::toVerilogType() {
+		ostringstream o;
+
+		o << "logic";
+		if ((1==width())&&(!isBus_))
+			return o.str();
+		if(isFix_ && isSigned_)
+			o << " signed";
+		o << " [" << width()-1 << ":0]";
+		return o.str();
+	}
+
+
+
 	string Signal::toVHDL() {
 		ostringstream o;
 
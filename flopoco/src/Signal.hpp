@@ -399,6 +399,11 @@ class Operator;
 		 */
 		std::string toVHDLType();
 
+		/**
+		 * Outputs the SystemVerilog type of this signal, e.g. logic [7:0]
+		 */
+		std::string toVerilogType();
+
 		/**
 		 * Obtain the name of a signal delayed by n cycles
 		 * @param delay in cycles */
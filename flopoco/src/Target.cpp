@@ -15,6 +15,8 @@
  */
 
 #include "Target.hpp"
+#include <fstream>
+#include <sstream>
 
 
 using namespace std;
@@ -256,6 +258,48 @@ namespace flopoco{
 
 
 
+	void Target::loadProfile(string filename){
+		ifstream file(filename.c_str());
+		if(!file.is_open()) {
+			throw("ERROR: cannot open target profile " + filename);
+		}
+		string line;
+		int lineNumber = 0;
+		while(getline(file, line)) {
+			lineNumber++;
+			size_t comment = line.find('#');
+			if(comment != string::npos) {
+				line.erase(comment);
+			}
+			istringstream fields(line);
+			string name, value;
+			if(!(fields >> name)) {
+				continue;  // blank or comment line
+			}
+			if(!(fields >> value)) {
+				throw("ERROR: " + filename + ":" + to_string(lineNumber) + ": no value for " + name);
+			}
+			if(name == "target") {
+				if(value != id_) {
+					throw("ERROR: target profile " + filename + " was fitted for " + value + ", not for " + id_);
+				}
+				continue;
+			}
+			double coefficient;
+			istringstream valueStream(value);
+			if(!(valueStream >> coefficient) || !setDelayParameter(name, coefficient)) {
+				throw("ERROR: " + filename + ":" + to_string(lineNumber) + ": " + id_ + " has no delay coefficient " + name + "=" + value);
+			}
+			TARGETREPORT("profile sets " << name << "=" << coefficient);
+		}
+	}
+
+	bool Target::setDelayParameter(string name, double value){
+		return false;
+	}
+
+
+
 	int Target::tableDepth(int wIn, int wOut){
 		cout << "Warning: using the generic Target::tableDepth(); pipelining using a gross estimate of the target" << endl;
 		return 2; // TODO
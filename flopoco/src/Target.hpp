@@ -356,6 +356,21 @@ namespace flopoco{
 		 */
 		virtual double tableDelay(int wIn_, int wOut_, bool logicTable_);
 
+		/** Loads a target profile, as fitted on post-route timing reports by tools/vivado-calibrate.py,
+		 * over the hand-set coefficients of the delay model.
+		 * The profile has one "name value" line per coefficient, in seconds, # starts a comment,
+		 * and a "target name" line that must match getID().
+		 * @param filename the profile file
+		 */
+		void loadProfile(string filename);
+
+		/** Sets one coefficient of the delay model of the target, see loadProfile
+		 * @param name the coefficient name, the member name without its trailing underscore
+		 * @param value the coefficient in seconds
+		 * @return false if the target has no such coefficient
+		 */
+		virtual bool setDelayParameter(string name, double value);
+
 
 
 		/** get a vector of possible DSP configurations */
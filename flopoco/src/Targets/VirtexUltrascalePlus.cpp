@@ -163,6 +163,30 @@ namespace flopoco{
 		return succes;
 	}
 
+	bool VirtexUltrascalePlus::setDelayParameter(string name, double value)
+	{
+		double* coefficient = nullptr;
+		if (name == "lut5Delay") coefficient = &lut5Delay_;
+		else if (name == "lut6Delay") coefficient = &lut6Delay_;
+		else if (name == "lut2Delay") coefficient = &lut2Delay_;
+		else if (name == "ffDelay") coefficient = &ffDelay_;
+		else if (name == "carry8Delay") coefficient = &carry8Delay_;
+		else if (name == "initCarryDelay") coefficient = &initCarryDelay_;
+		else if (name == "finalCarryDelay") coefficient = &finalCarryDelay_;
+		else if (name == "interCarryNetDelay") coefficient = &interCarryNetDelay_;
+		else if (name == "lut_to_carry_net") coefficient = &lut_to_carry_net;
+		else if (name == "fanoutConstant") coefficient = &fanoutConstant_;
+		else if (name == "typicalLocalRoutingDelay") coefficient = &typicalLocalRoutingDelay_;
+		else if (name == "DSPMultiplierDelay") coefficient = &DSPMultiplierDelay_;
+		else if (name == "RAMDelay") coefficient = &RAMDelay_;
+		else return false;
+		*coefficient = value;
+		// the adder formulas use these sums
+		adderConstantDelay_ = finalCarryDelay_ + initCarryDelay_ + lut2Delay_;
+		adderConstantDelayWithNets_ = adderConstantDelay_ + lut_to_carry_net;
+		return true;
+	}
+
 	void VirtexUltrascalePlus::delayForDSP(MultiplierBlock* multBlock, double currentCp, int& cycleDelay, double& cpDelay)
 	{
 		double targetPeriod, totalPeriod;
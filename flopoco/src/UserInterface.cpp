@@ -28,9 +28,12 @@ namespace flopoco
 
 	// Allocation of the global objects
 	string UserInterface::outputFileName;
+	string UserInterface::reportFileName;
+	string UserInterface::verilogFileName;
 	string UserInterface::entityName=""; // used for the -name option
 	int    UserInterface::verbose;
 	string UserInterface::targetFPGA;
+	string UserInterface::targetProfile;
 	double UserInterface::targetFrequencyMHz;
 	bool   UserInterface::clockEnable;
 	bool   UserInterface::useHardMult;
@@ -126,8 +129,11 @@ namespace flopoco
 				values.clear();
 				v.push_back(option_t("name", values));
 				v.push_back(option_t("outputFile", values));
+				v.push_back(option_t("report", values));
+				v.push_back(option_t("verilog", values));
 				v.push_back(option_t("hardMultThreshold", values));
 				v.push_back(option_t("frequency", values));
+				v.push_back(option_t("profile", values));
 
 				//verbosity level
 				values.clear();
@@ -169,7 +175,11 @@ namespace flopoco
 			}
 
 			outputVHDL();
+			if(verilogFileName != "")
+				outputVerilog();
 			finalReport(cerr);
+			if(reportFileName != "")
+				outputReport();
 			sollya_lib_close();
 		}
 		catch (string e) {
@@ -186,8 +196,11 @@ namespace flopoco
 		parseString(args, "name", &entityName, true); // not sticky: will be used, and reset, after the operator parser
 		parsePositiveInt(args, "verbose", &verbose, true); // sticky option
 		parseString(args, "outputFile", &outputFileName, true); // not sticky: will be used, and reset, after the operator parser
+		parseString(args, "report", &reportFileName, true); // sticky option
+		parseString(args, "verilog", &verilogFileName, true); // sticky option
 		parseString(args, "target", &targetFPGA, true); // not sticky: will be used, and reset, after the operator parser
 		parseFloat(args, "frequency", &targetFrequencyMHz, true); // sticky option
+		parseString(args, "profile", &targetProfile, true); // sticky option
 		parseBoolean(args, "plainVHDL", &plainVHDL, true);
 		parseBoolean(args, "clockEnable", &clockEnable, true);
 		parseFloat(args, "hardMultThreshold", &unusedHardMultThreshold, true); // sticky option
@@ -245,6 +258,7 @@ namespace flopoco
 			// make sure it is scheduled
 			op->schedule();
 			op->applySchedule();
+			op->markGenerated();
 			return op;
 		}
 	}
@@ -321,6 +335,142 @@ namespace flopoco
 	}
 
 
+	void UserInterface::collectEntities(vector<OperatorPtr> &oplist, vector<OperatorPtr> &entities, set<string> &alreadyCollected)
+	{
+		for(auto i: oplist) {
+			if(! i->getSubComponentListR().empty() )
+				collectEntities(i->getSubComponentListR(), entities, alreadyCollected);
+			if(alreadyCollected.find(i->getName())==alreadyCollected.end()) {
+				entities.push_back(i);
+				alreadyCollected.insert(i->getName());
+			}
+		}
+	}
+
+
+	// Entity and port names are VHDL identifiers, but the user can pass anything as name=
+	static string reportEscape(string str, bool xml) {
+		ostringstream o;
+		for(char c: str) {
+			if(xml && c=='&')       o << "&amp;";
+			else if(xml && c=='<')  o << "&lt;";
+			else if(xml && c=='>')  o << "&gt;";
+			else if(xml && c=='"')  o << "&quot;";
+			else if(!xml && (c=='"' || c=='\\')) o << '\\' << c;
+			else o << c;
+		}
+		return o.str();
+	}
+
+
+	void UserInterface::outputReport(){
+		bool xml = reportFileName.size()>=4 && reportFileName.compare(reportFileName.size()-4, 4, ".xml")==0;
+		vector<OperatorPtr> entities;
+		set<string> alreadyCollected;
+		collectEntities(UserInterface::globalOpList, entities, alreadyCollected);
+		Target* target = UserInterface::globalOpList.back()->getTarget();
+
+		ofstream file;
+		file.open(reportFileName.c_str(), ios::out);
+		file << setprecision(6);
+		if(xml) {
+			file << "<?xml version=\"1.0\"?>" << endl;
+			file << "<flopoco outputFile=\"" << reportEscape(outputFileName, true) << "\" target=\"" << target->getID()
+					 << "\" frequencyMHz=\"" << target->frequencyMHz() << "\">" << endl;
+			for(auto op: UserInterface::globalOpList)
+				file << tab << "<top name=\"" << reportEscape(op->getName(), true) << "\"/>" << endl;
+		}
+		else {
+			file << "{" << endl;
+			file << tab << "\"outputFile\": \"" << reportEscape(outputFileName, false) << "\"," << endl;
+			file << tab << "\"target\": \"" << target->getID() << "\"," << endl;
+			file << tab << "\"frequencyMHz\": " << target->frequencyMHz() << "," << endl;
+			file << tab << "\"top\": [";
+			for(unsigned i=0; i<UserInterface::globalOpList.size(); i++)
+				file << (i>0 ? ", " : "") << "\"" << reportEscape(UserInterface::globalOpList[i]->getName(), false) << "\"";
+			file << "]," << endl;
+			file << tab << "\"entities\": [" << endl;
+		}
+
+		for(unsigned e=0; e<entities.size(); e++) {
+			OperatorPtr op = entities[e];
+			ResourceEstimationHelper* re = op->reHelper;
+			vector<pair<string,int>> resources = {
+				{"lut", re->estimatedCountLUT},
+				{"ff", re->estimatedCountFF},
+				{"dsp", re->estimatedCountDSP},
+				{"bram", re->estimatedCountRAM},
+				{"rom", re->estimatedCountROM},
+				{"srl", re->estimatedCountSRL},
+				{"multiplier", re->estimatedCountMultiplier}
+			};
+			// negative when the operator was built outside of addSubComponent() and the global list
+			double generationTime = op->getGenerationTime();
+			double criticalPathNs = 1e9 * op->getMaxCriticalPath();
+			string name = reportEscape(op->getName(), xml);
+
+			if(xml) {
+				file << tab << "<entity name=\"" << name << "\" source=\"" << reportEscape(op->getSrcFileName(), true)
+						 << "\" pipelineDepth=\"" << op->getPipelineDepth() << "\" sequential=\"" << (op->isSequential() ? 1 : 0)
+						 << "\" criticalPathNs=\"" << criticalPathNs << "\" cost=\"" << op->getOperatorCost()
+						 << "\" generationTime=\"" << generationTime << "\">" << endl;
+				for(auto s: op->getIOListV())
+					file << tab << tab << "<" << (s->type()==Signal::in ? "input" : "output") << " name=\"" << reportEscape(s->getName(), true)
+							 << "\" width=\"" << s->width() << "\"/>" << endl;
+				file << tab << tab << "<resources";
+				for(auto r: resources)
+					file << " " << r.first << "=\"" << r.second << "\"";
+				file << "/>" << endl;
+				for(auto sub: op->getSubComponentListR())
+					file << tab << tab << "<subComponent name=\"" << reportEscape(sub->getName(), true) << "\"/>" << endl;
+				file << tab << "</entity>" << endl;
+			}
+			else {
+				file << tab << tab << "{" << endl;
+				file << tab << tab << tab << "\"name\": \"" << name << "\"," << endl;
+				file << tab << tab << tab << "\"source\": \"" << reportEscape(op->getSrcFileName(), false) << "\"," << endl;
+				file << tab << tab << tab << "\"pipelineDepth\": " << op->getPipelineDepth() << "," << endl;
+				file << tab << tab << tab << "\"sequential\": " << (op->isSequential() ? "true" : "false") << "," << endl;
+				for(int dir=0; dir<2; dir++) {
+					file << tab << tab << tab << (dir==0 ? "\"inputs\": [" : "\"outputs\": [");
+					bool first=true;
+					for(auto s: op->getIOListV()) {
+						if((s->type()==Signal::in) != (dir==0))
+							continue;
+						file << (first ? "" : ", ") << "{\"name\": \"" << reportEscape(s->getName(), false) << "\", \"width\": " << s->width() << "}";
+						first=false;
+					}
+					file << "]," << endl;
+				}
+				file << tab << tab << tab << "\"criticalPathNs\": " << criticalPathNs << "," << endl;
+				file << tab << tab << tab << "\"cost\": " << op->getOperatorCost() << "," << endl;
+				file << tab << tab << tab << "\"resources\": {";
+				for(unsigned r=0; r<resources.size(); r++)
+					file << (r>0 ? ", " : "") << "\"" << resources[r].first << "\": " << resources[r].second;
+				file << "}," << endl;
+				file << tab << tab << tab << "\"generationTime\": " << generationTime << "," << endl;
+				file << tab << tab << tab << "\"subComponents\": [";
+				bool first=true;
+				for(auto sub: op->getSubComponentListR()) {
+					file << (first ? "" : ", ") << "\"" << reportEscape(sub->getName(), false) << "\"";
+					first=false;
+				}
+				file << "]" << endl;
+				file << tab << tab << "}" << (e+1<entities.size() ? "," : "") << endl;
+			}
+		}
+
+		if(xml)
+			file << "</flopoco>" << endl;
+		else {
+			file << tab << "]" << endl;
+			file << "}" << endl;
+		}
+		file.close();
+		cerr << "Generation report: " << reportFileName << endl;
+	}
+
+
 	void UserInterface::registerFactory(OperatorFactoryPtr factory)	{
 		//		if(factoryList.find(factory->name())!=factoryList.end())
 		//			throw string("OperatorFactory - Factory with name '"+factory->name()+" has already been registered.");
@@ -353,7 +503,10 @@ namespace flopoco
 		// Initialize all the command-line options
 		verbose=1;
 		outputFileName="flopoco.vhdl";
+		reportFileName="";
+		verilogFileName="";
 		targetFPGA=defaultFPGA;
+		targetProfile="";
 		targetFrequencyMHz=400;
 		useHardMult=true;
 		unusedHardMultThreshold=0.7;
@@ -469,6 +622,8 @@ namespace flopoco
 				target->setILPSolver(ilpSolver);
 				target->setILPTimeout(ilpTimeout);
 				target->setTilingMethod(tiling);
+				if(targetProfile != "")
+					target->loadProfile(targetProfile);
 
 				// Now build the operator
 				OperatorFactoryPtr fp = getFactoryByName(opName);
@@ -486,6 +641,7 @@ namespace flopoco
 					// Schedule it
 					op->schedule();
 					op->applySchedule();
+					op->markGenerated();
 				}
 			}
 		}catch(std::string &s){
@@ -533,6 +689,35 @@ namespace flopoco
 	}
 
 
+	void UserInterface::outputVerilog() {
+		vector<OperatorPtr> entities;
+		set<string> alreadyCollected;
+		collectEntities(UserInterface::globalOpList, entities, alreadyCollected);
+
+		ofstream file;
+		file.open(verilogFileName.c_str(), ios::out);
+		string top;
+		for(auto i: entities) {
+			// test benches are behavioural VHDL (processes, file I/O) and stay VHDL only
+			if(dynamic_cast<TestBench*>(i) != nullptr)
+				continue;
+			top = i->getName();
+			try {
+				i->outputVerilog(file);
+			}
+			catch (std::string &s) {
+				cerr << "Exception while generating SystemVerilog for '" << i->getName() << "': " << s << endl;
+			}
+		}
+		file.close();
+		cerr << "SystemVerilog output file: " << verilogFileName << endl;
+		if(top != "") {
+			cerr << "To build a multithreaded C++ cycle model of " << top << ":" << endl;
+			cerr << "verilator --cc --build --threads 4 -Wno-fatal --top-module " << top << " " << verilogFileName << endl;
+		}
+	}
+
+
 
 
 
@@ -779,16 +964,19 @@ namespace flopoco
 		s << "Generic options include:" << endl;
 		s << "  " << COLOR_BOLD << "name" << COLOR_NORMAL << "=<string>:                override the the default entity name "<<endl;
 		s << "  " << COLOR_BOLD << "outputFile" << COLOR_NORMAL << "=<string>:          override the the default output file name " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL <<endl;
+		s << "  " << COLOR_BOLD << "verilog" << COLOR_NORMAL << "=<string>:             also write all entities but test benches as SystemVerilog, e.g. for Verilator " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL <<endl;
+		s << "  " << COLOR_BOLD << "report" << COLOR_NORMAL << "=<string>:              also write a generation report of all entities, as XML if the name ends in .xml, JSON otherwise " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL <<endl;
 		s << "  " << COLOR_BOLD << "target" << COLOR_NORMAL << "=<string>:              target FPGA (default " << defaultFPGA << ") " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
 		s << "     Supported targets: Kintex7, StratixV, Virtex6, Zynq7000, VirtexUltrascalePus"<<endl;
 		s << "  " << COLOR_BOLD << "frequency" << COLOR_NORMAL << "=<float>:            target frequency in MHz (default 400, 0 means: no pipeline) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
+		s << "  " << COLOR_BOLD << "profile" << COLOR_NORMAL << "=<string>:             delay model coefficients of the target fitted on Vivado timing reports by tools/vivado-calibrate.py " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
 		s << "  " << COLOR_BOLD << "plainVHDL" << COLOR_NORMAL << "=<0|1>:              use plain VHDL (default), or not " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL << endl;
 		s << "  " << COLOR_BOLD << "useHardMult" << COLOR_NORMAL << "=<0|1>:            use hardware multipliers " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
 		s << "  " << COLOR_BOLD << "useTargetOptimizations" << COLOR_NORMAL << "=<0|1>: use target specific optimizations (e.g., using primitives) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
 		s << "  " << COLOR_BOLD << "ilpSolver" << COLOR_NORMAL << "=<string>:           override ILP solver for operators optimized by ILP, has to match a solver name known by the ScaLP library" << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
 		s << "  " << COLOR_BOLD << "ilpTimeout" << COLOR_NORMAL << "=<int>:             sets the timeout in seconds for the ILP solver for operators optimized by ILP (default=3600)" << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
-		s << "  " << COLOR_BOLD << "compression" << COLOR_NORMAL << "=<heuristicMaxEff,heuristicPA,heuristicFirstFit,optimal,optimalMinStages>:        compression method (default=heuristicMaxEff)" << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
-		s << "  " << COLOR_BOLD << "tiling" << COLOR_NORMAL << "=<heuristicBasicTiling,optimal,heuristicGreedyTiling,heuristicXGreedyTiling,heuristicBeamSearchTiling>:        tiling method (default=heuristicBasicTiling)" << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
+		s << "  " << COLOR_BOLD << "compression" << COLOR_NORMAL << "=<heuristicMaxEff,heuristicPA,heuristicFirstFit,heuristicPortfolio,optimal,optimalMinStages>:        compression method (default=heuristicMaxEff)" << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
+		s << "  " << COLOR_BOLD << "tiling" << COLOR_NORMAL << "=<heuristicBasicTiling,optimal,heuristicGreedyTiling,heuristicXGreedyTiling,heuristicBeamSearchTiling,portfolio>:        tiling method (default=heuristicBasicTiling)" << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
         s << "  " << COLOR_BOLD << "hardMultThreshold" << COLOR_NORMAL << "=<float>: unused hard mult threshold (O..1, default 0.7) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
 		s << "  " << COLOR_BOLD << "generateFigures" << COLOR_NORMAL << "=<0|1>:generate SVG graphics (default off) " << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL << endl;
 		s << "  " << COLOR_BOLD << "verbose" << COLOR_NORMAL << "=<int>:        verbosity level (0-4, default=1)" << COLOR_RED_NORMAL << "(sticky option)" << COLOR_NORMAL<<endl;
@@ -63,6 +63,12 @@ namespace flopoco
 		/** generates a report for operators in globalOpList, and all their subcomponents */
 		static void finalReport(ostream & s);
 
+		/** writes the machine-readable generation report (JSON, or XML if the file name ends in .xml) to reportFileName */
+		static void outputReport();
+
+		/** writes all the entities but the test benches as SystemVerilog modules to verilogFileName */
+		static void outputVerilog();
+
 
 		/**a helper factory function. For the parameter documentation, see the OperatorFactory constructor */
 		static void add(
@@ -124,6 +130,9 @@ namespace flopoco
 		/** generates the code for operators in oplist, and all their subcomponents */
 		static void outputVHDLToFile(vector<OperatorPtr> &oplist, ofstream& file, set<string> &alreadyOutput);
 
+		/** collects oplist and all their subcomponents, each entity once, children before parents */
+		static void collectEntities(vector<OperatorPtr> &oplist, vector<OperatorPtr> &entities, set<string> &alreadyCollected);
+
 	private:
 		/** register a factory */
 		static void registerFactory(OperatorFactoryPtr factory);
@@ -146,8 +155,11 @@ namespace flopoco
 		static int pipelineActive_;
 	private:
 		static string outputFileName;
+		static string reportFileName;
+		static string verilogFileName;
 		static string entityName;
 		static string targetFPGA;
+		static string targetProfile;
 		static double targetFrequencyMHz;
 		static bool   pipeline;
 		static bool   clockEnable;
@@ -0,0 +1,1301 @@
+/*
+ * Translation of the VHDL written by FloPoCo operators into SystemVerilog.
+ *
+ * This file is part of the FloPoCo project
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <sstream>
+
+#include "VHDLToVerilog.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+namespace flopoco {
+
+	// precedences of the SystemVerilog operators, used to place the parentheses
+	enum {
+		precCond    = 10,
+		precOr      = 40,
+		precXor     = 45,
+		precAnd     = 50,
+		precEq      = 55,
+		precRel     = 60,
+		precShift   = 65,
+		precAdd     = 70,
+		precMul     = 80,
+		precPow     = 85,
+		precUnary   = 90,
+		precPrimary = 100
+	};
+
+
+	static bool isInteger(string s) {
+		size_t i = (s.size()>0 && s[0]=='-' ? 1 : 0);
+		if(i == s.size())
+			return false;
+		for(; i<s.size(); i++)
+			if(!isdigit(s[i]))
+				return false;
+		return true;
+	}
+
+
+	VHDLToVerilog::VHDLToVerilog(string tab, function<int(const string&)> widthOf) :
+		tab_(tab), widthOf_(widthOf), pos_(0), untranslated_(0)
+	{
+	}
+
+
+	int VHDLToVerilog::untranslated() {
+		return untranslated_;
+	}
+
+
+	string VHDLToVerilog::identifier(string name) {
+		// the SystemVerilog keywords that are not VHDL reserved words, hence may be signal names
+		static const set<string> keywords = {
+			"always", "always_comb", "always_ff", "always_latch", "assign", "automatic", "bind", "bit", "byte",
+			"cell", "chandle", "class", "const", "constraint", "context", "cover", "covergroup", "cross", "deassign",
+			"default", "defparam", "design", "disable", "dist", "do", "edge", "endcase", "endclass", "endfunction",
+			"endgenerate", "endmodule", "endtask", "enum", "event", "export", "extends", "extern", "final", "force",
+			"forever", "fork", "genvar", "highz0", "highz1", "iff", "ifnone", "import", "incdir", "initial", "input",
+			"inside", "instance", "int", "integer", "interface", "join", "large", "let", "liblist", "local",
+			"localparam", "logic", "longint", "macromodule", "medium", "modport", "module", "negedge", "new",
+			"output", "packed", "parameter", "posedge", "priority", "program", "property", "pull0", "pull1",
+			"pulldown", "pullup", "rand", "randc", "real", "realtime", "ref", "reg", "release", "repeat", "scalared",
+			"shortint", "shortreal", "signed", "small", "specify", "specparam", "static", "strength", "string",
+			"strong0", "strong1", "struct", "super", "supply0", "supply1", "table", "task", "this", "time", "tri",
+			"tri0", "tri1", "triand", "trior", "trireg", "typedef", "union", "unique", "unsigned", "uwire", "var",
+			"vectored", "virtual", "void", "wand", "weak0", "weak1", "wire", "wor"
+		};
+		if(keywords.find(name) != keywords.end())
+			return "\\" + name + " ";
+		return name;
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::makeExpr(string text, int prec) {
+		Expr e;
+		e.text = text;
+		e.prec = prec;
+		e.empty = false;
+		return e;
+	}
+
+
+	string VHDLToVerilog::paren(const Expr &e, int prec) {
+		if(e.empty || (e.text=="" && e.fill!=""))
+			throw string("an empty string or an (others => ...) aggregate whose width is unknown");
+		if(e.prec < prec)
+			return "(" + e.text + ")";
+		return e.text;
+	}
+
+
+	string VHDLToVerilog::concatText(const vector<string> &parts) {
+		ostringstream o;
+		o << "{";
+		for(size_t i=0; i<parts.size(); i++)
+			o << (i>0 ? ", " : "") << parts[i];
+		o << "}";
+		return o.str();
+	}
+
+
+	string VHDLToVerilog::comments(int level) {
+		ostringstream o;
+		for(auto c: pendingComments_) {
+			for(int i=0; i<level; i++)
+				o << tab_;
+			o << "//" << c << endl;
+		}
+		pendingComments_.clear();
+		return o.str();
+	}
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////
+	// Lexing
+
+	void VHDLToVerilog::tokenize(string vhdl) {
+		src_ = "";
+		tokens_.clear();
+		pos_ = 0;
+		lexComments_.clear();
+		pendingComments_.clear();
+		lex(vhdl);
+		endTokens();
+	}
+
+
+	// Appends the tokens of a piece of code to the ones lexed so far
+	void VHDLToVerilog::lex(string vhdl) {
+		size_t i = src_.size();
+		src_ += vhdl;
+		size_t n = src_.size();
+		while(i < n) {
+			char c = src_[i];
+			Token t;
+			t.begin = i;
+
+			if(isspace(c)) {
+				i++;
+				continue;
+			}
+			if(c=='-' && i+1<n && src_[i+1]=='-') {
+				size_t eol = src_.find('\n', i);
+				if(eol == string::npos)
+					eol = n;
+				lexComments_.push_back(src_.substr(i+2, eol-i-2));
+				i = eol;
+				continue;
+			}
+
+			if(isalpha(c)) {
+				size_t j = i;
+				while(j<n && (isalnum(src_[j]) || src_[j]=='_'))
+					j++;
+				// x"AF", b"0101" and o"17" bit strings
+				if(j==i+1 && j<n && src_[j]=='"' && string("xXbBoO").find(c)!=string::npos) {
+					size_t close = src_.find('"', j+1);
+					if(close == string::npos)
+						throw string("unterminated bit string");
+					t.type = Token::bitString;
+					t.text = src_.substr(i, close+1-i);
+					i = close+1;
+				}
+				else {
+					t.type = Token::name;
+					t.text = src_.substr(i, j-i);
+					i = j;
+				}
+			}
+			else if(c=='\\') {
+				size_t close = src_.find('\\', i+1);
+				if(close == string::npos)
+					throw string("unterminated extended identifier");
+				t.type = Token::name;
+				t.text = src_.substr(i+1, close-i-1);
+				i = close+1;
+			}
+			else if(isdigit(c)) {
+				size_t j = i;
+				while(j<n && (isalnum(src_[j]) || src_[j]=='_' || src_[j]=='#'
+				              || (src_[j]=='.' && j+1<n && isdigit(src_[j+1]))
+				              || ((src_[j]=='+' || src_[j]=='-') && (src_[j-1]=='e' || src_[j-1]=='E') && src_.find('#', i)>j)))
+					j++;
+				t.type = Token::number;
+				t.text = src_.substr(i, j-i);
+				i = j;
+			}
+			else if(c=='"') {
+				size_t close = src_.find('"', i+1);
+				if(close == string::npos)
+					throw string("unterminated string");
+				t.type = Token::stringLiteral;
+				t.text = src_.substr(i+1, close-i-1);
+				i = close+1;
+			}
+			else if(c=='\'' && i+2<n && src_[i+2]=='\'') {
+				t.type = Token::character;
+				t.text = src_.substr(i+1, 1);
+				i += 3;
+			}
+			else {
+				static const vector<string> twoChars = {"<=", ">=", "/=", "=>", ":=", "**", "<>"};
+				t.type = Token::symbol;
+				t.text = string(1, c);
+				for(auto s: twoChars)
+					if(src_.compare(i, 2, s)==0)
+						t.text = s;
+				i += t.text.size();
+			}
+			t.comments = lexComments_;
+			lexComments_.clear();
+			tokens_.push_back(t);
+		}
+	}
+
+
+	void VHDLToVerilog::endTokens() {
+		Token t;
+		t.type = Token::end;
+		t.begin = src_.size();
+		t.comments = lexComments_;
+		lexComments_.clear();
+		tokens_.push_back(t);
+	}
+
+
+	const VHDLToVerilog::Token& VHDLToVerilog::peek(int k) {
+		return tokens_[std::min(pos_+k, tokens_.size()-1)];
+	}
+
+
+	VHDLToVerilog::Token VHDLToVerilog::next() {
+		Token t = tokens_[pos_];
+		if(pos_ < tokens_.size()-1)
+			pos_++;
+		pendingComments_.insert(pendingComments_.end(), t.comments.begin(), t.comments.end());
+		return t;
+	}
+
+
+	bool VHDLToVerilog::isKeyword(string keyword, int k) {
+		return peek(k).type==Token::name && toLower(peek(k).text)==keyword;
+	}
+
+
+	bool VHDLToVerilog::isSymbol(string symbol, int k) {
+		return peek(k).type==Token::symbol && peek(k).text==symbol;
+	}
+
+
+	void VHDLToVerilog::expectKeyword(string keyword) {
+		if(!isKeyword(keyword))
+			throw "expected " + keyword + " instead of " + peek().text;
+		next();
+	}
+
+
+	void VHDLToVerilog::expectSymbol(string symbol) {
+		if(!isSymbol(symbol))
+			throw "expected " + symbol + " instead of " + peek().text;
+		next();
+	}
+
+
+	// Skips a statement that could not be translated: up to its semicolon,
+	// or up to the end of the process, block or generate it opens
+	void VHDLToVerilog::skipStatement() {
+		// the construct opened by the statement, if any, is the one whose end we look for
+		string construct;
+		for(size_t i=pos_; i<tokens_.size() && tokens_[i].type!=Token::end && tokens_[i].text!=";"; i++) {
+			string word = toLower(tokens_[i].text);
+			if(tokens_[i].type==Token::name && (word=="process" || word=="block" || word=="generate")) {
+				construct = word;
+				break;
+			}
+		}
+
+		int depth = 0;
+		while(peek().type != Token::end) {
+			if(construct=="" && isSymbol(";")) {
+				next();
+				return;
+			}
+			if(construct!="" && isKeyword("end") && isKeyword(construct, 1)) {
+				while(peek().type!=Token::end && !isSymbol(";"))
+					next();
+				next();
+				if(--depth <= 0)
+					return;
+				continue;
+			}
+			if(construct!="" && isKeyword(construct))
+				depth++;
+			next();
+		}
+	}
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////
+	// Declarations and statements
+
+	string VHDLToVerilog::statements(const vector<VHDLStatement> &sts) {
+		ostringstream o;
+		size_t i = 0;
+		while(i < sts.size()) {
+			if(sts[i].type != VHDLStatement::text) {
+				o << statement(sts[i]);
+				i++;
+				continue;
+			}
+			// the stream cuts code without marks at each semicolon: a generate or a process
+			// spans several text statements, that are parsed together
+			string code;
+			for(; i<sts.size() && sts[i].type==VHDLStatement::text; i++)
+				for(auto &t: sts[i].tokens)
+					code += t.code;
+			tokenize(code);
+			o << items(1);
+			next();
+			o << comments(1);
+		}
+		return o.str();
+	}
+
+
+	string VHDLToVerilog::statement(const VHDLStatement &st) {
+		// The code between the signals is lexed; a signal, printed as its name, is one name token
+		// that gets the delay chosen by the scheduler
+		src_ = "";
+		tokens_.clear();
+		pos_ = 0;
+		lexComments_.clear();
+		pendingComments_.clear();
+		for(auto &t: st.tokens) {
+			if(t.type==VHDLToken::text || t.code!=t.signalName) {
+				lex(t.code + t.delay);
+				continue;
+			}
+			Token n;
+			n.type = Token::name;
+			n.text = t.code + t.delay;
+			n.begin = src_.size();
+			n.comments = lexComments_;
+			lexComments_.clear();
+			src_ += n.text;
+			tokens_.push_back(n);
+		}
+		endTokens();
+
+		ostringstream o;
+		size_t start = pos_;
+		try {
+			if(st.type == VHDLStatement::instance) {
+				string label = identifier(next().text);
+				expectSymbol(":");
+				o << instance(1, label);
+			}
+			else if(st.type == VHDLStatement::selectedAssignment)
+				o << selectedAssignment(1);
+			else {
+				string t = target();
+				expectSymbol("<=");
+				o << conditionalAssignment(1, t);
+			}
+			if(peek().type != Token::end)
+				throw "unexpected " + peek().text + " after the statement";
+		}
+		catch(string &e) {
+			o.str("");
+			pos_ = start;
+			pendingComments_.clear();
+			while(peek().type != Token::end)
+				next();
+			o << untranslatedCode(1, e, start);
+		}
+		next();
+		return o.str() + comments(1);
+	}
+
+
+	string VHDLToVerilog::typeDeclaration(string name, string vhdlType) {
+		tokenize(vhdlType);
+		ostringstream o;
+		try {
+			o << "typedef ";
+			if(isSymbol("(")) {
+				// enumeration
+				next();
+				vector<string> values;
+				values.push_back(identifier(next().text));
+				while(isSymbol(",")) {
+					next();
+					values.push_back(identifier(next().text));
+				}
+				expectSymbol(")");
+				o << "enum {";
+				for(size_t i=0; i<values.size(); i++)
+					o << (i>0 ? ", " : "") << values[i];
+				o << "} " << identifier(name);
+			}
+			else if(isKeyword("array")) {
+				next();
+				expectSymbol("(");
+				vector<string> dims;
+				dims.push_back(range());
+				while(isSymbol(",")) {
+					next();
+					dims.push_back(range());
+				}
+				expectSymbol(")");
+				expectKeyword("of");
+				o << subtype() << " " << identifier(name);
+				for(auto d: dims)
+					o << " [" << d << "]";
+			}
+			else
+				o << subtype() << " " << identifier(name);
+			if(peek().type != Token::end)
+				throw "unexpected " + peek().text;
+		}
+		catch(string &e) {
+			untranslated_++;
+			o.str("");
+			o << tab_ << "// untranslated VHDL type (" << e << "): " << name << " is " << vhdlType << endl;
+			return o.str();
+		}
+		o << ";" << endl;
+		return tab_ + o.str();
+	}
+
+
+	string VHDLToVerilog::constantDeclaration(string name, string vhdlType, string vhdlValue) {
+		string n = identifier(name);
+		ostringstream o;
+		try {
+			tokenize(vhdlType);
+			string t = subtype();
+			if(peek().type != Token::end)
+				throw "unexpected " + peek().text;
+			tokenize(vhdlValue);
+			Expr v = expression();
+			if(peek().type != Token::end)
+				throw "unexpected " + peek().text;
+			o << tab_ << "localparam " << (t=="logic" ? "" : t + " ") << n << " = " << value(v, n) << ";" << endl;
+		}
+		catch(string &e) {
+			untranslated_++;
+			o.str("");
+			o << tab_ << "// untranslated VHDL constant (" << e << "): " << name << ": " << vhdlType << " := " << vhdlValue << endl;
+		}
+		return o.str();
+	}
+
+
+	string VHDLToVerilog::items(int level) {
+		ostringstream o;
+		while(peek().type != Token::end) {
+			if(isKeyword("end") && level>1)
+				break;
+			if(isKeyword("begin")) {
+				next();
+				continue;
+			}
+
+			size_t start = pos_;
+			size_t startComments = pendingComments_.size();
+			try {
+				o << concurrentStatement(level);
+			}
+			catch(string &e) {
+				pos_ = start;
+				pendingComments_.resize(startComments);
+				skipStatement();
+				o << untranslatedCode(level, e, start);
+			}
+		}
+		return o.str();
+	}
+
+
+	// The code from token start to the current one, as a comment
+	string VHDLToVerilog::untranslatedCode(int level, string reason, size_t start) {
+		ostringstream o;
+		o << comments(level);
+		string code = src_.substr(tokens_[start].begin, peek().begin - tokens_[start].begin);
+		while(code.size()>0 && isspace(code[code.size()-1]))
+			code.erase(code.size()-1);
+		for(int i=0; i<level; i++)
+			o << tab_;
+		o << "// untranslated VHDL (" << reason << "):" << endl;
+		istringstream lines(code);
+		string line;
+		while(getline(lines, line)) {
+			for(int i=0; i<level; i++)
+				o << tab_;
+			o << "// " << line << endl;
+		}
+		untranslated_++;
+		return o.str();
+	}
+
+
+	string VHDLToVerilog::concurrentStatement(int level) {
+		string indent;
+		for(int i=0; i<level; i++)
+			indent += tab_;
+
+		if(peek().type==Token::name && isSymbol(":", 1)) {
+			string label = identifier(next().text);
+			next();
+			if(isKeyword("for") || isKeyword("if"))
+				return generate(level, label);
+			if(isKeyword("process"))
+				return process(level);
+			if(isKeyword("block") || isKeyword("postponed") || isKeyword("assert"))
+				throw toLower(peek().text) + " statement";
+			return instance(level, label);
+		}
+		if(isKeyword("with"))
+			return selectedAssignment(level);
+		if(peek().type!=Token::name)
+			throw "unexpected " + peek().text;
+		if(isKeyword("process"))
+			return process(level);
+		if(isKeyword("assert") || isKeyword("block") || isKeyword("end")
+		   || isKeyword("for") || isKeyword("if") || isKeyword("case"))
+			throw toLower(peek().text) + " statement";
+
+		string t = target();
+		expectSymbol("<=");
+		return conditionalAssignment(level, t);
+	}
+
+
+	string VHDLToVerilog::conditionalAssignment(int level, string target) {
+		vector<pair<Expr, Expr>> cases;
+		Expr last;
+		while(true) {
+			Expr v = expression();
+			if(isKeyword("when")) {
+				next();
+				Expr c = expression();
+				cases.push_back(make_pair(v, c));
+				if(!isKeyword("else"))
+					throw string("conditional assignment without a final else");
+				next();
+				continue;
+			}
+			last = v;
+			break;
+		}
+		expectSymbol(";");
+
+		string text = value(last, target);
+		for(int i=cases.size()-1; i>=0; i--) {
+			Expr v = makeExpr(value(cases[i].first, target), cases[i].first.prec);
+			if(cases[i].first.fill != "")
+				v.prec = precPrimary;
+			text = paren(cases[i].second, precCond+1) + " ? " + paren(v, precCond+1) + " : " + text;
+		}
+
+		ostringstream o;
+		o << comments(level);
+		for(int i=0; i<level; i++)
+			o << tab_;
+		o << "assign " << target << " = " << text << ";" << endl;
+		return o.str();
+	}
+
+
+	// A process whose whole body is one if on the rising edge of a clock becomes an always_ff,
+	// any other an always_comb. Processes with declarations or a wait are not translated.
+	string VHDLToVerilog::process(int level) {
+		string indent;
+		for(int i=0; i<level; i++)
+			indent += tab_;
+
+		next(); // process
+		string leading = comments(level);
+		if(isSymbol("(")) {
+			// the sensitivity list: always_comb and always_ff find their own
+			while(peek().type!=Token::end && !isSymbol(")"))
+				next();
+			expectSymbol(")");
+		}
+		if(isKeyword("is"))
+			next();
+		if(!isKeyword("begin"))
+			throw string("process declarations");
+		next();
+
+		string clock;
+		int edge = 0;
+		if(isKeyword("if") && isKeyword("rising_edge", 1) && isSymbol("(", 2) && peek(3).type==Token::name
+		   && isSymbol(")", 4) && isKeyword("then", 5)) {
+			clock = peek(3).text;
+			edge = 6;
+		}
+		if(isKeyword("if") && peek(1).type==Token::name && isSymbol("'", 2) && isKeyword("event", 3) && isKeyword("and", 4)
+		   && peek(5).text==peek(1).text && isSymbol("=", 6) && peek(7).type==Token::character && peek(7).text=="1"
+		   && isKeyword("then", 8)) {
+			clock = peek(1).text;
+			edge = 9;
+		}
+
+		string body;
+		if(clock!="") {
+			for(int i=0; i<edge; i++)
+				next();
+			body = sequential(level+1, true);
+			expectKeyword("end");
+			expectKeyword("if");
+			expectSymbol(";");
+			if(!(isKeyword("end") && isKeyword("process", 1)))
+				throw string("process with statements outside of its clock edge");
+		}
+		else
+			body = sequential(level+1, false);
+		expectKeyword("end");
+		expectKeyword("process");
+		if(!isSymbol(";"))
+			next(); // label
+		expectSymbol(";");
+
+		ostringstream o;
+		o << leading;
+		o << indent << (clock!="" ? "always_ff @(posedge " + identifier(clock) + ")" : "always_comb") << " begin" << endl;
+		o << body;
+		o << indent << "end" << endl;
+		return o.str();
+	}
+
+
+	// Sequential signal assignments and if statements, up to the end, elsif or else that closes them
+	string VHDLToVerilog::sequential(int level, bool nonBlocking) {
+		string indent;
+		for(int i=0; i<level; i++)
+			indent += tab_;
+
+		ostringstream o;
+		while(peek().type!=Token::end && !isKeyword("end") && !isKeyword("elsif") && !isKeyword("else")) {
+			if(isKeyword("null")) {
+				next();
+				expectSymbol(";");
+				continue;
+			}
+			if(isKeyword("if")) {
+				next();
+				Expr c = expression();
+				expectKeyword("then");
+				o << comments(level) << indent << "if (" << paren(c, 0) << ") begin" << endl;
+				o << sequential(level+1, nonBlocking);
+				while(isKeyword("elsif")) {
+					next();
+					c = expression();
+					expectKeyword("then");
+					o << indent << "end else if (" << paren(c, 0) << ") begin" << endl;
+					o << sequential(level+1, nonBlocking);
+				}
+				if(isKeyword("else")) {
+					next();
+					o << indent << "end else begin" << endl;
+					o << sequential(level+1, nonBlocking);
+				}
+				expectKeyword("end");
+				expectKeyword("if");
+				expectSymbol(";");
+				o << indent << "end" << endl;
+				continue;
+			}
+			if(peek().type!=Token::name || isKeyword("case") || isKeyword("for") || isKeyword("while") || isKeyword("loop")
+			   || isKeyword("wait") || isKeyword("assert") || isKeyword("report") || isKeyword("return"))
+				throw toLower(peek().text) + " statement in a process";
+
+			string t = target();
+			if(isSymbol(":="))
+				throw string("variable assignment");
+			expectSymbol("<=");
+			Expr v = expression();
+			if(isKeyword("when"))
+				throw string("conditional assignment in a process");
+			expectSymbol(";");
+			o << comments(level) << indent << t << (nonBlocking ? " <= " : " = ") << value(v, t) << ";" << endl;
+		}
+		return o.str();
+	}
+
+
+	string VHDLToVerilog::selectedAssignment(int level) {
+		next(); // with
+		Expr selector = expression();
+		expectKeyword("select");
+		string t = target();
+		expectSymbol("<=");
+
+		vector<pair<string, string>> cases;
+		while(true) {
+			Expr v = expression();
+			expectKeyword("when");
+			vector<string> choices;
+			while(true) {
+				if(isKeyword("others")) {
+					next();
+					choices.push_back("default");
+				}
+				else
+					choices.push_back(paren(expression(), precCond+1));
+				if(!isSymbol("|"))
+					break;
+				next();
+			}
+			string label;
+			for(size_t i=0; i<choices.size(); i++)
+				label += (i>0 ? ", " : "") + choices[i];
+			cases.push_back(make_pair(label, value(v, t)));
+			if(!isSymbol(","))
+				break;
+			next();
+		}
+		expectSymbol(";");
+
+		string indent;
+		for(int i=0; i<level; i++)
+			indent += tab_;
+		ostringstream o;
+		o << comments(level);
+		o << indent << "always_comb" << endl;
+		o << indent << tab_ << "case (" << selector.text << ")" << endl;
+		for(auto c: cases)
+			o << indent << tab_ << tab_ << c.first << ": " << t << " = " << c.second << ";" << endl;
+		o << indent << tab_ << "endcase" << endl;
+		return o.str();
+	}
+
+
+	string VHDLToVerilog::instance(int level, string label) {
+		if(isKeyword("entity") || isKeyword("component"))
+			next();
+		string component = next().text;
+		while(isSymbol(".")) {
+			next();
+			component = next().text;
+		}
+		if(isSymbol("(")) {
+			// architecture name
+			next();
+			next();
+			expectSymbol(")");
+		}
+
+		vector<string> parameters, ports;
+		for(int map=0; map<2; map++) {
+			if(map==0 && !isKeyword("generic"))
+				continue;
+			expectKeyword(map==0 ? "generic" : "port");
+			expectKeyword("map");
+			expectSymbol("(");
+			while(true) {
+				string formal = identifier(next().text);
+				if(!isSymbol("=>"))
+					throw string("positional or partial association");
+				next();
+				string actual;
+				if(isKeyword("open"))
+					next();
+				else {
+					Expr e = expression();
+					actual = value(e, "");
+				}
+				(map==0 ? parameters : ports).push_back("." + formal + "(" + actual + ")");
+				if(!isSymbol(","))
+					break;
+				next();
+			}
+			expectSymbol(")");
+		}
+		expectSymbol(";");
+
+		string indent;
+		for(int i=0; i<level; i++)
+			indent += tab_;
+		ostringstream o;
+		o << comments(level);
+		o << indent << identifier(component);
+		if(parameters.size() > 0) {
+			o << " #(";
+			for(size_t i=0; i<parameters.size(); i++)
+				o << (i>0 ? ", " : "") << parameters[i];
+			o << ")";
+		}
+		o << " " << label << " (";
+		for(size_t i=0; i<ports.size(); i++)
+			o << (i>0 ? "," : "") << endl << indent << tab_ << tab_ << ports[i];
+		o << ");" << endl;
+		return o.str();
+	}
+
+
+	string VHDLToVerilog::generate(int level, string label) {
+		string header;
+		if(isKeyword("for")) {
+			next();
+			string var = identifier(next().text);
+			expectKeyword("in");
+			Expr from = expression();
+			bool down = isKeyword("downto");
+			if(down)
+				next();
+			else
+				expectKeyword("to");
+			Expr to = expression();
+			expectKeyword("generate");
+			header = "for (genvar " + var + " = " + from.text + "; " + var + (down ? " >= " : " <= ") + to.text + "; "
+				+ var + (down ? "--" : "++") + ") begin : " + label;
+		}
+		else {
+			expectKeyword("if");
+			Expr cond = expression();
+			expectKeyword("generate");
+			header = "if (" + cond.text + ") begin : " + label;
+		}
+
+		string indent;
+		for(int i=0; i<level; i++)
+			indent += tab_;
+		ostringstream o;
+		o << comments(level) << indent << header << endl;
+		o << items(level+1);
+		expectKeyword("end");
+		expectKeyword("generate");
+		if(peek().type == Token::name)
+			next();
+		expectSymbol(";");
+		o << comments(level+1) << indent << "end" << endl;
+		return o.str();
+	}
+
+
+	string VHDLToVerilog::subtype() {
+		Token t = next();
+		while(isSymbol(".")) {
+			next();
+			t = next();
+		}
+		if(t.type != Token::name)
+			throw "unexpected " + t.text + " in a type";
+		string n = toLower(t.text);
+
+		if(n=="std_logic" || n=="std_ulogic" || n=="bit" || n=="boolean")
+			return "logic";
+		if(n=="std_logic_vector" || n=="std_ulogic_vector" || n=="bit_vector" || n=="unsigned" || n=="signed") {
+			string s = (n=="signed" ? "logic signed" : "logic");
+			if(!isSymbol("("))
+				return s; // unconstrained: only for constants, whose width is the one of their value
+			next();
+			string r = range();
+			expectSymbol(")");
+			return s + " [" + r + "]";
+		}
+		if(n=="integer" || n=="natural" || n=="positive") {
+			if(isKeyword("range")) {
+				next();
+				range();
+			}
+			return "integer";
+		}
+		if(n=="real")
+			return "real";
+		return identifier(t.text);
+	}
+
+
+	string VHDLToVerilog::range() {
+		Expr left = expression();
+		if(!isKeyword("downto") && !isKeyword("to"))
+			throw string("range expected");
+		next();
+		Expr right = expression();
+		return left.text + ":" + right.text;
+	}
+
+
+	string VHDLToVerilog::target() {
+		return name().text;
+	}
+
+
+	// The text of an expression on the right-hand side of target
+	string VHDLToVerilog::value(Expr e, string target) {
+		if(e.empty)
+			throw string("empty string");
+		if(e.text=="" && e.fill!="") {
+			if(target=="")
+				throw string("(others => ...) aggregate whose width is unknown");
+			int width = widthOf_(target);
+			if(width > 0)
+				return "{" + to_string(width) + "{" + e.fill + "}}";
+			return "{$bits(" + target + "){" + e.fill + "}}";
+		}
+		return e.text;
+	}
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////
+	// Expressions
+
+	VHDLToVerilog::Expr VHDLToVerilog::expression() {
+		Expr l = relation();
+		while(isKeyword("and") || isKeyword("or") || isKeyword("xor") || isKeyword("nand") || isKeyword("nor") || isKeyword("xnor")) {
+			string op = toLower(next().text);
+			Expr r = relation();
+			if(op=="and")
+				l = makeExpr(paren(l, precAnd) + " & " + paren(r, precAnd+1), precAnd);
+			else if(op=="or")
+				l = makeExpr(paren(l, precOr) + " | " + paren(r, precOr+1), precOr);
+			else if(op=="xor")
+				l = makeExpr(paren(l, precXor) + " ^ " + paren(r, precXor+1), precXor);
+			else if(op=="nand")
+				l = makeExpr("~(" + paren(l, precAnd) + " & " + paren(r, precAnd+1) + ")", precUnary);
+			else if(op=="nor")
+				l = makeExpr("~(" + paren(l, precOr) + " | " + paren(r, precOr+1) + ")", precUnary);
+			else
+				l = makeExpr(paren(l, precXor) + " ~^ " + paren(r, precXor+1), precXor);
+		}
+		return l;
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::relation() {
+		Expr l = shiftExpression();
+		static const vector<pair<string, string>> ops = {
+			{"=", "=="}, {"/=", "!="}, {"<", "<"}, {"<=", "<="}, {">", ">"}, {">=", ">="}
+		};
+		for(auto op: ops) {
+			if(isSymbol(op.first)) {
+				next();
+				Expr r = shiftExpression();
+				int prec = (op.first=="=" || op.first=="/=" ? precEq : precRel);
+				// an (others => '0') operand takes the width of the other one
+				return makeExpr(paren(l, prec) + " " + op.second + " " + paren(r, prec+1), prec);
+			}
+		}
+		return l;
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::shiftExpression() {
+		Expr l = simpleExpression();
+		static const vector<pair<string, string>> ops = {
+			{"sll", "<<"}, {"srl", ">>"}, {"sla", "<<<"}, {"sra", ">>>"}
+		};
+		for(auto op: ops) {
+			if(isKeyword(op.first)) {
+				next();
+				Expr r = simpleExpression();
+				return makeExpr(paren(l, precShift) + " " + op.second + " " + paren(r, precShift+1), precShift);
+			}
+		}
+		if(isKeyword("rol") || isKeyword("ror"))
+			throw string("rotation");
+		return l;
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::simpleExpression() {
+		bool negate = false;
+		if(isSymbol("-")) {
+			next();
+			negate = true;
+		}
+		else if(isSymbol("+"))
+			next();
+
+		Expr l = term();
+		if(negate)
+			l = makeExpr("-" + paren(l, precUnary), precUnary);
+
+		while(isSymbol("+") || isSymbol("-") || isSymbol("&")) {
+			string op = next().text;
+			Expr r = term();
+			if(op=="&") {
+				// concatenations are flattened; the empty strings produced by zg(0) and friends vanish
+				vector<string> parts = l.parts;
+				if(parts.empty() && !l.empty)
+					parts.push_back(paren(l, precPrimary));
+				if(!r.empty)
+					parts.push_back(paren(r, precPrimary));
+				l = makeExpr(concatText(parts), precPrimary);
+				l.parts = parts;
+				l.empty = parts.empty();
+			}
+			else
+				l = makeExpr(paren(l, precAdd) + " " + op + " " + paren(r, precAdd+1), precAdd);
+		}
+		return l;
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::term() {
+		Expr l = factor();
+		while(isSymbol("*") || isSymbol("/") || isKeyword("mod") || isKeyword("rem")) {
+			string op = toLower(next().text);
+			if(op=="mod" || op=="rem")
+				op = "%";
+			Expr r = factor();
+			l = makeExpr(paren(l, precMul) + " " + op + " " + paren(r, precMul+1), precMul);
+		}
+		return l;
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::factor() {
+		if(isKeyword("not")) {
+			next();
+			Expr e = primary();
+			return makeExpr("~" + paren(e, precUnary), precUnary);
+		}
+		if(isKeyword("abs"))
+			throw string("abs");
+		Expr l = primary();
+		if(isSymbol("**")) {
+			next();
+			Expr r = primary();
+			return makeExpr(paren(l, precPow+1) + " ** " + paren(r, precPow+1), precPow);
+		}
+		return l;
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::primary() {
+		const Token &t = peek();
+
+		if(t.type==Token::number) {
+			string s = next().text;
+			s.erase(remove(s.begin(), s.end(), '_'), s.end());
+			size_t hash = s.find('#');
+			if(hash != string::npos) {
+				// based literal, e.g. 16#FF#
+				string base = s.substr(0, hash);
+				string digits = s.substr(hash+1, s.find('#', hash+1)-hash-1);
+				if(base=="2")
+					return makeExpr("'b" + digits, precPrimary);
+				if(base=="8")
+					return makeExpr("'o" + digits, precPrimary);
+				if(base=="16")
+					return makeExpr("'h" + digits, precPrimary);
+				throw "base " + base + " literal";
+			}
+			return makeExpr(s, precPrimary);
+		}
+
+		if(t.type==Token::character) {
+			char c = tolower(next().text[0]);
+			if(c=='0' || c=='1')
+				return makeExpr(string("1'b") + c, precPrimary);
+			if(c=='x' || c=='u' || c=='-' || c=='w')
+				return makeExpr("1'bx", precPrimary);
+			if(c=='z')
+				return makeExpr("1'bz", precPrimary);
+			if(c=='l')
+				return makeExpr("1'b0", precPrimary);
+			if(c=='h')
+				return makeExpr("1'b1", precPrimary);
+			throw string("character literal");
+		}
+
+		if(t.type==Token::stringLiteral) {
+			string bits = next().text;
+			if(bits.empty()) {
+				Expr e = makeExpr("", precPrimary);
+				e.empty = true;
+				return e;
+			}
+			for(auto &c: bits) {
+				c = tolower(c);
+				if(c=='u' || c=='-' || c=='w')
+					c = 'x';
+				else if(c=='l')
+					c = '0';
+				else if(c=='h')
+					c = '1';
+				else if(c!='0' && c!='1' && c!='x' && c!='z')
+					throw string("string literal");
+			}
+			return makeExpr(to_string(bits.size()) + "'b" + bits, precPrimary);
+		}
+
+		if(t.type==Token::bitString) {
+			string s = next().text;
+			char base = tolower(s[0]);
+			string digits = s.substr(2, s.size()-3);
+			size_t n = 0;
+			for(auto c: digits)
+				if(c!='_')
+					n++;
+			if(n==0) {
+				Expr e = makeExpr("", precPrimary);
+				e.empty = true;
+				return e;
+			}
+			if(base=='x')
+				return makeExpr(to_string(4*n) + "'h" + digits, precPrimary);
+			if(base=='o')
+				return makeExpr(to_string(3*n) + "'o" + digits, precPrimary);
+			return makeExpr(to_string(n) + "'b" + digits, precPrimary);
+		}
+
+		if(t.type==Token::symbol && t.text=="(")
+			return aggregate();
+
+		if(t.type==Token::name && !isKeyword("others") && !isKeyword("open") && !isKeyword("when") && !isKeyword("else"))
+			return name();
+
+		throw "unexpected " + (t.type==Token::end ? string("end of code") : t.text);
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::aggregate() {
+		next(); // (
+
+		if(isKeyword("others") && isSymbol("=>", 1)) {
+			next();
+			next();
+			Expr v = expression();
+			expectSymbol(")");
+			Expr e = makeExpr("", precPrimary);
+			e.fill = paren(v, precPrimary);
+			if(e.fill=="1'b0" || e.fill=="1'b1")
+				e.text = "'" + e.fill.substr(3);
+			return e;
+		}
+
+		Expr first = expression();
+		if(isKeyword("downto") || isKeyword("to")) {
+			// (left downto right => x): a replication
+			bool down = isKeyword("downto");
+			next();
+			Expr second = expression();
+			expectSymbol("=>");
+			Expr v = expression();
+			expectSymbol(")");
+			string count;
+			Expr hi = (down ? first : second), lo = (down ? second : first);
+			if(isInteger(hi.text) && isInteger(lo.text))
+				count = to_string(stol(hi.text) - stol(lo.text) + 1);
+			else
+				count = "(" + paren(hi, precAdd) + " - " + paren(lo, precAdd+1) + " + 1)";
+			return makeExpr("{" + count + "{" + paren(v, precPrimary) + "}}", precPrimary);
+		}
+		if(isSymbol("=>"))
+			throw string("named aggregate");
+
+		if(isSymbol(",")) {
+			// positional aggregate: the value of an array constant
+			vector<string> elements;
+			elements.push_back(value(first, ""));
+			while(isSymbol(",")) {
+				next();
+				elements.push_back(value(expression(), ""));
+			}
+			expectSymbol(")");
+			string text = "'{";
+			for(size_t i=0; i<elements.size(); i++)
+				text += (i>0 ? ", " : "") + elements[i];
+			return makeExpr(text + "}", precPrimary);
+		}
+
+		expectSymbol(")");
+		if(first.empty || (first.text=="" && first.fill!=""))
+			return first;
+		return makeExpr("(" + first.text + ")", precPrimary);
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::name() {
+		string n = next().text;
+		while(isSymbol(".")) {
+			next();
+			n = next().text;
+		}
+		string lower = toLower(n);
+		if(lower=="true")
+			return makeExpr("1'b1", precPrimary);
+		if(lower=="false")
+			return makeExpr("1'b0", precPrimary);
+
+		static const set<string> functions = {
+			"std_logic_vector", "std_ulogic_vector", "to_stdlogicvector", "unsigned", "signed",
+			"conv_std_logic_vector", "to_unsigned", "to_signed", "conv_unsigned", "conv_signed", "resize", "ext", "sxt",
+			"conv_integer", "to_integer", "shift_left", "shift_right", "and_reduce", "or_reduce", "xor_reduce",
+			"rising_edge", "falling_edge"
+		};
+
+		Expr e = makeExpr(identifier(n), precPrimary);
+		bool first = true;
+		while(isSymbol("(") || isSymbol("'")) {
+			if(isSymbol("'")) {
+				next();
+				string attribute = toLower(next().text);
+				if(attribute=="length")
+					e = makeExpr("$bits(" + e.text + ")", precPrimary);
+				else if(attribute=="high" || attribute=="left")
+					e = makeExpr("$high(" + e.text + ")", precPrimary);
+				else if(attribute=="low" || attribute=="right")
+					e = makeExpr("$low(" + e.text + ")", precPrimary);
+				else
+					throw "attribute " + attribute;
+				first = false;
+				continue;
+			}
+
+			next(); // (
+			vector<Expr> args;
+			vector<bool> isRange;
+			while(true) {
+				Expr a = expression();
+				bool r = false;
+				if(isKeyword("downto") || isKeyword("to")) {
+					next();
+					Expr b = expression();
+					a = makeExpr(a.text + ":" + b.text, precPrimary);
+					r = true;
+				}
+				else if(isSymbol("=>"))
+					throw string("named association");
+				args.push_back(a);
+				isRange.push_back(r);
+				if(!isSymbol(","))
+					break;
+				next();
+			}
+			expectSymbol(")");
+
+			if(first && functions.find(lower)!=functions.end()) {
+				for(auto r: isRange)
+					if(r)
+						throw "range in a call to " + n;
+				e = call(lower, args);
+			}
+			else {
+				string text = e.text;
+				for(auto a: args)
+					text += "[" + a.text + "]";
+				e = makeExpr(text, precPrimary);
+			}
+			first = false;
+		}
+		return e;
+	}
+
+
+	VHDLToVerilog::Expr VHDLToVerilog::call(string function, vector<Expr> &args) {
+		size_t arity = args.size();
+
+		if(arity==1 && (function=="std_logic_vector" || function=="std_ulogic_vector" || function=="to_stdlogicvector"
+		                || function=="conv_integer" || function=="to_integer"))
+			return args[0];
+		if(arity==1 && function=="unsigned")
+			return makeExpr("$unsigned(" + value(args[0], "") + ")", precPrimary);
+		if(arity==1 && function=="signed")
+			return makeExpr("$signed(" + value(args[0], "") + ")", precPrimary);
+		if(arity==1 && (function=="and_reduce" || function=="or_reduce" || function=="xor_reduce"))
+			return makeExpr(string(function=="and_reduce" ? "&" : function=="or_reduce" ? "|" : "^") + paren(args[0], precPrimary), precUnary);
+		if(arity==2 && function=="shift_left")
+			return makeExpr(paren(args[0], precShift) + " << " + paren(args[1], precShift+1), precShift);
+		if(arity==2 && function=="shift_right")
+			return makeExpr(paren(args[0], precShift) + " >>> " + paren(args[1], precShift+1), precShift);
+
+		if(arity==2 && (function=="conv_std_logic_vector" || function=="to_unsigned" || function=="to_signed"
+		                || function=="conv_unsigned" || function=="conv_signed" || function=="resize"
+		                || function=="ext" || function=="sxt")) {
+			// a value of the given width
+			string v = value(args[0], "");
+			string w = value(args[1], "");
+			bool signExtend = (function=="sxt");
+			if(isInteger(w)) {
+				if(isInteger(v)) {
+					if(v[0]=='-')
+						return makeExpr("-" + w + "'d" + v.substr(1), precUnary);
+					return makeExpr(w + "'d" + v, precPrimary);
+				}
+				if(signExtend)
+					return makeExpr(w + "'($signed(" + v + "))", precPrimary);
+				return makeExpr(w + "'(" + v + ")", precPrimary);
+			}
+			if(signExtend)
+				return makeExpr("(" + w + ")'($signed(" + v + "))", precPrimary);
+			return makeExpr("(" + w + ")'(" + v + ")", precPrimary);
+		}
+
+		throw "call to " + function;
+	}
+
+}
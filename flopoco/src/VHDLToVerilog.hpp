@@ -0,0 +1,135 @@
+/*
+ * Translation of the VHDL written by FloPoCo operators into SystemVerilog.
+ * The output is synthesizable and meant to be compiled by Verilator.
+ *
+ * This file is part of the FloPoCo project
+ */
+
+#ifndef VHDLTOVERILOG_HPP
+#define VHDLTOVERILOG_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "FlopocoStream.hpp"
+
+namespace flopoco {
+
+	/**
+	 * Translates the architecture of an operator, once scheduled, from VHDL to SystemVerilog.
+	 * It works on the statement list of the FlopocoStream: the kind of each statement is known,
+	 * and its signals come with the delays the scheduler gave them, so only the VHDL code between
+	 * the signals is lexed. The code the lexer did not mark (operators built with
+	 * setNoParseNoSchedule()) goes through the same parser as a whole.
+	 * Only the subset of VHDL that operators write is covered: simple, conditional and selected
+	 * signal assignments, component instances, for and if generate, processes made of signal
+	 * assignments and if statements, and the std_logic_arith / numeric_std conversion functions.
+	 * Anything else is copied as a comment and counted by untranslated().
+	 */
+	class VHDLToVerilog {
+	public:
+		/**
+		 * @param[in] tab     the indentation of one level
+		 * @param[in] widthOf the width of a signal of the operator, -1 if there is no such signal
+		 */
+		VHDLToVerilog(std::string tab, std::function<int(const std::string&)> widthOf);
+
+		/** Translates the statements of an architecture, as left by the scheduler */
+		std::string statements(const std::vector<VHDLStatement> &sts);
+
+		/** Translates an entry of the type table of an operator into a typedef */
+		std::string typeDeclaration(std::string name, std::string vhdlType);
+
+		/** Translates an entry of the constant table of an operator into a localparam */
+		std::string constantDeclaration(std::string name, std::string vhdlType, std::string vhdlValue);
+
+		/** The number of constructs that could not be translated so far */
+		int untranslated();
+
+		/** Escapes an identifier that happens to be a SystemVerilog keyword */
+		static std::string identifier(std::string name);
+
+	private:
+		struct Token {
+			typedef enum {
+				name,
+				number,
+				character,
+				stringLiteral,
+				bitString,
+				symbol,
+				end
+			} TokenType;
+
+			TokenType type;
+			std::string text;
+			size_t begin;                       /**< position of the token in the source */
+			std::vector<std::string> comments;  /**< the comments found before the token */
+		};
+
+		/** A translated expression, with the precedence of its top operator to place the parentheses */
+		struct Expr {
+			std::string text;
+			int prec;
+			std::vector<std::string> parts;  /**< for a concatenation, its operands */
+			std::string fill;                /**< for (others => x), the translation of x */
+			bool empty;                      /**< the empty string "" */
+		};
+
+		void tokenize(std::string vhdl);
+		void lex(std::string vhdl);
+		void endTokens();
+		const Token& peek(int k=0);
+		Token next();
+		bool isKeyword(std::string keyword, int k=0);
+		bool isSymbol(std::string symbol, int k=0);
+		void expectKeyword(std::string keyword);
+		void expectSymbol(std::string symbol);
+		void skipStatement();
+
+		std::string statement(const VHDLStatement &st);
+		std::string items(int level);
+		std::string concurrentStatement(int level);
+		std::string untranslatedCode(int level, std::string reason, size_t start);
+		std::string instance(int level, std::string label);
+		std::string generate(int level, std::string label);
+		std::string conditionalAssignment(int level, std::string target);
+		std::string selectedAssignment(int level);
+		std::string process(int level);
+		std::string sequential(int level, bool nonBlocking);
+
+		std::string subtype();
+		std::string range();
+		std::string target();
+
+		Expr expression();
+		Expr relation();
+		Expr shiftExpression();
+		Expr simpleExpression();
+		Expr term();
+		Expr factor();
+		Expr primary();
+		Expr name();
+		Expr aggregate();
+		Expr call(std::string function, std::vector<Expr> &args);
+
+		std::string value(Expr e, std::string target);
+
+		static Expr makeExpr(std::string text, int prec);
+		static std::string paren(const Expr &e, int prec);
+		static std::string concatText(const std::vector<std::string> &parts);
+		std::string comments(int level);
+
+		std::string tab_;
+		std::function<int(const std::string&)> widthOf_;
+		std::string src_;
+		std::vector<Token> tokens_;
+		size_t pos_;
+		std::vector<std::string> lexComments_;      /**< the comments lexed since the last token */
+		std::vector<std::string> pendingComments_;
+		int untranslated_;
+	};
+
+}
+#endif
@@ -0,0 +1,26 @@
+#!/bin/sh
+# Generates SystolicArrays as SystemVerilog and lints them with Verilator.
+# Fails if flopoco leaves a VHDL construct untranslated, or if Verilator finds an error.
+#
+# usage: lint_systolic_array.sh <flopoco executable> [work directory]
+
+flopoco=$1
+work=${2:-.}
+common="N=2 M=2 arithmetic_in=ieee:8:23 arithmetic_out=same msb_summand=16 lsb_summand=-60 nb_bits_ovf=6 has_HSSD=true chunk_size=-1 frequency=200 target=VirtexUltrascalePlus"
+
+cd "$work" || exit 1
+status=0
+for topology in "topology=orthogonal" "topology=weight_stationary b_depth=16"; do
+	name=SystolicArray_$(echo $topology | sed 's/topology=//; s/ .*//')
+	echo "== $name"
+	if ! "$flopoco" SystolicArray $common $topology name=$name outputFile=$name.vhdl verilog=$name.sv > $name.log 2>&1; then
+		cat $name.log
+		status=1
+		continue
+	fi
+	if grep "could not be translated" $name.log; then
+		status=1
+	fi
+	verilator --lint-only -Wall -Wno-fatal --top-module $name $name.sv || status=1
+done
+exit $status
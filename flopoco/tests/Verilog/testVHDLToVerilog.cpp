@@ -0,0 +1,180 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE VHDLToVerilogTest
+
+#include <boost/test/unit_test.hpp>
+#include "VHDLToVerilog.hpp"
+
+using namespace std;
+using namespace flopoco;
+
+/* Statements are built the way FlopocoStream leaves them after the schedule:
+   unmarked VHDL as text tokens, signals as rhsSignal or portActual tokens with their delay */
+
+static VHDLToken text(string code) {
+	VHDLToken t;
+	t.type = VHDLToken::text;
+	t.code = code;
+	t.functionalDelay = 0;
+	return t;
+}
+
+static VHDLToken signal(string name, string delay = "") {
+	VHDLToken t = text(name);
+	t.type = VHDLToken::rhsSignal;
+	t.signalName = name;
+	t.delay = delay;
+	return t;
+}
+
+static VHDLToken actual(string name, string formal, string delay = "") {
+	VHDLToken t = signal(name, delay);
+	t.type = VHDLToken::portActual;
+	t.formalName = formal;
+	return t;
+}
+
+static VHDLStatement statement(VHDLStatement::StatementType type, string lhsName, vector<VHDLToken> tokens) {
+	VHDLStatement st;
+	st.type = type;
+	st.lhsName = lhsName;
+	st.tokens = tokens;
+	return st;
+}
+
+static VHDLStatement code(string vhdl) {
+	return statement(VHDLStatement::text, "", {text(vhdl)});
+}
+
+/* the operator under translation has R on 12 bits and no other signal of known width */
+static VHDLToVerilog translator() {
+	return VHDLToVerilog("   ", [](const string& name) { return name == "R" ? 12 : -1; });
+}
+
+BOOST_AUTO_TEST_CASE(ConditionalAssignment) {
+	VHDLToVerilog t = translator();
+	string sv = t.statements({statement(VHDLStatement::assignment, "R",
+		{text("   "), text("R"), text(" <= "), signal("X", "_d2"), text(" + "), signal("Y"),
+		 text(" when "), signal("sel", "_d1"), text("='1' else (others => "), signal("Z"), text(");")})});
+	BOOST_CHECK_EQUAL(sv, "   assign R = sel_d1 == 1'b1 ? X_d2 + Y : {12{Z}};\n");
+	BOOST_CHECK_EQUAL(t.untranslated(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SelectedAssignment) {
+	VHDLToVerilog t = translator();
+	string sv = t.statements({statement(VHDLStatement::selectedAssignment, "Q",
+		{text("   with "), signal("A"), text(" select "), text("Q"),
+		 text(" <= \n      \"0001\" when \"00\",\n      \"0010\" when others;")})});
+	BOOST_CHECK_EQUAL(sv,
+		"   always_comb\n"
+		"      case (A)\n"
+		"         2'b00: Q = 4'b0001;\n"
+		"         default: Q = 4'b0010;\n"
+		"      endcase\n");
+	BOOST_CHECK_EQUAL(t.untranslated(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Instance) {
+	VHDLToVerilog t = translator();
+	VHDLStatement st = statement(VHDLStatement::instance, "Adder",
+		{text("   add: "), text("Adder"), text("\n      port map ( clk => clk,\n   "),
+		 text("X"), text(" => "), actual("R", "X", "_d1"), text(",\n   "),
+		 text("Y"), text(" => "), text("'0'"), text(",\n   "),
+		 text("S"), text(" => "), actual("out1", "S"), text(");")});
+	st.instanceName = "add";
+	BOOST_CHECK_EQUAL(t.statements({st}),
+		"   Adder add (\n"
+		"         .clk(clk),\n"
+		"         .X(R_d1),\n"
+		"         .Y(1'b0),\n"
+		"         .S(out1));\n");
+	BOOST_CHECK_EQUAL(t.untranslated(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Process) {
+	VHDLToVerilog t = translator();
+	/* the text statements of a process are joined before they are parsed */
+	string sv = t.statements({
+		code("   process(clk)\n   begin\n      if clk'event and clk = '1' then\n         if LDB = '1' then\n            b(conv_integer(w)) <= c;"),
+		code("\n            w <= w + 1;"),
+		code("\n         end if;"),
+		code("\n      end if;"),
+		code("\n   end process;\n")});
+	BOOST_CHECK_EQUAL(sv,
+		"   always_ff @(posedge clk) begin\n"
+		"      if (LDB == 1'b1) begin\n"
+		"         b[w] <= c;\n"
+		"         w <= w + 1;\n"
+		"      end\n"
+		"   end\n");
+	BOOST_CHECK_EQUAL(t.untranslated(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Generate) {
+	VHDLToVerilog t = translator();
+	string sv = t.statements({
+		code("   rows: for II in 0 to 3 generate\n      a_i: Arith port map ( clk => clk, a => r(II), s => s(((II+1)*8)-1 downto II*8));"),
+		code("\n   end generate;\n")});
+	BOOST_CHECK_EQUAL(sv,
+		"   for (genvar II = 0; II <= 3; II++) begin : rows\n"
+		"      Arith a_i (\n"
+		"            .clk(clk),\n"
+		"            .a(r[II]),\n"
+		"            .s(s[((II + 1) * 8) - 1:II * 8]));\n"
+		"   end\n");
+	BOOST_CHECK_EQUAL(t.untranslated(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ConversionFunctions) {
+	VHDLToVerilog t = translator();
+	string sv = t.statements({
+		statement(VHDLStatement::assignment, "A",
+			{text("   "), text("A"), text(" <= "), text("conv_std_logic_vector("), signal("X"), text(", 8);")}),
+		statement(VHDLStatement::assignment, "B",
+			{text("\n   "), text("B"), text(" <= "), text("conv_std_logic_vector(5, 8);")}),
+		statement(VHDLStatement::assignment, "C",
+			{text("\n   "), text("C"), text(" <= "), text("unsigned("), signal("X"), text(") + 1;")}),
+		statement(VHDLStatement::assignment, "D",
+			{text("\n   "), text("D"), text(" <= "), text("sxt("), signal("X"), text(", 16);")}),
+		statement(VHDLStatement::assignment, "E",
+			{text("\n   "), text("E"), text(" <= "), text("and_reduce("), signal("X"), text(");")}),
+		statement(VHDLStatement::assignment, "F",
+			{text("\n   "), text("F"), text(" <= "), text("std_logic_vector(shift_left(unsigned("), signal("X"), text("), 2));")})});
+	BOOST_CHECK_EQUAL(sv,
+		"   assign A = 8'(X);\n"
+		"   assign B = 8'd5;\n"
+		"   assign C = $unsigned(X) + 1;\n"
+		"   assign D = 16'($signed(X));\n"
+		"   assign E = &X;\n"
+		"   assign F = $unsigned(X) << 2;\n");
+	BOOST_CHECK_EQUAL(t.untranslated(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Declarations) {
+	VHDLToVerilog t = translator();
+	BOOST_CHECK_EQUAL(t.typeDeclaration("arr_t", "array(3 downto 0) of std_logic_vector(7 downto 0)"),
+		"   typedef logic [7:0] arr_t [3:0];\n");
+	BOOST_CHECK_EQUAL(t.constantDeclaration("K", "std_logic_vector(3 downto 0)", "\"0101\""),
+		"   localparam logic [3:0] K = 4'b0101;\n");
+	BOOST_CHECK_EQUAL(t.untranslated(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Untranslated) {
+	VHDLToVerilog t = translator();
+	/* what the translator does not cover is kept as a comment and counted, and the statements after it still translate */
+	BOOST_CHECK_EQUAL(t.typeDeclaration("bad_t", "range 0 to 3"),
+		"   // untranslated VHDL type (unexpected 0): bad_t is range 0 to 3\n");
+	BOOST_CHECK_EQUAL(t.untranslated(), 1);
+	string sv = t.statements({
+		statement(VHDLStatement::assignment, "P",
+			{text("   "), text("(P, Q)"), text(" <= "), signal("X", "_d3"), text(";")}),
+		code("\n   unknown stuff here;\n"),
+		statement(VHDLStatement::assignment, "R",
+			{text("   "), text("R"), text(" <= "), signal("X"), text(";")})});
+	BOOST_CHECK_EQUAL(sv,
+		"   // untranslated VHDL (expected <= instead of P):\n"
+		"   // (P, Q) <= X_d3;\n"
+		"   // untranslated VHDL (expected <= instead of stuff):\n"
+		"   // unknown stuff here;\n"
+		"   assign R = X;\n");
+	BOOST_CHECK_EQUAL(t.untranslated(), 3);
+}
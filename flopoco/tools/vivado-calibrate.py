@@ -0,0 +1,173 @@
+##
+################################################################################
+##             Delay model calibration from Vivado timing reports
+## This tool is part of  FloPoCo
+## Author:  Ledoux Louis
+## All rights reserved
+################################################################################
+##
+## Reads the data paths of post-route report_timing text files, as written by
+## vivado-runsyn.py or by "report_timing -max_paths 1000 -file x.txt" on a routed
+## design, and fits the coefficients of the delay model of a target on them:
+##  - the primitive delays are the means of the cell arcs of their kind,
+##  - fanoutConstant and typicalLocalRoutingDelay come from a least squares line
+##    of the routed net delays against their fanout,
+##  - DSPMultiplierDelay is the mean crossing of a DSP, its internal stages summed.
+## The result is a target profile, to give to flopoco with profile=<file>.
+
+from __future__ import print_function
+import sys
+import re
+import argparse
+
+def report(text):
+    print("vivado_calibrate: ", text)
+
+cell_regex = re.compile(r"\b([A-Z][A-Z0-9_]*) \((Prop_[^)]+)\)(.*)$")
+net_regex = re.compile(r"\bnet \(fo=(\d+), (\w+)\)\s+(-?[\d.]+)")
+number_regex = re.compile(r"-?\d+\.\d+")
+
+def get_data_paths(filename):
+    """Returns the data paths of a report, each a list of ("cell", type, arc, ns) and ("net", fo, ns, kind)"""
+    paths = []
+    closed = []
+    segment = []
+    pending_cell = None
+    for line in open(filename):
+        if line.strip().startswith("------"):
+            closed = segment
+            segment = []
+            pending_cell = None
+            continue
+        if "arrival time" in line:
+            # the data path is the section right before the arrival time
+            if not segment and closed:
+                paths.append(closed)
+            closed = []
+            continue
+        if pending_cell is not None:
+            numbers = number_regex.findall(line)
+            if numbers:
+                segment.append(("cell", pending_cell[0], pending_cell[1], float(numbers[0])))
+            pending_cell = None
+            continue
+        m = net_regex.search(line)
+        if m:
+            segment.append(("net", int(m.group(1)), float(m.group(3)), m.group(2)))
+            continue
+        m = cell_regex.search(line)
+        if m:
+            numbers = number_regex.findall(m.group(3))
+            if numbers:
+                segment.append(("cell", m.group(1), m.group(2), float(numbers[0])))
+            else:
+                # long cell names push the delay to the next line
+                pending_cell = (m.group(1), m.group(2))
+    return paths
+
+def is_carry(e):
+    return e[0] == "cell" and e[1].startswith("CARRY")
+
+def is_lut(e):
+    return e[0] == "cell" and e[1].startswith("LUT")
+
+def is_dsp(e):
+    return e[0] == "cell" and e[1].startswith("DSP")
+
+def fit(paths, net_kinds):
+    """Returns {coefficient: (value in seconds, samples)}"""
+    samples = {}
+    def add(name, ns):
+        samples.setdefault(name, []).append(ns*1e-9)
+    fanout_points = []
+    for path in paths:
+        dsp_crossing = None
+        for i, e in enumerate(path):
+            previous = path[i-1] if i > 0 else None
+            following = path[i+1] if i+1 < len(path) else None
+            # a DSP crossing goes through several internal stages chained by nets
+            if is_dsp(e) or (e[0] == "net" and previous is not None and following is not None and is_dsp(previous) and is_dsp(following)):
+                dsp_crossing = (dsp_crossing or 0.0) + (e[3] if e[0] == "cell" else e[2])
+                continue
+            if dsp_crossing is not None:
+                add("DSPMultiplierDelay", dsp_crossing)
+                dsp_crossing = None
+            if e[0] == "cell":
+                kind, arc, ns = e[1], e[2], e[3]
+                if kind.startswith("FD") and "_C_Q" in arc:
+                    add("ffDelay", ns)
+                elif kind in ("LUT2", "LUT5", "LUT6"):
+                    add("lut" + kind[3] + "Delay", ns)
+                elif kind.startswith("CARRY8"):
+                    if re.search(r"_CI_CO\[7\]", arc):
+                        add("carry8Delay", ns)
+                    elif re.search(r"_S\[\d\]_CO\[7\]", arc):
+                        add("initCarryDelay", ns)
+                    elif re.search(r"_CI_O\[\d\]", arc):
+                        add("finalCarryDelay", ns)
+                elif kind.startswith("RAMB"):
+                    add("RAMDelay", ns)
+                continue
+            fo, ns, kind = e[1], e[2], e[3]
+            if kind not in net_kinds or previous is None or following is None:
+                continue
+            if is_carry(previous) and is_carry(following):
+                add("interCarryNetDelay", ns)
+            elif is_lut(previous) and is_carry(following):
+                add("lut_to_carry_net", ns)
+            else:
+                fanout_points.append((fo, ns*1e-9))
+        if dsp_crossing is not None:
+            add("DSPMultiplierDelay", dsp_crossing)
+    coefficients = {}
+    for name in samples:
+        values = samples[name]
+        coefficients[name] = (sum(values)/len(values), len(values))
+    # least squares line delay = typicalLocalRoutingDelay + fanoutConstant*fo
+    if len(set(fo for fo, d in fanout_points)) > 1:
+        n = float(len(fanout_points))
+        mean_fo = sum(fo for fo, d in fanout_points)/n
+        mean_d = sum(d for fo, d in fanout_points)/n
+        var = sum((fo-mean_fo)**2 for fo, d in fanout_points)
+        cov = sum((fo-mean_fo)*(d-mean_d) for fo, d in fanout_points)
+        slope = max(cov/var, 0.0)
+        coefficients["fanoutConstant"] = (slope, len(fanout_points))
+        coefficients["typicalLocalRoutingDelay"] = (max(mean_d - slope*mean_fo, 0.0), len(fanout_points))
+    elif fanout_points:
+        report("all the routed nets have the same fanout, fanoutConstant is not fitted")
+    return coefficients
+
+#/* main */
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='This is an helper script for FloPoCo that fits the delay model of a target on Vivado report_timing files and writes a target profile, to use with profile=<file>')
+    parser.add_argument('reports', nargs='+', help='report_timing text files of routed designs')
+    parser.add_argument('-t', '--target', default='VirtexUltrascalePlus', help='Target the reports come from (default VirtexUltrascalePlus)')
+    parser.add_argument('-o', '--output', help='Profile file name (default <target>.profile)')
+    parser.add_argument('-m', '--min-samples', type=int, default=3, help='Samples needed to fit a coefficient, the hand-set value stays otherwise (default 3)')
+    parser.add_argument('-u', '--unrouted', action='store_true', help='Also use the estimated or unplaced nets of synthesis reports (default only routed nets)')
+
+    options=parser.parse_args()
+
+    paths = []
+    for filename in options.reports:
+        file_paths = get_data_paths(filename)
+        report("{}: {} data paths".format(filename, len(file_paths)))
+        paths += file_paths
+    if not paths:
+        report("no data path found, is it a report_timing output?")
+        sys.exit(1)
+
+    coefficients = fit(paths, ("routed", "estimated", "unplaced") if options.unrouted else ("routed",))
+    output = options.output or options.target + ".profile"
+    with open(output, "w") as profile:
+        profile.write("# flopoco target profile: delay model coefficients in seconds\n")
+        profile.write("# fitted by vivado-calibrate.py on {} data paths of {}\n".format(len(paths), " ".join(options.reports)))
+        profile.write("target {}\n".format(options.target))
+        for name in sorted(coefficients):
+            value, count = coefficients[name]
+            if count < options.min_samples:
+                report("{}: only {} samples, not fitted".format(name, count))
+                continue
+            profile.write("{} {:.4e}  # {} samples\n".format(name, value, count))
+            report("{} = {:.4f} ns over {} samples".format(name, value*1e9, count))
+    report("wrote " + output + ", use it with flopoco profile=" + output)
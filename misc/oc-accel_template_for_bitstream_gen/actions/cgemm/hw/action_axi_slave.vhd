@@ -18,6 +18,7 @@ entity action_axi_slave is
 		-- Users to add ports here
                 i_Action_Type    : in  std_logic_vector(31 downto 0);
                 i_Action_VER     : in  std_logic_vector(31 downto 0);
+                i_Action_Accum   : in  std_logic_vector(31 downto 0);
                 o_Context_ID     : buffer std_logic_vector(31 downto 0);
 
                 o_src_addr_h     : buffer std_logic_vector(31 downto 0);
@@ -187,6 +188,7 @@ architecture action_axi_slave of action_axi_slave is
    constant C_TRANSFER_TYPE_RD_Addr : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_B8";
 
    constant C_CTRL_RETC_RD_Addr     : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_84";
+   constant C_Action_Accum_RD_Addr  : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_88";
 
    --Control MMIO
    constant C_Action_Control_Addr   : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_00_00";
@@ -631,6 +633,8 @@ begin
                   axi_rdata <= o_transfer_type;
                when C_CTRL_RETC_RD_Addr =>
                   axi_rdata <= X"00_00_01_02";           -- 0x184
+               when C_Action_Accum_RD_Addr =>
+                  axi_rdata <= i_Action_Accum;           -- 0x188
                when others =>
                   axi_rdata  <= (others => '0');
             end case;
@@ -275,6 +275,7 @@ action_axi_slave_inst : entity work.action_axi_slave
         o_int_enable            => int_enable,
         i_Action_Type           => x"8686_8604",  -- action type
         i_Action_VER            => x"0000_0002",  -- 2nd version (OpenCAPI)
+        i_Action_Accum          => x"0000_0000",  -- B3=exact output (7), nb_bits_ovf (6:0); B2..B0=msb_summand (23:12), lsb_summand (11:0), signed
         o_Context_ID            => s_Context_ID,
 
         o_app_start             => app_start,
@@ -520,6 +521,12 @@ action_dma_axi_master_inst : entity work.action_axi_master
                     dma_wr_req    <= dest_host;
                     dma_wr_bready <= dest_host;
                     wr_gate       <= '1';
+                    -- a K-chunk ending inside a block leaves its sums in the
+                    -- array and has nothing to write
+                    if or_reduce(s_dst_data_size(31 downto 6)) = '0' then
+                      dma_wr_req       <= '0';
+                      wr_requests_done <= '1';
+                    end if;
                     fsm_copy_q    <= PROCESS_COPY;
                   end if;
 
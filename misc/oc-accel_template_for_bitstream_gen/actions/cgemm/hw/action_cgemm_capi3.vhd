@@ -275,6 +275,7 @@ action_axi_slave_inst : entity work.action_axi_slave
         o_int_enable            => int_enable,
         i_Action_Type           => x"8600_0300",     -- B3=action type; B2=undefined; B1=arith type (0 ieee, 1 tfp, 2 bf16, 3 posit); B0=accum type (0 alpha,1 beta,2 gamma,3 custom)
         i_Action_VER            => x"201f_0000",  -- B3=N; B2=M; B1=param1 arith; B0=param2 arith
+        i_Action_Accum          => x"0000_0000",  -- B3=exact output (7), nb_bits_ovf (6:0); B2..B0=msb_summand (23:12), lsb_summand (11:0), signed
         o_Context_ID            => s_Context_ID,
 
         o_app_start             => app_start,
@@ -520,6 +521,12 @@ action_dma_axi_master_inst : entity work.action_axi_master
                     dma_wr_req    <= dest_host;
                     dma_wr_bready <= dest_host;
                     wr_gate       <= '1';
+                    -- a K-chunk ending inside a block leaves its sums in the
+                    -- array and has nothing to write
+                    if or_reduce(s_dst_data_size(31 downto 7)) = '0' then
+                      dma_wr_req       <= '0';
+                      wr_requests_done <= '1';
+                    end if;
                     fsm_copy_q    <= PROCESS_COPY;
                   end if;
 
@@ -8,6 +8,8 @@ lsb=$5
 bits_ovf=$6
 has_HSSD="true"
 chunk_size="-1"
+# the DSE lets flopoco pick chunk_size and has_HSSD for the frequency instead of sweeping them
+tune="true"
 
 ACTION_ROOT=$7
 FPGACHIP=$8
@@ -24,6 +26,7 @@ echo "                        action config says lsb is $lsb"
 echo "                        action config says bits_ovf is $bits_ovf"
 echo "                        action config says has_HSSD is $has_HSSD"
 echo "                        action config says chunk_size is $chunk_size"
+echo "                        action config says tune is $tune"
 
 if [ ! -d $ACTION_ROOT/ip/action_ip_dir ]; then
 	echo "                        Call create_action_ip.tcl to generate IPs"
@@ -31,8 +34,9 @@ if [ ! -d $ACTION_ROOT/ip/action_ip_dir ]; then
 fi
 
 echo "                        CREATING SA"
-python3 $ACTION_ROOT/hw/prepare_hw.py --N $N --M $M --arithmetic_in $arithmetic_in --arithmetic_out $arithmetic_out --msb $msb --lsb $lsb --bits_ovf $bits_ovf --has_HSSD $has_HSSD --chunk_size $chunk_size
-mv flopoco.vhdl $ACTION_ROOT/hw/libs/systolic_array/
+python3 $ACTION_ROOT/hw/prepare_hw.py --N $N --M $M --arithmetic_in $arithmetic_in --arithmetic_out $arithmetic_out --msb $msb --lsb $lsb --bits_ovf $bits_ovf --has_HSSD $has_HSSD --chunk_size $chunk_size --tune $tune
+mv flopoco.vhdl flopoco_report.json $ACTION_ROOT/hw/libs/systolic_array/
+if [ -f S3FDP_tuning.csv ]; then mv S3FDP_tuning.csv $ACTION_ROOT/hw/libs/systolic_array/; fi
 
 echo "                        CLEANING TEMP FILES"
 rm -r $ACTION_ROOT/hw/dot
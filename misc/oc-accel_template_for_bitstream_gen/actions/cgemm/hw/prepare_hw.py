@@ -1,6 +1,6 @@
 #!/usr/bin/env python
 import argparse
-import re
+import json
 import subprocess
 from datetime import date
 import os
@@ -16,6 +16,7 @@ def parse_args():
 	parser.add_argument('--bits_ovf', required=True, type=str)
 	parser.add_argument('--has_HSSD', required=True, type=str)
 	parser.add_argument('--chunk_size', required=True, type=str)
+	parser.add_argument('--tune', default="false", type=str, help='let flopoco pick chunk_size and has_HSSD for the frequency, candidates in S3FDP_tuning.csv')
 	return parser.parse_args()
 
 def get_bitwidths_and_type_from_ariths(args, arithmetic_in, arithmetic_out):
@@ -60,21 +61,37 @@ def get_bitwidths_and_type_from_ariths(args, arithmetic_in, arithmetic_out):
 """
 	@brief call flopoco and creates a SA depending on HW needed
 	@param the parameters as namespace
+	@return the generation report flopoco wrote for the SA and its sub-entities
 """
 def create_SA(args):
-	cmd = os.path.dirname(__file__) + "/libs/systolic_array/flopoco SystolicArray N={} M={} arithmetic_in={} arithmetic_out={} msb_summand={} lsb_summand={} nb_bits_ovf={} has_HSSD={} chunk_size={} frequency=270 target=VirtexUltrascalePlus name=SystolicArray".format(args.N,args.M,args.arithmetic_in,args.arithmetic_out,args.msb,args.lsb,args.bits_ovf,args.has_HSSD,args.chunk_size)
-	result = subprocess.check_output(cmd, shell=True, stderr=subprocess.STDOUT)
-	# print(result)
-	a = re.search("Entity l2a\n.*?(\d+)", result.decode("utf-8"), re.M)
-	b = re.search("Entity s3fdp\n.*?(\d+)", result.decode("utf-8"), re.M)
-	S3FDP_ppDepth = b.group(1)
-	try:
-		LAICPT2_to_arith_ppDepth = a.group(1)
-	except: # exact case has no pp as it does not exist
-		print("EXACT")
-		LAICPT2_to_arith_ppDepth = "0"
+	cmd = os.path.dirname(__file__) + "/libs/systolic_array/flopoco SystolicArray N={} M={} arithmetic_in={} arithmetic_out={} msb_summand={} lsb_summand={} nb_bits_ovf={} has_HSSD={} chunk_size={} tune={} frequency=270 target=VirtexUltrascalePlus report=flopoco_report.json name=SystolicArray".format(args.N,args.M,args.arithmetic_in,args.arithmetic_out,args.msb,args.lsb,args.bits_ovf,args.has_HSSD,args.chunk_size,args.tune)
+	subprocess.check_output(cmd, shell=True, stderr=subprocess.STDOUT)
+	with open("flopoco_report.json") as report_file:
+		return json.load(report_file)
+
+"""
+	@brief looks up an entity of the flopoco report by name, None if it was not generated
+"""
+def get_entity(report, name):
+	return next((e for e in report["entities"] if e["name"] == name), None)
+
+"""
+	@brief pipeline depths of the S3FDP and of LAICPT2_to_arith, the latter is combinatorial in the exact case
+"""
+def get_pp_depths(report):
+	S3FDP_ppDepth = str(get_entity(report, "s3fdp")["pipelineDepth"])
+	l2a = get_entity(report, "l2a")
+	LAICPT2_to_arith_ppDepth = str(l2a["pipelineDepth"]) if l2a is not None else "0"
 	return S3FDP_ppDepth, LAICPT2_to_arith_ppDepth
 
+"""
+	@brief element widths of the generated SA, read from the widths of its rowsA and colsC ports
+"""
+def get_bitwidths_from_report(args, report):
+	sa = get_entity(report, "SystolicArray")
+	ports = {p["name"]: p["width"] for p in sa["inputs"] + sa["outputs"]}
+	return ports["rowsA"] // int(args.N), ports["colsC"] // int(args.M)
+
 '''
 	@brief build strings of hexadecimal to inject as description registers to be fetch by software
 '''
@@ -102,6 +119,18 @@ def create_hexstrings(arith_type, N, M, arith_in_bitwidth, arith_in_param1, arit
 	print(str_action_type, str_action_version)
 	return str_action_type, str_action_version
 
+'''
+	@brief build the accumulator register, read by software to decode exact outputs
+'''
+def create_accum_hexstring(args):
+	exact = args.arithmetic_out.split(":")[0] == "exact"
+	ovf, msb, lsb = int(args.bits_ovf), int(args.msb), int(args.lsb)
+	if ovf < 0 or ovf > 127 or msb < -2048 or msb > 2047 or lsb < -2048 or lsb > 2047:
+		raise ValueError("the accumulator register holds 7 bits of ovf and 12 bit signed msb and lsb")
+	accum = (int(exact) << 31) | (ovf << 24) | ((msb & 0xfff) << 12) | (lsb & 0xfff)
+	str_accum = f"{accum:08x}"               # B3 exact output (7), ovf (6:0); B2..B0 msb (23:12), lsb (11:0)
+	return str_accum[:4] + "_" + str_accum[4:]
+
 
 
 def replace_templates(args, S3FDP_ppDepth, LAICPT2_to_arith_ppDepth, bitwidth_in, bitwidth_out, arith_type, arith_in_param1, arith_in_param2):
@@ -126,6 +155,7 @@ def replace_templates(args, S3FDP_ppDepth, LAICPT2_to_arith_ppDepth, bitwidth_in
 		orig_content = orig_file.read()
 		orig_content = orig_content.replace('[[HW_CONFIG_ACTION_TYPE]]', action_type)
 		orig_content = orig_content.replace('[[HW_CONFIG_ACTION_VERSION]]', action_version)
+		orig_content = orig_content.replace('[[HW_CONFIG_ACTION_ACCUM]]', create_accum_hexstring(args))
 		dest_content = orig_content
 		with open(os.path.dirname(__file__) + "/action_cgemm_capi3.vhd", "w") as dest_file:
 			dest_file.write(dest_content)
@@ -133,7 +163,9 @@ def replace_templates(args, S3FDP_ppDepth, LAICPT2_to_arith_ppDepth, bitwidth_in
 def main():
 	args = parse_args()
 	bitwidth_in, bitwidth_out, arith_type, arith_in_param1, arith_in_param2 = get_bitwidths_and_type_from_ariths(args, args.arithmetic_in, args.arithmetic_out)
-	S3FDP_ppDepth, LAICPT2_to_arith_ppDepth = create_SA(args)
+	report = create_SA(args)
+	S3FDP_ppDepth, LAICPT2_to_arith_ppDepth = get_pp_depths(report)
+	bitwidth_in, bitwidth_out = get_bitwidths_from_report(args, report)
 	replace_templates(args, S3FDP_ppDepth, LAICPT2_to_arith_ppDepth,bitwidth_in, bitwidth_out, arith_type, arith_in_param1, arith_in_param2)
 
 if __name__ == '__main__':
@@ -50,6 +50,7 @@ int main (int argc, char* argv[])
     struct snap_job cjob;
     struct action_job mjob;
     unsigned long timeout = 360;
+    int use_irq = 0;
     struct timeval etime, stime, etime1, stime1, etime2, stime2, etime3, stime3, etime0, stime0;
 
     int cmd;
@@ -65,8 +66,9 @@ int main (int argc, char* argv[])
      //       { "posit_width", required_argument, NULL, 'W' },
             { "path_in", required_argument, NULL, 'I' },
             { "path_out", required_argument, NULL, 'O' },
+            { "irq", no_argument, NULL, 'i' },
         };
-        cmd = getopt_long (argc, argv, "N:M:P:B:I:O:v", long_options, &option_index);
+        cmd = getopt_long (argc, argv, "N:M:P:B:I:O:vi", long_options, &option_index);
 
         if (cmd == -1) { /* all params processed ? */
             break;
@@ -102,6 +104,10 @@ int main (int argc, char* argv[])
            B = atoi(optarg);
            break;
 
+       case 'i':   /* wait for the done IRQ instead of polling */
+           use_irq = 1;
+           break;
+
         default:
             break;
         }
@@ -197,7 +203,7 @@ int main (int argc, char* argv[])
         __hexdump(stdout, mem_in, Data_Size_in);
     }
 
-    snap_action_flag_t action_irq = 0; //(SNAP_ACTION_DONE_IRQ | SNAP_ATTACH_IRQ); //no irq for now; snap_action_flag_t is an enum defined in snaplib
+    snap_action_flag_t action_irq = use_irq ? SNAP_ACTION_DONE_IRQ : 0; //snap_action_flag_t is an enum defined in snaplib
 
     // Offloading Action
     // Card Allocation
@@ -223,6 +229,9 @@ int main (int argc, char* argv[])
         VERBOSE0(stderr, "err: failed to attach action %u: %s\n", card_no, strerror(errno));
         goto out_error1;
     }
+    if (use_irq) {
+        snap_action_assign_irq(action, ACTION_IRQ_SRC_LO);
+    }
     gettimeofday(&etime2, NULL);
     VERBOSE3(stdout, "Action Attached Successfully\n");
 
@@ -297,6 +306,18 @@ int main (int argc, char* argv[])
               ((double)(total_arithmetic_ops)/((long long)timediff_usec(&etime,  &stime)))
             );
 
+    // Completion latency of the job, to compare polling and IRQ per size
+    uint64_t lat_hist[SNAP_LAT_BUCKETS];
+    snap_wait_mode_t wait_mode = use_irq ? SNAP_WAIT_IRQ : SNAP_WAIT_POLL;
+    if (snap_action_get_latency(action, wait_mode, lat_hist)) {
+        for (int b = 0; b < SNAP_LAT_BUCKETS; b++) {
+            if (lat_hist[b])
+                VERBOSE1(stdout, "%s completion in %llu..%llu usec\n",
+                         use_irq ? "irq" : "poll", b ? 1ull << b : 0ull,
+                         (1ull << (b + 1)) - 1);
+        }
+    }
+
     if (verbose_level > 2 ) {
         __hexdump(stdout, mem_out, Data_Size_out);
     }
@@ -6,6 +6,8 @@ from configs import configs
 # 1. copy recursively the oc-accel template into /tmp for each config in configs
 # 2. call action_config.sh in each of these folders to prepare the HW
 # 3. folders are ready to be sent (over SSH) to compute server (e.g. EPI) to build bitstreams
+# chunk_size and has_HSSD are not swept: the template sets tune="true" and flopoco leaves its pick and
+# the other candidates in hw/libs/systolic_array/S3FDP_tuning.csv of each folder
 
 cmd_cp_r = "cp -r ~/Documents/PhD/high_end/misc/oc-accel_template_for_bitstream_gen /tmp/SA_200_{}_{}_{}_{}_m{}_{}_HSSD" # N M arith_in msb lsb ovf
 cmd_prep_hw = '/tmp/SA_200_{}_{}_{}_{}_m{}_{}_HSSD/actions/cgemm/hw/action_config.sh'
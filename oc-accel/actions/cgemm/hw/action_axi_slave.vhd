@@ -18,6 +18,9 @@ entity action_axi_slave is
 		-- Users to add ports here
                 i_Action_Type    : in  std_logic_vector(31 downto 0);
                 i_Action_VER     : in  std_logic_vector(31 downto 0);
+                i_Action_Accum   : in  std_logic_vector(31 downto 0);
+                i_Action_Topology : in  std_logic_vector(31 downto 0);
+                i_Action_Alt_Formats : in  std_logic_vector(95 downto 0);
                 o_Context_ID     : buffer std_logic_vector(31 downto 0);
 
                 o_src_addr_h     : buffer std_logic_vector(31 downto 0);
@@ -31,6 +34,7 @@ entity action_axi_slave is
                 o_rd_burst_num   : buffer std_logic_vector(31 downto 0);
                 o_wr_burst_num   : buffer std_logic_vector(31 downto 0);
                 o_transfer_type  : buffer std_logic_vector(31 downto 0);
+                o_arith_format   : buffer std_logic_vector(31 downto 0);
 
                 o_int_enable     : out std_logic;
                 o_app_start      : out std_logic;
@@ -168,6 +172,7 @@ architecture action_axi_slave of action_axi_slave is
    constant C_RD_BURST_NUM_WR_Addr  : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_30";
    constant C_WR_BURST_NUM_WR_Addr  : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_34";
    constant C_TRANSFER_TYPE_WR_Addr : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_38";
+   constant C_ARITH_FORMAT_WR_Addr  : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_3C";
 
    constant C_CTRL_RETC_WR_Addr     : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_04";
 
@@ -185,8 +190,14 @@ architecture action_axi_slave of action_axi_slave is
    constant C_RD_BURST_NUM_RD_Addr  : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_B0";
    constant C_WR_BURST_NUM_RD_Addr  : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_B4";
    constant C_TRANSFER_TYPE_RD_Addr : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_B8";
+   constant C_ARITH_FORMAT_RD_Addr  : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_BC";
 
    constant C_CTRL_RETC_RD_Addr     : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_84";
+   constant C_Action_Accum_RD_Addr  : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_88";
+   constant C_Action_Topology_RD_Addr : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_8C";
+   constant C_Action_Alt1_RD_Addr   : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_C0";
+   constant C_Action_Alt2_RD_Addr   : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_C4";
+   constant C_Action_Alt3_RD_Addr   : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_01_C8";
 
    --Control MMIO
    constant C_Action_Control_Addr   : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0) := X"00_00_00_00";
@@ -313,6 +324,7 @@ begin
 	      o_rd_burst_num   <= (others => '0');
 	      o_wr_burst_num   <= (others => '0');
 	      o_transfer_type  <= (others => '0');
+	      o_arith_format   <= (others => '0');
 
 
 	    else
@@ -439,6 +451,13 @@ begin
 	                o_transfer_type(byte_index*8+7 downto byte_index*8) <= S_AXI_WDATA(byte_index*8+7 downto byte_index*8);
 	              end if;
 	            end loop;
+	          when C_ARITH_FORMAT_WR_Addr =>
+	            for byte_index in 0 to (C_S_AXI_DATA_WIDTH/8-1) loop
+	              if ( S_AXI_WSTRB(byte_index) = '1' ) then
+	                -- Respective byte enables are asserted as per write strobes
+	                o_arith_format(byte_index*8+7 downto byte_index*8) <= S_AXI_WDATA(byte_index*8+7 downto byte_index*8);
+	              end if;
+	            end loop;
 
 	          when others =>
 	            s_action_ctrl_W  <= s_action_ctrl_W;
@@ -456,6 +475,7 @@ begin
 	            o_rd_burst_num   <= o_rd_burst_num ;
 	            o_wr_burst_num   <= o_wr_burst_num ;
 	            o_transfer_type  <= o_transfer_type;
+	            o_arith_format   <= o_arith_format ;
 
 	        end case;
 	      end if;
@@ -629,8 +649,20 @@ begin
                   axi_rdata <= o_wr_burst_num;
                when C_TRANSFER_TYPE_RD_Addr =>
                   axi_rdata <= o_transfer_type;
+               when C_ARITH_FORMAT_RD_Addr  =>
+                  axi_rdata <= o_arith_format;
                when C_CTRL_RETC_RD_Addr =>
                   axi_rdata <= X"00_00_01_02";           -- 0x184
+               when C_Action_Accum_RD_Addr =>
+                  axi_rdata <= i_Action_Accum;           -- 0x188
+               when C_Action_Topology_RD_Addr =>
+                  axi_rdata <= i_Action_Topology;        -- 0x18C
+               when C_Action_Alt1_RD_Addr =>
+                  axi_rdata <= i_Action_Alt_Formats(31 downto 0);   -- 0x1C0
+               when C_Action_Alt2_RD_Addr =>
+                  axi_rdata <= i_Action_Alt_Formats(63 downto 32);  -- 0x1C4
+               when C_Action_Alt3_RD_Addr =>
+                  axi_rdata <= i_Action_Alt_Formats(95 downto 64);  -- 0x1C8
                when others =>
                   axi_rdata  <= (others => '0');
             end case;
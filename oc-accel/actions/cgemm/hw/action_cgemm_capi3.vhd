@@ -153,6 +153,7 @@ architecture action_cgemm_capi3 of action_cgemm_capi3 is
         sow_i  : in std_logic;
         eow_dma_i  : in std_logic;
         data_i : in std_logic_vector(DATA_WIDTH-1 downto 0);
+        format_i : in std_logic_vector(1 downto 0);
 
         -- MASTER SIDE
         rtr_i  : in std_logic;
@@ -179,6 +180,7 @@ architecture action_cgemm_capi3 of action_cgemm_capi3 is
         signal s_rd_burst_num   : std_logic_vector(31 downto 0);
         signal s_wr_burst_num   : std_logic_vector(31 downto 0);
         signal s_transfer_type  : std_logic_vector(31 downto 0);
+        signal s_arith_format   : std_logic_vector(31 downto 0);
         signal int_enable       : std_logic;
         signal app_start        : std_logic;
         signal app_done         : std_logic;
@@ -273,8 +275,11 @@ action_axi_slave_inst : entity work.action_axi_slave
     port map (
         -- User ports begin
         o_int_enable            => int_enable,
-        i_Action_Type           => x"8604_0300",     -- B3=action type; B2=undefined; B1=arith type (0 ieee, 1 tfp, 2 bf16, 3 posit); B0=accum type (0 alpha,1 beta,2 gamma,3 custom)
+        i_Action_Type           => x"8604_0310",     -- B3=action type; B2=undefined; B1=arith type (0 ieee, 1 tfp, 2 bf16, 3 posit); B0=engines (7:4, 0 reads as 1), accum type (3:0: 0 alpha,1 beta,2 gamma,3 custom)
         i_Action_VER            => x"201f_0400",  -- B3=N; B2=M; B1=param1 arith; B0=param2 arith
+        i_Action_Accum          => x"0000_0000",  -- B3=exact output (7), nb_bits_ovf (6:0); B2..B0=msb_summand (23:12), lsb_summand (11:0), signed
+        i_Action_Topology       => x"0000_0000",  -- B3=weight stationary (7); B2..B0=b_depth (23:0), k steps of B it holds
+        i_Action_Alt_Formats    => x"0000_0000_0000_0000_0000_0000", -- per alternate format f at 32*(f-1): B3=arith type; B2=arith bitwidth; B1=param1 arith; B0=param2 arith; 0 when absent
         o_Context_ID            => s_Context_ID,
 
         o_app_start             => app_start,
@@ -291,6 +296,7 @@ action_axi_slave_inst : entity work.action_axi_slave
         o_rd_burst_num          => s_rd_burst_num,
         o_wr_burst_num          => s_wr_burst_num,
         o_transfer_type         => s_transfer_type,
+        o_arith_format          => s_arith_format,
 
         -- User ports ends
         S_AXI_ACLK  => action_clk,
@@ -520,6 +526,12 @@ action_dma_axi_master_inst : entity work.action_axi_master
                     dma_wr_req    <= dest_host;
                     dma_wr_bready <= dest_host;
                     wr_gate       <= '1';
+                    -- a K-chunk ending inside a block leaves its sums in the
+                    -- array and has nothing to write
+                    if or_reduce(s_dst_data_size(31 downto 7)) = '0' then
+                      dma_wr_req       <= '0';
+                      wr_requests_done <= '1';
+                    end if;
                     fsm_copy_q    <= PROCESS_COPY;
                   end if;
 
@@ -610,6 +622,7 @@ action_dma_axi_master_inst : entity work.action_axi_master
             sow_i  => '0',
             eow_dma_i => eow_dma,
             data_i => dma_rd_data,
+            format_i => s_arith_format(1 downto 0),
 
             -- MASTER SIDE
             rtr_i => dma_wr_ready,
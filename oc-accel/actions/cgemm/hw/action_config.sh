@@ -10,6 +10,24 @@ lsb="-4"
 bits_ovf="5"
 has_HSSD="true"
 chunk_size="-1"
+# "true" lets flopoco pick chunk_size and has_HSSD for the frequency over the two above,
+# all candidates with their estimated paths and resources go to S3FDP_tuning.csv
+tune="false"
+# systolic arrays side by side on the bus, engines*(N+M)*bits must fit 1022 bits
+engines="1"
+# orthogonal streams A and B, weight_stationary preloads b_depth k steps of B
+# and streams A only, engines*N*bits must then fit 1021 bits
+topology="orthogonal"
+b_depth="1024"
+# adjacent columns per PE whose significand products share one multiplier (one DSP for small
+# significands), divides M
+packing="1"
+# input arithmetics a job can select instead of arithmetic_in, plus-separated, e.g.
+# "bfloat16+posit:16:1", none wider than arithmetic_in; outputs stay in arithmetic_out
+arithmetic_alt="none"
+# delay coefficients of the target fitted on the timing reports of earlier bitstreams by
+# flopoco/tools/vivado-calibrate.py, "none" keeps the hand-set ones
+profile="none"
 
 # Some addtional code generation or automation taks can be put here.
 echo "                        action config says ACTION_ROOT is $ACTION_ROOT"
@@ -23,6 +41,13 @@ echo "                        action config says lsb is $lsb"
 echo "                        action config says bits_ovf is $bits_ovf"
 echo "                        action config says has_HSSD is $has_HSSD"
 echo "                        action config says chunk_size is $chunk_size"
+echo "                        action config says tune is $tune"
+echo "                        action config says engines is $engines"
+echo "                        action config says topology is $topology"
+echo "                        action config says b_depth is $b_depth"
+echo "                        action config says packing is $packing"
+echo "                        action config says arithmetic_alt is $arithmetic_alt"
+echo "                        action config says profile is $profile"
 
 if [ ! -d $ACTION_ROOT/ip/action_ip_dir ]; then
 	echo "                        Call create_action_ip.tcl to generate IPs"
@@ -30,8 +55,9 @@ if [ ! -d $ACTION_ROOT/ip/action_ip_dir ]; then
 fi
 
 echo "                        CREATING SA"
-python3 ./prepare_hw.py --N $N --M $M --arithmetic_in $arithmetic_in --arithmetic_out $arithmetic_out --msb $msb --lsb $lsb --bits_ovf $bits_ovf --has_HSSD $has_HSSD --chunk_size $chunk_size
-mv flopoco.vhdl $ACTION_ROOT/hw/libs/systolic_array/
+python3 ./prepare_hw.py --N $N --M $M --arithmetic_in $arithmetic_in --arithmetic_out $arithmetic_out --msb $msb --lsb $lsb --bits_ovf $bits_ovf --has_HSSD $has_HSSD --chunk_size $chunk_size --tune $tune --engines $engines --topology $topology --b_depth $b_depth --packing $packing --arithmetic_alt $arithmetic_alt --profile $profile
+mv flopoco.vhdl flopoco_report.json $ACTION_ROOT/hw/libs/systolic_array/
+if [ -f S3FDP_tuning.csv ]; then mv S3FDP_tuning.csv $ACTION_ROOT/hw/libs/systolic_array/; fi
 
 echo "                        CLEANING TEMP FILES"
 rm -r $ACTION_ROOT/hw/dot
@@ -8,6 +8,19 @@
 // Create Date: 22/09/2022
 // Description: axi stream sv wrapper +
 //  assuming N + M arithmetic dense words fit in the 512b bus or 1024. Depending CAPI2 or CAPI3
+//  ENGINES arrays run side by side, engine e takes lane e of every bus word
+//  (N+M words at e*(N+M)*ARITH_IN_WIDTH) and drives lane e of every output word
+//  (M words at e*M*ARITH_OUT_WIDTH). SOB and EOB are shared, so every lane of a
+//  block gets the same number of words: the host gives each engine its own tile
+//  of C over the whole of k with rounded outputs, or its own segment of k with
+//  exact ones, and leaves zero the lanes past the last tile and the steps past k
+//  With STATIONARY=1 the arrays are weight stationary: words flagged LDB carry
+//  one k step of the B band (M words at 0), shared by all the engines, which
+//  store it; the other words carry one k step of A only, engine e taking the N
+//  words at e*N*ARITH_IN_WIDTH, and each engine reads B back from its buffer
+//  format_i comes from the job register 0x13C and selects the input format of
+//  all the arrays for the job: 0 for arithmetic_in, f for alternate format f,
+//  whose elements sit in the low bits of the ARITH_IN_WIDTH slots
 //
 //////////////////////////////////////////////////////////////////////////////////
 
@@ -30,6 +43,8 @@ module my_sv_wrapper #
     input  wire eow_dma_i,
     // data in
     input wire [DATA_WIDTH-1:0] data_i,
+    // input format of the job
+    input wire [1:0] format_i,
 
     // MASTER SIDE
 
@@ -45,11 +60,15 @@ localparam integer ARITH_IN_WIDTH = 4;
 localparam integer ARITH_OUT_WIDTH = 4;
 localparam integer N = 32;
 localparam integer M = 31;
+localparam integer ENGINES = 1;
+localparam integer STATIONARY = 0;
 // this number exists only after a flopoco run
 localparam integer S3FDP_PP_DEPTH = 1;
 localparam integer L2A_PP_DEPTH = 1;
 localparam integer FIFO_DEPTH = 1024;
-localparam integer OUT_WIDTH = M*ARITH_OUT_WIDTH;
+localparam integer LANE_IN_WIDTH = STATIONARY ? N*ARITH_IN_WIDTH : (N+M)*ARITH_IN_WIDTH;
+localparam integer LANE_OUT_WIDTH = M*ARITH_OUT_WIDTH;
+localparam integer OUT_WIDTH = ENGINES*LANE_OUT_WIDTH;
 localparam integer FIFO_WIDTH = OUT_WIDTH;
 
 // signals
@@ -58,9 +77,10 @@ localparam integer FIFO_WIDTH = OUT_WIDTH;
 logic [DATA_WIDTH-1:0] sa_data_i;
 logic [OUT_WIDTH-1:0] sa_data_o;
 logic sa_eob;
-logic sa_eob_q;
+logic [ENGINES-1:0] sa_eob_q;
 logic sa_valid_o;
 logic sa_sob;
+logic sa_ldb;
 
 // FIFO
 logic [OUT_WIDTH-1:0] fifo_data_o;
@@ -75,31 +95,61 @@ assign rtr_o = rtr_i;
 assign sa_data_i = (rts_i & rtr_o) ? data_i : {DATA_WIDTH{1'b0}};
 assign sa_eob = sa_data_i[DATA_WIDTH-1];
 assign sa_sob = sa_data_i[DATA_WIDTH-2];
+assign sa_ldb = sa_data_i[DATA_WIDTH-3];
 
 //    _____ ___
 //   / ___//   |
 //   \__ \/ /| |
 //  ___/ / ___ |
 // /____/_/  |_|
+genvar e;
+generate
+for (e = 0; e < ENGINES; e = e + 1) begin : engine
+if (STATIONARY) begin : ws
 SystolicArray sa_inst (
 
     // System
-    .clk     ( clk                                            ),
-    .rst     ( ~rst_n                                         ),
+    .clk     ( clk                                                       ),
+    .rst     ( ~rst_n                                                    ),
 
     // IOs
-    .rowsA   ( sa_data_i[(N*ARITH_IN_WIDTH)-1:0]                 ),
-    .colsB   ( sa_data_i[((M+N)*ARITH_IN_WIDTH)-1:N*ARITH_IN_WIDTH] ),
-    .SOB     ( sa_sob                                         ),
-    .EOB     ( sa_eob                                         ),
-    .colsC   ( sa_data_o                                      ),
-    .EOB_Q_o ( sa_eob_q                                       )
+    .rowsA   ( sa_data_i[e*LANE_IN_WIDTH +: N*ARITH_IN_WIDTH]               ),
+    .colsB   ( sa_data_i[0 +: M*ARITH_IN_WIDTH]                            ),
+    .SOB     ( sa_sob                                                    ),
+    .EOB     ( sa_eob                                                    ),
+    .FORMAT  ( format_i                                                  ),
+    .LDB     ( sa_ldb                                                    ),
+    .VALID   ( rts_i & rtr_o                                             ),
+    .colsC   ( sa_data_o[e*LANE_OUT_WIDTH +: LANE_OUT_WIDTH]             ),
+    .EOB_Q_o ( sa_eob_q[e]                                               )
 
 );
+end
+else begin : orthogonal
+SystolicArray sa_inst (
+
+    // System
+    .clk     ( clk                                                       ),
+    .rst     ( ~rst_n                                                    ),
+
+    // IOs
+    .rowsA   ( sa_data_i[e*LANE_IN_WIDTH +: N*ARITH_IN_WIDTH]               ),
+    .colsB   ( sa_data_i[e*LANE_IN_WIDTH+N*ARITH_IN_WIDTH +: M*ARITH_IN_WIDTH] ),
+    .SOB     ( sa_sob                                                    ),
+    .EOB     ( sa_eob                                                    ),
+    .FORMAT  ( format_i                                                  ),
+    .colsC   ( sa_data_o[e*LANE_OUT_WIDTH +: LANE_OUT_WIDTH]             ),
+    .EOB_Q_o ( sa_eob_q[e]                                               )
+
+);
+end
+end
+endgenerate
 
 // valid_o from systolic array logic
 // we will create a shift register of size N+2+PP_DEPTH(S3FDP)-1+PP_DEPTH(L2A)
-// we connect the eob_q of PE(N-1,M-1) as the input bit
+// we connect the eob_q of PE(N-1,M-1) of engine 0 as the input bit, the
+// engines share SOB and EOB so engine 0 drains with all of them
 // the OR reduction from the N MSB bits are the valid signal
 localparam integer size = N+2+S3FDP_PP_DEPTH+L2A_PP_DEPTH-1;
 logic [size-1:0] shift_register;
@@ -108,7 +158,7 @@ always_ff @(posedge clk or negedge rst_n) begin
 		shift_register <= 0;
 	end
 	else begin
-		shift_register <= {shift_register[size-2:0],sa_eob_q};
+		shift_register <= {shift_register[size-2:0],sa_eob_q[0]};
 	end
 end
 assign sa_valid_o = |shift_register[(size-2) -: N];
@@ -1,6 +1,6 @@
 #!/usr/bin/env python
 import argparse
-import re
+import json
 import subprocess
 from datetime import date
 
@@ -15,6 +15,13 @@ def parse_args():
 	parser.add_argument('--bits_ovf', required=True, type=str)
 	parser.add_argument('--has_HSSD', required=True, type=str)
 	parser.add_argument('--chunk_size', required=True, type=str)
+	parser.add_argument('--tune', default="false", type=str, help='let flopoco pick chunk_size and has_HSSD for the frequency, candidates in S3FDP_tuning.csv')
+	parser.add_argument('--engines', default="1", type=str, help='number of systolic arrays sharing the bus')
+	parser.add_argument('--topology', default="orthogonal", choices=["orthogonal", "weight_stationary"], help='weight_stationary preloads B and streams A only')
+	parser.add_argument('--b_depth', default="1024", type=str, help='k steps of B a weight stationary array holds, a power of two')
+	parser.add_argument('--packing', default="1", type=str, help='adjacent columns per PE sharing one significand multiplier, divides M')
+	parser.add_argument('--profile', default="none", type=str, help='target profile of delay coefficients fitted by flopoco/tools/vivado-calibrate.py')
+	parser.add_argument('--arithmetic_alt', default="none", type=str, help='plus-separated input arithmetics a job can select instead of arithmetic_in, none wider than it')
 	return parser.parse_args()
 
 def get_bitwidths_and_type_from_ariths(args, arithmetic_in, arithmetic_out):
@@ -56,28 +63,69 @@ def get_bitwidths_and_type_from_ariths(args, arithmetic_in, arithmetic_out):
 
 	return bitwidth_in, bitwidth_out, arith_type, int(array_arith_in[1]), int(array_arith_in[2])
 
+"""
+	@brief checks that the lanes of all engines fit the bus, the two top bits are SOB and EOB
+	and the third one LDB for weight stationary arrays, whose lanes hold A only
+"""
+def check_engines(args, bitwidth_in, bitwidth_out, data_width):
+	engines = int(args.engines)
+	if args.topology == "weight_stationary":
+		flags = 3
+		lanes_in = max(engines * int(args.N), int(args.M)) * bitwidth_in
+		b_depth = int(args.b_depth)
+		if b_depth < 2 or b_depth & (b_depth - 1) or b_depth >= 1 << 24:
+			raise ValueError("b_depth must be a power of two, 2 to 2^23")
+	else:
+		flags = 2
+		lanes_in = engines * (int(args.N) + int(args.M)) * bitwidth_in
+	lanes_out = engines * int(args.M) * bitwidth_out
+	if engines < 1 or engines > 15:
+		raise ValueError("engines must be 1 to 15")
+	if lanes_in > data_width - flags:
+		raise ValueError("{} engines need {} input bits, the bus has {}".format(engines, lanes_in, data_width - flags))
+	if lanes_out > data_width:
+		raise ValueError("{} engines need {} output bits, the bus has {}".format(engines, lanes_out, data_width))
+
 """
 	@brief call flopoco and creates a SA depending on HW needed
 	@param the parameters as namespace
+	@return the generation report flopoco wrote for the SA and its sub-entities
 """
 def create_SA(args):
-	cmd = "./libs/systolic_array/flopoco SystolicArray N={} M={} arithmetic_in={} arithmetic_out={} msb_summand={} lsb_summand={} nb_bits_ovf={} has_HSSD={} chunk_size={} frequency=200 target=VirtexUltrascalePlus name=SystolicArray".format(args.N,args.M,args.arithmetic_in,args.arithmetic_out,args.msb,args.lsb,args.bits_ovf,args.has_HSSD,args.chunk_size)
-	result = subprocess.check_output(cmd, shell=True, stderr=subprocess.STDOUT)
-	# print(result)
-	a = re.search("Entity l2a\n.*?(\d+)", result.decode("utf-8"), re.M)
-	b = re.search("Entity s3fdp\n.*?(\d+)", result.decode("utf-8"), re.M)
-	S3FDP_ppDepth = b.group(1)
-	try:
-		LAICPT2_to_arith_ppDepth = a.group(1)
-	except: # exact case has no pp as it does not exist
-		print("EXACT")
-		LAICPT2_to_arith_ppDepth = "0"
+	cmd = "./libs/systolic_array/flopoco SystolicArray N={} M={} arithmetic_in={} arithmetic_out={} msb_summand={} lsb_summand={} nb_bits_ovf={} has_HSSD={} chunk_size={} tune={} topology={} b_depth={} packing={} arithmetic_alt={} frequency=200 target=VirtexUltrascalePlus report=flopoco_report.json name=SystolicArray".format(args.N,args.M,args.arithmetic_in,args.arithmetic_out,args.msb,args.lsb,args.bits_ovf,args.has_HSSD,args.chunk_size,args.tune,args.topology,args.b_depth,args.packing,args.arithmetic_alt)
+	if args.profile != "none":
+		cmd += " profile={}".format(args.profile)
+	subprocess.check_output(cmd, shell=True, stderr=subprocess.STDOUT)
+	with open("flopoco_report.json") as report_file:
+		return json.load(report_file)
+
+"""
+	@brief looks up an entity of the flopoco report by name, None if it was not generated
+"""
+def get_entity(report, name):
+	return next((e for e in report["entities"] if e["name"] == name), None)
+
+"""
+	@brief pipeline depths of the S3FDP and of LAICPT2_to_arith, the latter is combinatorial in the exact case
+"""
+def get_pp_depths(report):
+	S3FDP_ppDepth = str(get_entity(report, "s3fdp")["pipelineDepth"])
+	l2a = get_entity(report, "l2a")
+	LAICPT2_to_arith_ppDepth = str(l2a["pipelineDepth"]) if l2a is not None else "0"
 	return S3FDP_ppDepth, LAICPT2_to_arith_ppDepth
 
+"""
+	@brief element widths of the generated SA, read from the widths of its rowsA and colsC ports
+"""
+def get_bitwidths_from_report(args, report):
+	sa = get_entity(report, "SystolicArray")
+	ports = {p["name"]: p["width"] for p in sa["inputs"] + sa["outputs"]}
+	return ports["rowsA"] // int(args.N), ports["colsC"] // int(args.M)
+
 '''
 	@brief build strings of hexadecimal to inject as description registers to be fetch by software
 '''
-def create_hexstrings(arith_type, N, M, arith_in_bitwidth, arith_in_param1, arith_in_param2):
+def create_hexstrings(arith_type, N, M, arith_in_bitwidth, arith_in_param1, arith_in_param2, engines):
 	str_action_type = ""
 	str_action_version = ""
 	str_arith_type = f"{arith_type:02x}"
@@ -90,7 +138,7 @@ def create_hexstrings(arith_type, N, M, arith_in_bitwidth, arith_in_param1, arit
 	str_action_type += str_arith_in_bitwidth  # B2 is arith_bitwidth in bits
 	str_action_type += "_"
 	str_action_type += str_arith_type         # B1 arith type
-	str_action_type += "00"                   # B0 accum type
+	str_action_type += f"{engines:x}0"         # B0 engines (7:4), accum type (3:0)
 
 	str_action_version += f"{N:02x}"          # B3 systolic N dimensions
 	str_action_version += f"{M:02x}"          # B2 systolic N dimensions
@@ -101,6 +149,42 @@ def create_hexstrings(arith_type, N, M, arith_in_bitwidth, arith_in_param1, arit
 	print(str_action_type, str_action_version)
 	return str_action_type, str_action_version
 
+'''
+	@brief build the accumulator register, read by software to decode exact outputs
+'''
+def create_accum_hexstring(args):
+	exact = args.arithmetic_out.split(":")[0] == "exact"
+	ovf, msb, lsb = int(args.bits_ovf), int(args.msb), int(args.lsb)
+	if ovf < 0 or ovf > 127 or msb < -2048 or msb > 2047 or lsb < -2048 or lsb > 2047:
+		raise ValueError("the accumulator register holds 7 bits of ovf and 12 bit signed msb and lsb")
+	accum = (int(exact) << 31) | (ovf << 24) | ((msb & 0xfff) << 12) | (lsb & 0xfff)
+	str_accum = f"{accum:08x}"               # B3 exact output (7), ovf (6:0); B2..B0 msb (23:12), lsb (11:0)
+	return str_accum[:4] + "_" + str_accum[4:]
+
+'''
+	@brief build the topology register, read by software to pack the stream: 0 for orthogonal arrays
+'''
+def create_topology_hexstring(args):
+	stationary = args.topology == "weight_stationary"
+	topology = (int(stationary) << 31) | (int(args.b_depth) if stationary else 0)
+	str_topology = f"{topology:08x}"         # B3 weight stationary (7); B2..B0 b_depth (23:0)
+	return str_topology[:4] + "_" + str_topology[4:]
+
+'''
+	@brief build the alternate formats registers, format f at 32*(f-1), read by software to pack
+	the elements of a job run in format f; 0 when there is no format f
+'''
+def create_alt_formats_hexstring(args):
+	alternates = [] if args.arithmetic_alt == "none" else args.arithmetic_alt.split("+")
+	if len(alternates) > 3:
+		raise ValueError("at most 3 alternate arithmetics")
+	formats = [0, 0, 0]
+	for f, alternate in enumerate(alternates):
+		bitwidth, _, arith_type, param1, param2 = get_bitwidths_and_type_from_ariths(args, alternate, "same")
+		formats[f] = (arith_type << 24) | (bitwidth << 16) | (param1 << 8) | param2  # B3 arith type; B2 bitwidth; B1 param1; B0 param2
+	str_formats = "".join(f"{word:08x}" for word in reversed(formats))
+	return "_".join(str_formats[i:i+4] for i in range(0, len(str_formats), 4))
+
 
 
 def replace_templates(args, S3FDP_ppDepth, LAICPT2_to_arith_ppDepth, bitwidth_in, bitwidth_out, arith_type, arith_in_param1, arith_in_param2):
@@ -114,17 +198,22 @@ def replace_templates(args, S3FDP_ppDepth, LAICPT2_to_arith_ppDepth, bitwidth_in
 		orig_content = orig_content.replace('[[HW_CONFIG_ARITH_OUT_WIDTH]]',str(bitwidth_out))
 		orig_content = orig_content.replace('[[HW_CONFIG_SA_N]]', args.N)
 		orig_content = orig_content.replace('[[HW_CONFIG_SA_M]]', args.M)
+		orig_content = orig_content.replace('[[HW_CONFIG_SA_ENGINES]]', args.engines)
+		orig_content = orig_content.replace('[[HW_CONFIG_SA_STATIONARY]]', str(int(args.topology == "weight_stationary")))
 		orig_content = orig_content.replace('[[HW_CONFIG_S3FDP_PP_DEPTH]]', S3FDP_ppDepth)
 		orig_content = orig_content.replace('[[HW_CONFIG_L2A_PP_DEPTH]]', LAICPT2_to_arith_ppDepth)
 		dest_content = orig_content
 		with open("./my_sv_wrapper.sv", "w") as dest_file:
 			dest_file.write(dest_content)
 
-	action_type, action_version = create_hexstrings(arith_type, int(args.N), int(args.M), bitwidth_in, arith_in_param1, arith_in_param2)
+	action_type, action_version = create_hexstrings(arith_type, int(args.N), int(args.M), bitwidth_in, arith_in_param1, arith_in_param2, int(args.engines))
 	with open("./action_cgemm_capi3.vhd.template") as orig_file:
 		orig_content = orig_file.read()
 		orig_content = orig_content.replace('[[HW_CONFIG_ACTION_TYPE]]', action_type)
 		orig_content = orig_content.replace('[[HW_CONFIG_ACTION_VERSION]]', action_version)
+		orig_content = orig_content.replace('[[HW_CONFIG_ACTION_ACCUM]]', create_accum_hexstring(args))
+		orig_content = orig_content.replace('[[HW_CONFIG_ACTION_TOPOLOGY]]', create_topology_hexstring(args))
+		orig_content = orig_content.replace('[[HW_CONFIG_ACTION_ALT_FORMATS]]', create_alt_formats_hexstring(args))
 		dest_content = orig_content
 		with open("./action_cgemm_capi3.vhd", "w") as dest_file:
 			dest_file.write(dest_content)
@@ -132,7 +221,10 @@ def replace_templates(args, S3FDP_ppDepth, LAICPT2_to_arith_ppDepth, bitwidth_in
 def main():
 	args = parse_args()
 	bitwidth_in, bitwidth_out, arith_type, arith_in_param1, arith_in_param2 = get_bitwidths_and_type_from_ariths(args, args.arithmetic_in, args.arithmetic_out)
-	S3FDP_ppDepth, LAICPT2_to_arith_ppDepth = create_SA(args)
+	report = create_SA(args)
+	S3FDP_ppDepth, LAICPT2_to_arith_ppDepth = get_pp_depths(report)
+	bitwidth_in, bitwidth_out = get_bitwidths_from_report(args, report)
+	check_engines(args, bitwidth_in, bitwidth_out, 1024)  # hardcoded 1024 at the moment
 	replace_templates(args, S3FDP_ppDepth, LAICPT2_to_arith_ppDepth,bitwidth_in, bitwidth_out, arith_type, arith_in_param1, arith_in_param2)
 
 if __name__ == '__main__':
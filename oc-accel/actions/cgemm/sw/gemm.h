@@ -10,6 +10,10 @@ extern "C" {
 /* This number is unique and is declared in ~snap/ActionTypes.md */
 #define ACTION_TYPE 0x86868604
 
+/* read only, bit 31 set when the arrays are weight stationary */
+#define ACTION_TOPOLOGY_REG 0x18C
+#define GEMM_TOPOLOGY_WS 0x80000000
+
 static int verbose_level = 0;
 
 #define VERBOSE0(file, fmt, ...) do {       \
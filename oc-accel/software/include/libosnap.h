@@ -290,6 +290,46 @@ int snap_action_completed (struct snap_action* action, int* rc,
 int snap_action_wait_interrupt (struct snap_action* action, int* rc, int timeout);
 int snap_action_assign_irq (struct snap_action* action, uint32_t action_irq_ea_reg_addr);
 
+/*
+ * Tuning of snap_action_completed() without SNAP_ACTION_DONE_IRQ. The
+ * action is polled back to back for spin_us, then with sleeps starting at
+ * sleep_min_us and doubling up to sleep_max_us. Defaults are 100, 10 and
+ * 1000 usec, or SNAP_POLL_SPIN_US, SNAP_POLL_SLEEP_MIN_US and
+ * SNAP_POLL_SLEEP_MAX_US from the environment.
+ */
+struct snap_poll_cfg {
+    unsigned int spin_us;
+    unsigned int sleep_min_us;
+    unsigned int sleep_max_us;
+};
+
+int snap_action_set_poll (struct snap_action* action,
+                          const struct snap_poll_cfg* cfg);
+int snap_action_get_poll (struct snap_action* action,
+                          struct snap_poll_cfg* cfg);
+
+/*
+ * Completion latency, from snap_action_start() until snap_action_completed()
+ * sees the action idle, per wait mode. Bucket b counts latencies of 2^b up
+ * to 2^(b+1)-1 usec, bucket 0 also the ones below 1 usec. SNAP_TRACE=0x80
+ * prints the histograms when the card is freed.
+ *
+ * @hist        SNAP_LAT_BUCKETS counters to fill, may be NULL.
+ * @return      number of completions counted for mode.
+ */
+#define SNAP_LAT_BUCKETS 32
+
+typedef enum snap_wait_mode {
+    SNAP_WAIT_POLL = 0,             /* Polled ACTION_CONTROL */
+    SNAP_WAIT_IRQ = 1,              /* Waited for the action done IRQ */
+    SNAP_WAIT_MODES = 2
+} snap_wait_mode_t;
+
+uint64_t snap_action_get_latency (struct snap_action* action,
+                                  snap_wait_mode_t mode,
+                                  uint64_t hist[SNAP_LAT_BUCKETS]);
+void snap_action_reset_latency (struct snap_action* action);
+
 /**
  * Synchronous way to send a job away.  First step : set registers
  * This function writes through MMIO interface the registers
@@ -23,6 +23,7 @@
 #include <errno.h>
 #include <endian.h>
 #include <sys/time.h>
+#include <time.h>
 
 #include <libosnap.h>
 #include <libocxl.h>
@@ -120,6 +121,16 @@ struct snap_card {
     unsigned int queue_length;      /* unused */
     uint64_t cap_reg;               /* Capability Register */
     const char* name;               /* Card name */
+    struct snap_poll_cfg poll;      /* Completion poller tuning */
+    uint64_t start_us;              /* Time of the last snap_action_start */
+    uint64_t lat_hist[SNAP_WAIT_MODES][SNAP_LAT_BUCKETS];
+};
+
+/* Poller defaults, SNAP_POLL_* in the environment override them */
+static struct snap_poll_cfg snap_poll_default = {
+    .spin_us = 100,
+    .sleep_min_us = 10,
+    .sleep_max_us = 1000,
 };
 
 /* Translate Card ID to Name */
@@ -156,16 +167,52 @@ static const char* snap_card_id_2_name (int card_id)
 }
 
 
-/*        Get Time in msec */
-static unsigned long tget_ms (void)
+/*        Get monotonic Time in usec */
+static uint64_t tget_us (void)
+{
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+static void snap_sleep_us (unsigned int usec)
+{
+    struct timespec ts;
+
+    ts.tv_sec = usec / 1000000;
+    ts.tv_nsec = (long) (usec % 1000000) * 1000;
+    nanosleep (&ts, NULL);
+}
+
+/* Count one completion in bucket log2(usec) of the mode's histogram */
+static void snap_lat_record (struct snap_card* card, snap_wait_mode_t mode,
+                             uint64_t usec)
 {
-    struct timeval now;
-    unsigned long tms;
+    int b = 63 - __builtin_clzll (usec | 1);
+
+    if (b >= SNAP_LAT_BUCKETS) {
+        b = SNAP_LAT_BUCKETS - 1;
+    }
+
+    card->lat_hist[mode][b]++;
+}
 
-    gettimeofday (&now, NULL);
-    tms = (unsigned long) (now.tv_sec * 1000) +
-          (unsigned long) (now.tv_usec / 1000);
-    return tms;
+static void snap_lat_print (struct snap_card* card, FILE* fp)
+{
+    static const char* mode_name[SNAP_WAIT_MODES] = { "poll", "irq" };
+    int m, b;
+
+    for (m = 0; m < SNAP_WAIT_MODES; m++) {
+        for (b = 0; b < SNAP_LAT_BUCKETS; b++) {
+            if (card->lat_hist[m][b]) {
+                fprintf (fp, "  %-4s %8llu .. %8llu usec: %llu\n",
+                         mode_name[m], b ? 1ull << b : 0ull,
+                         (1ull << (b + 1)) - 1,
+                         (unsigned long long)card->lat_hist[m][b]);
+            }
+        }
+    }
 }
 
 static void* hw_snap_card_alloc_dev (const char* path,
@@ -201,6 +248,7 @@ static void* hw_snap_card_alloc_dev (const char* path,
         goto __snap_alloc_err;
     }
 
+    dn->poll = snap_poll_default;
     dn->sat = INVALID_SAT;        // Invalid Short Action Type stands for not attached
     dn->action_type = 0xffffffff;
     dn->vendor_id = vendor_id;
@@ -345,6 +393,11 @@ static void hw_snap_card_free (struct snap_card* card)
         return;
     }
 
+    if (stat_trace_enabled()) {
+        fprintf (stderr, "%s: completion latency\n", card->name);
+        snap_lat_print (card, stderr);
+    }
+
     if (card->errinfo) {
         __free (card->errinfo);
         card->errinfo = NULL;
@@ -358,10 +411,13 @@ static void hw_snap_card_free (struct snap_card* card)
     __free (card);
 }
 
-//FIXME: irq procedure needs to be revised
+/* Wait up to timeout_sec for the action IRQ, a negative timeout waits forever */
 static int hw_wait_irq (struct snap_card* card, int timeout_sec/*, int expect_irq*/)
 {
     int rc = 0;
+    uint16_t events;
+    int timeout_ms = (timeout_sec < 0) ? -1 : timeout_sec * 1000;
+    uint64_t t0 = tget_us();
 
     snap_trace ("  %s: Enter fd: %d Flags: 0x%x  Timeout: %d sec\n",
                 __func__, card->afu_fd,
@@ -369,9 +425,15 @@ static int hw_wait_irq (struct snap_card* card, int timeout_sec/*, int expect_ir
 
 __hw_wait_irq_retry:
 
-    if (!ocxl_afu_event_check (card->afu_h, -1, &card->event, 1)) {
-	rc = EINTR;
+    events = ocxl_afu_event_check (card->afu_h, timeout_ms, &card->event, 1);
+
+    if (events == 0) {
+        rc = ETIME;
         snap_trace ("    Timeout......\n");
+    } else if (events == (uint16_t)-1) {
+        /* ocxl_afu_event_check() returns uint16_t, -1 arrives as 0xffff */
+        rc = EINTR;
+        snap_trace ("    Event check failed......\n");
     } else {
         snap_trace ("    Event is Pending ......\n");
     }
@@ -390,6 +452,18 @@ __hw_wait_irq_retry:
             if (card->irq_ea != card->event.irq.handle) {
                 snap_trace ("  %s:     Wrong IRQ.. Retry ! Get: %lx, expect: %lx\n", __func__,
                         card->event.irq.handle, card->irq_ea);
+
+                /* Only wait for what is left of the timeout */
+                if (timeout_ms >= 0) {
+                    timeout_ms -= (int) ((tget_us() - t0) / 1000);
+                    t0 = tget_us();
+
+                    if (timeout_ms <= 0) {
+                        rc = ETIME;
+                        break;
+                    }
+                }
+
                 goto __hw_wait_irq_retry;
             }
 
@@ -665,6 +739,7 @@ int snap_action_start (struct snap_action* action)
         snap_action_write32 (card, ACTION_IRQ_CONTROL, ACTION_IRQ_CONTROL_ON);
     }
 
+    card->start_us = tget_us();
     return snap_action_write32 (card, ACTION_CONTROL, ACTION_CONTROL_START);
 }
 
@@ -702,37 +777,88 @@ int snap_action_wait_interrupt(struct snap_action *action, int *rc, int timeout)
     return _rc;
 }
 
+/*
+ * Poll ACTION_CONTROL until idle. Short jobs are caught by reading back to
+ * back for spin_us, longer ones by sleeping between reads, starting at
+ * sleep_min_us and doubling up to sleep_max_us.
+ */
+static int hw_poll_idle (struct snap_card* card, int timeout_sec,
+                         uint32_t* action_data)
+{
+    int rc;
+    uint64_t t0 = tget_us();
+    uint64_t dt, timeout_us = (uint64_t)timeout_sec * 1000000;
+    unsigned int sleep_us = card->poll.sleep_min_us;
+    unsigned long spins = 0, sleeps = 0;
+
+    while (1) {
+        rc = snap_action_read32 (card, ACTION_CONTROL, action_data);
+
+        if ((rc != 0) ||
+            ((*action_data & ACTION_CONTROL_IDLE) == ACTION_CONTROL_IDLE)) {
+            break;
+        }
+
+        dt = tget_us() - t0;
+
+        if (dt >= timeout_us) {
+            break;
+        }
+
+        if (dt < card->poll.spin_us) {
+            spins++;
+            continue;
+        }
+
+        /* Don't oversleep the timeout */
+        if (sleep_us > timeout_us - dt) {
+            sleep_us = (unsigned int) (timeout_us - dt);
+        }
+
+        snap_sleep_us (sleep_us);
+        sleeps++;
+        sleep_us = MIN (sleep_us * 2, card->poll.sleep_max_us);
+    }
+
+    poll_trace ("  %s: %lu spins %lu sleeps %llu usec rc: %d\n", __func__,
+                spins, sleeps, (unsigned long long) (tget_us() - t0), rc);
+    return rc;
+}
+
 int snap_action_completed (struct snap_action* action, int* rc, int timeout)
 {
     int _rc = 0;
     uint32_t action_data = 0;
     struct snap_card* card = (struct snap_card*)action;
-    unsigned long t0;
-    int dt, timeout_ms;
+    snap_wait_mode_t mode;
+    uint64_t t0 = card->start_us ? card->start_us : tget_us();
 
     if (SNAP_ACTION_DONE_IRQ & card->flags) {
         snap_trace ("Wait for IRQ\n");
-        hw_wait_irq (card, timeout);
+        mode = SNAP_WAIT_IRQ;
+        _rc = hw_wait_irq (card, timeout);
         snap_action_write32 (card, ACTION_IRQ_STATUS, ACTION_IRQ_STATUS_DONE);
         snap_action_write32 (card, ACTION_IRQ_APP, 0);
         snap_action_write32 (card, ACTION_IRQ_CONTROL, ACTION_IRQ_CONTROL_OFF);
-        _rc = snap_action_read32 (card, ACTION_CONTROL, &action_data);
-    } else {
-        snap_trace ("Poll until timeout\n");
-        /* Busy poll timout sec */
-        t0 = tget_ms();
-        dt = 0;
-        timeout_ms = timeout * 1000;
 
-        while (dt < timeout_ms) {
-            _rc = snap_action_read32 (card, ACTION_CONTROL, &action_data);
-
-            if ((action_data & ACTION_CONTROL_IDLE) == ACTION_CONTROL_IDLE) {
-                break;
-            }
+        /* A timeout shows up as not completed below */
+        if (_rc == ETIME) {
+            _rc = 0;
+        }
 
-            dt = (int) (tget_ms() - t0);
+        if (_rc == 0) {
+            _rc = snap_action_read32 (card, ACTION_CONTROL, &action_data);
         }
+    } else {
+        snap_trace ("Poll until timeout\n");
+        mode = SNAP_WAIT_POLL;
+        _rc = hw_poll_idle (card, timeout, &action_data);
+    }
+
+    if ((_rc == 0) &&
+        ((action_data & ACTION_CONTROL_IDLE) == ACTION_CONTROL_IDLE)) {
+        snap_lat_record (card, mode, tget_us() - t0);
+        card->start_us = 0;
     }
 
     if (rc) {
@@ -743,6 +869,70 @@ int snap_action_completed (struct snap_action* action, int* rc, int timeout)
     return (action_data & ACTION_CONTROL_IDLE) == ACTION_CONTROL_IDLE;
 }
 
+int snap_action_set_poll (struct snap_action* action,
+                          const struct snap_poll_cfg* cfg)
+{
+    struct snap_card* card = (struct snap_card*)action;
+
+    if ((card == NULL) || (cfg == NULL) ||
+        (cfg->sleep_min_us > cfg->sleep_max_us)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    card->poll = *cfg;
+    snap_trace ("%s: spin %u usec sleep %u .. %u usec\n", __func__,
+                cfg->spin_us, cfg->sleep_min_us, cfg->sleep_max_us);
+    return 0;
+}
+
+int snap_action_get_poll (struct snap_action* action,
+                          struct snap_poll_cfg* cfg)
+{
+    struct snap_card* card = (struct snap_card*)action;
+
+    if ((card == NULL) || (cfg == NULL)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    *cfg = card->poll;
+    return 0;
+}
+
+uint64_t snap_action_get_latency (struct snap_action* action,
+                                  snap_wait_mode_t mode,
+                                  uint64_t hist[SNAP_LAT_BUCKETS])
+{
+    struct snap_card* card = (struct snap_card*)action;
+    uint64_t count = 0;
+    int b;
+
+    if ((card == NULL) || (mode >= SNAP_WAIT_MODES)) {
+        errno = EINVAL;
+        return 0;
+    }
+
+    for (b = 0; b < SNAP_LAT_BUCKETS; b++) {
+        if (hist) {
+            hist[b] = card->lat_hist[mode][b];
+        }
+
+        count += card->lat_hist[mode][b];
+    }
+
+    return count;
+}
+
+void snap_action_reset_latency (struct snap_action* action)
+{
+    struct snap_card* card = (struct snap_card*)action;
+
+    if (card) {
+        memset (card->lat_hist, 0, sizeof (card->lat_hist));
+    }
+}
+
 int snap_action_assign_irq (struct snap_action* action, uint32_t action_irq_ea_reg_addr)
 {
     struct snap_card* card = (struct snap_card*)action;
@@ -1027,4 +1217,26 @@ static void _init (void)
     if (trace_env != NULL) {
         snap_trace = strtol (trace_env, (char**)NULL, 0);
     }
+
+    trace_env = getenv ("SNAP_POLL_SPIN_US");
+
+    if (trace_env != NULL) {
+        snap_poll_default.spin_us = strtoul (trace_env, (char**)NULL, 0);
+    }
+
+    trace_env = getenv ("SNAP_POLL_SLEEP_MIN_US");
+
+    if (trace_env != NULL) {
+        snap_poll_default.sleep_min_us = strtoul (trace_env, (char**)NULL, 0);
+    }
+
+    trace_env = getenv ("SNAP_POLL_SLEEP_MAX_US");
+
+    if (trace_env != NULL) {
+        snap_poll_default.sleep_max_us = strtoul (trace_env, (char**)NULL, 0);
+    }
+
+    if (snap_poll_default.sleep_max_us < snap_poll_default.sleep_min_us) {
+        snap_poll_default.sleep_max_us = snap_poll_default.sleep_min_us;
+    }
 }
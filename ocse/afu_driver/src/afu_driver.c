@@ -226,11 +226,12 @@ static void error_message(const char *str)
 
 static void tlx_control(void)
 {
-	// Wait for clock edge from OCSE
+	// Wait for clock edge from OCSE, unless in a clock burst
 	fd_set watchset;
 	FD_ZERO(&watchset);
 	FD_SET(event.sockfd, &watchset);
-	select(event.sockfd + 1, &watchset, NULL, NULL, NULL);
+	if (!tlx_burst_pending(&event))
+		select(event.sockfd + 1, &watchset, NULL, NULL, NULL);
 	
 	debug_msg("tlx_control: %08lld: calling tlx_get_tlx_events...", (long long) c_sim_time);
 	int rc = tlx_get_tlx_events(&event);
@@ -1017,6 +1018,13 @@ void set_simulation_time(const svLogicVecVal *simulationTime)
 //  printf("inside C: time value  = %08lld\n", (long long) c_sim_time);
 }
 
+// The AFU will not drive TLX for this many cycles unless TLX drives it
+// first, 0xffffffff for none until then.  Lets OCSE run the clock ahead.
+void set_afu_quiet(const svLogicVecVal *quietCycles)
+{
+  event.afu_tlx_quiet = quietCycles->aval;
+}
+
 void get_simuation_error(svLogic *simulationError)
 {
   *simulationError  = c_sim_error & 0x1;
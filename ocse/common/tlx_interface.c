@@ -132,8 +132,11 @@ static int establish_protocol(struct AFU_EVENT *event)
 
 		return TLX_VERSION_ERROR;
 	}
-	else
-		return TLX_SUCCESS;
+
+	// Clock bursts need both sides to know the extra header fields
+	event->burst_ok = (secondary >= PROTOCOL_SECONDARY_BURST) &&
+	    (event->proto_secondary >= PROTOCOL_SECONDARY_BURST);
+	return TLX_SUCCESS;
 
 
 }
@@ -1102,6 +1105,15 @@ int tlx_signal_afu_model(struct AFU_EVENT *event)
 		event->tlx_afu_resp_credit = 0;
 		event->tlx_afu_resp_data_credit = 0;
 	}
+	// Let an AFU that said it would stay quiet run ahead (4 bytes)
+	if (event->burst_ok && (event->tlx_afu_burst != 0)) {
+		event->tbuf[0] = event->tbuf[0] | 0x80;
+		for (i = 0; i < 4; i++) {
+			event->tbuf[bp++] =
+			    ((event->tlx_afu_burst) >> ((3 - i) * 8)) & 0xFF;
+		}
+		event->tlx_afu_burst = 0;
+	}
 
 	// if nothing but a clock event, don't bother sending bytes 1->4
 	if ( bp == 5)
@@ -1130,6 +1142,15 @@ int tlx_signal_afu_model(struct AFU_EVENT *event)
 	return TLX_SUCCESS;
 }
 
+/* Does the AFU have anything for tlx_signal_tlx_model() to send? */
+
+static int afu_outputs_pending(struct AFU_EVENT *event)
+{
+	return event->afu_tlx_cmd_valid || event->afu_tlx_cdata_valid ||
+	    event->afu_tlx_resp_valid || event->afu_tlx_rdata_valid ||
+	    event->cfg_tlx_resp_valid || event->afu_tlx_credit_req_valid;
+}
+
 /* AFU calls this to send an event to the TLX model */
 /* Now static as it's called in tlx_get_tlx_events() */
 
@@ -1266,6 +1287,20 @@ static int tlx_signal_tlx_model(struct AFU_EVENT *event)
 	} else {
 	        debug_msg("tlx_signal_tlx_model: no (initial) credits to send");
 	}
+	// Cycles run in the burst just ended and the quiet hint (8 bytes)
+	if (event->burst_ok &&
+	    ((event->afu_tlx_quiet != 0) || (event->afu_tlx_burst_ran != 0))) {
+		event->tbuf[0] = event->tbuf[0] | 0x80;
+		for (i = 0; i < 4; i++) {
+			event->tbuf[bp++] =
+			    ((event->afu_tlx_burst_ran) >> ((3 - i) * 8)) & 0xFF;
+		}
+		for (i = 0; i < 4; i++) {
+			event->tbuf[bp++] =
+			    ((event->afu_tlx_quiet) >> ((3 - i) * 8)) & 0xFF;
+		}
+		event->afu_tlx_burst_ran = 0;
+	}
 
 	// if nothing but a clock event, don't bother sending bytes 1->4
 	if ( bp == 5)
@@ -1336,6 +1371,8 @@ int tlx_get_afu_events(struct AFU_EVENT *event)
 			event->clock = 0;
 			if (event->rbuf[0] == 0x10) {
 				debug_msg("tlx_get_afu_events: Just a clock event");
+				event->afu_tlx_burst_ran = 0;
+				event->afu_tlx_quiet = 0;
 				event->rbp = 0;
 				return 1;
 			}
@@ -1400,6 +1437,9 @@ int tlx_get_afu_events(struct AFU_EVENT *event)
 		  // debug_msg("      extract cfg byte count");
 			rbc += 9; // for now, always copy over everything
 		}
+		if ((event->rbuf[0] & 0x80) != 0) {
+			rbc += 8; // burst cycles ran and quiet hint
+		}
 
 		//printf("TLX_GET_AFU_EVENT-2 - rbuf[0] is 0x%02x and rbc is %2d \n", event->rbuf[0], rbc);
 		if ( ( bc = recv( event->sockfd, event->rbuf + event->rbp, rbc - event->rbp, 0 ) ) == -1) {
@@ -1595,6 +1635,19 @@ int tlx_get_afu_events(struct AFU_EVENT *event)
 		debug_msg("tlx_get_afu_events: setting afu_tlx_credit_req_valid=0 after processing");
 		}
 
+	event->afu_tlx_burst_ran = 0;
+	event->afu_tlx_quiet = 0;
+	if ((event->rbuf[0] & 0x80) != 0) {
+		for (i = 0; i < 4; i++) {
+			event->afu_tlx_burst_ran =
+			    (event->afu_tlx_burst_ran << 8) | event->rbuf[rbc++];
+		}
+		for (i = 0; i < 4; i++) {
+			event->afu_tlx_quiet =
+			    (event->afu_tlx_quiet << 8) | event->rbuf[rbc++];
+		}
+	}
+
 	event->rbp = 0;
 	return 1;
 }
@@ -1608,10 +1661,25 @@ int tlx_get_tlx_events(struct AFU_EVENT *event)
 {
         int bc, i;
 	uint32_t rbc = 1;
+	uint32_t burst;
 	uint16_t cmd_data_byte_cnt, resp_data_byte_cnt;
 	cmd_data_byte_cnt = 0;
 	resp_data_byte_cnt = 0;
 	debug_msg("tlx_get_tlx_events: entered" );
+	// In a clock burst the reply to ocse is held back.  Run another
+	// cycle with the inputs unchanged, just as for a clock only message,
+	// until the burst is used up or the AFU has something to send.
+	if ((event->clock == 1) && (event->rbp == 0)) {
+		if ((event->burst_left != 0) && !afu_outputs_pending(event)) {
+			event->burst_left--;
+			event->afu_tlx_burst_ran++;
+			return 1;
+		}
+		event->burst_left = 0;
+		tlx_signal_tlx_model(event);
+		// ocse can't have sent anything before seeing the reply
+		return 0;
+	}
 	if (event->rbp == 0) {
 		if ((bc = recv(event->sockfd, event->rbuf, 1, 0)) == -1) {
 			if (errno == EWOULDBLOCK) {
@@ -1636,7 +1704,9 @@ int tlx_get_tlx_events(struct AFU_EVENT *event)
 		        // printf("tlx_get_tlx_events: clock\n" );
 			event->clock = 1;
 		        debug_msg("tlx_get_tlx_events: sending events to tlx" );
-			tlx_signal_tlx_model(event);
+			// A burst grant is answered once the burst ends
+			if ((event->rbuf[0] & 0x80) == 0)
+				tlx_signal_tlx_model(event);
 		        //printf("tlx_get_tlx_events: sent\n" );
 			if (event->rbuf[0] == 0x40) {
 				//printf("tlx_get_tlx_events: only a clock, nothing else to decode\n" );
@@ -1706,6 +1776,9 @@ int tlx_get_tlx_events(struct AFU_EVENT *event)
 			rbc += 9; //TODO for now, send all credits which are now 9 bytes
 			// printf("tlx_get_tlx_events: tlx_afu_credit: rbc is 0x%x \n", rbc);
 		}
+		if ((event->rbuf[0] & 0x80) != 0) {
+			rbc += 4; // burst cycles
+		}
 		//printf("rbc is 0x%x \n", rbc);
 		if ( ( bc = recv( event->sockfd, event->rbuf + event->rbp, rbc - event->rbp, 0 ) ) == -1 ) {
 			if (errno == EWOULDBLOCK) {
@@ -1886,10 +1959,30 @@ int tlx_get_tlx_events(struct AFU_EVENT *event)
 		event->tlx_afu_resp_data_credit = 0;
 	}
 	//	printf("rbc is 0x%x \n", rbc);
+	if (event->rbuf[0] & 0x80) {
+		burst = 0;
+		for (i = 0; i < 4; i++) {
+			burst = (burst << 8) | event->rbuf[rbc++];
+		}
+		// Outputs from the last cycle can't wait for the burst
+		if ((burst != 0) && !afu_outputs_pending(event)) {
+			event->burst_left = burst;
+			event->afu_tlx_burst_ran = 0;
+		} else {
+			tlx_signal_tlx_model(event);
+		}
+	}
 	event->rbp = 0;
 	return 1;
 }
 
+/* Call this from the AFU to see if it is in a clock burst */
+
+int tlx_burst_pending(struct AFU_EVENT *event)
+{
+	return event->clock == 1;
+}
+
 
 /* Call this from AFU to set the initial afu tlx_credit values */
 
@@ -239,6 +239,13 @@ int tlx_get_afu_events(struct AFU_EVENT *event);
 int tlx_get_tlx_events(struct AFU_EVENT *event);
 
 
+/* The AFU owes ocse a reply for a clock burst.  While this returns 1 call
+ * tlx_get_tlx_events() without waiting on the socket: each call runs one
+ * more cycle of the burst, which ends early once the AFU drives anything. */
+
+int tlx_burst_pending(struct AFU_EVENT *event);
+
+
 /* Call this from AFU to set the initial afu tlx_credit values */
 
 int afu_tlx_send_initial_credits(struct AFU_EVENT *event,
@@ -38,10 +38,18 @@
 
 #ifdef TLX3
 #define PROTOCOL_PRIMARY 3
-#define PROTOCOL_SECONDARY 0000
+#define PROTOCOL_SECONDARY 0001
 #define PROTOCOL_TERTIARY 0
 #endif /* TLX3 */
 
+// Both sides at or above this secondary level understand clock bursts:
+// the AFU may report how long it will stay quiet and ocse may then let it
+// run that many cycles on one socket message
+#define PROTOCOL_SECONDARY_BURST 1
+
+// afu_tlx_quiet value for an AFU that does nothing until TLX drives it
+#define TLX_QUIET_WAIT 0xffffffff
+
 /* Select the initial value for credits??  */
 #define MAX_AFU_TLX_CMD_CREDITS 5
 #define MAX_AFU_TLX_RESP_CREDITS 10
@@ -445,6 +453,13 @@ struct AFU_EVENT {
   uint8_t cfg_tlx_rdata_valid;          /* 6 bit config response data is valid */
   uint8_t cfg_tlx_rdata_bdi;              /* 1 bit config response data is bad */
 
+  // Clock bursts (simulation only, no TLX signals)
+  uint8_t burst_ok;                       /* remote side is at PROTOCOL_SECONDARY_BURST */
+  uint32_t afu_tlx_quiet;                 /* cycles the AFU will not drive TLX unless driven, or TLX_QUIET_WAIT */
+  uint32_t tlx_afu_burst;                 /* extra cycles the AFU may run before its next reply */
+  uint32_t afu_tlx_burst_ran;             /* extra cycles the AFU actually ran */
+  uint32_t burst_left;                    /* AFU side: cycles left in the current burst */
+
   // TLX Framer - Template Configuration (table 15)
   uint8_t afu_cfg_xmit_tmpl_config_0;     /* 1 bit xmit template enable - default */
   uint8_t afu_cfg_xmit_tmpl_config_1;     /* 1 bit xmit template enable */
@@ -15,15 +15,23 @@
  */
 
 #include <errno.h>
+#include <fcntl.h>
 #include <inttypes.h>
 #include <netinet/in.h>
 #include <poll.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
 
 #include "debug.h"
 #include "utils.h"
@@ -139,20 +147,534 @@ void ns_delay(long ns)
 	nanosleep(&ts, &ts);
 }
 
-// Delay to allow another thread to have mutex lock
-void lock_delay(pthread_mutex_t * lock)
+// Wait on cond for up to timeout_ms milliseconds, lock must be held
+int lock_wait(pthread_mutex_t * lock, pthread_cond_t * cond, int timeout_ms)
 {
-	pthread_mutex_unlock(lock);
-	ns_delay(100000);
-	pthread_mutex_lock(lock);
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec += timeout_ms / 1000;
+	ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+	if (ts.tv_nsec >= 1000000000L) {
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+	return pthread_cond_timedwait(cond, lock, &ts);
+}
+
+// Open wake channel, returns 0 on success
+int wake_init(struct ocse_wake *wake)
+{
+#ifdef __linux__
+	wake->rfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	wake->wfd = wake->rfd;
+	return (wake->rfd < 0) ? -1 : 0;
+#else
+	int fds[2];
+
+	wake->rfd = wake->wfd = -1;
+	if (pipe(fds) < 0)
+		return -1;
+	fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+	fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+	wake->rfd = fds[0];
+	wake->wfd = fds[1];
+	return 0;
+#endif
+}
+
+// Signal wake channel, safe to call without holding any lock
+void wake_signal(struct ocse_wake *wake)
+{
+	uint64_t one = 1;
+	ssize_t rc;
+
+	if (wake->wfd < 0)
+		return;
+	// A full pipe or saturated eventfd is already signalled
+#ifdef __linux__
+	rc = write(wake->wfd, &one, sizeof(one));
+#else
+	rc = write(wake->wfd, &one, 1);
+#endif
+	(void)rc;
+}
+
+// Consume all pending wake signals
+void wake_drain(struct ocse_wake *wake)
+{
+	uint64_t buf[8];
+
+	if (wake->rfd < 0)
+		return;
+	while (read(wake->rfd, buf, sizeof(buf)) > 0) ;
+}
+
+// Close wake channel
+void wake_close(struct ocse_wake *wake)
+{
+	if (wake->wfd >= 0 && wake->wfd != wake->rfd)
+		close(wake->wfd);
+	if (wake->rfd >= 0)
+		close(wake->rfd);
+	wake->rfd = wake->wfd = -1;
+}
+
+// Local transport: one single producer/single consumer byte ring per
+// direction in memory shared by client and OCSE.  The Unix socket the
+// rings were set up on stays open: a consumer about to sleep sets armed
+// and polls the socket, a producer that finds armed set writes one
+// doorbell byte.  A closed socket is still how either side sees the
+// other go away.
+#define SHM_MAX_FD 1024
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+struct shm_ring {
+	uint32_t head;		// bytes produced, written by producer
+	uint32_t pad0[15];
+	uint32_t tail;		// bytes consumed, written by consumer
+	uint32_t pad1[15];
+	uint32_t armed;		// consumer is waiting for a doorbell
+	uint32_t pad2[15];
+	uint8_t data[OCSE_SHM_RING_BYTES];
+};
+
+// ring[0] carries client to OCSE, ring[1] OCSE to client
+struct shm_map {
+	uint32_t magic;
+	uint32_t pad[15];
+	struct shm_ring ring[2];
+};
+
+struct shm_link {
+	struct shm_map *map;
+	struct shm_ring *rx;
+	struct shm_ring *tx;
+	pthread_mutex_t tx_lock;
+	int hup;
+	int refs;		// the table's plus one per _shm_hold()
+};
+
+// Every client thread looks links up, so the table is only touched under
+// _shm_links_lock and a link is freed when its last holder lets it go
+static struct shm_link *_shm_links[SHM_MAX_FD];
+static pthread_mutex_t _shm_links_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct shm_link *_shm_hold(int fd)
+{
+	struct shm_link *link;
+
+	if ((fd < 0) || (fd >= SHM_MAX_FD))
+		return NULL;
+	pthread_mutex_lock(&_shm_links_lock);
+	link = _shm_links[fd];
+	if (link != NULL)
+		link->refs++;
+	pthread_mutex_unlock(&_shm_links_lock);
+	return link;
+}
+
+static void _shm_release(struct shm_link *link)
+{
+	int refs;
+
+	pthread_mutex_lock(&_shm_links_lock);
+	refs = --link->refs;
+	pthread_mutex_unlock(&_shm_links_lock);
+	if (refs)
+		return;
+	munmap(link->map, sizeof(struct shm_map));
+	pthread_mutex_destroy(&(link->tx_lock));
+	free(link);
+}
+
+static int _shm_add(int fd, struct shm_map *map, int server)
+{
+	struct shm_link *link;
+
+	if ((fd < 0) || (fd >= SHM_MAX_FD))
+		return -1;
+	link = (struct shm_link *)calloc(1, sizeof(struct shm_link));
+	if (link == NULL)
+		return -1;
+	link->map = map;
+	link->rx = &(map->ring[server ? 0 : 1]);
+	link->tx = &(map->ring[server ? 1 : 0]);
+	pthread_mutex_init(&(link->tx_lock), NULL);
+	link->refs = 1;
+	pthread_mutex_lock(&_shm_links_lock);
+	_shm_links[fd] = link;
+	pthread_mutex_unlock(&_shm_links_lock);
+	return 0;
+}
+
+// Threads still using the link keep the rings mapped until they are done
+static void _shm_remove(int fd)
+{
+	struct shm_link *link;
+
+	if ((fd < 0) || (fd >= SHM_MAX_FD))
+		return;
+	pthread_mutex_lock(&_shm_links_lock);
+	link = _shm_links[fd];
+	_shm_links[fd] = NULL;
+	pthread_mutex_unlock(&_shm_links_lock);
+	if (link != NULL)
+		_shm_release(link);
+}
+
+static uint32_t _ring_count(struct shm_ring *ring)
+{
+	return __atomic_load_n(&(ring->head), __ATOMIC_SEQ_CST) -
+	    __atomic_load_n(&(ring->tail), __ATOMIC_RELAXED);
+}
+
+static int _ring_read(struct shm_ring *ring, uint8_t * data, int size)
+{
+	uint32_t tail, count, offset, first;
+
+	tail = __atomic_load_n(&(ring->tail), __ATOMIC_RELAXED);
+	count = __atomic_load_n(&(ring->head), __ATOMIC_ACQUIRE) - tail;
+	if (count > (uint32_t) size)
+		count = size;
+	offset = tail & (OCSE_SHM_RING_BYTES - 1);
+	first = OCSE_SHM_RING_BYTES - offset;
+	if (first > count)
+		first = count;
+	memcpy(data, &(ring->data[offset]), first);
+	memcpy(data + first, ring->data, count - first);
+	__atomic_store_n(&(ring->tail), tail + count, __ATOMIC_RELEASE);
+	return count;
+}
+
+static int _ring_write(struct shm_ring *ring, uint8_t * data, int size)
+{
+	uint32_t head, space, offset, first;
+
+	head = __atomic_load_n(&(ring->head), __ATOMIC_RELAXED);
+	space = OCSE_SHM_RING_BYTES -
+	    (head - __atomic_load_n(&(ring->tail), __ATOMIC_ACQUIRE));
+	if (space > (uint32_t) size)
+		space = size;
+	offset = head & (OCSE_SHM_RING_BYTES - 1);
+	first = OCSE_SHM_RING_BYTES - offset;
+	if (first > space)
+		first = space;
+	memcpy(&(ring->data[offset]), data, first);
+	memcpy(ring->data, data + first, space - first);
+	// Sequentially consistent so either we see armed or the consumer
+	// sees the new head before it sleeps
+	__atomic_store_n(&(ring->head), head + space, __ATOMIC_SEQ_CST);
+	return space;
+}
+
+// Swallow doorbells, then report ring data or arm the doorbell
+static int _shm_pending(struct shm_link *link, int fd)
+{
+	uint8_t buffer[64];
+	int rc;
+
+	while ((rc = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) ;
+	if (rc == 0)
+		__atomic_store_n(&(link->hup), 1, __ATOMIC_RELAXED);
+	if (_ring_count(link->rx))
+		return 1;
+	__atomic_store_n(&(link->rx->armed), 1, __ATOMIC_SEQ_CST);
+	return (_ring_count(link->rx) != 0);
+}
+
+static int _shm_ready(struct shm_link *link, int fd, int timeout, int *abort)
+{
+	struct pollfd pfd;
+	struct timespec now, end;
+	int rc, wait;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	end.tv_sec += timeout / 1000;
+	end.tv_nsec += (long)(timeout % 1000) * 1000000L;
+	if (end.tv_nsec >= 1000000000L) {
+		end.tv_sec++;
+		end.tv_nsec -= 1000000000L;
+	}
+	wait = timeout;
+	while (1) {
+		if ((abort != NULL) && (*abort != 0))
+			return -1;
+		if (_shm_pending(link, fd))
+			return 1;
+		if (__atomic_load_n(&(link->hup), __ATOMIC_RELAXED)) {
+			warn_msg("Socket disconnect on poll");
+			return -1;
+		}
+		if (wait == 0)
+			return 0;
+		pfd.fd = fd;
+		pfd.events = POLLIN | POLLHUP;
+		pfd.revents = 0;
+		do {
+			rc = poll(&pfd, 1, wait);
+		}
+		while ((rc < 0) && (errno == EINTR));
+		if (rc < 0)
+			return -1;
+		if (timeout < 0)
+			continue;
+		// Doorbells may be stale, keep waiting out the rest of timeout
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		wait = (end.tv_sec - now.tv_sec) * 1000 +
+		    (end.tv_nsec - now.tv_nsec) / 1000000L;
+		if (wait < 0)
+			wait = 0;
+	}
+}
+
+static int _shm_get(struct shm_link *link, int fd, int size, uint8_t * data,
+		    int timeout, int *abort)
+{
+	int bytes, rc;
+
+	if ((abort != NULL) && (*abort != 0))
+		return -1;
+	bytes = 0;
+	while (bytes < size) {
+		bytes += _ring_read(link->rx, &(data[bytes]), size - bytes);
+		if (bytes == size)
+			break;
+		rc = _shm_ready(link, fd, timeout, abort);
+		if (rc == 0) {
+			warn_msg("Socket timeout");
+			return -1;
+		}
+		if (rc < 0) {
+			warn_msg("bytes_ready:Socket disconnect");
+			return -1;
+		}
+	}
+	return 0;
+}
+
+static int _shm_put(struct shm_link *link, int fd, int size, uint8_t * data)
+{
+	struct pollfd pfd;
+	uint8_t bell = 0;
+	int bytes, count;
+
+	pthread_mutex_lock(&(link->tx_lock));
+	bytes = 0;
+	while (bytes < size) {
+		count = _ring_write(link->tx, &(data[bytes]), size - bytes);
+		bytes += count;
+		if (__atomic_exchange_n(&(link->tx->armed), 0,
+					__ATOMIC_SEQ_CST) &&
+		    (send(fd, &bell, 1, MSG_NOSIGNAL) < 0) && (errno != EAGAIN))
+			break;
+		if (count)
+			continue;
+		// Ring is full, give the consumer a moment unless it is gone
+		pfd.fd = fd;
+		pfd.events = 0;
+		pfd.revents = 0;
+		if ((poll(&pfd, 1, 1) > 0) && (pfd.revents & (POLLHUP | POLLERR)))
+			break;
+	}
+	pthread_mutex_unlock(&(link->tx_lock));
+	return (bytes == size) ? bytes : -1;
+}
+
+// Fill addr with the abstract Unix socket address OCSE listens on next to
+// TCP port, returns the address length
+socklen_t shm_socket_addr(struct sockaddr_un *addr, int port)
+{
+	int len;
+
+	memset(addr, 0, sizeof(struct sockaddr_un));
+	addr->sun_family = AF_UNIX;
+	// Leading NUL puts the name in the abstract namespace, no file
+	// to clean up and it is private to this network namespace
+	len = snprintf(&(addr->sun_path[1]), sizeof(addr->sun_path) - 1,
+		       "ocse.%d", port);
+	return offsetof(struct sockaddr_un, sun_path) + 1 + len;
+}
+
+// Send one setup byte, with fd attached if fd >= 0
+static int _shm_send_setup(int sock, uint8_t byte, int fd)
+{
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg;
+	union {
+		char buf[CMSG_SPACE(sizeof(int))];
+		struct cmsghdr align;
+	} u;
+
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = &byte;
+	iov.iov_len = 1;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	if (fd >= 0) {
+		memset(&u, 0, sizeof(u));
+		msg.msg_control = u.buf;
+		msg.msg_controllen = sizeof(u.buf);
+		cmsg = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+		memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+	}
+	return (sendmsg(sock, &msg, MSG_NOSIGNAL) == 1) ? 0 : -1;
+}
+
+// Receive one setup byte and any fd attached to it
+static int _shm_recv_setup(int sock, uint8_t * byte, int *fd, int timeout)
+{
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg;
+	union {
+		char buf[CMSG_SPACE(sizeof(int))];
+		struct cmsghdr align;
+	} u;
+
+	*fd = -1;
+	if (bytes_ready(sock, timeout, NULL) <= 0)
+		return -1;
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = byte;
+	iov.iov_len = 1;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = u.buf;
+	msg.msg_controllen = sizeof(u.buf);
+	if (recvmsg(sock, &msg, 0) != 1)
+		return -1;
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+	     cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if ((cmsg->cmsg_level == SOL_SOCKET) &&
+		    (cmsg->cmsg_type == SCM_RIGHTS))
+			memcpy(fd, CMSG_DATA(cmsg), sizeof(int));
+	}
+	return 0;
+}
+
+// Offer shared memory rings on a connected Unix socket, returns 0 when the
+// rings are in use and 1 when the connection stays a plain stream
+int shm_connect(int fd, int timeout)
+{
+	struct shm_map *map;
+	uint8_t byte;
+	int memfd, rc;
+
+	map = MAP_FAILED;
+	memfd = -1;
+#ifdef SYS_memfd_create
+	if (fd < SHM_MAX_FD)
+		memfd = syscall(SYS_memfd_create, "ocse", 0);
+#endif
+	if ((memfd >= 0) &&
+	    (ftruncate(memfd, sizeof(struct shm_map)) == 0))
+		map = mmap(NULL, sizeof(struct shm_map),
+			   PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+	if (map != MAP_FAILED) {
+		map->magic = OCSE_SHM_MAGIC;
+		rc = _shm_send_setup(fd, OCSE_SHM_RING, memfd);
+	} else {
+		rc = _shm_send_setup(fd, OCSE_SHM_NONE, -1);
+	}
+	if (memfd >= 0)
+		close(memfd);
+	if ((rc < 0) || (_shm_recv_setup(fd, &byte, &memfd, timeout) < 0)) {
+		if (map != MAP_FAILED)
+			munmap(map, sizeof(struct shm_map));
+		return -1;
+	}
+	if (memfd >= 0)
+		close(memfd);
+	if ((byte == OCSE_SHM_RING) && (map != MAP_FAILED) &&
+	    (_shm_add(fd, map, 0) == 0))
+		return 0;
+	if (map != MAP_FAILED)
+		munmap(map, sizeof(struct shm_map));
+	return 1;
+}
+
+// Answer a client's shm_connect(), same return values
+int shm_accept(int fd, int timeout)
+{
+	struct shm_map *map;
+	struct stat st;
+	uint8_t byte;
+	int memfd;
+
+	if (_shm_recv_setup(fd, &byte, &memfd, timeout) < 0)
+		return -1;
+	map = MAP_FAILED;
+	if ((byte == OCSE_SHM_RING) && (memfd >= 0) &&
+	    (fstat(memfd, &st) == 0) &&
+	    (st.st_size == (off_t) sizeof(struct shm_map)))
+		map = mmap(NULL, sizeof(struct shm_map),
+			   PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+	if (memfd >= 0)
+		close(memfd);
+	if ((map != MAP_FAILED) &&
+	    ((map->magic != OCSE_SHM_MAGIC) || (_shm_add(fd, map, 1) < 0))) {
+		munmap(map, sizeof(struct shm_map));
+		map = MAP_FAILED;
+	}
+	byte = (map != MAP_FAILED) ? OCSE_SHM_RING : OCSE_SHM_NONE;
+	if (_shm_send_setup(fd, byte, -1) < 0) {
+		_shm_remove(fd);
+		return -1;
+	}
+	return (map != MAP_FAILED) ? 0 : 1;
+}
+
+// Does fd have ring data waiting?  Plain sockets always return 0.
+int bytes_pending(int fd)
+{
+	struct shm_link *link;
+	int rc;
+
+	if ((link = _shm_hold(fd)) == NULL)
+		return 0;
+	rc = _shm_pending(link, fd);
+	_shm_release(link);
+	return rc;
+}
+
+// Turn poll() revents for fd into what a socket would report
+short poll_revents(int fd, short revents)
+{
+	struct shm_link *link;
+
+	if ((link = _shm_hold(fd)) == NULL)
+		return revents;
+	if (_shm_pending(link, fd))
+		revents = POLLIN;
+	else if (__atomic_load_n(&(link->hup), __ATOMIC_RELAXED))
+		revents = POLLHUP;
+	else
+		revents &= (POLLHUP | POLLERR | POLLNVAL);
+	_shm_release(link);
+	return revents;
 }
 
 // Is there incoming data on socket?
 int bytes_ready(int fd, int timeout, int *abort)
 {
+	struct shm_link *link;
 	struct pollfd pfd;
 	int rc;
 
+	if ((link = _shm_hold(fd)) != NULL) {
+		rc = _shm_ready(link, fd, timeout, abort);
+		_shm_release(link);
+		return rc;
+	}
+
 	pfd.fd = fd;
 	pfd.events = POLLIN | POLLHUP;
 	pfd.revents = 0;
@@ -173,8 +695,18 @@ int bytes_ready(int fd, int timeout, int *abort)
 // Get bytes from socket
 int get_bytes_silent(int fd, int size, uint8_t * data, int timeout, int *abort)
 {
+	struct shm_link *link;
 	int count, bytes, rc;
 
+	if (data && ((link = _shm_hold(fd)) != NULL)) {
+		rc = _shm_get(link, fd, size, data, timeout, abort);
+		_shm_release(link);
+		if (rc < 0)
+			return -1;
+		bytes = size;
+		goto received;
+	}
+
 	bytes = 0;
 	while (bytes < size) {
 		// Check for socket activity
@@ -189,7 +721,7 @@ int get_bytes_silent(int fd, int size, uint8_t * data, int timeout, int *abort)
 			break;
 		}
 
-		bytes = recv(fd, data, size - bytes, MSG_PEEK | MSG_DONTWAIT);
+		bytes = recv(fd, data, size, MSG_PEEK | MSG_DONTWAIT);
 		if (((bytes < 0) && (errno != EINTR)) || !bytes) {
 			warn_msg("get_bytes_silent:Socket disconnect on recv");
 			return -1;
@@ -201,7 +733,7 @@ int get_bytes_silent(int fd, int size, uint8_t * data, int timeout, int *abort)
 
 	bytes = 0;
 	while (data && (bytes < size)) {
-		count = recv(fd, &(data[bytes]), size, 0);
+		count = recv(fd, &(data[bytes]), size - bytes, 0);
 		if (count <= 0) {
 			if (errno != EINTR)
 				break;
@@ -211,6 +743,7 @@ int get_bytes_silent(int fd, int size, uint8_t * data, int timeout, int *abort)
 		bytes += count;
 	}
 
+ received:
 #if DEBUG
 	DPRINTF("DEBUG:SOCKET IN:0x");
 	for (count = 0; count < bytes; count++)
@@ -236,11 +769,20 @@ int get_bytes(int fd, int size, uint8_t * data, int timeout, int *abort,
 // Put bytes on socket
 int put_bytes_silent(int fd, int size, uint8_t * data)
 {
+	struct shm_link *link;
 	int count, bytes;
 
+	if (data && ((link = _shm_hold(fd)) != NULL)) {
+		bytes = _shm_put(link, fd, size, data);
+		_shm_release(link);
+		if (bytes < 0)
+			return -1;
+		goto sent;
+	}
+
 	bytes = 0;
 	while (data && (bytes < size)) {
-		count = write(fd, &(data[bytes]), size);
+		count = write(fd, &(data[bytes]), size - bytes);
 		if (count < 0) {
 			if (errno == EINTR)
 				continue;
@@ -250,6 +792,7 @@ int put_bytes_silent(int fd, int size, uint8_t * data)
 		bytes += count;
 	}
 
+ sent:
 #if DEBUG
 	DPRINTF("DEBUG:SOCKET OUT:0x");
 	for (count = 0; count < bytes; count++)
@@ -315,6 +858,8 @@ int close_socket(int *sockfd)
 	char buffer[4096];
 	int yes = 1;
 
+	_shm_remove(*sockfd);
+
 	// Shutdown socket traffic
 	if (shutdown(*sockfd, SHUT_RDWR))
 		return -1;
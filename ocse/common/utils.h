@@ -20,6 +20,8 @@
 #include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include "tlx_interface_t.h"
 
 #ifdef DEBUG
@@ -37,7 +39,9 @@
 #define TLX_IDLE_CYCLES 200
 
 #define OCSE_VERSION_MAJOR	0x03
-#define OCSE_VERSION_MINOR	0x00
+#define OCSE_VERSION_MINOR	0x01
+// Clients at or above this minor version accept the _BULK memory messages
+#define OCSE_VERSION_MINOR_BULK	0x01
 
 #define OCSE_CONNECT		0x01
 #define OCSE_QUERY		0x02
@@ -79,9 +83,33 @@
 #define OCSE_FIND                       0x30
 #define OCSE_FIND_NTH                   0x31
 #define OCSE_FIND_ACK                   0x32
+#define OCSE_MEMORY_READ_BULK           0x33
+#define OCSE_MEMORY_WRITE_BULK          0x34
+#define OCSE_MEM_BULK_DONE              0x35
+
+// Most memory accesses carried by one _BULK message.  A request is a
+// 16-bit access count and 32-bit body length followed by the body: one
+// {16-bit size, 64-bit addr} per access, each followed by size bytes of
+// data for writes.  The reply is OCSE_MEM_BULK_DONE, one status byte per
+// access, then the data of each successful read in request order.
+#define OCSE_BULK_MAX_SEGS              64
 
 #define OCSE_FAILED                     0xff
 
+// Local transport setup, the first byte a client sends on the Unix socket.
+// OCSE_SHM_RING carries a memfd holding a struct shm_map, OCSE answers
+// with the same byte if it mapped the rings or OCSE_SHM_NONE if the
+// connection stays a plain stream.
+#define OCSE_SHM_RING                   0x40
+#define OCSE_SHM_NONE                   0x41
+#define OCSE_SHM_MAGIC                  0x4f43524eU
+// Bytes in each direction's ring, must be a power of 2
+#define OCSE_SHM_RING_BYTES             (256 * 1024)
+// Milliseconds either side waits for the other's setup byte.  OCSE
+// answers on its accept thread, so this also bounds how long one stalled
+// client holds up the others.
+#define OCSE_SHM_SETUP_MS               1000
+
 #define MAX_INT32 0x7fffffffU
 #define MIN_INT32 0x80000000U
 #define MAX_UINT32 0xffffffffU
@@ -128,8 +156,48 @@ void debug_msg(const char *format, ...);
 // Delay for up to ns nanoseconds
 void ns_delay(long ns);
 
-// Delay to allow another thread to have mutex lock
-void lock_delay(pthread_mutex_t * lock);
+// Wait on cond for up to timeout_ms milliseconds, lock must be held
+int lock_wait(pthread_mutex_t * lock, pthread_cond_t * cond, int timeout_ms);
+
+// Wake channel: a pollable file descriptor other threads can signal to
+// break a thread out of poll() when it has new work (eventfd on Linux,
+// pipe elsewhere).  rfd goes into the pollfd set, wfd is written.
+struct ocse_wake {
+	int rfd;
+	int wfd;
+};
+
+// Open wake channel, returns 0 on success
+int wake_init(struct ocse_wake *wake);
+
+// Signal wake channel, safe to call without holding any lock
+void wake_signal(struct ocse_wake *wake);
+
+// Consume all pending wake signals
+void wake_drain(struct ocse_wake *wake);
+
+// Close wake channel
+void wake_close(struct ocse_wake *wake);
+
+// Fill addr with the abstract Unix socket address OCSE listens on next to
+// TCP port, returns the address length
+socklen_t shm_socket_addr(struct sockaddr_un *addr, int port);
+
+// Offer shared memory rings on a connected Unix socket, returns 0 when the
+// rings are in use and 1 when the connection stays a plain stream
+int shm_connect(int fd, int timeout);
+
+// Answer a client's shm_connect(), same return values
+int shm_accept(int fd, int timeout);
+
+// Does fd have ring data waiting?  Plain sockets always return 0.  Call
+// before handing fd to poll(): with no data the writer is asked to ring
+// the doorbell.
+int bytes_pending(int fd);
+
+// Turn poll() revents for fd into what a socket would report, consuming
+// ring doorbells.  Plain sockets pass through.
+short poll_revents(int fd, short revents);
 
 // Is there incoming data on socket?
 int bytes_ready(int fd, int timeout, int *abort);
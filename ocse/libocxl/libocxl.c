@@ -22,6 +22,7 @@
 #include <arpa/inet.h>
 #include <assert.h>
 #include <errno.h>
+#include <ifaddrs.h>
 #include <inttypes.h>
 #include <netdb.h>
 #include <netinet/in.h>
@@ -31,6 +32,7 @@
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <time.h>
 #include <unistd.h>
 #include <limits.h>
@@ -477,6 +479,86 @@ static void _handle_write(struct ocxl_afu *afu, uint64_t addr, uint16_t size,
 	DPRINTF("WRITE to addr @ 0x%016" PRIx64 "\n", addr);
 }
 
+// Service every access of an OCSE_MEMORY_*_BULK message and answer with a
+// single OCSE_MEM_BULK_DONE reply: one status byte per access, then the
+// data of each successful read in request order.
+static void _handle_mem_bulk(struct ocxl_afu *afu, uint8_t type,
+			     uint16_t count, uint8_t * body, uint32_t len)
+{
+	uint8_t *reply, *status, *data, *bp;
+	uint64_t addr, page, valid_page;
+	uint32_t total;
+	uint16_t size;
+	int i;
+
+	if (!afu)
+		fatal_msg("NULL afu passed to libocxl.c:_handle_mem_bulk");
+
+	// First pass sizes the reply
+	total = 1 + count;
+	bp = body;
+	for (i = 0; i < count; i++) {
+		memcpy(&size, bp, sizeof(size));
+		size = ntohs(size);
+		bp += sizeof(size) + sizeof(addr);
+		if (type == OCSE_MEMORY_WRITE_BULK)
+			bp += size;
+		else
+			total += size;
+		if (bp > body + len) {
+			warn_msg("Malformed memory bulk request");
+			_all_idle(afu);
+			return;
+		}
+	}
+	reply = (uint8_t *) malloc(total);
+	reply[0] = OCSE_MEM_BULK_DONE;
+	status = &(reply[1]);
+	data = &(reply[1 + count]);
+
+	// Accesses in a bulk are usually in the same page, only test a
+	// page once (1 is never a page address)
+	valid_page = 1;
+	bp = body;
+	for (i = 0; i < count; i++) {
+		memcpy(&size, bp, sizeof(size));
+		size = ntohs(size);
+		bp += sizeof(size);
+		memcpy(&addr, bp, sizeof(addr));
+		addr = ntohll(addr);
+		bp += sizeof(addr);
+		page = addr & FOURK_MASK;
+		if ((page != valid_page) && !_testmemaddr((uint8_t *) addr)) {
+			if (_handle_dsi(afu, addr) < 0)
+				perror("DSI Failure");
+			warn_msg("%s invalid addr @ 0x%016" PRIx64,
+				 (type == OCSE_MEMORY_WRITE_BULK) ?
+				 "WRITE to" : "READ from", addr);
+			status[i] = OCSE_MEM_FAILURE;
+			if (type == OCSE_MEMORY_WRITE_BULK)
+				bp += size;
+			continue;
+		}
+		valid_page = page;
+		status[i] = OCSE_MEM_SUCCESS;
+		if (type == OCSE_MEMORY_WRITE_BULK) {
+			memcpy((void *)addr, bp, size);
+			bp += size;
+		} else {
+			memcpy(data, (void *)addr, size);
+			data += size;
+		}
+	}
+
+	if (put_bytes_silent(afu->fd, data - reply, reply) != data - reply) {
+		afu->opened = 0;
+		afu->attached = 0;
+	}
+	free(reply);
+	DPRINTF("BULK %s of %d accesses\n",
+		(type == OCSE_MEMORY_WRITE_BULK) ? "WRITE" : "READ", count);
+}
+
 static void _handle_touch(struct ocxl_afu *afu, uint64_t addr, uint8_t function_code, uint8_t cmd_pg_size)
 {
 	uint8_t buffer;
@@ -1457,7 +1539,6 @@ static void *_psl_loop(void *ptr)
 	afu->opened = 1;
 
 	while (afu->opened) {
-		_delay_1ms();
 		// Send any requests to OCSE over socket
 		if (afu->int_req.state == LIBOCXL_REQ_REQUEST)
 			_req_max_int(afu);
@@ -1506,8 +1587,9 @@ static void *_psl_loop(void *ptr)
 			}
 		}
 
-		// Process socket input from OCSE
-		rc = bytes_ready(afu->fd, 1000, 0);
+		// Process socket input from OCSE, the short wait is also how
+		// soon new requests from the application get picked up
+		rc = bytes_ready(afu->fd, 1, 0);
 		if (rc == 0)
 			continue;
 		if (rc < 0) {
@@ -1695,6 +1777,37 @@ static void *_psl_loop(void *ptr)
 			}
 			_handle_write(afu, addr, size, buffer);
 			break;
+		case OCSE_MEMORY_READ_BULK:
+		case OCSE_MEMORY_WRITE_BULK: {
+			uint8_t type = buffer[0];
+			uint16_t count;
+			uint32_t len;
+			uint8_t *body;
+
+			DPRINTF("AFU MEMORY BULK\n");
+			if (get_bytes_silent(afu->fd, sizeof(count) + sizeof(len),
+					     buffer, 1000, 0) < 0) {
+				warn_msg
+				    ("Socket failure getting memory bulk header");
+				_all_idle(afu);
+				break;
+			}
+			memcpy((char *)&count, buffer, sizeof(count));
+			count = ntohs(count);
+			memcpy((char *)&len, &(buffer[sizeof(count)]), sizeof(len));
+			len = ntohl(len);
+			body = (uint8_t *) malloc(len);
+			if (get_bytes_silent(afu->fd, len, body, 1000, 0) < 0) {
+				warn_msg
+				    ("Socket failure getting memory bulk body");
+				free(body);
+				_all_idle(afu);
+				break;
+			}
+			_handle_mem_bulk(afu, type, count, body, len);
+			free(body);
+			break;
+		}
 		// add the case for ocse_memory_be_write
 		// need to size, addr and data as above in ocse_memory_write
 	        // and then need to get byte enable in manner similar to addr (maybe)
@@ -1901,6 +2014,60 @@ static void *_psl_loop(void *ptr)
 	pthread_exit(NULL);
 }
 
+// Is addr one of this host's IPv4 addresses (loopback included)?
+static int _is_local_host(struct in_addr *addr)
+{
+	struct ifaddrs *ifa_list, *ifa;
+	int local = 0;
+
+	if (getifaddrs(&ifa_list) < 0)
+		return 0;
+	for (ifa = ifa_list; ifa != NULL; ifa = ifa->ifa_next) {
+		if ((ifa->ifa_addr == NULL) ||
+		    (ifa->ifa_addr->sa_family != AF_INET))
+			continue;
+		if (((struct sockaddr_in *)ifa->ifa_addr)->sin_addr.s_addr ==
+		    addr->s_addr) {
+			local = 1;
+			break;
+		}
+	}
+	freeifaddrs(ifa_list);
+	return local;
+}
+
+// OCSE on this host also listens on a Unix socket, use it and the shared
+// memory rings behind it unless OCSE_TRANSPORT=tcp
+static int _ocse_connect_local(int port)
+{
+	struct sockaddr_un addr;
+	char *transport;
+	socklen_t len;
+	int fd;
+
+	transport = getenv("OCSE_TRANSPORT");
+	if (transport && !strcmp(transport, "tcp"))
+		return -1;
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+		return -1;
+	len = shm_socket_addr(&addr, port);
+	if (connect(fd, (struct sockaddr *)&addr, len) < 0) {
+		close(fd);
+		return -1;
+	}
+	switch (shm_connect(fd, OCSE_SHM_SETUP_MS)) {
+	case 0:
+		info_msg("Using shared memory transport");
+		return fd;
+	case 1:
+		info_msg("Using local socket transport");
+		return fd;
+	default:
+		close_socket(&fd);
+		return -1;
+	}
+}
+
 static int _ocse_connect(uint16_t * afu_map, int *fd)
 {
 	char *ocse_server_dat_path;
@@ -1950,6 +2117,11 @@ static int _ocse_connect(uint16_t * afu_map, int *fd)
 	}
 	memset(&ssadr, 0, sizeof(ssadr));
 	memcpy(&ssadr.sin_addr, he->h_addr_list[0], he->h_length);
+	*fd = -1;
+	if ((he->h_addrtype == AF_INET) && _is_local_host(&ssadr.sin_addr))
+		*fd = _ocse_connect_local(port);
+	if (*fd >= 0)
+		goto connected;
 	ssadr.sin_family = AF_INET;
 	ssadr.sin_port = htons(port);
 	if ((*fd = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
@@ -1962,6 +2134,7 @@ static int _ocse_connect(uint16_t * afu_map, int *fd)
 		perror("connect");
 		goto connect_fail;
 	}
+ connected:
 	strcpy((char *)buffer, "OCSE");
 	buffer[4] = (uint8_t) OCSE_VERSION_MAJOR;
 	buffer[5] = (uint8_t) OCSE_VERSION_MINOR;
@@ -2974,14 +3147,19 @@ uint16_t ocxl_afu_event_check_versioned( ocxl_afu_h afu, int timeout, ocxl_event
 		warn_msg("ocxl_afu_event_check_versioned: event count must be 1, continuing as if 1 had be sent.");
 	}
 
-	// read an event - if not one, just wait here
-	//     we ignore timeout for now
+	// read an event - if not one, wait up to timeout ms, -1 waits forever
 	debug_msg("ocxl_read_event: waiting for event");
 	pthread_mutex_lock(&(afu->event_lock));
-	while (afu->opened && !afu->events[0]) {	/*infinite loop */
+	while (afu->opened && !afu->events[0]) {
+		if (timeout == 0) {
+			pthread_mutex_unlock(&(afu->event_lock));
+			return 0;
+		}
 		pthread_mutex_unlock(&(afu->event_lock));
 		if (_delay_1ms() < 0)
 			return -1;
+		if (timeout > 0)
+			--timeout;
 		pthread_mutex_lock(&(afu->event_lock));
 	}
 
@@ -38,6 +38,7 @@ struct client {
 	int context;
 	int abort;
 	int timeout;
+	int bulk;		// client accepts OCSE_MEMORY_*_BULK
 	enum flush_state flushing;
 	enum client_state state;
 	char type;
@@ -763,6 +763,125 @@ void handle_cmd(struct cmd *cmd, uint32_t latency)
 // when get the data back from the host, we just send it with the response.
 // should we defer some of this to handle_response?  Or should we process
 // the data and response here and also free the event?
+// Randomly select a memory access for a RETRY, FAILED, DERROR or
+// XLATE_PENDING response.  Returns 1 if the event was failed and must not
+// be sent to the client.
+static int _inject_mem_fault(struct cmd *cmd, struct cmd_event *event)
+{
+	uint32_t resp_opcode;
+
+	if (event->type == CMD_READ)
+		resp_opcode = TLX_RSP_READ_FAILED;
+	else
+		resp_opcode = TLX_RSP_WRITE_FAILED;
+
+	if ( allow_retry(cmd->parms)) {
+		event->state = MEM_DONE;
+		event->resp = 0x02;
+		debug_msg("_inject_mem_fault: RETRY this cmd =0x%x \n", event->command);
+	} else if ( allow_failed(cmd->parms)) {
+		event->state = MEM_DONE;
+		event->resp = 0x0e;
+		debug_msg("_inject_mem_fault: FAIL this cmd =0x%x \n", event->command);
+	} else if ( allow_derror(cmd->parms)) {
+		event->state = MEM_DONE;
+		event->resp = 0x08;
+		debug_msg("_inject_mem_fault: DERROR this cmd =0x%x \n", event->command);
+	} else if ( allow_pending(cmd->parms)) {
+		// for xlate_pending response, ocse has to THEN follow up with an xlate_done response
+		// (at some unknown time later) and that will "complete" the original cmd (no rd/write )
+		event->state = MEM_XLATE_PENDING;
+		event->resp = 0x04;
+		debug_msg("_inject_mem_fault: send XLATE_PENDING for this cmd =0x%x \n", event->command);
+	} else {
+		return 0;
+	}
+	event->type = CMD_FAILED;
+	event->resp_opcode = resp_opcode;
+	return 1;
+}
+
+// Send head and every other access of the same type that is ready for the
+// same client as one OCSE_MEMORY_*_BULK message.  Returns -1 without
+// sending anything when there is nothing to batch with head, so the caller
+// can use the per-line message instead.
+static int _send_mem_bulk(struct cmd *cmd, struct client *client,
+			  struct cmd_event *head)
+{
+	struct cmd_event *event, **tail;
+	enum mem_state ready;
+	uint8_t *buffer, *bp;
+	uint64_t addr, offset;
+	uint32_t body;
+	uint16_t count, size;
+	int len, write;
+
+	write = (head->type == CMD_WRITE);
+	ready = write ? MEM_RECEIVED : MEM_IDLE;
+
+	// Chain the accesses through _bulk_next, head first
+	count = 1;
+	len = 7 + 10 + (write ? head->size : 0);
+	head->_bulk_next = NULL;
+	tail = &(head->_bulk_next);
+	for (event = head->_next; (event != NULL) &&
+	     (count < OCSE_BULK_MAX_SEGS); event = event->_next) {
+		if ((event->type != head->type) || (event->state != ready) ||
+		    (event->context != head->context))
+			continue;
+		if (_inject_mem_fault(cmd, event))
+			continue;
+		event->_bulk_next = NULL;
+		*tail = event;
+		tail = &(event->_bulk_next);
+		len += 10 + (write ? event->size : 0);
+		++count;
+	}
+	if (count == 1)
+		return -1;
+
+	buffer = (uint8_t *) malloc(len);
+	buffer[0] = write ? OCSE_MEMORY_WRITE_BULK : OCSE_MEMORY_READ_BULK;
+	count = htons(count);
+	memcpy(&(buffer[1]), &count, sizeof(count));
+	body = htonl(len - 7);
+	memcpy(&(buffer[3]), &body, sizeof(body));
+	bp = &(buffer[7]);
+	for (event = head; event != NULL; event = event->_bulk_next) {
+		size = htons(event->size);
+		memcpy(bp, &size, sizeof(size));
+		bp += sizeof(size);
+		addr = htonll(event->addr);
+		memcpy(bp, &addr, sizeof(addr));
+		bp += sizeof(addr);
+		if (write) {
+			// partial writes sit at their cacheline offset
+			offset = 0;
+			if (event->size <= 32)
+				offset = event->addr & ~CACHELINE_MASK;
+			memcpy(bp, &(event->data[offset]), event->size);
+			bp += event->size;
+			event->state = DMA_MEM_RESP;
+		} else {
+			event->state = MEM_REQUEST;
+		}
+		event->abort = &(client->abort);
+		debug_msg("%s:MEMORY %s BULK afutag=0x%04x size=%d addr=0x%016"PRIx64,
+			  cmd->afu_name, write ? "WRITE" : "READ", event->afutag,
+			  event->size, event->addr);
+		debug_cmd_client(cmd->dbg_fp, cmd->dbg_id, event->afutag,
+				 event->context);
+	}
+
+	if (put_bytes(client->fd, len, buffer, cmd->dbg_fp, cmd->dbg_id,
+		      client->context) < 0) {
+		client_drop(client, TLX_IDLE_CYCLES, CLIENT_NONE);
+	}
+	free(buffer);
+	client->mem_access = (void *)head;
+	return 0;
+}
+
 void handle_buffer_write(struct cmd *cmd)
 {
 	struct cmd_event *event;
@@ -800,40 +919,8 @@ void handle_buffer_write(struct cmd *cmd)
 
 	if ((event->state == MEM_IDLE) && (client->mem_access == NULL)) {
 	        // Check to see if this cmd gets selected for a RETRY or FAILED or PENDING or DERROR read_failed response
-		if ( allow_retry(cmd->parms)) {
-			event->state = MEM_DONE;
-			event->type = CMD_FAILED;
-			event->resp_opcode = TLX_RSP_READ_FAILED;
-			event->resp = 0x02;
-			debug_msg("handle_buffer_write:RETRY this cmd =0x%x \n", event->command);
-			return;
-		}
-		if ( allow_failed(cmd->parms)) {
-			event->state = MEM_DONE;
-			event->type = CMD_FAILED;
-			event->resp_opcode = TLX_RSP_READ_FAILED;
-			event->resp = 0x0e;
-			debug_msg("handle_buffer_write: FAIL this cmd =0x%x \n", event->command);
-			return;
-		}
-		if ( allow_derror(cmd->parms)) {
-			event->state = MEM_DONE;
-			event->type = CMD_FAILED;
-			event->resp_opcode = TLX_RSP_READ_FAILED;
-			event->resp = 0x08;
-			debug_msg("handle_buffer_write: DERROR this cmd =0x%x \n", event->command);
-			return;
-		}
-		// for xlate_pending response, ocse has to THEN follow up with an xlate_done response
-		// (at some unknown time later) and that will "complete" the original cmd (no rd/write )
-		if ( allow_pending(cmd->parms)) {
-		        event->state = MEM_XLATE_PENDING;
-			event->type = CMD_FAILED;
-			event->resp_opcode = TLX_RSP_READ_FAILED;
-			event->resp = 0x04;
-			debug_msg("handle_buffer_write: send XLATE_PENDING for this cmd =0x%x \n", event->command);
+		if (_inject_mem_fault(cmd, event))
 			return;
-		}
 	}
 
 	// after the client returns data with a call to the function _handle_mem_read,
@@ -912,6 +999,10 @@ void handle_buffer_write(struct cmd *cmd)
 		// to point to this event blocking any other memory
 		// accesses to client until data is returned by call
 		// to the _handle_mem_read() function.
+		// Clients that support it get every pending read at once.
+		if ((event->type == CMD_READ) && client->bulk &&
+		    (_send_mem_bulk(cmd, client, event) == 0))
+			return;
                 if (event->type == CMD_READ) {
 		    buffer[0] = (uint8_t) OCSE_MEMORY_READ;
 
@@ -1032,48 +1123,20 @@ void handle_afu_tlx_write_cmd(struct cmd *cmd)
 		return;
 	}
 	debug_msg("entering HANDLE_AFU_TLX_WRITE_CMD");
-	// Check to see if this cmd gets selected for a RETRY or FAILED or PENDING read_failed response
-	if ( allow_retry(cmd->parms)) {
-		event->state = MEM_DONE;
-		event->type = CMD_FAILED;
-		event->resp_opcode = TLX_RSP_WRITE_FAILED;
-		event->resp = 0x02;
-		debug_msg("handle_afu_tlx_write_cmd: RETRY this cmd =0x%x \n", event->command);
-		return;
-	}
-	if ( allow_failed(cmd->parms)) {
-		event->state = MEM_DONE;
-		event->type = CMD_FAILED;
-		event->resp_opcode = TLX_RSP_WRITE_FAILED;
-		event->resp = 0x0e;
-		debug_msg("handle_afu_tlx_write_cmd: FAIL this cmd =0x%x \n", event->command);
-		return;
-	}
-	if ( allow_derror(cmd->parms)) {
-		event->state = MEM_DONE;
-		event->type = CMD_FAILED;
-		event->resp_opcode = TLX_RSP_WRITE_FAILED;
-		event->resp = 0x08;
-		debug_msg("handle_afu_tlx_write_cmd: DERROR this cmd =0x%x \n", event->command);
-		return;
-	}
-
-	// for xlate_pending response, ocse has to THEN follow up with an xlate_done response
-	// (at some unknown time later) and that will "complete" the original cmd (no rd/write )
-	if ( allow_pending(cmd->parms)) {
-		event->state = MEM_XLATE_PENDING;
-		event->type = CMD_FAILED;
-		event->resp_opcode = TLX_RSP_WRITE_FAILED;
-		event->resp = 0x04;
-		debug_msg("handle_afu_tlx_write_cmd: send XLATE_PENDING for this cmd =0x%x \n", event->command);
+	// Check to see if this cmd gets selected for a RETRY or FAILED or PENDING write_failed response
+	if (_inject_mem_fault(cmd, event))
 		return;
-	}
 
 	// Send buffer read request to AFU.  Setting cmd->buffer_read
 	// will block any more buffer read requests until buffer read
 	// data is returned and handled in handle_buffer_data().
 	debug_msg("%s:BUFFER READY TO GO TO CLIENT afutag=0x%04x addr=0x%016"PRIx64, cmd->afu_name,
 		  event->afutag, event->addr);
+	if ((event->type == CMD_WRITE) && client->bulk &&
+	    (_send_mem_bulk(cmd, client, event) == 0)) {
+		cmd->buffer_read = NULL;
+		return;
+	}
 	if (event->type == CMD_WRITE) {
 		buffer = (uint8_t *) malloc(event->size + 11);
 		buffer[0] = (uint8_t) OCSE_MEMORY_WRITE;
@@ -1811,6 +1874,36 @@ void handle_mem_return(struct cmd *cmd, struct cmd_event *event, int fd)
 	debug_cmd_return(cmd->dbg_fp, cmd->dbg_id, event->afutag, event->context);
 }
 
+// Decide what to do with the reply to a bulk memory message.  It carries
+// one status byte per access in request order, then the data of each
+// successful read, so each access is finished exactly as a per-line reply.
+void handle_mem_bulk_return(struct cmd *cmd, struct cmd_event *head, int fd)
+{
+	struct cmd_event *event, *next;
+	uint8_t status[OCSE_BULK_MAX_SEGS];
+	int count, i;
+
+	if (head == NULL)
+		return;
+
+	count = 0;
+	for (event = head; event != NULL; event = event->_bulk_next)
+		++count;
+	if (get_bytes_silent(fd, count, status, cmd->parms->timeout,
+			     head->abort) < 0)
+		memset(status, OCSE_MEM_FAILURE, count);
+
+	i = 0;
+	for (event = head; event != NULL; event = next) {
+		next = event->_bulk_next;
+		event->_bulk_next = NULL;
+		if (status[i++] == OCSE_MEM_SUCCESS)
+			handle_mem_return(cmd, event, fd);
+		else
+			handle_aerror(cmd, event);
+	}
+}
+
 // Mark memory event as address error in preparation for response
 void handle_aerror(struct cmd *cmd, struct cmd_event *event)
 {
@@ -103,6 +103,7 @@ struct cmd_event {
 	enum mem_state state;
 	enum client_state client_state;
 	struct cmd_event *_next;
+	struct cmd_event *_bulk_next;	// next access in the same bulk message
 };
 
 struct cmd {
@@ -148,6 +149,8 @@ void handle_interrupt(struct cmd *cmd);
 
 void handle_mem_return(struct cmd *cmd, struct cmd_event *event, int fd);
 
+void handle_mem_bulk_return(struct cmd *cmd, struct cmd_event *head, int fd);
+
 void handle_aerror(struct cmd *cmd, struct cmd_event *event);
 
 void handle_response(struct cmd *cmd);
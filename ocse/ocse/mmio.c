@@ -59,6 +59,7 @@ struct mmio *mmio_init(struct AFU_EVENT *afu_event, int timeout, char *afu_name,
 	mmio->dbg_fp = dbg_fp;
 	mmio->dbg_id = dbg_id;
 	mmio->timeout = timeout;
+	pthread_cond_init(&(mmio->done), NULL);
 	return mmio;
 }
 
@@ -264,10 +265,13 @@ static struct mmio_event *_add_mem(struct mmio *mmio, struct client *client,
   return _add_mem_event(mmio, client, rnw, size, region, addr, data, be_valid, be);
 }
 
-static void _wait_for_done(enum ocse_state *state, pthread_mutex_t * lock)
+// Sleep until the OCL thread completes the event.  The timeout only
+// bounds a missed broadcast, it is not how progress is made.
+static void _wait_for_done(struct mmio *mmio, enum ocse_state *state,
+			   pthread_mutex_t * lock)
 {
 	while (*state != OCSE_DONE)	/* infinite loop */
-		lock_delay(lock);
+		lock_wait(lock, &(mmio->done), OCL_IDLE_POLL_MS);
 }
 
 // Read the AFU descriptor template 0 from the afu information DVSEC
@@ -287,19 +291,19 @@ static struct mmio_event *_read_afu_descriptor(struct mmio *mmio, uint64_t addr,
   debug_msg("_read_afu_descriptor: AFU descriptor offset 0x%016lx indirect read", offset);
   debug_msg("   AFU Information DVSEC write 0x%08x @ 0x%016lx", offset, addr);
   event0c = _add_cfg(mmio, 0, 0, addr, offset);
-  _wait_for_done(&(event0c->state), lock);
+  _wait_for_done(mmio, &(event0c->state), lock);
   debug_msg("   AFU Information DVSEC write 0x%08x @ 0x%016lx complete", offset, addr);
   free(event0c);
 
   // step 2: read the afu descriptor offset register looking for the data valid bit to become 1
   event0c = _add_cfg(mmio, 1, 0, addr, 0L);
-  _wait_for_done(&(event0c->state), lock);
+  _wait_for_done(mmio, &(event0c->state), lock);
   debug_msg("   AFU Information DVSEC read @ 0x%016lx = 0x%08x", addr, event0c->cmd_data);
   
   while ((event0c->cmd_data & AFU_DESC_DATA_VALID) == 0) {
     free(event0c);
     event0c = _add_cfg(mmio, 1, 0, addr, 0L);
-    _wait_for_done(&(event0c->state), lock);
+    _wait_for_done(mmio, &(event0c->state), lock);
     debug_msg("   AFU Information DVSEC read @ 0x%016lx = 0x%08x", addr, event0c->cmd_data);
   }
   free(event0c);
@@ -307,7 +311,7 @@ static struct mmio_event *_read_afu_descriptor(struct mmio *mmio, uint64_t addr,
 
   // step 3: read the data from the afu descriptor data register
   event10 = _add_cfg(mmio, 1, 0, addr + 4, 0L);  // assuming the data register is adjacent to the offset register
-  _wait_for_done(&(event10->state), lock);
+  _wait_for_done(mmio, &(event10->state), lock);
   debug_msg("   AFU Information DVSEC afu descriptor data read 0x%08x @ 0x%016lx complete", event10->cmd_data, addr + 4);
 
   return event10;
@@ -378,7 +382,7 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 		// read open capi configuration space header
 		debug_msg("_read_config_space_header:  pa 0x%016lx ", cmd_pa_fcn);
 		eventa  = _add_cfg(mmio, 1, 0, cmd_pa_fcn, 0L); // opencapi configuration header
-  		_wait_for_done( &(eventa->state), lock );
+  		_wait_for_done( mmio, &(eventa->state), lock );
 		device_id = (uint16_t)( ( eventa->cmd_data >> 16 ) & 0x0000FFFF);
 		vendor_id = (uint16_t)( eventa->cmd_data & 0x0000FFFF );
 		free( eventa );
@@ -403,7 +407,7 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 			  // Read extended capabilities - offset + 0x100  [31:20] next ec offset, [7:0] this ec ID
 			  cmd_pa_ec = cmd_pa_fcn + next_capability_offset;
 			  eventa  = _add_cfg( mmio, 1, 0, cmd_pa_ec, 0L ); // extended capabilities
-			  _wait_for_done( &(eventa->state), lock );
+			  _wait_for_done( mmio, &(eventa->state), lock );
 			
 			  ec_id = (uint16_t)( eventa->cmd_data & 0x0000FFFF );
 			  
@@ -416,7 +420,7 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 				case 0x001b: 
 				     info_msg("    Found a PASID extended capability 0x%04x at offset 0x%04x", ec_id, next_capability_offset );
 				     eventb = _add_cfg( mmio, 1, 0, cmd_pa_ec + 0x04, 0L ); 
-				     _wait_for_done(&(eventb->state), lock);
+				     _wait_for_done(mmio, &(eventb->state), lock);
 				     mmio->fcn_cfg_array[f]->max_pasid_width = eventb->cmd_data >> 8;
 				     ocl->max_clients = ocl->max_clients + ( 1 << mmio->fcn_cfg_array[f]->max_pasid_width );
 				     // this functions max clients is 1 << max_pasid_width
@@ -427,24 +431,24 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 				     info_msg("    Found a OpenCAPI DVSEC 0x%04x at offset 0x%04x", ec_id, next_capability_offset );
 				     // we need to read the dvsec id to learn what to do next
 				     eventb = _add_cfg( mmio, 1, 0, cmd_pa_ec + 0x08, 0L ); 
-				     _wait_for_done( &(eventb->state), lock );
+				     _wait_for_done( mmio, &(eventb->state), lock );
 				     switch ( eventb->cmd_data & 0x0000FFFF ) {
 				          case 0xF000: 
 					       info_msg("    Found OpenCAPI TL DVSEC ");
 					       // make these subroutines ???
 					       eventc = _add_cfg( mmio, 1, 0, cmd_pa_ec + 0x0c, 0L ); 
-					       _wait_for_done( &(eventc->state), lock );
+					       _wait_for_done( mmio, &(eventc->state), lock );
 					       mmio->fcn_cfg_array[f]->tl_major_version_capability = ( eventc->cmd_data & 0xff000000 ) >> 24;
 					       mmio->fcn_cfg_array[f]->tl_minor_version_capability = ( eventc->cmd_data & 0x00ff0000 ) >> 16;
 					       free( eventc );
 
 					       eventc = _add_cfg( mmio, 1, 0, cmd_pa_ec + 0x24, 0L ); 
-					       _wait_for_done( &(eventc->state), lock );
+					       _wait_for_done( mmio, &(eventc->state), lock );
 					       mmio->fcn_cfg_array[f]->tl_xmit_template_cfg = eventc->cmd_data;
 					       free( eventc );
 
 					       eventc = _add_cfg( mmio, 1, 0, cmd_pa_ec + 0x6c, 0L ); 
-					       _wait_for_done( &(eventc->state), lock );
+					       _wait_for_done( mmio, &(eventc->state), lock );
 					       mmio->fcn_cfg_array[f]->tl_xmit_rate_per_template_cfg = eventc->cmd_data;
 					       free( eventc );
 					       info_msg( "    major = 0x%02x, minor = 0x%02x, xmit_template_cfg = 0x%08x, xmit_rate_per_template_cfg = 0x%08x", 
@@ -469,20 +473,20 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 						     // one or more afu's are present, discover and set the BAR's
 						     // write all 1's to the bar lo/hi
 						     eventc  = _add_cfg(mmio, 0, 0, cmd_pa_fcn + 0x10, 0xFFFFFFFF );
-						     _wait_for_done( &(eventc->state), lock );
+						     _wait_for_done( mmio, &(eventc->state), lock );
 						     free( eventc );
 						     eventc  = _add_cfg(mmio, 0, 0, cmd_pa_fcn + 0x14, 0xFFFFFFFF );
-						     _wait_for_done( &(eventc->state), lock );
+						     _wait_for_done( mmio, &(eventc->state), lock );
 						     free( eventc );
 						     
 						     // read bar lo/hi
 						     eventc  = _add_cfg(mmio, 1, 0, cmd_pa_fcn + 0x10, 0x00 );
-						     _wait_for_done( &(eventc->state), lock );
+						     _wait_for_done( mmio, &(eventc->state), lock );
 						     // the low order 4 bits of cmd_data have some reserved data not related to the window, mask them off
 						     bar0 = eventc->cmd_data & 0xFFFFFFF0;
 						     free( eventc );
 						     eventc  = _add_cfg(mmio, 1, 0, cmd_pa_fcn + 0x14, 0x00 );
-						     _wait_for_done( &(eventc->state), lock );
+						     _wait_for_done( mmio, &(eventc->state), lock );
 						     bar0 = bar0 | ( eventc->cmd_data << 32 );
 						     free( eventc );
 		      
@@ -493,10 +497,10 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 						     //    OpenCAPI Configuration Header 0x14 = bar0 high
 						     mmio->fcn_cfg_array[f]->bar0 = bar;
 						     eventc  = _add_cfg(mmio, 0, 0, cmd_pa_fcn + 0x10, mmio->fcn_cfg_array[f]->bar0 & 0xFFFFFFFF );
-						     _wait_for_done( &(eventc->state), lock );
+						     _wait_for_done( mmio, &(eventc->state), lock );
 						     free( eventc );
 						     eventc  = _add_cfg(mmio, 0, 0, cmd_pa_fcn + 0x14, mmio->fcn_cfg_array[f]->bar0 >> 32 );
-						     _wait_for_done( &(eventc->state), lock );
+						     _wait_for_done( mmio, &(eventc->state), lock );
 						     free( eventc );
 						     
 						     // add the size of the current window to bar
@@ -508,7 +512,7 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 								
 						     // one or more afu's are present, so set the memory space bit in the configuration space header
 						     eventc  = _add_cfg(mmio, 0, 0, cmd_pa_fcn + 0x04, 0x00000002 );
-						     _wait_for_done( &(eventc->state), lock );
+						     _wait_for_done( mmio, &(eventc->state), lock );
 						     free( eventc );
 						     info_msg( "    Enabled memory space for function %d", f );	
 					       }
@@ -537,18 +541,18 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 
 					      // read 0x10
 					      eventc = _add_cfg( mmio, 1, 0, cmd_pa_ec + 0x10, 0L ); 
-					      _wait_for_done( &(eventc->state), lock );
+					      _wait_for_done( mmio, &(eventc->state), lock );
 					      mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->pasid_len_supported = ( eventc->cmd_data ) & 0x1F;
 					      free( eventc );
 					      // read 0x18
 					      eventc = _add_cfg( mmio, 1, 0, cmd_pa_ec + 0x18, 0L ); 
-					      _wait_for_done( &(eventc->state), lock );
+					      _wait_for_done( mmio, &(eventc->state), lock );
 					      mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->actag_length_supported = ( eventc->cmd_data ) & 0xFFF;
 					      free( eventc );
 					      // read afu descriptor data for this afu
 					      //     write afu_index to afu_information_ec_pa.afu_info_index
 					      eventc = _add_cfg( mmio, 0, 0, mmio->fcn_cfg_array[f]->afu_information_dvsec_pa + 0x08, afu_index << 16 ); 
-					      _wait_for_done( &(eventc->state), lock );
+					      _wait_for_done( mmio, &(eventc->state), lock );
 					      free( eventc );
 
 					      //     read name space
@@ -626,13 +630,13 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 					      mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->pasid_len_enabled = 
 						mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->pasid_len_supported;
 					      eventc = _add_cfg( mmio, 0, 0, cmd_pa_ec + 0x10, mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->pasid_len_enabled << 8 ); 
-					      _wait_for_done( &(eventc->state), lock );
+					      _wait_for_done( mmio, &(eventc->state), lock );
 					      free( eventc );
 
 					      //   write pasid base...  
 					      mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->pasid_base = pasid;
 					      eventc = _add_cfg( mmio, 0, 0, cmd_pa_ec + 0x14, mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->pasid_base ); 
-					      _wait_for_done( &(eventc->state), lock );
+					      _wait_for_done( mmio, &(eventc->state), lock );
 					      free( eventc );
 
 					      info_msg( "    afu %d pasid base = 0x%05x, pasid length supported = 0x%02x, pasid length enabled = 0x%02x", 
@@ -650,13 +654,13 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 					      mmio->fcn_cfg_array[f]->function_actag_length_enabled = 
 						mmio->fcn_cfg_array[f]->function_actag_length_enabled + mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->actag_length_enabled;
 					      eventc = _add_cfg( mmio, 0, 0, cmd_pa_ec + 0x18, mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->actag_length_enabled << 16 ); 
-					      _wait_for_done( &(eventc->state), lock );
+					      _wait_for_done( mmio, &(eventc->state), lock );
 					      free( eventc );
 					      
 					      // actag base...  
 					      mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->actag_base = actag;
 					      eventc = _add_cfg( mmio, 0, 0, cmd_pa_ec + 0x1c, mmio->fcn_cfg_array[f]->afu_cfg_array[afu_index]->actag_base ); 
-					      _wait_for_done( &(eventc->state), lock );
+					      _wait_for_done( mmio, &(eventc->state), lock );
 					      free( eventc );
 
 					      info_msg( "    afu %d actag base = 0x%03x, actag length supported = 0x%03x, actag length enabled = 0x%03x", 
@@ -670,7 +674,7 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 
 					      //   rwrite afu_control_dvsec(0x0c) enable afu - can I really do this here?
 					      eventc = _add_cfg(mmio, 0, 0, cmd_pa_ec + 0x0c, 0x01000000);
-					      _wait_for_done(&(eventc->state), lock);
+					      _wait_for_done(mmio, &(eventc->state), lock);
 					      info_msg("    afu %d enabled", afu_index );
 
 					      break;
@@ -702,7 +706,7 @@ int read_afu_config(struct ocl *ocl, uint8_t bus, pthread_mutex_t * lock)
 		      eventa  = _add_cfg( mmio, 0, 0, mmio->fcn_cfg_array[f]->function_dvsec_pa + 0x0c, 
 					  ( ( (uint32_t)mmio->fcn_cfg_array[f]->function_actag_base << 16 ) | 
 					    (uint32_t)mmio->fcn_cfg_array[f]->function_actag_length_enabled ) );
-		      _wait_for_done( &(eventa->state), lock );
+		      _wait_for_done( mmio, &(eventa->state), lock );
 		      free( eventa );
 
 		      info_msg( "    function %d actag base = 0x%04x, actag length enabled = 0x%04x ", 
@@ -217,6 +217,7 @@ struct mmio {
         //struct afu_cfg_sp cfg;
 	//struct fun_cfg_sp *fun_array;
 	struct mmio_event *list;
+	pthread_cond_t done;	// broadcast by the OCL thread on AFU events
 	char *afu_name;
 	FILE *dbg_fp;
 	uint8_t dbg_id;
@@ -28,6 +28,7 @@
 
 #include <arpa/inet.h>
 #include <assert.h>
+#include <errno.h>
 #include <inttypes.h>
 #include <poll.h>
 #include <stdlib.h>
@@ -149,7 +150,7 @@ static void _handle_afu(struct ocl *ocl)
 	}
 }
 
-static void _handle_client(struct ocl *ocl, struct client *client)
+static void _handle_client(struct ocl *ocl, struct client *client, short revents)
 {
 	struct mmio_event *mmio;
 	struct cmd_event *cmd;
@@ -173,7 +174,7 @@ static void _handle_client(struct ocl *ocl, struct client *client)
 	dw = 0;
 	global = 0;
 	region = 0;
-	if (bytes_ready(client->fd, 1, &(client->abort))) {
+	if (revents || client->abort) {
 		if (get_bytes(client->fd, 1, buffer, ocl->timeout,
 			      &(client->abort), ocl->dbg_fp, ocl->dbg_id,
 			      client->context) < 0) {
@@ -198,6 +199,11 @@ static void _handle_client(struct ocl *ocl, struct client *client)
 				handle_mem_return(ocl->cmd, cmd, client->fd);
 			client->mem_access = NULL;
 			break;
+		case OCSE_MEM_BULK_DONE:
+			if (client->mem_access != NULL)
+				handle_mem_bulk_return(ocl->cmd, cmd, client->fd);
+			client->mem_access = NULL;
+			break;
 		case OCSE_MMIO_MAP:
 		case OCSE_GLOBAL_MMIO_MAP:
 			handle_mmio_map(ocl->mmio, client);
@@ -255,11 +261,98 @@ static void _handle_client(struct ocl *ocl, struct client *client)
 	}
 }
 
+// Poll the wake channel and every client socket.  Returns with pfd[i+1]
+// holding the events for client[i].  The lock is released while blocking
+// so other threads can queue work and signal the wake channel.
+static struct pollfd *_poll_events(struct ocl *ocl, struct pollfd *wake_pfd,
+				   int timeout)
+{
+	struct pollfd *pfd;
+	int i, nfds, rc;
+
+	pfd = (ocl->pfd != NULL) ? ocl->pfd : wake_pfd;
+	pfd[0].fd = ocl->wake.rfd;
+	pfd[0].events = POLLIN;
+	pfd[0].revents = 0;
+	nfds = 1;
+	if (ocl->pfd != NULL) {
+		for (i = 0; i < ocl->max_clients; i++) {
+			pfd[i + 1].fd = -1;
+			if (ocl->client[i] != NULL)
+				pfd[i + 1].fd = ocl->client[i]->fd;
+			// Data already in a shared memory ring won't wake poll()
+			if ((pfd[i + 1].fd >= 0) && bytes_pending(pfd[i + 1].fd))
+				timeout = 0;
+			pfd[i + 1].events = POLLIN | POLLHUP;
+			pfd[i + 1].revents = 0;
+		}
+		nfds += ocl->max_clients;
+	}
+
+	if (timeout)
+		pthread_mutex_unlock(ocl->lock);
+	do {
+		rc = poll(pfd, nfds, timeout);
+	}
+	while ((rc < 0) && (errno == EINTR));
+	if (timeout)
+		pthread_mutex_lock(ocl->lock);
+
+	for (i = 1; i < nfds; i++) {
+		if (pfd[i].fd >= 0)
+			pfd[i].revents = poll_revents(pfd[i].fd,
+						      pfd[i].revents);
+	}
+	if (pfd[0].revents)
+		wake_drain(&(ocl->wake));
+	return pfd;
+}
+
+// Does OCSE have anything to drive to the AFU on the next clock?
+static int _afu_input_pending(struct ocl *ocl)
+{
+	struct AFU_EVENT *afu_event = ocl->afu_event;
+
+	if (afu_event->tlx_cfg_valid || afu_event->tlx_afu_cmd_valid ||
+	    afu_event->tlx_afu_cmd_data_valid || afu_event->tlx_afu_resp_valid ||
+	    afu_event->tlx_afu_resp_data_valid || afu_event->tlx_afu_credit_valid)
+		return 1;
+	if ((ocl->mmio->list != NULL) ||
+	    ((ocl->cmd != NULL) && (ocl->cmd->list != NULL)))
+		return 1;
+	return 0;
+}
+
+// AFU said it does nothing until driven and there is nothing to drive
+static int _afu_waiting(struct ocl *ocl)
+{
+	return ocl->afu_event->burst_ok &&
+	    (ocl->afu_event->afu_tlx_quiet == TLX_QUIET_WAIT) &&
+	    !_afu_input_pending(ocl);
+}
+
+// Extra cycles the AFU may run on the next clock without answering
+static uint32_t _burst_cycles(struct ocl *ocl)
+{
+	uint32_t burst;
+
+	if (!ocl->afu_event->burst_ok || _afu_input_pending(ocl))
+		return 0;
+	burst = ocl->afu_event->afu_tlx_quiet;
+	if (burst > OCL_MAX_BURST)
+		burst = OCL_MAX_BURST;
+	// Without clients idle_cycles is counting down to stopping clocks
+	if ((ocl->attached_clients == 0) && (burst >= (uint32_t)ocl->idle_cycles))
+		burst = ocl->idle_cycles - 1;
+	return burst;
+}
+
 // TLX thread loop
 static void *_ocl_loop(void *ptr)
 {
 	struct ocl *ocl = (struct ocl *)ptr;
 	struct cmd_event *event, *temp;
+	struct pollfd wake_pfd, *pfd;
 	int events, i, stopped, reset;
 	uint8_t ack = OCSE_DETACH;
 
@@ -283,37 +376,57 @@ static void *_ocl_loop(void *ptr)
 			stopped = 0;
 		  }
 		}
-		if (ocl->idle_cycles) {
-			// Clock AFU
+		// An AFU waiting for events isn't clocked until there is
+		// something to drive, _poll_events() below sleeps until then
+		if (ocl->idle_cycles && !_afu_waiting(ocl)) {
+			// Clock AFU.  afu_event is only touched by this thread
+			// so the lock is dropped for the socket round trip,
+			// which is where other threads get to run.
+			ocl->afu_event->tlx_afu_burst = _burst_cycles(ocl);
+			pthread_mutex_unlock(ocl->lock);
 			tlx_signal_afu_model(ocl->afu_event);
 			// Check for events from AFU
 			events = tlx_get_afu_events(ocl->afu_event);
+			pthread_mutex_lock(ocl->lock);
 			// Error on socket
 			if (events < 0) {
 				warn_msg("Lost connection with AFU");
 				break;
 			}
-			// Handle events from AFU
-			if (events > 0)
+			// Handle events from AFU and wake _wait_for_done()
+			if (events > 0) {
 				_handle_afu(ocl);
+				pthread_cond_broadcast(&(ocl->mmio->done));
+			}
 
 			// Drive events to AFU
 			send_mmio(ocl->mmio);
 
-			if (ocl->mmio->list == NULL)
+			if (ocl->mmio->list == NULL) {
 				ocl->idle_cycles--;
-		} else {
+				// Cycles the AFU ran in a burst count too
+				if (ocl->afu_event->afu_tlx_burst_ran >=
+				    (uint32_t)ocl->idle_cycles)
+					ocl->idle_cycles = 0;
+				else
+					ocl->idle_cycles -= ocl->afu_event->afu_tlx_burst_ran;
+			}
+		} else if (ocl->idle_cycles == 0) {
 			if (!stopped)
 				info_msg("Stopping clocks to %s", ocl->name);
 			stopped = 1;
-			lock_delay(ocl->lock);
 		}
 
+		// Sample sockets while clocking, otherwise sleep until a
+		// client sends something or another thread signals us
+		pfd = _poll_events(ocl, &wake_pfd,
+				   (ocl->idle_cycles && !_afu_waiting(ocl)) ?
+				   0 : OCL_IDLE_POLL_MS);
+
 		// Skip client section if AFU descriptor hasn't been read yet
-		if (ocl->client == NULL) {
-			lock_delay(ocl->lock);
+		// (or was only read while poll() had the lock released)
+		if ((ocl->client == NULL) || (pfd != ocl->pfd))
 			continue;
-		}
 		// Check for event from application
 		reset = 0;
 		for (i = 0; i < ocl->max_clients; i++) {
@@ -334,7 +447,10 @@ static void *_ocl_loop(void *ptr)
 			}
 			if (ocl->state == OCSE_RESET)
 				continue;
-			_handle_client(ocl, ocl->client[i]);
+			// Slot may have been reassigned while poll() was unlocked
+			if (pfd[i + 1].fd != ocl->client[i]->fd)
+				pfd[i + 1].revents = 0;
+			_handle_client(ocl, ocl->client[i], pfd[i + 1].revents);
 			while (ocl->client[i]->idle_cycles) {
 				ocl->client[i]->idle_cycles--;
 			}
@@ -368,8 +484,6 @@ static void *_ocl_loop(void *ptr)
 			ocl->cmd->list = NULL;
 			info_msg("No longer sending reset to AFU");
 		}
-
-		lock_delay(ocl->lock);
 	}
 
 	// Disconnect clients
@@ -389,6 +503,12 @@ static void *_ocl_loop(void *ptr)
 	info_msg("Disconnecting %s @ %s:%d", ocl->name, ocl->host, ocl->port);
 	if (ocl->client)
 		free(ocl->client);
+	if (ocl->pfd)
+		free(ocl->pfd);
+	// On OCSE_DONE the SIGINT handler still signals the wake channel,
+	// it closes it after joining this thread
+	if (ocl->state != OCSE_DONE)
+		wake_close(&(ocl->wake));
 	if (ocl->_prev)
 		ocl->_prev->_next = ocl->_next;
 	if (ocl->_next)
@@ -397,6 +517,7 @@ static void *_ocl_loop(void *ptr)
 		free(ocl->cmd);
 	}
 	if (ocl->mmio) {
+		pthread_cond_destroy(&(ocl->mmio->done));
 		free(ocl->mmio);
 	}
 	if (ocl->host)
@@ -437,6 +558,10 @@ uint16_t ocl_init(struct ocl **head, struct parms *parms, char *id, char *host,
 		goto init_fail;
 	}
 	ocl->timeout = parms->timeout;
+	if (wake_init(&(ocl->wake)) < 0) {
+		perror("wake_init");
+		goto init_fail;
+	}
 	if ( (strlen(id) != 4) || strncmp(id, "tlx", 3) ) {
 		warn_msg("Invalid afu name: %s", id);
 		goto init_fail;
@@ -578,6 +703,8 @@ uint16_t ocl_init(struct ocl **head, struct parms *parms, char *id, char *host,
 		error_msg("AFU programming model is invalid");
 		goto init_fail;
 	}
+	ocl->pfd = (struct pollfd *)calloc(ocl->max_clients + 1,
+					   sizeof(struct pollfd));
 	ocl->client = (struct client **)calloc(ocl->max_clients,
 					       sizeof(struct client *));
 	ocl->cmd->client = ocl->client;
@@ -587,6 +714,7 @@ uint16_t ocl_init(struct ocl **head, struct parms *parms, char *id, char *host,
 
  init_fail:
 	if (ocl) {
+		wake_close(&(ocl->wake));
 		if (ocl->afu_event) {
 			tlx_close_afu_event(ocl->afu_event);
 			free(ocl->afu_event);
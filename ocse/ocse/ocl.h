@@ -17,6 +17,7 @@
 #ifndef _OCL_H_
 #define _OCL_H_
 
+#include <poll.h>
 #include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -27,6 +28,13 @@
 #include "parms.h"
 #include "../common/utils.h"
 
+// Longest a stopped OCL loop sleeps before rechecking state it was not
+// signalled about
+#define OCL_IDLE_POLL_MS 100
+
+// Most cycles an AFU that reported itself quiet may run on one clock
+// message before it has to answer
+#define OCL_MAX_BURST 1024
 
 struct ocl {
 	struct AFU_EVENT *afu_event;
@@ -39,6 +47,8 @@ struct ocl {
 	struct ocl **head;
 	struct ocl *_prev;
 	struct ocl *_next;
+	struct ocse_wake wake;		// signalled when the loop has new work
+	struct pollfd *pfd;		// wake + one slot per client
 	volatile enum ocse_state state;
 	uint32_t latency;
 	char *name;
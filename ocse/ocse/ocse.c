@@ -44,8 +44,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <termios.h>
 #include <time.h>
+#include <unistd.h>
 
 #include "client.h"
 #include "mmio.h"
@@ -67,7 +69,8 @@ FILE *fp;
 static void _INThandler(int sig)
 {
 	pthread_t thread;
-	struct ocl *ocl;
+	struct ocse_wake wake;
+	struct ocl *ocl, *next;
 	int i;
 
 	// Flush debug output
@@ -81,10 +84,17 @@ static void _INThandler(int sig)
 			if (ocl->client[i] != NULL)
 				ocl->client[i]->abort = 1;
 		}
-		ocl->state = OCSE_DONE;
+		// The woken thread frees ocl, so nothing in it may be
+		// touched once state is OCSE_DONE.  It leaves the wake
+		// channel open though, so it is closed here once joined.
 		thread = ocl->thread;
-		ocl = ocl->_next;
+		wake = ocl->wake;
+		next = ocl->_next;
+		ocl->state = OCSE_DONE;
+		wake_signal(&wake);
+		ocl = next;
 		pthread_join(thread, NULL);
+		wake_close(&wake);
 	}
 }
 
@@ -485,8 +495,9 @@ static struct client *_client_connect(int *fd, char *ip)
 		return NULL;
 	}
 	rc = get_bytes_silent(*fd, 2, buffer, timeout, 0);
+	// Older minor versions are accepted and use per-line memory messages
 	if ((rc < 0) || ((uint8_t) buffer[0] != OCSE_VERSION_MAJOR) ||
-	    ((uint8_t) buffer[1] != OCSE_VERSION_MINOR)) {
+	    ((uint8_t) buffer[1] > OCSE_VERSION_MINOR)) {
 		info_msg("Client is wrong version\n");
 		put_bytes(*fd, 1, ack, fp, -1, -1);
 		close_socket(fd);
@@ -500,6 +511,7 @@ static struct client *_client_connect(int *fd, char *ip)
 	client->timeout = timeout;
 	client->flushing = FLUSH_NONE;
 	client->state = CLIENT_INIT;
+	client->bulk = ((uint8_t) buffer[1] >= OCSE_VERSION_MINOR_BULK);
 
 	// lgt quick fix for bdf
 	client->bdf = 0x5001;
@@ -574,6 +586,7 @@ static int _client_associate(struct client *client)
 			client->state = CLIENT_VALID;
 			client->pending = 0;
 			ocl->client[i] = client;
+			wake_signal(&(ocl->wake));
 			break;
 		}
 	}
@@ -614,11 +627,13 @@ static void *_client_loop(void *ptr)
 
 	pthread_mutex_lock(&lock);
 	while (client->pending) {
-		rc = bytes_ready(client->fd, client->timeout, &(client->abort));
-		if (rc == 0) {
-			lock_delay(&lock);
+		// Don't hold the lock while waiting on the application
+		pthread_mutex_unlock(&lock);
+		rc = bytes_ready(client->fd, client->timeout ? client->timeout :
+				 OCL_IDLE_POLL_MS, &(client->abort));
+		pthread_mutex_lock(&lock);
+		if (rc == 0)
 			continue;
-		}
 		if ((rc < 0) || get_bytes(client->fd, 1, data, 10,
 					  &(client->abort), fp, -1, -1) < 0) {
 			client_drop(client, TLX_IDLE_CYCLES, CLIENT_NONE);
@@ -626,17 +641,14 @@ static void *_client_loop(void *ptr)
 		}
 		if (data[0] == OCSE_QUERY) {
 			_query(client);
-			lock_delay(&lock);
 			continue;
 		}
 		if (data[0] == OCSE_FIND) {
 			_find(client);
-			lock_delay(&lock);
 			continue;
 		}
 		if (data[0] == OCSE_FIND_NTH) {
 			_find_nth(client);
-			lock_delay(&lock);
 			continue;
 		}
 		if (data[0] == OCSE_OPEN) {
@@ -646,7 +658,6 @@ static void *_client_loop(void *ptr)
 		}
 		client->pending = 0;
 		break;
-		lock_delay(&lock);
 	}
 	pthread_mutex_unlock(&lock);
 
@@ -700,6 +711,33 @@ static int _start_server()
 	return listen_fd;
 }
 
+// Listen for clients on this host next to the TCP port, they get the
+// shared memory transport.  Failing here only costs them the fast path.
+static int _start_local_server(int listen_fd)
+{
+	struct sockaddr_in serv_addr;
+	struct sockaddr_un local_addr;
+	socklen_t len;
+	int local_fd;
+
+	len = sizeof(serv_addr);
+	if (getsockname(listen_fd, (struct sockaddr *)&serv_addr, &len) < 0)
+		return -1;
+	if ((local_fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+		return -1;
+	len = shm_socket_addr(&local_addr, ntohs(serv_addr.sin_port));
+	if ((bind(local_fd, (struct sockaddr *)&local_addr, len) < 0) ||
+	    (listen(local_fd, 4) < 0)) {
+		warn_msg("Unable to start local server, clients will use TCP");
+		close(local_fd);
+		return -1;
+	}
+	info_msg("Local clients use shared memory via @%s",
+		 &(local_addr.sun_path[1]));
+
+	return local_fd;
+}
+
 //
 // Main
 //
@@ -707,9 +745,10 @@ static int _start_server()
 int main(int argc, char **argv)
 {
 	struct sockaddr_in client_addr;
+	struct pollfd pfd[2];
 	struct client *client;
 	struct client **client_ptr;
-	int listen_fd, connect_fd;
+	int listen_fd, local_fd, connect_fd, local;
 	socklen_t client_len;
 	sigset_t set;
 	struct sigaction action;
@@ -782,21 +821,40 @@ int main(int argc, char **argv)
 		pthread_mutex_destroy(&lock);
 		return -1;
 	}
+	local_fd = _start_local_server(listen_fd);
+	pfd[0].fd = listen_fd;
+	pfd[0].events = POLLIN;
+	pfd[1].fd = local_fd;
+	pfd[1].events = POLLIN;
 	// Watch for client connections
 	while (ocl_list != NULL) {
 		// Wait for next client to connect
 		client_len = sizeof(client_addr);
 		pthread_mutex_unlock(&lock);
-		connect_fd = accept(listen_fd, (struct sockaddr *)&client_addr,
-				    &client_len);
+		connect_fd = -1;
+		local = 0;
+		pfd[0].revents = pfd[1].revents = 0;
+		if (poll(pfd, 2, -1) > 0) {
+			local = (pfd[1].revents != 0);
+			connect_fd = accept(pfd[local].fd,
+					    local ? NULL :
+					    (struct sockaddr *)&client_addr,
+					    local ? NULL : &client_len);
+		}
+		// Agree on shared memory before the OCSE handshake
+		if ((connect_fd >= 0) && local &&
+		    (shm_accept(connect_fd, OCSE_SHM_SETUP_MS) < 0))
+			close_socket(&connect_fd);
 		pthread_mutex_lock(&lock);
-		if (connect_fd < 0) {
-			lock_delay(&lock);
+		// poll() above blocks until the next connection
+		if (connect_fd < 0)
 			continue;
-		}
 		ip = (char *)malloc(INET_ADDRSTRLEN + 1);
-		inet_ntop(AF_INET, &(client_addr.sin_addr.s_addr), ip,
-			  INET_ADDRSTRLEN);
+		if (local)
+			strcpy(ip, "local");
+		else
+			inet_ntop(AF_INET, &(client_addr.sin_addr.s_addr), ip,
+				  INET_ADDRSTRLEN);
 		// Clean up disconnected clients
 		client_ptr = &client_list;
 		while (*client_ptr != NULL) {
@@ -807,7 +865,6 @@ int main(int argc, char **argv)
 				if (client->_next != NULL)
 					client->_next->_prev = client->_prev;
 				_free_client(client);
-				lock_delay(&lock);
 				continue;
 			}
 			client_ptr = &((*client_ptr)->_next);
@@ -826,10 +883,11 @@ int main(int argc, char **argv)
 				break;
 			}
 		}
-		lock_delay(&lock);
 	}
 	info_msg("No AFUs connected, Shutting down OCSE\n");
 	close_socket(&listen_fd);
+	if (local_fd >= 0)
+		close(local_fd);
 
 	// Shutdown unassociated client connections
 	while (client_list != NULL) {
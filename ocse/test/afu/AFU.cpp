@@ -46,6 +46,9 @@ uint8_t afu_enable_reset = 0;
 uint32_t wr_config_data;
 uint32_t bar_h0, bar_l0, bar_h1, bar_l1, bar_h2, bar_l2;
 uint64_t bar = 0x00000000ll;
+uint64_t fcn_bar0[8];		// BAR0 as ocse configured it, per function
+uint16_t fcn_bdf[8];
+uint8_t mmio_fcn = 0;		// function of the last mmio address
 uint8_t enable_bar = 0;
 uint8_t read_status_resp = 0;
 uint8_t write_status_resp = 0;
@@ -56,10 +59,20 @@ uint16_t gACTAG = 0;
 uint16_t gDUT = 0;
 uint16_t other_resp_completed = 0;
 
-AFU::AFU (int port, string filename, bool parity, bool jerror):
+AFU::AFU (int port, string filename, bool parity, bool jerror,
+          string cgemm_config):
     descriptor (filename),
-    context_to_mc ()
+    context_to_mc (),
+    cgemm (NULL)
 {
+    if (!cgemm_config.empty ()) {
+	cgemm = new CgemmAction (&descriptor);
+	if (!cgemm->configure (cgemm_config)) {
+	    error_msg ("AFU: bad cgemm configuration %s",
+		       cgemm_config.c_str ());
+	    exit (1);
+	}
+    }
 
     // initializes AFU socket connection as server
     if (tlx_serv_afu_event (&afu_event, port) == TLX_BAD_SOCKET)
@@ -116,9 +129,12 @@ AFU::start ()
     while (1) {
         fd_set watchset;
 
-        FD_ZERO (&watchset);
-        FD_SET (afu_event.sockfd, &watchset);
-        select (afu_event.sockfd + 1, &watchset, NULL, NULL, NULL);
+	// cycles in a clock burst don't come from the socket
+	if (!tlx_burst_pending (&afu_event)) {
+            FD_ZERO (&watchset);
+            FD_SET (afu_event.sockfd, &watchset);
+            select (afu_event.sockfd + 1, &watchset, NULL, NULL, NULL);
+	}
 
 	// check socket if there are new events from ocse to process
 	printf("getting tlx events\n");
@@ -133,40 +149,44 @@ AFU::start ()
             break;
         }
 
-	// get TLX initial cmd and data credits run once
+	// get TLX initial cmd and data credits run once, they come with
+	// tlx_afu_credit_valid, which may not be set on the first events
 	if(initial_credit_flag == 0) {
 	    debug_msg("AFU: afu read initial credit");
 	    if(tlx_afu_read_initial_credits(&afu_event, &tlx_afu_cmd_max_credit,
-		&tlx_afu_data_max_credit) != TLX_SUCCESS) {
-		error_msg("AFU: Failed tlx_afu_read_initial_credits");
+		&tlx_afu_resp_max_credit, &tlx_afu_cmd_data_max_credit,
+		&tlx_afu_resp_data_max_credit) == TLX_SUCCESS) {
+		TagManager::reset_tlx_credit(tlx_afu_cmd_max_credit, tlx_afu_resp_max_credit,
+		    tlx_afu_cmd_data_max_credit, tlx_afu_resp_data_max_credit);
+		info_msg("AFU: Receive TLX cmd and data initial credits");
+		debug_msg("AFU:  tlx_afu_cmd_max_credit = %d", tlx_afu_cmd_max_credit);
+		debug_msg("AFU:  tlx_afu_resp_max_credit = %d", tlx_afu_resp_max_credit);
+		debug_msg("AFU:  tlx_afu_cmd_data_max_credit = %d", tlx_afu_cmd_data_max_credit);
+		debug_msg("AFU:  tlx_afu_resp_data_max_credit = %d", tlx_afu_resp_data_max_credit);
+		initial_credit_flag = 1;
 	    }
-	    TagManager::reset_tlx_credit(tlx_afu_cmd_max_credit, tlx_afu_data_max_credit);
-	    info_msg("AFU: Receive TLX cmd and data initial credits");
-    	    debug_msg("AFU:  tlx_afu_cmd_max_credit = %d", tlx_afu_cmd_max_credit);
-    	    debug_msg("AFU:  tlx_afu_data_max_credit = %d", tlx_afu_data_max_credit);
-	    initial_credit_flag = 1;
 	}
 
 	// no new events to be processed
         if (rc <= 0)		
             continue;
 	
-	// Return TLX credit
+	// Return TLX credit, each flag arrives once per credit
 	if(afu_event.tlx_afu_resp_credit) {
 	    TagManager::release_tlx_credit(RESP_CREDIT);
-	    //afu_event.tlx_afu_resp_credit = 0;
+	    afu_event.tlx_afu_resp_credit = 0;
 	}
 	if(afu_event.tlx_afu_resp_data_credit) {
 	    TagManager::release_tlx_credit(RESP_DATA_CREDIT);
-	    //afu_event.tlx_afu_resp_data_credit = 0;
+	    afu_event.tlx_afu_resp_data_credit = 0;
 	}
 	if(afu_event.tlx_afu_cmd_credit) {
 	    TagManager::release_tlx_credit(CMD_CREDIT);
-	    //afu_event.tlx_afu_cmd_credit = 0;
+	    afu_event.tlx_afu_cmd_credit = 0;
 	}
 	if(afu_event.tlx_afu_cmd_data_credit) {
 	    TagManager::release_tlx_credit(CMD_DATA_CREDIT);
-	    //afu_event.tlx_afu_cmd_data_credit = 0;
+	    afu_event.tlx_afu_cmd_data_credit = 0;
 	}
 	// process config commands
 	if (afu_event.tlx_cfg_valid) {
@@ -184,7 +204,8 @@ AFU::start ()
 	// process tlx response
 	if (afu_event.tlx_afu_resp_valid) {
 	    debug_msg("AFU: Received TLX response 0x%x", afu_event.tlx_afu_resp_opcode);
-	    resolve_tlx_afu_resp();
+	    if (!(cgemm && cgemm->resolve_tlx_afu_resp (&afu_event)))
+		resolve_tlx_afu_resp();
 	    afu_event.afu_tlx_resp_credit = 1;	// return TLX resp credit
 	    afu_event.tlx_afu_resp_valid = 0;
 	}
@@ -242,7 +263,11 @@ AFU::start ()
 	}
 	// get machine context and create new MachineController
 	else if(state == READY) {
-	    if(get_machine_context()) {
+	    // the cgemm action runs its jobs out of the READY state
+	    if(cgemm) {
+		cgemm->cycle(&afu_event);
+	    }
+	    else if(get_machine_context()) {
 		if(gDUT==1) {
 		    printf("gDUT = %d\n", gDUT);
 		    gBDF = 1;
@@ -371,6 +396,13 @@ AFU::start ()
 		debug_msg("AFU: state = HALT");
             }
         }
+
+	// Waiting for MMIO to enable the AFU or supply a context, nothing
+	// happens here until ocse drives an event
+	if ((state == IDLE || state == READY) && !(cgemm && cgemm->busy ()))
+	    afu_event.afu_tlx_quiet = TLX_QUIET_WAIT;
+	else
+	    afu_event.afu_tlx_quiet = 0;
     }
 }
 
@@ -384,6 +416,7 @@ AFU::~AFU ()
         delete it->second;
   
     context_to_mc.clear ();
+    delete cgemm;
 }
 
 
@@ -890,6 +923,7 @@ AFU::tlx_afu_config_write()
 	if((cmd_pa & 0x0FFC) == 0x50c) {
 	    afu_enable_reset = 1;
 	    afu_function = cmd_pa & 0x000F0000;	//afu function number
+	    fcn_bdf[afu_function >> 16] = (afu_event.tlx_cfg_pa & 0xFFFF0000) >> 16;
 	}
 	// 0x40c afu descriptor offset port, 0x410 afu descriptor data port
    	if((cmd_pa & 0x0FFC) == 0x40c) {	
@@ -919,10 +953,16 @@ AFU::tlx_afu_config_write()
 			enable_bar = 0;
 			bar_l0 = wr_config_data;
 			printf("AFU: bar_l0 = 0x%x\n", bar_l0);
+			fcn_bar0[(cmd_pa >> 16) & 0x7] =
+			    (fcn_bar0[(cmd_pa >> 16) & 0x7] & 0xFFFFFFFF00000000ll) |
+			    (bar_l0 & 0xFFFFFFF0);
 			break;
 		    case 0x14:
 			bar_h0 = wr_config_data;
 		  	printf("AFU: bar_h0 = 0x%x\n", bar_h0);
+			fcn_bar0[(cmd_pa >> 16) & 0x7] =
+			    (fcn_bar0[(cmd_pa >> 16) & 0x7] & 0xFFFFFFFFll) |
+			    ((uint64_t)bar_h0 << 32);
 			break;
 		    case 0x18:
 			enable_bar = 1;
@@ -1005,7 +1045,7 @@ AFU::tlx_pr_rd_mem()
     	descriptor.get_mmio_mem(mem_offset, (char*)&mem_data, data_size);
     	debug_msg("mem_offset = 0x%x mem_data = 0x%016llx", mem_offset, mem_data);
     	memcpy(&afu_event.afu_tlx_rdata_bus, &mem_data, data_size);
-    	byte_shift(afu_event.afu_tlx_rdata_bus, data_size, mem_offset, RIGHT);
+    	byte_shift(afu_event.afu_tlx_rdata_bus, data_size, mem_offset & 0x3F, RIGHT);
 
       	if(TagManager::request_tlx_credit(RESP_CREDIT)) {
             if(afu_tlx_send_resp_and_data(&afu_event, afu_tlx_resp_opcode, afu_tlx_resp_dl, 
@@ -1104,6 +1144,8 @@ AFU::tlx_pr_wr_mem()
 	    memcpy(&mem_data, afu_event.tlx_afu_cmd_data_bus, data_size);
 	    // mmio write
 	    descriptor.set_mmio_mem(cmd_pa, (char*)&mem_data, data_size);
+	    if(cgemm)
+		cgemm->mmio_write(cmd_pa, fcn_bdf[mmio_fcn]);
 	    //descriptor.set_port_reg(cmd_pa, mem_data);
 	    afu_resp_opcode = 0x04;		// mem write resp
 	    resp_code = 0x0;
@@ -1139,6 +1181,13 @@ AFU::is_mmio_addr(uint64_t addr)
 {
     printf("AFU: mmio addr = 0x%016lx\n", addr);
     printf("AFU: bar addr  = 0x%016lx\n", bar);
+    // the first 64k behind a function's BAR0 is its mmio space
+    for(int f=0; f<8; f++) {
+	if(fcn_bar0[f] && addr >= fcn_bar0[f] && addr < fcn_bar0[f]+0x10000) {
+	    mmio_fcn = f;
+	    return 1;
+	}
+    }
     addr = addr & 0xFFFFFFFFFFF10000;
     if(addr >= bar && addr < bar+0x10000) {
 	return 1;
@@ -22,6 +22,7 @@
 #include "MachineController.h"
 #include "Commands.h"
 #include "Lpc.h"
+#include "CgemmAction.h"
 
 extern "C" {
 #include "tlx_interface.h"
@@ -50,6 +51,7 @@ private:
         MachineController * >::iterator highest_priority_mc;
 
     MachineController *machine_controller;
+    CgemmAction *cgemm;		// set when the AFU models the cgemm action
 
     AFU_State state;
     AFU_State config_state;
@@ -58,7 +60,9 @@ private:
 //    uint8_t  memory[128];
     uint64_t global_configs[3];	// stores MMIO registers for global configurations
     uint8_t  tlx_afu_cmd_max_credit;
-    uint8_t  tlx_afu_data_max_credit;
+    uint8_t  tlx_afu_resp_max_credit;
+    uint8_t  tlx_afu_cmd_data_max_credit;
+    uint8_t  tlx_afu_resp_data_max_credit;
 
     int reset_delay;
 
@@ -89,7 +93,8 @@ private:
 public:
     /* constructor sets up descriptor from config file, establishes server socket connection
        and waits for client to connect */
-    AFU (int port, std::string filename, bool parity, bool jerror);
+    AFU (int port, std::string filename, bool parity, bool jerror,
+         std::string cgemm_config = "");
 
     /* starts the main loop of the afu test platform */
     void start ();
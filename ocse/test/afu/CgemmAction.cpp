@@ -0,0 +1,675 @@
+/*
+ * Copyright 2015,2017 International Business Machines
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CgemmAction.h"
+#include "TagManager.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+using std::string;
+
+static uint64_t
+load_element (const uint8_t * p, int bytes)
+{
+    uint64_t v = 0;
+
+    for (int i = bytes - 1; i >= 0; --i)
+	v = (v << 8) | p[i];
+    return v;
+}
+
+static void
+store_element (uint8_t * p, int bytes, uint64_t v)
+{
+    for (int i = 0; i < bytes; ++i) {
+	p[i] = v & 0xff;
+	v >>= 8;
+    }
+}
+
+static void
+store_bits (uint8_t * p, uint32_t pos, const std::vector < uint64_t > &v,
+	    uint32_t bits)
+{
+    for (uint32_t i = 0; i < bits; ++i)
+	if ((v[i >> 6] >> (i & 63)) & 1)
+	    p[(pos + i) >> 3] |= 1 << ((pos + i) & 7);
+}
+
+CgemmAction::CgemmAction (Descriptor * descriptor):
+    descriptor (descriptor),
+    in_arith (&arith),
+    rows (0),
+    cols (0),
+    engines (1),
+    msb (0),
+    lsb (0),
+    ovf (0),
+    exact_out (false),
+    b_depth (0),
+    b_write (0),
+    b_read (0),
+    out_bits (0),
+    pp_offset (0),
+    pp_stride (0),
+    contexts (0),
+    bdf (0),
+    actag_assigned (0),
+    running (false),
+    failed (false),
+    pasid (0),
+    irq_pending (false),
+    irq_in_flight (false),
+    irq_afutag (0),
+    irq_pasid (0),
+    irq_bdf (0),
+    irq_obj (0)
+{
+}
+
+bool
+CgemmAction::configure (const string & config)
+{
+    size_t comma = config.find (',');
+
+    if (comma == string::npos)
+	return false;
+    if (sscanf (config.c_str (), "%u*%ux%u", &engines, &rows, &cols) != 3) {
+	engines = 1;
+	if (sscanf (config.c_str (), "%ux%u", &rows, &cols) != 2)
+	    return false;
+    }
+
+    string rest = config.substr (comma + 1);
+    const string alt_option = ",alt=";
+    size_t option;
+    alt.clear ();
+    while ((option = rest.find (alt_option)) != string::npos) {
+	size_t end = rest.find (',', option + 1);
+	CgemmArith format;
+	if (!format.parse (rest.substr (option + alt_option.size (),
+				       end == string::npos ? string::npos :
+				       end - option - alt_option.size ())))
+	    return false;
+	alt.push_back (format);
+	rest.erase (option, end == string::npos ? string::npos : end - option);
+    }
+    const string ws_suffix = ",ws=";
+    size_t ws = rest.rfind (ws_suffix);
+    b_depth = 0;
+    if (ws != string::npos) {
+	if (sscanf (rest.c_str () + ws + ws_suffix.size (), "%u", &b_depth) != 1 ||
+	    b_depth < 2 || (b_depth & (b_depth - 1)) || b_depth >= (1u << 24))
+	    return false;
+	rest.erase (ws);
+    }
+    const string exact_suffix = ",exact";
+    exact_out = rest.size () > exact_suffix.size () &&
+	rest.compare (rest.size () - exact_suffix.size (),
+		      exact_suffix.size (), exact_suffix) == 0;
+    if (exact_out)
+	rest.erase (rest.size () - exact_suffix.size ());
+    comma = rest.find (',');
+    if (!arith.parse (rest.substr (0, comma)))
+	return false;
+
+    // default to a window holding every product, 32 bits of carries
+    arith.exact_window (&msb, &lsb);
+    ovf = 32;
+    // alternate formats fill the low bits of the slots of arithmetic_in
+    if (alt.size () > CGEMM_ALT_FORMATS)
+	return false;
+    for (size_t f = 0; f < alt.size (); ++f) {
+	int alt_msb, alt_lsb;
+	if (alt[f].bits > arith.bits)
+	    return false;
+	alt[f].exact_window (&alt_msb, &alt_lsb);
+	msb = std::max (msb, alt_msb);
+	lsb = std::min (lsb, alt_lsb);
+    }
+    if (comma != string::npos &&
+	sscanf (rest.c_str () + comma + 1, "%d,%d,%d", &msb, &lsb, &ovf) != 3)
+	return false;
+    if (msb < lsb || ovf < 0)
+	return false;
+    // ACTION_ACCUM_REG has 7 bits of ovf and 12 bit signed msb and lsb
+    if (ovf > 127 || msb > 2047 || lsb < -2048)
+	return false;
+    // an exact output is the accumulator and its NaN flag
+    out_bits = exact_out ? msb + ovf - lsb + 2 : arith.bits;
+
+    // the operand vectors of all engines and the flag byte share one bus
+    // word, the rows of all engines one output word; weight stationary
+    // words hold the rows of all engines or one B band
+    uint32_t lane_elements = b_depth ? rows : rows + cols;
+    if (rows < 1 || cols < 1 || rows > 255 || cols > 255 || engines < 1 ||
+	engines > 15 ||
+	engines * lane_elements * (arith.bits / 8) > CGEMM_BUS_BYTES - 1 ||
+	cols * (arith.bits / 8) > CGEMM_BUS_BYTES - 1 ||
+	engines * cols * out_bits > CGEMM_BUS_BYTES * 8)
+	return false;
+
+    a.resize (engines * rows);
+    b.resize (engines * cols);
+    b_buffer.assign ((size_t) b_depth * cols, CgemmOperand ());
+    b_write = 0;
+    b_read = 0;
+    pes.assign (engines * rows * cols, CgemmAccumulator (msb, lsb, ovf));
+
+    // ocse keeps the 64k aligned part of offset and stride, with the
+    // test AFU descriptors every pasid lands on the same registers
+    pp_offset = descriptor->get_afu_desc_reg (0x30) & 0xFFFF0000;
+    pp_stride = descriptor->get_afu_desc_reg (0x38) & 0xFFFF0000;
+    if (pp_offset >= CGEMM_MMIO_SIZE)
+	return false;
+    if (pp_stride == 0 || pp_offset + pp_stride > CGEMM_MMIO_SIZE) {
+	pp_stride = CGEMM_MMIO_SIZE - pp_offset;
+	contexts = 1;
+    }
+    else {
+	contexts = (CGEMM_MMIO_SIZE - pp_offset) / pp_stride;
+    }
+    if (contexts > 32)
+	contexts = 32;
+
+    uint32_t type_reg = (CGEMM_ACTION << 24) | (arith.bits << 16) |
+	(arith.type << 8) | (engines << 4);
+    uint32_t release_reg = (rows << 24) | (cols << 16) |
+	(arith.param1 << 8) | arith.param2;
+    uint32_t accum_reg = (exact_out ? CGEMM_ACCUM_EXACT : 0) | (ovf << 24) |
+	((msb & 0xfff) << 12) | (lsb & 0xfff);
+    uint32_t topology_reg = b_depth ? CGEMM_TOPOLOGY_WS | b_depth : 0;
+    for (uint32_t i = 0; i < contexts; ++i) {
+	set_reg (i, ACTION_TYPE_REG, type_reg);
+	set_reg (i, ACTION_RELEASE_REG, release_reg);
+	set_reg (i, ACTION_ACCUM_REG, accum_reg);
+	set_reg (i, ACTION_TOPOLOGY_REG, topology_reg);
+	for (size_t f = 0; f < CGEMM_ALT_FORMATS; ++f)
+	    set_reg (i, ACTION_ALT_FORMAT_REG + 4 * f, f < alt.size () ?
+		     (alt[f].type << 24) | (alt[f].bits << 16) |
+		     (alt[f].param1 << 8) | alt[f].param2 : 0);
+	set_reg (i, ACTION_CONTROL, ACTION_CONTROL_IDLE);
+    }
+
+    // libosnap checks the card before it attaches an action
+    uint64_t cap = SNAP_CAP_AD9V3;
+    descriptor->set_mmio_mem (SNAP_CAP, (char *) &cap, sizeof (cap));
+
+    info_msg ("CgemmAction: %u %ux%u arrays, arith type %d %d bits, "
+	      "window %d..%d ovf %d, %u bit outputs, B buffer %u, %u contexts, "
+	      "%u alternate formats",
+	      engines, rows, cols, arith.type, arith.bits, msb, lsb, ovf,
+	      out_bits, b_depth, contexts, (unsigned) alt.size ());
+    return true;
+}
+
+uint32_t
+CgemmAction::get_reg (uint32_t context, uint32_t offset)
+{
+    uint32_t data = 0;
+
+    descriptor->get_mmio_mem (pp_offset + context * pp_stride + offset,
+			      (char *) &data, sizeof (data));
+    return data;
+}
+
+void
+CgemmAction::set_reg (uint32_t context, uint32_t offset, uint32_t data)
+{
+    descriptor->set_mmio_mem (pp_offset + context * pp_stride + offset,
+			      (char *) &data, sizeof (data));
+}
+
+void
+CgemmAction::mmio_write (uint32_t offset, uint16_t bdf)
+{
+    if (contexts == 0 || offset < pp_offset)
+	return;
+
+    uint32_t context = (offset - pp_offset) / pp_stride;
+    if (context >= contexts)
+	return;
+
+    // one interrupt channel, writing the status register clears it
+    if ((offset - pp_offset) % pp_stride == ACTION_IRQ_STATUS) {
+	set_reg (context, ACTION_IRQ_STATUS, 0);
+	return;
+    }
+    if ((offset - pp_offset) % pp_stride != ACTION_CONTROL)
+	return;
+    if (!(get_reg (context, ACTION_CONTROL) & ACTION_CONTROL_START))
+	return;
+
+    // there is one array, a second job is turned down
+    if (running) {
+	warn_msg ("CgemmAction: pasid %u started while pasid %u runs",
+		  context, pasid);
+	set_reg (context, ACTION_RETC_OUT, SNAP_RETC_FAILURE);
+	set_reg (context, ACTION_CONTROL,
+		 ACTION_CONTROL_IDLE | ACTION_CONTROL_DONE);
+	return;
+    }
+    start (context, bdf);
+}
+
+void
+CgemmAction::start (uint32_t context, uint16_t bdf)
+{
+    uint32_t job = ACTION_PARAMS_IN + 0x10;
+    uint32_t in_size;
+
+    pasid = context;
+    if (bdf != this->bdf)
+	actag_assigned = 0;
+    this->bdf = bdf;
+    in_addr = get_reg (context, job + 0x00) |
+	((uint64_t) get_reg (context, job + 0x04) << 32);
+    in_size = get_reg (context, job + 0x08);
+    out_addr = get_reg (context, job + 0x10) |
+	((uint64_t) get_reg (context, job + 0x14) << 32);
+    out_size = get_reg (context, job + 0x18);
+    // as the format mux of the array, the last alternate takes the codes
+    // past it
+    uint32_t format = get_reg (context, job + CGEMM_JOB_FORMAT) & 3;
+    if (format > alt.size ())
+	format = alt.size ();
+    in_arith = format ? &alt[format - 1] : &arith;
+
+    running = true;
+    failed = false;
+    in_words = in_size / CGEMM_BUS_BYTES;
+    next_read = 0;
+    next_word = 0;
+    blocks = 0;
+    writes_in_flight = 0;
+    reads.clear ();
+    write_tags.clear ();
+    words.clear ();
+    lines.clear ();
+    set_reg (context, ACTION_CONTROL, ACTION_CONTROL_RUN);
+
+    info_msg ("CgemmAction: pasid %u in 0x%016llx size %u out 0x%016llx "
+	      "size %llu", pasid, (long long) in_addr, in_size,
+	      (long long) out_addr, (long long) out_size);
+    if ((in_addr % CGEMM_BUS_BYTES) || (in_size % CGEMM_BUS_BYTES) ||
+	(out_addr % 64)) {
+	warn_msg ("CgemmAction: buffers not aligned to the bus");
+	failed = true;
+    }
+}
+
+void
+CgemmAction::finish (uint32_t retc)
+{
+    info_msg ("CgemmAction: pasid %u done, %llu blocks, retc 0x%x", pasid,
+	      (long long) blocks, retc);
+    set_reg (pasid, ACTION_RETC_OUT, retc);
+    set_reg (pasid, ACTION_CONTROL,
+	     ACTION_CONTROL_IDLE | ACTION_CONTROL_DONE);
+    running = false;
+
+    if ((get_reg (pasid, ACTION_IRQ_CONTROL) & ACTION_IRQ_CONTROL_ON) &&
+	(get_reg (pasid, ACTION_IRQ_APP) & ACTION_IRQ_APP_DONE)) {
+	set_reg (pasid, ACTION_IRQ_STATUS, ACTION_IRQ_STATUS_DONE);
+	irq_pasid = pasid;
+	irq_bdf = bdf;
+	irq_obj = get_reg (pasid, ACTION_IRQ_SRC_LO) |
+	    ((uint64_t) get_reg (pasid, ACTION_IRQ_SRC_HI) << 32);
+	irq_pending = true;
+    }
+}
+
+bool
+CgemmAction::busy () const
+{
+    return running || irq_pending;
+}
+
+void
+CgemmAction::cycle (AFU_EVENT * event)
+{
+    if (!busy () || event->afu_tlx_cmd_valid)
+	return;
+
+    // the done IRQ goes out before the next job starts issuing
+    if (irq_pending) {
+	if (!irq_in_flight)
+	    send_interrupt (event);
+	return;
+    }
+
+    if (!(actag_assigned & (1u << pasid))) {
+	uint8_t ea[9];
+	uint32_t afutag;
+
+	memset (ea, 0, sizeof (ea));
+	TagManager::request_tag (&afutag);
+	if (afu_tlx_send_cmd (event, AFU_CMD_ASSIGN_ACTAG, 1 + pasid, 0, ea,
+			      afutag, 1, 3,
+#ifdef TLX4
+			      0,
+#endif
+			      0, 0, 0, bdf, pasid, 0) == TLX_SUCCESS)
+	    actag_assigned |= 1u << pasid;
+	// assign_actag has no response
+	TagManager::release_tag (afutag);
+	return;
+    }
+
+    if (failed) {
+	// let everything in flight drain before reporting
+	lines.clear ();
+	if (reads.empty () && writes_in_flight == 0)
+	    finish (SNAP_RETC_FAILURE);
+	return;
+    }
+
+    if (!lines.empty () && writes_in_flight < CGEMM_MAX_WRITES) {
+	send_write (event);
+	return;
+    }
+    if (next_read < in_words && reads.size () < CGEMM_MAX_READS &&
+	next_read < next_word + CGEMM_WINDOW) {
+	send_read (event);
+	return;
+    }
+    if (next_word == in_words && lines.empty () && writes_in_flight == 0)
+	finish (SNAP_RETC_SUCCESS);
+}
+
+bool
+CgemmAction::send_read (AFU_EVENT * event)
+{
+    uint64_t ea = in_addr + next_read * CGEMM_BUS_BYTES;
+    uint8_t ea_or_obj[9];
+    uint32_t afutag;
+
+    memset (ea_or_obj, 0, sizeof (ea_or_obj));
+    memcpy (ea_or_obj, &ea, sizeof (ea));
+    TagManager::request_tag (&afutag);
+    if (afu_tlx_send_cmd (event, AFU_CMD_RD_WNITC, 1 + pasid, 0, ea_or_obj,
+			  afutag, 2, 0,
+#ifdef TLX4
+			  0,
+#endif
+			  0, 0, 0, bdf, pasid, 0) != TLX_SUCCESS) {
+	TagManager::release_tag (afutag);
+	return false;
+    }
+    reads[afutag] = next_read++;
+    return true;
+}
+
+bool
+CgemmAction::send_write (AFU_EVENT * event)
+{
+    OutLine & line = lines.front ();
+    uint8_t ea_or_obj[9];
+    uint32_t afutag;
+
+    memset (ea_or_obj, 0, sizeof (ea_or_obj));
+    memcpy (ea_or_obj, &line.ea, sizeof (line.ea));
+    TagManager::request_tag (&afutag);
+    if (afu_tlx_send_cmd_and_data (event, AFU_CMD_DMA_W, 1 + pasid, 0,
+				   ea_or_obj, afutag, 1, 0,
+#ifdef TLX4
+				   0,
+#endif
+				   0, 0, 0, bdf, pasid, 0, line.data,
+				   0) != TLX_SUCCESS) {
+	TagManager::release_tag (afutag);
+	return false;
+    }
+    write_tags.insert (afutag);
+    ++writes_in_flight;
+    lines.pop_front ();
+    return true;
+}
+
+bool
+CgemmAction::send_interrupt (AFU_EVENT * event)
+{
+    uint8_t ea_or_obj[9];
+
+    memset (ea_or_obj, 0, sizeof (ea_or_obj));
+    memcpy (ea_or_obj, &irq_obj, sizeof (irq_obj));
+    TagManager::request_tag (&irq_afutag);
+    if (afu_tlx_send_cmd (event, AFU_CMD_INTRP_REQ, 1 + irq_pasid, 0,
+			  ea_or_obj, irq_afutag, 0, 0,
+#ifdef TLX4
+			  0,
+#endif
+			  0, 0, 0, irq_bdf, irq_pasid, 0) != TLX_SUCCESS) {
+	TagManager::release_tag (irq_afutag);
+	return false;
+    }
+    irq_in_flight = true;
+    return true;
+}
+
+bool
+CgemmAction::resolve_tlx_afu_resp (AFU_EVENT * event)
+{
+    uint32_t afutag = event->tlx_afu_resp_afutag;
+    std::map < uint32_t, uint64_t >::iterator read = reads.find (afutag);
+    bool write = write_tags.count (afutag);
+    bool irq = irq_in_flight && afutag == irq_afutag;
+
+    if (!busy () || (read == reads.end () && !write && !irq))
+	return false;
+
+    uint8_t opcode, code, pg_size, dl, dp, bdi;
+    uint16_t resp_afutag;
+    uint32_t addr_tag;
+#ifdef TLX4
+    uint32_t host_tag;
+    uint8_t cache_state;
+#endif
+    uint8_t data[256];
+
+    tlx_afu_read_resp (event, &opcode, &resp_afutag, &code, &pg_size, &dl,
+#ifdef TLX4
+		       &host_tag, &cache_state,
+#endif
+		       &dp, &addr_tag);
+    // the test AFU hands back one response credit per cycle
+    event->afu_tlx_credit_req_valid = 1;
+
+    if (irq) {
+	// resp_code 2 asks for a retry, anything else but 0 drops the IRQ
+	irq_in_flight = false;
+	TagManager::release_tag (afutag);
+	if (opcode != TLX_RSP_INTRP_RESP || code != 2)
+	    irq_pending = false;
+	if (opcode != TLX_RSP_INTRP_RESP || (code != 0 && code != 2))
+	    warn_msg ("CgemmAction: intrp_req for pasid %u failed, opcode "
+		      "0x%x code 0x%x", irq_pasid, opcode, code);
+    }
+    else if (opcode == TLX_RSP_READ_RESP && read != reads.end ()) {
+	uint32_t size = (dl == 3) ? 256 : (dl == 2) ? 128 : 64;
+	uint32_t offset = (dp & 0x3) * 64;
+
+	afu_tlx_resp_data_read_req (event, 1, size / 64);
+	tlx_afu_read_resp_data (event, &bdi, data);
+
+	InWord & word = words[read->second];
+	if (word.data.empty ()) {
+	    word.data.resize (CGEMM_BUS_BYTES);
+	    word.bytes = 0;
+	}
+	if (offset < CGEMM_BUS_BYTES) {
+	    uint32_t n = CGEMM_BUS_BYTES - offset;
+	    memcpy (&word.data[offset], data, (size < n) ? size : n);
+	}
+	word.bytes += size;
+	if (word.bytes >= CGEMM_BUS_BYTES) {
+	    reads.erase (read);
+	    TagManager::release_tag (afutag);
+	    consume_words ();
+	}
+    }
+    else if (opcode == TLX_RSP_WRITE_RESP && write) {
+	write_tags.erase (afutag);
+	TagManager::release_tag (afutag);
+	--writes_in_flight;
+    }
+    else {
+	warn_msg ("CgemmAction: afutag 0x%x failed, opcode 0x%x code 0x%x",
+		  afutag, opcode, code);
+	failed = true;
+	if (read != reads.end ())
+	    reads.erase (read);
+	if (write) {
+	    write_tags.erase (afutag);
+	    --writes_in_flight;
+	}
+	TagManager::release_tag (afutag);
+    }
+    return true;
+}
+
+void
+CgemmAction::consume_words ()
+{
+    std::map < uint64_t, InWord >::iterator it;
+
+    if (failed)
+	return;
+
+    // blocks are framed by SOB and EOB in the last byte of each word
+    while (!failed && (it = words.find (next_word)) != words.end () &&
+	   it->second.bytes >= CGEMM_BUS_BYTES) {
+	uint8_t flags = it->second.data[CGEMM_BUS_BYTES - 1];
+
+	if (b_depth) {
+	    accumulate_stationary (&it->second.data[0], flags);
+	    words.erase (it);
+	    ++next_word;
+	    if ((flags & CGEMM_EOB) && !(flags & CGEMM_LDB))
+		drain ();
+	    continue;
+	}
+	if (flags & CGEMM_SOB)
+	    for (size_t i = 0; i < pes.size (); ++i)
+		pes[i].clear ();
+	accumulate (&it->second.data[0]);
+	words.erase (it);
+	++next_word;
+	if (flags & CGEMM_EOB)
+	    drain ();
+    }
+}
+
+void
+CgemmAction::accumulate (const uint8_t * word)
+{
+    uint32_t w = arith.bits / 8;
+    uint32_t in_w = in_arith->bits / 8;
+
+    // lane e holds rows + cols elements of engine e
+    for (uint32_t e = 0; e < engines; ++e) {
+	const uint8_t *lane = word + e * (rows + cols) * w;
+
+	for (uint32_t i = 0; i < rows; ++i)
+	    a[e * rows + i] = in_arith->decode (load_element (lane + i * w, in_w));
+	for (uint32_t j = 0; j < cols; ++j)
+	    b[e * cols + j] =
+		in_arith->decode (load_element (lane + (rows + j) * w, in_w));
+    }
+    for (uint32_t e = 0; e < engines; ++e)
+	for (uint32_t i = 0; i < rows; ++i)
+	    for (uint32_t j = 0; j < cols; ++j)
+		pes[(e * rows + i) * cols + j].mac (a[e * rows + i],
+						    b[e * cols + j]);
+}
+
+void
+CgemmAction::accumulate_stationary (const uint8_t * word, uint8_t flags)
+{
+    uint32_t w = arith.bits / 8;
+    uint32_t in_w = in_arith->bits / 8;
+
+    // SOB rewinds the buffer, and clears the accumulators on an A word
+    if (flags & CGEMM_SOB) {
+	b_write = 0;
+	b_read = 0;
+    }
+    if (flags & CGEMM_LDB) {
+	for (uint32_t j = 0; j < cols; ++j)
+	    b_buffer[b_write * cols + j] =
+		in_arith->decode (load_element (word + j * w, in_w));
+	b_write = (b_write + 1) % b_depth;
+	return;
+    }
+    if (flags & CGEMM_SOB)
+	for (size_t i = 0; i < pes.size (); ++i)
+	    pes[i].clear ();
+
+    // lane e holds the rows of engine e, all engines share the B step
+    for (uint32_t e = 0; e < engines; ++e)
+	for (uint32_t i = 0; i < rows; ++i)
+	    a[e * rows + i] =
+		in_arith->decode (load_element (word + (e * rows + i) * w, in_w));
+    const CgemmOperand *step = &b_buffer[b_read * cols];
+    b_read = (b_read + 1) % b_depth;
+    for (uint32_t e = 0; e < engines; ++e)
+	for (uint32_t i = 0; i < rows; ++i)
+	    for (uint32_t j = 0; j < cols; ++j)
+		pes[(e * rows + i) * cols + j].mac (a[e * rows + i], step[j]);
+}
+
+void
+CgemmAction::drain ()
+{
+    uint32_t w = arith.bits / 8;
+    uint64_t base = out_addr + blocks * rows * CGEMM_BUS_BYTES;
+
+    if ((blocks + 1) * rows * CGEMM_BUS_BYTES > out_size) {
+	warn_msg ("CgemmAction: output buffer too small for block %llu",
+		  (long long) blocks);
+	failed = true;
+	return;
+    }
+
+    // the arrays drain bottom row first, one bus word per row
+    for (uint32_t r = 0; r < rows; ++r) {
+	uint32_t i = rows - 1 - r;
+	uint8_t word[CGEMM_BUS_BYTES];
+
+	memset (word, 0, sizeof (word));
+	for (uint32_t e = 0; e < engines; ++e)
+	    for (uint32_t j = 0; j < cols; ++j) {
+		CgemmAccumulator & pe = pes[(e * rows + i) * cols + j];
+
+		if (exact_out)
+		    store_bits (word, (e * cols + j) * out_bits, pe.exact (),
+				out_bits);
+		else
+		    store_element (word + (e * cols + j) * w, w,
+				   pe.round (arith));
+	    }
+	for (uint32_t half = 0; half < 2; ++half) {
+	    OutLine line;
+
+	    line.ea = base + r * CGEMM_BUS_BYTES + half * 64;
+	    memcpy (line.data, word + half * 64, 64);
+	    lines.push_back (line);
+	}
+    }
+    ++blocks;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2015,2017 International Business Machines
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __cgemm_action_h__
+#define __cgemm_action_h__
+
+#include "Descriptor.h"
+#include "CgemmArith.h"
+
+extern "C" {
+#include "tlx_interface.h"
+#include "utils.h"
+}
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <deque>
+
+// oc-accel action registers, 32 bit in each per PASID MMIO space
+#define ACTION_CONTROL		0x00
+#define ACTION_CONTROL_START	0x01
+#define ACTION_CONTROL_DONE	0x02
+#define ACTION_CONTROL_IDLE	0x04
+#define ACTION_CONTROL_RUN	0x08
+#define ACTION_IRQ_CONTROL	0x04
+#define ACTION_IRQ_CONTROL_ON	0x01
+#define ACTION_IRQ_APP		0x08
+#define ACTION_IRQ_APP_DONE	0x01
+#define ACTION_IRQ_STATUS	0x0c
+#define ACTION_IRQ_STATUS_DONE	0x01
+#define ACTION_TYPE_REG		0x10
+#define ACTION_RELEASE_REG	0x14
+#define ACTION_IRQ_SRC_LO	0x18
+#define ACTION_IRQ_SRC_HI	0x1c
+#define ACTION_PARAMS_IN	0x100
+#define ACTION_RETC_OUT		0x184
+#define ACTION_ACCUM_REG	0x188	// read only, the accumulator window
+#define ACTION_TOPOLOGY_REG	0x18c	// read only, weight stationary and b_depth
+#define ACTION_ALT_FORMAT_REG	0x1c0	// read only, alternate input formats 1..3
+
+// global MMIO capability register, low byte is the card id
+#define SNAP_CAP		0x30
+#define SNAP_CAP_AD9V3		0x31
+
+#define SNAP_RETC_SUCCESS	0x102
+#define SNAP_RETC_FAILURE	0x104
+
+#define CGEMM_ACTION		0x86
+#define CGEMM_BUS_BYTES		128	// one word of the action data bus
+#define CGEMM_SOB		0x40	// flags in the last byte of a word
+#define CGEMM_EOB		0x80
+#define CGEMM_LDB		0x20	// weight stationary: the word loads B
+#define CGEMM_ACCUM_EXACT	0x80000000	// ACTION_ACCUM_REG: exact outputs
+#define CGEMM_TOPOLOGY_WS	0x80000000	// ACTION_TOPOLOGY_REG: weight stationary
+#define CGEMM_JOB_FORMAT	0x2c	// job register, the input format
+#define CGEMM_ALT_FORMATS	3
+#define CGEMM_MAX_READS		32
+#define CGEMM_MAX_WRITES	32
+#define CGEMM_WINDOW		1024	// words read ahead of the array
+#define CGEMM_MMIO_SIZE		0x4000	// Descriptor mmio space
+
+/* CgemmAction class - behavioral model of the oc-accel cgemm action. It
+ * serves the action registers out of the Descriptor mmio space, streams
+ * the SOB/EOB framed input of gemm_backend_test in with TLX reads,
+ * accumulates each word into exact accumulators and writes the rows back
+ * bottom row first on EOB, as the hardware array drains them. Only SOB
+ * clears the accumulators, so a block may span several jobs, and a job
+ * without EOB writes nothing. Several engines
+ * share the bus in lanes, lane e of a word feeds engine e and lane e of
+ * each output word holds its row. With exact outputs the accumulators
+ * are written as they are, out_bits apart. Weight stationary arrays
+ * keep a B band of b_depth steps: LDB words store one step of it, the
+ * other words carry the rows of A only, lane e of engine e, and take B
+ * from the buffer. SOB rewinds the buffer. Alternate input formats
+ * decode the low bytes of the element slots when the job selects them,
+ * the outputs keep the format of the array. With the done IRQ
+ * enabled it sends an intrp_req to the handle in ACTION_IRQ_SRC. */
+class CgemmAction
+{
+private:
+    struct InWord
+    {
+	std::vector < uint8_t > data;
+	uint32_t bytes;
+    };
+
+    struct OutLine
+    {
+	uint64_t ea;
+	uint8_t data[64];
+    };
+
+    Descriptor *descriptor;
+    CgemmArith arith;
+    std::vector < CgemmArith > alt;	// alternate input formats 1..3
+    const CgemmArith *in_arith;	// input format of the running job
+    uint32_t rows, cols, engines;
+    int msb, lsb, ovf;
+    bool exact_out;		// write the accumulators instead of rounding
+    uint32_t b_depth;		// weight stationary B buffer, 0 for orthogonal
+    uint32_t b_write, b_read;
+    std::vector < CgemmOperand > b_buffer;	// step, column
+    uint32_t out_bits;		// bits of an output element
+    uint32_t pp_offset, pp_stride, contexts;
+    uint16_t bdf;
+    uint32_t actag_assigned;	// one bit per pasid
+
+    bool running;
+    bool failed;
+    uint32_t pasid;
+    uint64_t in_addr, in_words;
+    uint64_t out_addr, out_size;
+    uint64_t next_read, next_word, blocks;
+    uint32_t writes_in_flight;
+    std::map < uint32_t, uint64_t > reads;	// afutag -> word
+    std::set < uint32_t > write_tags;
+    std::map < uint64_t, InWord > words;
+    std::deque < OutLine > lines;
+    std::vector < CgemmOperand > a, b;	// operands of the current word
+    std::vector < CgemmAccumulator > pes;	// engine, row, column
+
+    bool irq_pending;
+    bool irq_in_flight;
+    uint32_t irq_afutag;
+    uint32_t irq_pasid;
+    uint16_t irq_bdf;
+    uint64_t irq_obj;
+
+    uint32_t get_reg (uint32_t context, uint32_t offset);
+    void set_reg (uint32_t context, uint32_t offset, uint32_t data);
+    void start (uint32_t context, uint16_t bdf);
+    void finish (uint32_t retc);
+    void consume_words ();
+    void accumulate (const uint8_t * word);
+    void accumulate_stationary (const uint8_t * word, uint8_t flags);
+    void drain ();
+    bool send_read (AFU_EVENT * event);
+    bool send_write (AFU_EVENT * event);
+    bool send_interrupt (AFU_EVENT * event);
+
+public:
+    CgemmAction (Descriptor * descriptor);
+
+    /* takes [<engines>*]<N>x<M>,<arithmetic_in>[,<msb>,<lsb>,<ovf>][,exact]
+     * [,ws=<b_depth>][,alt=<arithmetic>]... and sets up the action
+     * registers, returns false on a bad configuration */
+    bool configure (const std::string & config);
+
+    /* called after the AFU stored an MMIO write at offset, bdf is the
+     * function it came through, commands carry it with the pasid */
+    void mmio_write (uint32_t offset, uint16_t bdf);
+
+    /* a job is running or its done IRQ is not out yet, needs clocks */
+    bool busy () const;
+
+    /* issues at most one TLX command per cycle */
+    void cycle (AFU_EVENT * event);
+
+    /* consumes the response if it answers one of our commands */
+    bool resolve_tlx_afu_resp (AFU_EVENT * event);
+};
+
+#endif
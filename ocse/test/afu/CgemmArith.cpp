@@ -0,0 +1,431 @@
+/*
+ * Copyright 2015,2017 International Business Machines
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CgemmArith.h"
+
+#include <stdlib.h>
+
+using std::string;
+using std::vector;
+
+static uint64_t
+low_mask (int n)
+{
+    return (n >= 64) ? ~0ULL : ((1ULL << n) - 1);
+}
+
+static bool
+mag_bit (const vector < uint64_t > &mag, int i)
+{
+    if (i < 0 || i >= (int) (64 * mag.size ()))
+	return false;
+    return (mag[i >> 6] >> (i & 63)) & 1;
+}
+
+// index of the highest set bit, -1 for zero
+static int
+mag_top (const vector < uint64_t > &mag)
+{
+    for (int l = (int) mag.size () - 1; l >= 0; --l) {
+	if (mag[l])
+	    return 64 * l + 63 - __builtin_clzll (mag[l]);
+    }
+    return -1;
+}
+
+// any bit set below index i
+static bool
+mag_any_below (const vector < uint64_t > &mag, int i)
+{
+    if (i <= 0)
+	return false;
+    for (int l = 0; l < (int) mag.size () && 64 * l < i; ++l) {
+	if (i - 64 * l >= 64) {
+	    if (mag[l])
+		return true;
+	}
+	else if (mag[l] & low_mask (i - 64 * l)) {
+	    return true;
+	}
+    }
+    return false;
+}
+
+CgemmArith::CgemmArith ():type (ARITH_IEEE), bits (32), param1 (8), param2 (23)
+{
+}
+
+bool
+CgemmArith::parse (const string & arith)
+{
+    vector < string > fields;
+    size_t start = 0, colon;
+
+    do {
+	colon = arith.find (':', start);
+	fields.push_back (arith.substr (start, colon - start));
+	start = colon + 1;
+    } while (colon != string::npos);
+
+    if (fields[0] == "ieee" && fields.size () == 3) {
+	type = ARITH_IEEE;
+	param1 = atoi (fields[1].c_str ());
+	param2 = atoi (fields[2].c_str ());
+	// the significand product has to fit 128 bits
+	if (param1 < 2 || param1 > 11 || param2 < 1 || param2 > 52)
+	    return false;
+	bits = 1 + param1 + param2;
+    }
+    else if (fields[0] == "bfloat16" && fields.size () == 1) {
+	type = ARITH_BF16;
+	param1 = 8;
+	param2 = 7;
+	bits = 16;
+    }
+    else if (fields[0] == "posit" && fields.size () == 3) {
+	type = ARITH_POSIT;
+	param1 = atoi (fields[1].c_str ());
+	param2 = atoi (fields[2].c_str ());
+	if (param1 < 3 || param1 > 64 || param2 > 4)
+	    return false;
+	bits = param1;
+    }
+    else {
+	// tfp has no software model yet
+	return false;
+    }
+
+    // gemm_backend_test packs whole bytes on the bus
+    return (bits % 8) == 0;
+}
+
+void
+CgemmArith::exact_window (int *msb, int *lsb) const
+{
+    if (type == ARITH_POSIT) {
+	int maxscale = (param1 - 2) << param2;
+
+	*msb = 2 * maxscale;
+	*lsb = -2 * maxscale;
+    }
+    else {
+	int bias = (1 << (param1 - 1)) - 1;
+
+	*msb = 2 * bias + 1;
+	*lsb = 2 * (1 - bias - param2);
+    }
+}
+
+CgemmOperand
+CgemmArith::decode (uint64_t element) const
+{
+    CgemmOperand op;
+
+    op.nan = false;
+    op.sign = false;
+    op.significand = 0;
+    op.scale = 0;
+
+    if (type == ARITH_POSIT) {
+	int n = param1, es = param2;
+	uint64_t p = element & low_mask (n);
+
+	if (p == 0)
+	    return op;
+	if (p == (1ULL << (n - 1))) {
+	    op.nan = true;	// NaR
+	    return op;
+	}
+	op.sign = (p >> (n - 1)) & 1;
+	if (op.sign)
+	    p = (~p + 1) & low_mask (n);
+
+	// regime is a run of identical bits after the sign
+	int i = n - 2;
+	bool first = (p >> i) & 1;
+	int run = 0;
+	while (i >= 0 && (bool) ((p >> i) & 1) == first) {
+	    ++run;
+	    --i;
+	}
+	int k = first ? run - 1 : -run;
+	--i;			// terminating bit
+
+	// exponent bits cut off by the end of the word are 0
+	int e = 0;
+	for (int j = 0; j < es; ++j) {
+	    e <<= 1;
+	    if (i >= 0) {
+		e |= (p >> i) & 1;
+		--i;
+	    }
+	}
+
+	int fraction_bits = (i >= 0) ? i + 1 : 0;
+	op.significand = (1ULL << fraction_bits) |
+	    (p & low_mask (fraction_bits));
+	op.scale = k * (1 << es) + e - fraction_bits;
+    }
+    else {
+	int we = param1, wf = param2;
+	int bias = (1 << (we - 1)) - 1;
+	uint64_t exponent = (element >> wf) & low_mask (we);
+	uint64_t fraction = element & low_mask (wf);
+
+	op.sign = (element >> (we + wf)) & 1;
+	if (exponent == low_mask (we)) {
+	    // the S3 format has no infinities
+	    op.nan = true;
+	}
+	else if (exponent == 0) {
+	    op.significand = fraction;
+	    op.scale = 1 - bias - wf;
+	}
+	else {
+	    op.significand = fraction | (1ULL << wf);
+	    op.scale = (int) exponent - bias - wf;
+	}
+    }
+    return op;
+}
+
+uint64_t
+CgemmArith::nan () const
+{
+    if (type == ARITH_POSIT)
+	return 1ULL << (param1 - 1);
+    return (low_mask (param1) << param2) | (1ULL << (param2 - 1));
+}
+
+uint64_t
+CgemmArith::encode (bool sign, const vector < uint64_t > &magnitude,
+                    int lsb) const
+{
+    if (mag_top (magnitude) < 0)
+	return 0;
+    if (type == ARITH_POSIT)
+	return encode_posit (sign, magnitude, lsb);
+    return encode_ieee (sign, magnitude, lsb);
+}
+
+uint64_t
+CgemmArith::encode_ieee (bool sign, const vector < uint64_t > &mag,
+                         int lsb) const
+{
+    int we = param1, wf = param2;
+    int bias = (1 << (we - 1)) - 1;
+    int top = mag_top (mag);
+    int scale = top + lsb;
+    int emin = 1 - bias;
+
+    // weight of the last significand bit, fixed below emin for subnormals
+    int quantum = ((scale > emin) ? scale : emin) - wf;
+    int q = quantum - lsb;
+
+    uint64_t m = 0;
+    for (int i = top; i >= q; --i)
+	m = (m << 1) | mag_bit (mag, i);
+
+    bool guard = mag_bit (mag, q - 1);
+    bool sticky = mag_any_below (mag, q - 1);
+    if (guard && (sticky || (m & 1)))
+	++m;
+    if (m >> (wf + 1)) {
+	m >>= 1;
+	++quantum;
+    }
+
+    uint64_t exponent = 0;
+    uint64_t fraction = m;
+    if (m >> wf) {
+	exponent = quantum + wf + bias;
+	fraction = m & low_mask (wf);
+	if (exponent >= low_mask (we)) {
+	    exponent = low_mask (we);	// infinity
+	    fraction = 0;
+	}
+    }
+    return ((uint64_t) sign << (we + wf)) | (exponent << wf) | fraction;
+}
+
+uint64_t
+CgemmArith::encode_posit (bool sign, const vector < uint64_t > &mag,
+                          int lsb) const
+{
+    int n = param1, es = param2;
+    int top = mag_top (mag);
+    int scale = top + lsb;
+    int k = (scale >= 0) ? (scale >> es) : -((-scale + (1 << es) - 1) >> es);
+    int e = scale - k * (1 << es);
+
+    // n-1 bits after the sign, then the guard bit, then sticky
+    uint64_t body = 0;
+    bool guard = false, sticky = false;
+    int len = 0;
+#define PUSH(b) do { \
+	if (len < n - 1) body = (body << 1) | (b); \
+	else if (len == n - 1) guard = (b); \
+	else sticky = sticky || (b); \
+	++len; \
+    } while (0)
+
+    if (k >= 0) {
+	for (int i = 0; i <= k; ++i)
+	    PUSH (true);
+	PUSH (false);
+    }
+    else {
+	for (int i = 0; i < -k; ++i)
+	    PUSH (false);
+	PUSH (true);
+    }
+    for (int j = es - 1; j >= 0; --j)
+	PUSH ((bool) ((e >> j) & 1));
+
+    int i = top - 1;
+    while (len < n && i >= 0) {
+	PUSH (mag_bit (mag, i));
+	--i;
+    }
+    sticky = sticky || mag_any_below (mag, i + 1);
+    while (len < n)
+	PUSH (false);
+#undef PUSH
+
+    if (guard && (sticky || (body & 1)))
+	++body;
+
+    // posits saturate instead of rounding to 0 or NaR
+    if (body == 0)
+	body = 1;
+    if (body >= (1ULL << (n - 1)))
+	body = (1ULL << (n - 1)) - 1;
+    if (sign)
+	body = (~body + 1) & low_mask (n);
+    return body;
+}
+
+CgemmAccumulator::CgemmAccumulator (int msb, int lsb, int ovf):
+    limbs ((msb + ovf - lsb + 1 + 63) / 64),
+    lsb (lsb),
+    width (msb + ovf - lsb + 1),
+    nan (false)
+{
+}
+
+void
+CgemmAccumulator::clear ()
+{
+    for (size_t i = 0; i < limbs.size (); ++i)
+	limbs[i] = 0;
+    nan = false;
+}
+
+void
+CgemmAccumulator::mac (const CgemmOperand & x, const CgemmOperand & y)
+{
+    if (x.nan || y.nan) {
+	nan = true;
+	return;
+    }
+
+    unsigned __int128 p = (unsigned __int128) x.significand * y.significand;
+    int pos = x.scale + y.scale - lsb;
+
+    if (p == 0)
+	return;
+    if (pos < 0) {
+	if (pos <= -128)
+	    return;
+	p >>= -pos;
+	pos = 0;
+    }
+    if (p == 0 || pos >= width)
+	return;
+
+    int l = pos >> 6, s = pos & 63;
+    uint64_t w[3];
+    w[0] = (uint64_t) (p << s);
+    w[1] = s ? (uint64_t) (p >> (64 - s)) : (uint64_t) (p >> 64);
+    w[2] = s ? (uint64_t) (p >> (128 - s)) : 0;
+
+    uint64_t carry = 0;
+    if (x.sign == y.sign) {
+	for (size_t i = 0; l + i < limbs.size (); ++i) {
+	    uint64_t add = (i < 3) ? w[i] : 0;
+	    if (i >= 3 && carry == 0)
+		break;
+	    uint64_t sum = limbs[l + i] + add;
+	    uint64_t c = sum < add;
+	    limbs[l + i] = sum + carry;
+	    carry = c | (limbs[l + i] < sum);
+	}
+    }
+    else {
+	for (size_t i = 0; l + i < limbs.size (); ++i) {
+	    uint64_t sub = (i < 3) ? w[i] : 0;
+	    if (i >= 3 && carry == 0)
+		break;
+	    uint64_t a = limbs[l + i];
+	    uint64_t diff = a - sub;
+	    uint64_t b = a < sub;
+	    limbs[l + i] = diff - carry;
+	    carry = b | (diff < carry);
+	}
+    }
+}
+
+uint64_t
+CgemmAccumulator::round (const CgemmArith & arith) const
+{
+    if (nan)
+	return arith.nan ();
+
+    vector < uint64_t > mag (limbs);
+
+    // sign extend from the top bit so carries out of it wrap around
+    int l = (width - 1) >> 6, b = (width - 1) & 63;
+    bool sign = (mag[l] >> b) & 1;
+    if (b != 63) {
+	if (sign)
+	    mag[l] |= ~0ULL << (b + 1);
+	else
+	    mag[l] &= low_mask (b + 1);
+    }
+    if (sign) {
+	uint64_t carry = 1;
+	for (size_t i = 0; i < mag.size (); ++i) {
+	    mag[i] = ~mag[i] + carry;
+	    carry = carry && (mag[i] == 0);
+	}
+    }
+    return arith.encode (sign, mag, lsb);
+}
+
+vector < uint64_t >
+CgemmAccumulator::exact () const
+{
+    vector < uint64_t > bits (limbs);
+
+    // drop what wrapped past the top, as the hardware register does
+    bits.resize ((width + 1 + 63) / 64, 0);
+    bits[width >> 6] &= low_mask (width & 63);
+    for (size_t i = (width >> 6) + 1; i < bits.size (); ++i)
+	bits[i] = 0;
+    if (nan)
+	bits[width >> 6] |= 1ULL << (width & 63);
+    return bits;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2015,2017 International Business Machines
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __cgemm_arith_h__
+#define __cgemm_arith_h__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// arithmetic types as reported in ACTION_TYPE_REG bits 15:8
+#define ARITH_IEEE	0
+#define ARITH_TFP	1
+#define ARITH_BF16	2
+#define ARITH_POSIT	3
+
+/* CgemmOperand - an element split into (-1)^sign * significand * 2^scale,
+ * which is what the S3FDP of a systolic array PE works on */
+struct CgemmOperand
+{
+    bool nan;
+    bool sign;
+    uint64_t significand;
+    int scale;
+};
+
+/* CgemmArith class - element format of the cgemm systolic array, given
+ * with the syntax of prepare_hw.py --arithmetic_in: ieee:<we>:<wf>,
+ * bfloat16 or posit:<n>:<es> */
+class CgemmArith
+{
+public:
+    uint8_t type;
+    uint8_t bits;
+    uint8_t param1;	// we for ieee, n for posit
+    uint8_t param2;	// wf for ieee, es for posit
+
+    CgemmArith ();
+
+    /* returns false if the format is unknown or the model can't do it */
+    bool parse (const std::string & arith);
+
+    /* smallest summand window holding every product exactly */
+    void exact_window (int *msb, int *lsb) const;
+
+    CgemmOperand decode (uint64_t element) const;
+
+    /* rounds (-1)^sign * magnitude * 2^lsb to nearest even, magnitude
+     * is little endian in 64 bit limbs */
+    uint64_t encode (bool sign, const std::vector < uint64_t > &magnitude,
+                     int lsb) const;
+
+    uint64_t nan () const;
+
+private:
+    uint64_t encode_ieee (bool sign, const std::vector < uint64_t > &mag,
+                          int lsb) const;
+    uint64_t encode_posit (bool sign, const std::vector < uint64_t > &mag,
+                           int lsb) const;
+};
+
+/* CgemmAccumulator class - the exact fixed point accumulator of one PE,
+ * msb_summand down to lsb_summand plus nb_bits_ovf carry bits and a sign
+ * bit, two's complement. Product bits below lsb are dropped and carries
+ * past the top wrap around, as in the S3FDP operator. */
+class CgemmAccumulator
+{
+private:
+    std::vector < uint64_t > limbs;
+    int lsb;
+    int width;
+    bool nan;
+
+public:
+    CgemmAccumulator (int msb, int lsb, int ovf);
+
+    void clear ();
+
+    void mac (const CgemmOperand & x, const CgemmOperand & y);
+
+    uint64_t round (const CgemmArith & arith) const;
+
+    /* the accumulator as arithmetic_out=exact returns it, two's complement
+     * with the NaN flag above, little endian in 64 bit limbs */
+    std::vector < uint64_t > exact () const;
+};
+
+#endif
@@ -102,13 +102,14 @@ TagManager::set_max_credits (int mc)
 
 // reset credit
 void
-TagManager::reset_tlx_credit(uint8_t cmd_max_credit, uint8_t data_max_credit )
+TagManager::reset_tlx_credit(uint8_t cmd_max_credit, uint8_t resp_max_credit,
+			     uint8_t cmd_data_max_credit, uint8_t resp_data_max_credit)
 {
     //info_msg("TagManager: Initialize TLX cmd and data credits");
-    resp_credit = cmd_max_credit;
+    resp_credit = resp_max_credit;
     cmd_credit  = cmd_max_credit;
-    resp_data_credit = data_max_credit;
-    cmd_data_credit  = data_max_credit;
+    resp_data_credit = resp_data_max_credit;
+    cmd_data_credit  = cmd_data_max_credit;
 }
 
 // request credit
@@ -64,7 +64,8 @@ public:
     static void reset ();
 
     // reset credit
-    static void reset_tlx_credit(uint8_t cmd_max_credit, uint8_t data_max_credit);
+    static void reset_tlx_credit(uint8_t cmd_max_credit, uint8_t resp_max_credit,
+				 uint8_t cmd_data_max_credit, uint8_t resp_data_max_credit);
 
     // request credit
     static bool request_tlx_credit(uint8_t type);
@@ -27,7 +27,7 @@ main (int argc, char *argv[])
 {
     if (argc < 3) {
         fprintf (stderr,
-                 "Not enough arguments. Usage: ./afu port_number descriptor_file [parity] [jerror]\n");
+                 "Not enough arguments. Usage: ./afu port_number descriptor_file [parity] [jerror] [cgemm=[<K>*]<N>x<M>,<arith>]\n");
         exit (1);
     }
 
@@ -37,12 +37,27 @@ main (int argc, char *argv[])
     string descriptor_file (argv[2]);
     bool parity = false;
     bool jerror = false;
+    string cgemm_config;
 
     stringstream ss;
 
     ss << argv[1];
     ss >> port;
 
+    // cgemm=[<K>*]<N>x<M>,<arith>[,<msb>,<lsb>,<ovf>] models the cgemm action
+    for (int i = 3; i < argc; ++i) {
+        string arg (argv[i]);
+
+        if (arg.compare (0, 6, "cgemm=") == 0) {
+            printf ("MAIN: AFU models the cgemm action %s\n", arg.c_str () + 6);
+            cgemm_config = arg.substr (6);
+            --argc;
+            for (int j = i; j < argc; ++j)
+                argv[j] = argv[j + 1];
+            --i;
+        }
+    }
+
     if (argc == 4 && string (argv[3]) == "parity") {
         printf ("MAIN: AFU parity enabled\n");
         parity = true;
@@ -58,7 +73,7 @@ main (int argc, char *argv[])
         jerror = true;
     }
 
-    AFU afu (port, descriptor_file, parity, jerror);
+    AFU afu (port, descriptor_file, parity, jerror, cgemm_config);
 
     afu.start ();
     debug_msg ("main: AFU quitting");